@@ -0,0 +1,142 @@
+/**
+ * @file    bench.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the microbenchmark harness implementation, and the reading and comparing of results.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "bench.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace Bench {
+
+Suite::Suite(uint64_t _iterations, const std::string& _filter)
+    : iterations(_iterations), filter(_filter) {
+  // The fastest of many back to back reads is the part of a single call timing that is just the clock.
+  overhead = UINT64_MAX;
+  for (int i = 0; i < 10000; i++) {
+    uint64_t start = now_ns();
+    overhead = std::min(overhead, now_ns() - start);
+  }
+}
+
+void Suite::finish(Result& result) {
+  result.p50 = histogram.percentile(50);
+  result.p90 = histogram.percentile(90);
+  result.p99 = histogram.percentile(99);
+  result.p999 = histogram.percentile(99.9);
+  result.max = histogram.max();
+  resultList.push_back(result);
+
+  std::cout << std::left << std::setw(36) << result.name << std::right << std::fixed << std::setprecision(1)
+	    << std::setw(10) << result.nsPerOp << " ns/op   p50 " << std::setw(6) << result.p50
+	    << "  p99 " << std::setw(6) << result.p99 << "  p99.9 " << std::setw(6) << result.p999
+	    << "  max " << result.max << std::endl;
+}
+
+void Suite::writeJSON(std::ostream& out) const {
+  out << "{\n  \"clock_overhead_ns\": " << overhead << ",\n  \"benchmarks\": [\n";
+  for (std::size_t i = 0; i < resultList.size(); i++) {
+    const Result& result = resultList[i];
+    out << "    {\"name\": \"" << result.name << "\", \"iterations\": " << result.iterations
+	<< ", \"ns_per_op\": " << std::fixed << std::setprecision(2) << result.nsPerOp
+	<< ", \"p50_ns\": " << result.p50 << ", \"p90_ns\": " << result.p90 << ", \"p99_ns\": " << result.p99
+	<< ", \"p999_ns\": " << result.p999 << ", \"max_ns\": " << result.max << "}"
+	<< (i + 1 < resultList.size() ? ",\n" : "\n");
+  }
+  out << "  ]\n}\n";
+}
+
+/**
+ * @brief Find a number in a line of results.
+ * @param line Line holding one benchmark.
+ * @param key Key of the number.
+ * @retval double Number, or 0 if the key isn't there.
+ */
+static double numberField(const std::string& line, const std::string& key) {
+  std::size_t position = line.find("\"" + key + "\": ");
+  if (position == std::string::npos)
+    return 0;
+
+  return std::strtod(line.c_str() + position + key.size() + 4, nullptr);
+}
+
+std::vector<Result> readJSON(std::istream& in) {
+  // Only files written by writeJSON() are read, which have each benchmark on a line of its own.
+  const std::string nameKey = "\"name\": \"";
+  std::vector<Result> results;
+  std::string line;
+  while (std::getline(in, line)) {
+    std::size_t start = line.find(nameKey);
+    if (start == std::string::npos)
+      continue;
+
+    start += nameKey.size();
+    Result result;
+    result.name = line.substr(start, line.find('"', start) - start);
+    result.iterations = numberField(line, "iterations");
+    result.nsPerOp = numberField(line, "ns_per_op");
+    result.p50 = numberField(line, "p50_ns");
+    result.p90 = numberField(line, "p90_ns");
+    result.p99 = numberField(line, "p99_ns");
+    result.p999 = numberField(line, "p999_ns");
+    result.max = numberField(line, "max_ns");
+    results.push_back(result);
+  }
+
+  return results;
+}
+
+bool compare(const std::vector<Result>& baseline, const std::vector<Result>& current,
+	     double maxRegression, std::ostream& out) {
+  bool passed = true;
+  out << std::left << std::setw(36) << "benchmark" << std::right << std::setw(12) << "baseline" << std::setw(12)
+      << "current" << std::setw(10) << "change" << std::setw(10) << "p99" << std::endl;
+
+  for (const Result& result : current) {
+    auto old = std::find_if(baseline.begin(), baseline.end(),
+			    [&result](const Result& other) { return other.name == result.name; });
+    out << std::left << std::setw(36) << result.name << std::right << std::fixed << std::setprecision(1);
+    if (old == baseline.end() || old->nsPerOp <= 0) {
+      out << std::setw(12) << "-" << std::setw(12) << result.nsPerOp << "   (new)" << std::endl;
+      continue;
+    }
+
+    double change = 100 * (result.nsPerOp - old->nsPerOp) / old->nsPerOp;
+    double p99Change = old->p99 ? 100 * ((double)result.p99 - (double)old->p99) / old->p99 : 0;
+    out << std::setw(12) << old->nsPerOp << std::setw(12) << result.nsPerOp << std::showpos << std::setw(9)
+	<< change << '%' << std::setw(9) << p99Change << '%' << std::noshowpos;
+    if (change > maxRegression) {
+      out << "  REGRESSED";
+      passed = false;
+    }
+    out << std::endl;
+  }
+
+  return passed;
+}
+
+} // namespace Bench
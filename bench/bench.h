@@ -0,0 +1,199 @@
+/**
+ * @file    bench.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the declarations for the microbenchmark harness used by the benchmark suite.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "../lib/telemetry/latency.h"
+
+/**
+ * @brief Microbenchmark harness for timing small pieces of the control path with no hardware attached.
+ * Each benchmark is an operation called with an iteration number, so it can step through inputs
+ * worked out beforehand. It is timed twice: once as a tight loop for throughput, and once call by call
+ * for the latency distribution, since the control loop cares about the slowest sample, not the average.
+ */
+namespace Bench {
+
+  /**
+   * @brief Stop the compiler from optimising away a value that is otherwise unused.
+   * @param value Value to keep.
+   */
+  template <typename T>
+  inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+  }
+
+  /**
+   * @brief Timings of one benchmark.
+   */
+  struct Result {
+    /** Name of the benchmark. */
+    std::string name;
+
+    /** Number of calls timed in each phase. */
+    uint64_t iterations = 0;
+
+    /** Mean time per call over the throughput loop, in nanoseconds. */
+    double nsPerOp = 0;
+
+    /** Latency percentiles and maximum of single calls, in nanoseconds, less the clock overhead. */
+    uint64_t p50 = 0;
+    uint64_t p90 = 0;
+    uint64_t p99 = 0;
+    uint64_t p999 = 0;
+    uint64_t max = 0;
+  };
+
+  /**
+   * @brief Runs benchmarks and collects their results.
+   */
+  class Suite {
+  public:
+    /**
+     * @brief Constructor. Measures the overhead of reading the clock, to take off single call timings.
+     * @param _iterations Number of calls timed in each phase of a benchmark.
+     * @param _filter Only benchmarks whose names contain this are run. Empty runs everything.
+     */
+    Suite(uint64_t _iterations, const std::string& _filter = "");
+
+    /**
+     * @brief Run a benchmark, unless it is filtered out, and print its result.
+     * @param name Name of the benchmark, as it appears in the results.
+     * @param operation Operation to time, called with the iteration number.
+     */
+    template <typename Operation>
+    void run(const std::string& name, Operation operation);
+
+    /**
+     * @brief Write the results as JSON, one benchmark per line.
+     * @param out Stream to write to.
+     */
+    void writeJSON(std::ostream& out) const;
+
+    /**
+     * @brief Get the results of the benchmarks run so far.
+     * @retval const std::vector<Result>& Results, in the order run.
+     */
+    const std::vector<Result>& results(void) const { return resultList; }
+
+    /**
+     * @brief Get the time taken to read the clock twice, taken off single call timings.
+     * @retval uint64_t Clock overhead in nanoseconds.
+     */
+    uint64_t clockOverhead(void) const { return overhead; }
+
+  private:
+    /**
+     * @brief Read the clock.
+     * @retval uint64_t Time in nanoseconds.
+     */
+    static uint64_t now_ns(void) {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Fill in the latencies of a result from the histogram, store it, and print it.
+     * @param result Result with the name, iterations and throughput filled in.
+     */
+    void finish(Result& result);
+
+    /** Number of calls timed in each phase. */
+    uint64_t iterations;
+
+    /** Benchmark name filter. */
+    std::string filter;
+
+    /** Clock overhead in nanoseconds. */
+    uint64_t overhead = 0;
+
+    /** Latencies of single calls of the benchmark being run. */
+    Telemetry::LatencyHistogram histogram;
+
+    /** Results of the benchmarks run so far. */
+    std::vector<Result> resultList;
+  };
+
+  template <typename Operation>
+  void Suite::run(const std::string& name, Operation operation) {
+    if (!filter.empty() && name.find(filter) == std::string::npos)
+      return;
+
+    // Warm up the caches and branch predictors first.
+    for (uint64_t i = 0; i < iterations / 10; i++)
+      operation(i);
+
+    // Time the whole loop for throughput, so reading the clock isn't part of it.
+    Result result;
+    result.name = name;
+    result.iterations = iterations;
+    uint64_t start = now_ns();
+    for (uint64_t i = 0; i < iterations; i++)
+      operation(i);
+    result.nsPerOp = (double)(now_ns() - start) / iterations;
+
+    // Then time each call on its own for the tail latency.
+    histogram.reset();
+    for (uint64_t i = 0; i < iterations; i++) {
+      uint64_t callStart = now_ns();
+      operation(i);
+      uint64_t elapsed = now_ns() - callStart;
+      histogram.record(elapsed > overhead ? elapsed - overhead : 0);
+    }
+
+    finish(result);
+  }
+
+  /**
+   * @brief Read results back from a file written by Suite::writeJSON().
+   * @param in Stream to read from.
+   * @retval std::vector<Result> Results, in file order.
+   */
+  std::vector<Result> readJSON(std::istream& in);
+
+  /**
+   * @brief Print the change in each benchmark from a baseline, and check none got slower than allowed.
+   * Only throughput is checked, as single call latencies are too noisy on a desktop to fail a run on,
+   * but the change in p99 is printed alongside.
+   * @param baseline Results to compare against, e.g. from the previous commit.
+   * @param current Results to check.
+   * @param maxRegression Largest allowed increase in time per call, in percent.
+   * @param out Stream to print the comparison to.
+   * @retval bool True if no benchmark regressed by more than maxRegression.
+   */
+  bool compare(const std::vector<Result>& baseline, const std::vector<Result>& current,
+               double maxRegression, std::ostream& out);
+
+} // namespace Bench
+
+#endif
@@ -0,0 +1,371 @@
+/**
+ * @file    bench_main.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the benchmark suite for the control path, run with no hardware attached.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Usage: ShakeyTable_bench [--config <rig config>] [--trace <MPU6050 trace>] [results file] [iterations] [filter]
+ *        ShakeyTable_bench --compare <baseline file> <results file> [max regression %]
+ * The first form runs every benchmark whose name contains the filter, prints a table, and writes the
+ * results as JSON (to bench_results.json by default). With a trace recorded on a rig (mpu_trace in its
+ * config), the sensor and control path benchmarks are also run on the recorded data. The second form
+ * compares two results files, and exits with 1 if any benchmark got slower by more than the allowed
+ * regression (10 % by default).
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "../lib/MotorDriver/MotorDriver.h"
+#include "../lib/i2c_interface/replay_i2c_if.h"
+#include "../lib/estimator/estimator.h"
+#include "../lib/mpu6050/frame_convert.h"
+#include "../lib/mpu6050/mpu6050.h"
+#include "../lib/params/config.h"
+#include "../lib/pid/pid.h"
+#include "../lib/pipeline/pipeline.h"
+#include "../lib/telemetry/telemetry.h"
+#include "../test/fake_mpu6050.h"
+
+using namespace MPU6050_Driver;
+
+/** Number of distinct inputs each benchmark steps through. A power of two, so wrapping is a mask. */
+static constexpr std::size_t INPUT_COUNT = 1024;
+
+/** Number of frames drained from the FIFO at once by the FIFO benchmark. */
+static constexpr uint16_t FIFO_BURST = 32;
+
+/**
+ * @brief Pitching table sample, as if the table swings slowly either side of upright.
+ * @param i Sample number
+ * @param period Sample period (s)
+ * @return MPU6050Sample Sample, in g and deg/s
+ */
+MPU6050Sample swingSample(std::size_t i, float period) {
+  MPU6050Sample sample;
+  double angle = 0.1 * std::sin(i * period * 3);
+  sample.ax = std::sin(angle);
+  sample.ay = std::cos(angle);
+  sample.az = 0.01;
+  sample.temp = 25;
+  sample.gz = 0.3 * 180 / M_PI * std::cos(i * period * 3);
+  return sample;
+}
+
+/**
+ * @brief MPU6050 stand-in returning frames worked out beforehand. Register reads step through the frames one
+ * at a time, and FIFO reads stream through them, so the driver never sees the same data twice in a row.
+ */
+class FrameBus final : public FakeMPU6050
+{
+public:
+  /**
+   * @brief Constructor, encoding a swinging table at full scales of 2 g and 250 deg/s.
+   * @param period Sample period (s)
+   */
+  FrameBus(float period) : FakeMPU6050(false) {
+    frames.resize(INPUT_COUNT * FIFO_FRAME_SIZE);
+    for (std::size_t i = 0; i < INPUT_COUNT; i++) {
+      MPU6050Sample sample = swingSample(i, period);
+      const float values[7] = {sample.ax * 16384, sample.ay * 16384, sample.az * 16384,
+			       (sample.temp - 36.53f) * 340, sample.gx * 131, sample.gy * 131, sample.gz * 131};
+      for (int j = 0; j < 7; j++) {
+	int16_t raw = (int16_t)std::lround(values[j]);
+	frames[i * FIFO_FRAME_SIZE + 2 * j] = (uint16_t)raw >> 8;
+	frames[i * FIFO_FRAME_SIZE + 2 * j + 1] = raw & 0xFF;
+      }
+    }
+  }
+
+  /**
+   * @brief Set the number of whole frames the FIFO count reports.
+   * @param count Number of frames
+   */
+  void setFIFOFrames(uint16_t count) { fifoBytes = count * FIFO_FRAME_SIZE; }
+};
+
+/**
+ * @brief Direction output stand-in, costing about as much as an uncached register write.
+ */
+class NullDIR final : public DIR_Backend {
+public:
+  virtual void writeDirection(bool forward) override { reg = forward; }
+
+private:
+  /** Stand-in register. */
+  volatile uint32_t reg = 0;
+};
+
+/**
+ * @brief PWM backend stand-in, costing about as much as an uncached register write.
+ */
+class NullPWM final : public PWM_Backend {
+public:
+  virtual bool writePeriod(uint32_t period_ns) override { reg = period_ns; return true; }
+  virtual bool writeDuty(uint32_t duty_ns) override { reg = duty_ns; return true; }
+  virtual bool writeEnable(bool enable) override { reg = enable; return true; }
+
+private:
+  /** Stand-in register. */
+  volatile uint32_t reg = 0;
+};
+
+/**
+ * @brief MPU6050 callback that keeps the newest sample, so the sample isn't optimised away.
+ */
+class KeepSample final : public MPU6050Interface {
+public:
+  virtual void hasSample(MPU6050Sample& sample) override { last = sample; }
+
+  /** Newest sample. */
+  MPU6050Sample last;
+};
+
+/**
+ * @brief PID callback that keeps the newest output, so the controller isn't optimised away.
+ */
+class KeepOutput final : public PID_Interface {
+public:
+  virtual void hasOutput(double pidOutput) override { last = pidOutput; }
+
+  /** Newest output. */
+  double last = 0;
+};
+
+/**
+ * @brief Make a motor driver on the stand-in backends.
+ * @param config Settings, for the PWM period
+ * @return std::unique_ptr<MotorDriver> Motor driver
+ */
+std::unique_ptr<MotorDriver> nullMotorDriver(const Params::Config& config) {
+  return std::unique_ptr<MotorDriver>(new MotorDriver(std::unique_ptr<DIR_Backend>(new NullDIR),
+						      std::unique_ptr<PWM_Backend>(new NullPWM), config.mdPeriod_ns));
+}
+
+/**
+ * @brief Run every benchmark of the control path, in the order data flows through it.
+ * @param suite Suite to run them in
+ * @param config Settings of the rig, so the benchmarks time what the table actually runs
+ * @param tracePath MPU6050 trace to also run the sensor and control path on, or empty for none
+ * @param telemetryPath File the control path benchmark logs its telemetry to
+ */
+void runBenchmarks(Bench::Suite& suite, const Params::Config& config, const std::string& tracePath,
+		   const std::string& telemetryPath) {
+  const float period = config.MPUSamplePeriod();
+  const std::size_t mask = INPUT_COUNT - 1;
+
+  // Inputs worked out beforehand, so the benchmarks only time the code under test.
+  std::vector<MPU6050Sample> samples(INPUT_COUNT);
+  std::vector<double> angles(INPUT_COUNT);
+  std::vector<double> dutyCycles(INPUT_COUNT);
+  for (std::size_t i = 0; i < INPUT_COUNT; i++) {
+    samples[i] = swingSample(i, period);
+    angles[i] = 0.1 * std::sin(i * period * 3);
+    dutyCycles[i] = 0.8 * std::sin(i * 2 * M_PI / INPUT_COUNT);
+  }
+
+  // Sensor: block read into a raw frame, converting a frame into units, then both with the callback.
+  FrameBus bus(period);
+  KeepSample sampleSink;
+  MPU6050 mpu(&bus, &sampleSink, 0);
+  mpu.SetGyroFullScale(config.mpuGyroScale);
+  mpu.SetAccelFullScale(config.mpuAccelScale);
+
+  std::vector<MPU6050Frame> frames(INPUT_COUNT);
+  for (MPU6050Frame& frame : frames)
+    mpu.ReadAllRawData(frame);
+
+  MPU6050Frame frame;
+  suite.run("mpu6050_read_all_raw_data", [&](uint64_t) {
+    mpu.ReadAllRawData(frame);
+    Bench::doNotOptimize(frame);
+  });
+  suite.run("mpu6050_frame_to_sample", [&](uint64_t i) {
+    frames[i & mask].toSample(sampleSink.last);
+    Bench::doNotOptimize(sampleSink.last);
+  });
+  suite.run("mpu6050_process_sample", [&](uint64_t i) { mpu.ProcessSample(i + 1); });
+  Bench::doNotOptimize(sampleSink.last);
+
+  std::vector<MPU6050Sample> burst(FIFO_BURST);
+  bus.setFIFOFrames(FIFO_BURST);
+  suite.run("mpu6050_read_fifo_frames_x32", [&](uint64_t) {
+    i2c_status_t error;
+    mpu.ReadFIFOFrames(burst.data(), FIFO_BURST, &error);
+    Bench::doNotOptimize(burst[FIFO_BURST - 1]);
+  });
+
+  // Converting a burst of raw frames into one array per axis, with the build's vector instructions and without.
+  std::vector<uint8_t> rawBurst(FIFO_BURST * FIFO_FRAME_SIZE);
+  for (uint16_t i = 0; i < FIFO_BURST; i++)
+    std::copy_n(frames[i].bytes, FIFO_FRAME_SIZE, &rawBurst[i * FIFO_FRAME_SIZE]);
+  std::unique_ptr<MPU6050Batch> batch(new MPU6050Batch), scalarBatch(new MPU6050Batch);
+  suite.run("mpu6050_convert_frames_x32", [&](uint64_t) {
+    ConvertFrames(rawBurst.data(), FIFO_BURST, mpu.GetScale(), *batch);
+    Bench::doNotOptimize(*batch);
+  });
+  suite.run("mpu6050_convert_frames_x32_scalar", [&](uint64_t) {
+    ConvertFramesScalar(rawBurst.data(), FIFO_BURST, mpu.GetScale(), *scalarBatch);
+    Bench::doNotOptimize(*scalarBatch);
+  });
+  ConvertFrames(rawBurst.data(), FIFO_BURST, mpu.GetScale(), *batch);
+  ConvertFramesScalar(rawBurst.data(), FIFO_BURST, mpu.GetScale(), *scalarBatch);
+  bool matched = true;
+  for (int word = 0; word < 7; word++)
+    matched = matched && std::memcmp(batch->words[word], scalarBatch->words[word], FIFO_BURST * sizeof(float)) == 0;
+  if (!matched)
+    std::cout << "ConvertFrames (" << ConvertFramesISA() << ") does not match the scalar conversion." << std::endl;
+
+  // Tilt: the accelerometer angle alone, then every filter that fuses it with the gyro rate.
+  Attitude::Estimator tiltEstimator(config.mpuFilter, period, config.radius);
+  suite.run("estimator_accel_tilt", [&](uint64_t i) {
+    float tilt = tiltEstimator.accelTilt(samples[i & mask]);
+    Bench::doNotOptimize(tilt);
+  });
+
+  const std::pair<Attitude::Filter_t, const char*> filters[] = {
+    {Attitude::Filter_t::COMPLEMENTARY, "estimator_update_complementary"},
+    {Attitude::Filter_t::MAHONY, "estimator_update_mahony"},
+    {Attitude::Filter_t::KALMAN, "estimator_update_kalman"}};
+  for (const auto& filter : filters) {
+    Attitude::Estimator estimator(filter.first, period, config.radius);
+    suite.run(filter.second, [&](uint64_t i) {
+      float angle = estimator.update(samples[i & mask]);
+      Bench::doNotOptimize(angle);
+    });
+  }
+
+  // The rig's filter straight from raw frames, converting only the axes it uses.
+  Attitude::Estimator frameEstimator(config.mpuFilter, period, config.radius);
+  suite.run("estimator_update_frame", [&](uint64_t i) {
+    float angle = frameEstimator.update(frames[i & mask]);
+    Bench::doNotOptimize(angle);
+  });
+
+  // Controller.
+  KeepOutput outputSink;
+  PID pid(&outputSink, config.outerSetpoint, period, 10, -10, config.outer.Kp, config.outer.Kd, config.outer.Ki);
+  suite.run("pid_calculate", [&](uint64_t i) { pid.calculate(angles[i & mask]); });
+  Bench::doNotOptimize(outputSink.last);
+
+  // Actuator: a new duty cycle every call, and the same one, which is skipped.
+  std::unique_ptr<MotorDriver> motorDriver = nullMotorDriver(config);
+  suite.run("motordriver_set_duty_cycle", [&](uint64_t i) { motorDriver->setDutyCycle(dutyCycles[i & mask]); });
+  suite.run("motordriver_set_duty_cycle_unchanged", [&](uint64_t) { motorDriver->setDutyCycle(0.5); });
+
+  // The whole single loop, from the sensor read to the motor driver write, logging as it goes.
+  Telemetry::Logger logger(telemetryPath);
+  Telemetry::Producer& producer = logger.createProducer();
+  logger.begin();
+  std::unique_ptr<MotorDriver> loopMotorDriver = nullMotorDriver(config);
+  Pipeline::SingleLoop<MotorDriver> loop(config, *loopMotorDriver, producer);
+  MPU6050 loopMPU(&bus, &loop.mpuInput(), 0);
+  loopMPU.SetGyroFullScale(config.mpuGyroScale);
+  loopMPU.SetAccelFullScale(config.mpuAccelScale);
+  suite.run("control_path_single_loop", [&](uint64_t i) { loopMPU.ProcessSample(i + 1); });
+
+  // The same again on data recorded from a rig, looping round the recording.
+  if (!tracePath.empty()) {
+    REPLAY_I2C_IF replay(tracePath);
+    replay.SetLoop(true);
+    MPU6050 traceMPU(&replay, &sampleSink, 0);
+    MPU6050 traceLoopMPU(&replay, &loop.mpuInput(), 0);
+    for (MPU6050* mpu : {&traceMPU, &traceLoopMPU}) {
+      mpu->SetGyroFullScale(config.mpuGyroScale);
+      mpu->SetAccelFullScale(config.mpuAccelScale);
+    }
+
+    suite.run("trace_mpu6050_process_sample", [&](uint64_t i) { traceMPU.ProcessSample(i + 1); });
+    suite.run("trace_control_path_single_loop", [&](uint64_t i) { traceLoopMPU.ProcessSample(i + 1); });
+    if (replay.GetServedCount() == 0)
+      std::cout << tracePath << " has no MPU6050 sample reads, so the trace benchmarks timed failed reads." << std::endl;
+  }
+  logger.end();
+}
+
+/**
+ * @brief Print both forms of the command line.
+ * @param program Name the program was run as.
+ */
+static void printUsage(const char* program) {
+  std::cout << "Usage: " << program << " [--config <rig config>] [--trace <MPU6050 trace>] [results file] [iterations] [filter]" << std::endl;
+  std::cout << "       " << program << " --compare <baseline file> <results file> [max regression %]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1 && std::string(argv[1]) == "--compare") {
+    if (argc < 4) {
+      printUsage(argv[0]);
+      return 1;
+    }
+
+    std::ifstream baselineFile(argv[2]);
+    std::ifstream currentFile(argv[3]);
+    if (!baselineFile.is_open() || !currentFile.is_open()) {
+      std::cout << "Failed to open " << (baselineFile.is_open() ? argv[3] : argv[2]) << "." << std::endl;
+      return 1;
+    }
+
+    double maxRegression = argc > 4 ? std::atof(argv[4]) : 10;
+    bool passed = Bench::compare(Bench::readJSON(baselineFile), Bench::readJSON(currentFile), maxRegression, std::cout);
+    return passed ? 0 : 1;
+  }
+
+  Params::Config config;
+  std::string tracePath;
+  int arg = 1;
+  for (; arg < argc && argv[arg][0] == '-' && argv[arg][1] == '-'; arg += 2) {
+    std::string option = argv[arg];
+    if (option != "--config" && option != "--trace") {
+      std::cout << "Unknown option " << option << "." << std::endl;
+      printUsage(argv[0]);
+      return 1;
+    }
+    if (arg + 1 >= argc) {
+      std::cout << "Option " << option << " needs a value." << std::endl;
+      printUsage(argv[0]);
+      return 1;
+    }
+
+    if (option == "--config")
+      Params::LoadConfig(argv[arg + 1], config);
+    else
+      tracePath = argv[arg + 1];
+  }
+
+  std::string resultsPath = argc > arg ? argv[arg] : "bench_results.json";
+  uint64_t iterations = argc > arg + 1 ? std::strtoull(argv[arg + 1], nullptr, 10) : 200000;
+  std::string filter = argc > arg + 2 ? argv[arg + 2] : "";
+  if (iterations == 0) {
+    std::cout << "Iterations must be a positive number." << std::endl;
+    return 1;
+  }
+
+  std::ofstream resultsFile(resultsPath);
+  if (!resultsFile.is_open()) {
+    std::cout << "Failed to open " << resultsPath << "." << std::endl;
+    return 1;
+  }
+
+  Bench::Suite suite(iterations, filter);
+  std::cout << "Clock overhead: " << suite.clockOverhead() << " ns, taken off single call latencies" << std::endl;
+  std::cout << "Frame conversion: " << ConvertFramesISA() << std::endl;
+
+  const std::string telemetryPath = "bench_telemetry.bin";
+  runBenchmarks(suite, config, tracePath, telemetryPath);
+  std::remove(telemetryPath.c_str());
+
+  suite.writeJSON(resultsFile);
+  std::cout << "Results written to " << resultsPath << std::endl;
+  return 0;
+}
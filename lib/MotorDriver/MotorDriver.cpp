@@ -32,86 +32,48 @@
 #include <cmath>
 #include "MotorDriver.h"
 
-MotorDriver::MotorDriver(const std::filesystem::path chip_path, gpiod::line::offset pin_DIR, uint32_t period_ns)
+MotorDriver::MotorDriver(const std::filesystem::path chip_path, gpiod::line::offset pin_DIR, uint32_t period_ns,
+                         std::unique_ptr<PWM_Backend> pwm_backend)
 :
-period_PWM(period_ns),
-_pin_DIR(pin_DIR),
-request_DIR(::gpiod::chip(chip_path)
-			       .prepare_request()
-			       .set_consumer("set-line-direction")
-			       .add_line_settings(_pin_DIR, ::gpiod::line_settings()
-                         .set_direction(::gpiod::line::direction::OUTPUT))
-			       .do_request())
+MotorDriver(std::unique_ptr<DIR_Backend>(new GpiodDIR(chip_path, pin_DIR)), std::move(pwm_backend), period_ns)
+{
+}
+
+MotorDriver::MotorDriver(std::unique_ptr<DIR_Backend> dir_backend, std::unique_ptr<PWM_Backend> pwm_backend,
+                         uint32_t period_ns)
+:
+dir(std::move(dir_backend)),
+pwm(std::move(pwm_backend)),
+period_PWM(period_ns)
 
 {
       //std::cout << "MotorDriver constructor entered." << std::endl;
 
       // Presetting DIR pin to low
-      request_DIR.set_value(_pin_DIR, ::gpiod::line::value::INACTIVE);
-
-      // Create pwm2 directory and open files for controlling PWM
-      // Initialise PWM by enabling it and presetting duty cycle to zero
-      PWM2_Export.open("/sys/class/pwm/pwmchip2/export", std::ios::out | std::ios::trunc);
-      if (PWM2_Export.is_open()) 
-      {
-            PWM2_Export << 2 << std::endl;
-      }
-      else 
-      {
-            std::cout << "Failed to create pwm2 directory." << std::endl; // Display an error message if file opening failed
-            throw std::invalid_argument( "Failed to create pwm2 directory." );
-      }
+      dir->writeDirection(false);
 
-      // Open PWM unexport file to close pwm2 directory when finished.
-      PWM2_Unexport.open("/sys/class/pwm/pwmchip2/unexport", std::ios::out | std::ios::trunc);
-      if (!PWM2_Unexport.is_open()) 
-      {
-            std::cout << "Failed to open pwm unexport file." << std::endl; // Display an error message if file opening failed
-            throw std::invalid_argument( "Failed to open pwm unexport file." );
-      }
+      // Export pwm2 and open its files for controlling PWM, unless another backend was given
+      if (!pwm)
+            pwm.reset(new SysfsPWM("/sys/class/pwm/pwmchip2", 2));
 
-
-      PeriodOutputFile.open("/sys/class/pwm/pwmchip2/pwm2/period", std::ios::out | std::ios::trunc);
-
-      /* For some reason the "period" file cannot be opened immediately after writing "2" to the "export" file.
-       * The "period" file does exist immediately after the "export" write, which can be confirmed using
-       * std::filesystem::exists(), but is not openable. Maybe the kernel is still accessing it?
-       * So, we loop round trying to open the file until it can be opened.
-       */
-      while (!PeriodOutputFile.is_open())
-	    PeriodOutputFile.open("/sys/class/pwm/pwmchip2/pwm2/period", std::ios::out | std::ios::trunc);
-      
-      if (PeriodOutputFile.is_open()) // Bit redundant now. Maybe add timeout for above loop, so this is still relevant?
-      {
-            PeriodOutputFile << period_PWM << std::endl;
-      }
-      else 
+      // Initialise PWM by setting the period, presetting duty cycle to zero and enabling it
+      if (!pwm->writePeriod(period_PWM))
       {
-            std::cout << "Failed to open period file." << std::endl; // Display an error message if file opening failed
-            throw std::invalid_argument( "Failed to open period file." );
+            std::cout << "Failed to write period file." << std::endl; // Display an error message if writing failed
+            throw std::invalid_argument( "Failed to write period file." );
       }
 
-      DutyCycleOutputFile.open("/sys/class/pwm/pwmchip2/pwm2/duty_cycle", std::ios::out | std::ios::trunc);
-      if ( DutyCycleOutputFile.is_open())
-      {
-            DutyCycleOutputFile << 0 << std::endl;
-      }
-      else 
+      if (!pwm->writeDuty(0))
       {
-            std::cout << "Failed to open duty_cycle file." << std::endl; // Display an error message if file opening failed
-            throw std::invalid_argument( "Failed to open duty_cycle file." );
+            std::cout << "Failed to write duty_cycle file." << std::endl; // Display an error message if writing failed
+            throw std::invalid_argument( "Failed to write duty_cycle file." );
       }
 
-      EnableOutputFile.open("/sys/class/pwm/pwmchip2/pwm2/enable", std::ios::out | std::ios::trunc);
-      if (EnableOutputFile.is_open()){
-            EnableOutputFile << 1 << std::endl;
-      }
-      else 
+      if (!pwm->writeEnable(true))
       {
-            std::cout << "Failed to open enable file." << std::endl; // Display an error message if file opening failed
-            throw std::invalid_argument( "Failed to open enable file." );
+            std::cout << "Failed to write enable file." << std::endl; // Display an error message if writing failed
+            throw std::invalid_argument( "Failed to write enable file." );
       }
-
 }
 
 void MotorDriver::setDutyCycle(double DutyCycle)
@@ -125,6 +87,11 @@ void MotorDriver::setDutyCycle(double DutyCycle)
       {
             DutyCycle = -1;
       }
+      else if (!(DutyCycle >= -1 && DutyCycle <= 1))
+      {
+            std::cout << "Duty Cycle out of limit." << std::endl; // Display an error message if file Duty Cycle is out of limits
+            throw std::invalid_argument( "Duty Cycle out of limit." ); 
+      }
 
       // Record current duty cycle
       currDC = DutyCycle;
@@ -132,80 +99,71 @@ void MotorDriver::setDutyCycle(double DutyCycle)
       // Convert duty cycle into appropriate form
       uint32_t Duty_nanosec = (uint32_t)(std::abs(DutyCycle) * period_PWM);
 
-      // Set duty cycle and direction.
-      if (DutyCycle >= 0 && DutyCycle <= 1)
-      {
-            //forward motion
-	    request_DIR.set_value(_pin_DIR, ::gpiod::line::value::ACTIVE);
-	    //std::cout << "Dir pin should be HIGH." << std::endl;
-      
-            if (DutyCycleOutputFile.is_open())
-            {
-                  DutyCycleOutputFile <<  Duty_nanosec << std::endl;
-		  //std::cout << "Set duty cycle to " << Duty_nanosec << " in the 'forward' direction." << std::endl;
-		  log_file << Duty_nanosec << std::endl;
-            }
-            else 
-            {
-                  std::cout << "Failed to open duty_cycle file." << std::endl; // Display an error message if file opening failed
-                  throw std::invalid_argument( "Failed to open duty_cycle file." );
-                  
-            }
-      }
-      else if (DutyCycle < 0 && DutyCycle >= -1)
+      // Within the deadband the motor is off, so there's no direction to change to.
+      bool DIR = DutyCycle >= 0;
+      if (Duty_nanosec < deadband_PWM)
+            Duty_nanosec = 0;
+      if (Duty_nanosec == 0)
+            DIR = prev_DIR;
+
+      // Set direction, only when it changes.
+      if (DIR != prev_DIR)
       {
-            //backwards motion
-	    request_DIR.set_value(_pin_DIR, ::gpiod::line::value::INACTIVE);
-	    //std::cout << "Dir pin should be LOW." << std::endl;
-            
-            if (DutyCycleOutputFile.is_open())
-            {
-                  DutyCycleOutputFile << Duty_nanosec << std::endl;
-		  //std::cout << "Set duty cycle to " << Duty_nanosec << " in the 'backward' direction." << std::endl;
-		  log_file << Duty_nanosec << std::endl;
-            }
-            else 
-            {
-                  std::cout << "Failed to open duty_cycle file." << std::endl; // Display an error message if file opening failed
-                  throw std::invalid_argument( "Failed to open duty_cycle file." );
-                  
-            }
+            // Stop the output before reversing, so the old duty cycle is never driven the wrong way.
+            if (prevDuty_ns != 0)
+                  writeDuty(0);
+
+            dir->writeDirection(DIR);
+            prev_DIR = DIR;
+            dirWrites.fetch_add(1, std::memory_order_relaxed);
       }
       else
+            dirSkips.fetch_add(1, std::memory_order_relaxed);
+
+      // Set duty cycle, unless it is within the hysteresis of what the PWM already has.
+      // Starting and stopping are always written exactly.
+      uint32_t change = Duty_nanosec > prevDuty_ns ? Duty_nanosec - prevDuty_ns : prevDuty_ns - Duty_nanosec;
+      if (change != 0 && (change > hysteresis_PWM || Duty_nanosec == 0 || prevDuty_ns == 0))
+            writeDuty(Duty_nanosec);
+      else
+            dutySkips.fetch_add(1, std::memory_order_relaxed);
+
+      Telemetry::LatencyTrace::stamp(Telemetry::LatencyStage::PWM_WRITE);
+}
+
+void MotorDriver::writeDuty(uint32_t Duty_nanosec)
+{
+      if (!pwm->writeDuty(Duty_nanosec))
       {
-            std::cout << "Duty Cycle out of limit." << std::endl; // Display an error message if file Duty Cycle is out of limits
-            throw std::invalid_argument( "Duty Cycle out of limit." ); 
-            
+            std::cout << "Failed to write duty_cycle file." << std::endl; // Display an error message if writing failed
+            throw std::invalid_argument( "Failed to write duty_cycle file." );
       }
+
+      prevDuty_ns = Duty_nanosec;
+      dutyWrites.fetch_add(1, std::memory_order_relaxed);
+      //std::cout << "Set duty cycle to " << Duty_nanosec << "." << std::endl;
+      if (telemetry)
+	    telemetry->log(telemetryChannel, Duty_nanosec);
 }
 
 
 void MotorDriver::setDutyCycleDelta(double DCdelta) { setDutyCycle(currDC + DCdelta); }
 
+void MotorDriver::setTelemetry(Telemetry::Producer* producer, uint16_t channel)
+{
+      telemetry = producer;
+      telemetryChannel = channel;
+}
+
+void MotorDriver::setDeadband(uint32_t deadband_ns) { deadband_PWM = deadband_ns; }
+
+void MotorDriver::setHysteresis(uint32_t hysteresis_ns) { hysteresis_PWM = hysteresis_ns; }
+
 MotorDriver::~MotorDriver()
 {
-      // Disable PWM output and close all PWM control files
-      PeriodOutputFile.close();
-      DutyCycleOutputFile.close();
-      EnableOutputFile << 0 << std::endl;
-      EnableOutputFile.close();
-      PWM2_Export.close();
-      PWM2_Unexport << 2 << std::endl;
-      PWM2_Unexport.close();
-      if (PeriodOutputFile.is_open())
-            {
-                  std::cout << "Failed to close period file." << std::endl; // Display an error message if file closing failed
-            }
-      if (DutyCycleOutputFile.is_open())
-            {
-                  std::cout << "Failed to close duty_cycle file." << std::endl; // Display an error message if file closing failed
-            }
-      if (EnableOutputFile.is_open())
-            {
-                  std::cout << "Failed to close enable file." << std::endl; // Display an error message if file closing failed
-            }
-      if (PWM2_Export.is_open())
+      // Disable PWM output. The sysfs backend closes its files and unexports pwm2 when it is destroyed.
+      if (!pwm->writeEnable(false))
             {
-                  std::cout << "Failed to close pwm2 directory." << std::endl; // Display an error message if file closing failed
+                  std::cout << "Failed to write enable file." << std::endl; // Display an error message if writing failed
             }
 }
@@ -32,24 +32,44 @@
 #include <gpiod.hpp>
 #include <gpiodcxx/line-request.hpp>
 #include <iostream>
+#include <atomic>
+#include <memory>
+#include "../telemetry/latency.h"
+#include "../telemetry/telemetry.h"
+#include "dir_backend.h"
+#include "dutycycle_interface.h"
+#include "pwm_backend.h"
+#include "sysfs_pwm.h"
 
 /**
  * @brief The main MotorDriver class,
  *   Sets and controlls the DIR and PWM pins of the MotorDriver,
  *   Sets the direction and power delivery to the motor
  */
-class MotorDriver {
+class MotorDriver final : public DutyCycle_Interface {
 public:
   /**
    * Constructor function for the MotorDriver class
-   * Creates a directory for PWM, opens files for PWM control and enables it
+   * Sets up the PWM backend and enables it
    * Sets DIR pi
    * @param chip_path File path of the gpiochip device file to be used
    * @param pin_DIR Pi GPIO pin for direction control
    * @param period_ns PWM period in nanoseconds
+   * @param pwm_backend PWM backend to drive, or nullptr to export and use pwm2 of pwmchip2 through sysfs
    */
   MotorDriver(const std::filesystem::path chip_path,
               gpiod::line::offset pin_DIR,
+	      uint32_t period_ns,
+	      std::unique_ptr<PWM_Backend> pwm_backend = nullptr);
+
+  /**
+   * Constructor function for the MotorDriver class, driving the given backends
+   * @param dir_backend Direction output to drive
+   * @param pwm_backend PWM backend to drive, or nullptr to export and use pwm2 of pwmchip2 through sysfs
+   * @param period_ns PWM period in nanoseconds
+   */
+  MotorDriver(std::unique_ptr<DIR_Backend> dir_backend,
+	      std::unique_ptr<PWM_Backend> pwm_backend,
 	      uint32_t period_ns);
 
   /**
@@ -63,55 +83,108 @@ public:
    * @param DutyCycle index value between -1 and 1 for setting direction and
    * power delivery to the motor
    */
-  void setDutyCycle(double DutyCycle);
+  virtual void setDutyCycle(double DutyCycle) override;
 
   /**
    * @brief Function to change duty cycle by a delta.
    * @param DCdelta amount to change the duty cycle by
    */
-  void setDutyCycleDelta(double DCdelta);
+  virtual void setDutyCycleDelta(double DCdelta) override;
+
+  /**
+   * @brief Function to log every duty cycle written to the PWM to a telemetry producer.
+   * The producer must belong to the thread that calls setDutyCycle().
+   * @param producer Telemetry producer, or nullptr to stop logging
+   * @param channel Telemetry channel the duty cycle (in nanoseconds) is logged under
+   */
+  void setTelemetry(Telemetry::Producer* producer, uint16_t channel);
+
+  /**
+   * @brief Function to set the deadband on the duty cycle. Duty cycles shorter than the deadband
+   * are written as zero, and leave the direction as it was.
+   * @param deadband_ns Deadband in nanoseconds, 0 to disable
+   */
+  void setDeadband(uint32_t deadband_ns);
+
+  /**
+   * @brief Function to set the hysteresis on the duty cycle. A new duty cycle within the hysteresis
+   * of the one last written is not written. Zero and direction changes are always written.
+   * @param hysteresis_ns Hysteresis in nanoseconds, 0 to write every change
+   */
+  void setHysteresis(uint32_t hysteresis_ns);
+
+  /**
+   * @brief Function to get the number of duty cycle writes made to the PWM backend.
+   * @return uint64_t Number of duty cycle writes
+   */
+  uint64_t getDutyWriteCount(void) const { return dutyWrites.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Function to get the number of duty cycle writes skipped as unchanged.
+   * @return uint64_t Number of skipped duty cycle writes
+   */
+  uint64_t getDutySkipCount(void) const { return dutySkips.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Function to get the number of DIR pin writes made.
+   * @return uint64_t Number of DIR pin writes
+   */
+  uint64_t getDirWriteCount(void) const { return dirWrites.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Function to get the number of DIR pin writes skipped as unchanged.
+   * @return uint64_t Number of skipped DIR pin writes
+   */
+  uint64_t getDirSkipCount(void) const { return dirSkips.load(std::memory_order_relaxed); }
     
   protected:
     /**
-     * @brief Output file stream for logging motor driver control.
+     * @brief Function to write a duty cycle to the PWM backend, and log it.
+     * @param Duty_nanosec Duty cycle in nanoseconds
      */
-    std::ofstream log_file{"MD20_log", std::ios::trunc};
+    void writeDuty(uint32_t Duty_nanosec);
+
+
     /**
-    * @brief DIR output pin
-    */
-    gpiod::line::offset _pin_DIR;
+     * @brief Telemetry producer for logging motor driver control.
+     */
+    Telemetry::Producer* telemetry = nullptr;
     /**
-    * @brief PWM export file stream object
+     * @brief Telemetry channel for logging motor driver control.
+     */
+    uint16_t telemetryChannel = 0;
+    /**
+    * @brief DIR output the direction is written to
     */
-    std::basic_ofstream<char> PWM2_Export;
+    std::unique_ptr<DIR_Backend> dir;
     /**
-    * @brief PWM unexport file stream object
+    * @brief PWM backend the duty cycle is written to
     */
-    std::basic_ofstream<char> PWM2_Unexport;
+    std::unique_ptr<PWM_Backend> pwm;
     /**
-    * @brief PWM period file stream object
+    * @brief Period of PWM in nanoseconds
     */
-    std::basic_ofstream<char> PeriodOutputFile;
+    uint32_t period_PWM;
     /**
-    * @brief PWM Duty Cycle file stream object
+    * @brief Previous motor direction
     */
-    std::basic_ofstream<char> DutyCycleOutputFile;
+    bool prev_DIR = 0;  
     /**
-    * @brief PWM Enable file stream object
+    * @brief Duty cycle last written to the PWM backend, in nanoseconds
     */
-    std::basic_ofstream<char> EnableOutputFile;
+    uint32_t prevDuty_ns = 0;
     /**
-    * @brief Variable for DIR pin control
+    * @brief Duty cycles shorter than this are written as zero, in nanoseconds
     */
-    gpiod::line_request request_DIR; 
+    uint32_t deadband_PWM = 0;
     /**
-    * @brief Period of PWM in nanoseconds
+    * @brief Duty cycle changes this small or smaller are not written, in nanoseconds
     */
-    uint32_t period_PWM;
+    uint32_t hysteresis_PWM = 0;
     /**
-    * @brief Previous motor direction
+    * @brief Counters of writes made and skipped, read from other threads for monitoring
     */
-    bool prev_DIR = 0;  
+    std::atomic<uint64_t> dutyWrites{0}, dutySkips{0}, dirWrites{0}, dirSkips{0};
     /**
     * @brief Current duty cycle
     */
@@ -0,0 +1,42 @@
+/**
+ * @file    dir_backend.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the GPIO direction output implementation.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "dir_backend.h"
+
+GpiodDIR::GpiodDIR(const std::filesystem::path& chip_path, gpiod::line::offset _pin)
+  : pin(_pin),
+    request(::gpiod::chip(chip_path)
+		.prepare_request()
+		.set_consumer("set-line-direction")
+		.add_line_settings(pin, ::gpiod::line_settings()
+				   .set_direction(::gpiod::line::direction::OUTPUT)
+				   .set_output_value(::gpiod::line::value::INACTIVE))
+		.do_request()) {}
+
+void GpiodDIR::writeDirection(bool forward) {
+  request.set_value(pin, forward ? ::gpiod::line::value::ACTIVE : ::gpiod::line::value::INACTIVE);
+}
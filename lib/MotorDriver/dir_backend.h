@@ -0,0 +1,70 @@
+/**
+ * @file    dir_backend.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the interface between the motor driver and its direction output.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef DIR_BACKEND_H
+#define DIR_BACKEND_H
+
+#include <filesystem>
+#include <gpiod.hpp>
+
+/**
+ * @brief Interface to the motor driver's direction (DIR) output.
+ */
+class DIR_Backend {
+public:
+  virtual ~DIR_Backend() {}
+
+  /**
+   * @brief Set the direction output.
+   * @param forward True to drive the line high (forward), false for low (backward).
+   */
+  virtual void writeDirection(bool forward) = 0;
+};
+
+/**
+ * @brief Direction output on a GPIO line, requested through libgpiod.
+ */
+class GpiodDIR : public DIR_Backend {
+public:
+  /**
+   * @brief Constructor. Requests the line as an output, initially low.
+   * @param chip_path File path of the gpiochip device file to be used
+   * @param _pin Pi GPIO pin for direction control
+   */
+  GpiodDIR(const std::filesystem::path& chip_path, gpiod::line::offset _pin);
+
+  virtual void writeDirection(bool forward) override;
+
+private:
+  /** DIR output pin. */
+  gpiod::line::offset pin;
+
+  /** Request holding the DIR line. */
+  gpiod::line_request request;
+};
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * @file    dutycycle_interface.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the duty cycle sink interface implemented by motor drivers.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DUTYCYCLE_INTERFACE_H
+#define DUTYCYCLE_INTERFACE_H
+
+/**
+ * @brief Interface for anything that takes a motor duty cycle, so that the
+ * control loops can drive either the real motor driver or a simulated one.
+ */
+class DutyCycle_Interface {
+public:
+  /**
+   * @brief Class destructor.
+   */
+  virtual ~DutyCycle_Interface() {}
+
+  /**
+   * @brief Function to set the duty cycle and direction of the motor
+   * @param DutyCycle index value between -1 and 1 for setting direction and
+   * power delivery to the motor
+   */
+  virtual void setDutyCycle(double DutyCycle) = 0;
+
+  /**
+   * @brief Function to change duty cycle by a delta.
+   * @param DCdelta amount to change the duty cycle by
+   */
+  virtual void setDutyCycleDelta(double DCdelta) = 0;
+};
+#endif
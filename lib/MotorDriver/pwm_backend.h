@@ -0,0 +1,63 @@
+/**
+ * @file    pwm_backend.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the interface between the motor driver and the PWM hardware.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef PWM_BACKEND_H
+#define PWM_BACKEND_H
+
+#include <cstdint>
+
+/**
+ * @brief Interface to one PWM channel. MotorDriver only deals in nanoseconds and leaves
+ * how they reach the hardware to the backend.
+ */
+class PWM_Backend {
+public:
+  virtual ~PWM_Backend() {}
+
+  /**
+   * @brief Set the PWM period.
+   * @param period_ns Period in nanoseconds.
+   * @retval bool False if the write failed.
+   */
+  virtual bool writePeriod(uint32_t period_ns) = 0;
+
+  /**
+   * @brief Set the PWM duty cycle. Called on every control tick, so must be cheap.
+   * @param duty_ns Time the output is high in each period, in nanoseconds.
+   * @retval bool False if the write failed.
+   */
+  virtual bool writeDuty(uint32_t duty_ns) = 0;
+
+  /**
+   * @brief Enable or disable the PWM output.
+   * @param enable True to enable.
+   * @retval bool False if the write failed.
+   */
+  virtual bool writeEnable(bool enable) = 0;
+};
+
+#endif
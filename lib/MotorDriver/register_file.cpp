@@ -0,0 +1,62 @@
+/**
+ * @file    register_file.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the memory-mapped register block implementation.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "register_file.h"
+#include <fcntl.h>
+#include <iostream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+
+RegisterFile::RegisterFile(const std::filesystem::path& device, off_t offset, std::size_t size) : length(size) {
+  int fd = open(device.c_str(), O_RDWR | O_SYNC | O_CLOEXEC);
+  if (fd < 0) {
+    std::cout << "Failed to open " << device << " for mapping registers." << std::endl; // Display an error message if file opening failed
+    throw std::invalid_argument("Failed to open register device.");
+  }
+
+  void* map = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
+  close(fd); // The mapping stays valid after the file is closed.
+  if (map == MAP_FAILED) {
+    std::cout << "Failed to map registers from " << device << "." << std::endl;
+    throw std::invalid_argument("Failed to map registers.");
+  }
+
+  base = static_cast<volatile uint32_t*>(map);
+}
+
+RegisterFile::RegisterFile(std::size_t size) : length(size) {
+  void* map = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (map == MAP_FAILED) {
+    std::cout << "Failed to map stand-in registers." << std::endl;
+    throw std::invalid_argument("Failed to map stand-in registers.");
+  }
+
+  base = static_cast<volatile uint32_t*>(map);
+}
+
+RegisterFile::~RegisterFile() { munmap(const_cast<uint32_t*>(base), length); }
@@ -0,0 +1,95 @@
+/**
+ * @file    register_file.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains a memory-mapped block of 32-bit hardware registers.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef REGISTER_FILE_H
+#define REGISTER_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <sys/types.h>
+
+/**
+ * @brief A block of 32-bit hardware registers mapped into this process, either from a device file
+ * such as /dev/mem, or as anonymous memory standing in for the hardware so register-level code can
+ * be run anywhere, e.g. in tests. Register offsets are in bytes from the start of the block.
+ */
+class RegisterFile {
+public:
+  /**
+   * @brief Constructor. Maps registers from a device file. Throws std::invalid_argument if the
+   * device can't be opened or mapped.
+   * @param device Device file to map, e.g. /dev/mem.
+   * @param offset Offset of the block in the device file (its physical address for /dev/mem).
+   * @param size Size of the block in bytes.
+   */
+  RegisterFile(const std::filesystem::path& device, off_t offset, std::size_t size);
+
+  /**
+   * @brief Constructor. Maps zeroed anonymous memory as a stand-in for the registers.
+   * Throws std::invalid_argument if it can't be mapped.
+   * @param size Size of the block in bytes.
+   */
+  explicit RegisterFile(std::size_t size);
+
+  /**
+   * @brief Destructor. Unmaps the block.
+   */
+  ~RegisterFile();
+
+  RegisterFile(const RegisterFile&) = delete;
+  RegisterFile& operator=(const RegisterFile&) = delete;
+
+  /**
+   * @brief Read a register.
+   * @param offset Byte offset of the register.
+   * @retval uint32_t Register value.
+   */
+  uint32_t read(std::size_t offset) const { return base[offset / sizeof(uint32_t)]; }
+
+  /**
+   * @brief Write a register.
+   * @param offset Byte offset of the register.
+   * @param value Value to write.
+   */
+  void write(std::size_t offset, uint32_t value) { base[offset / sizeof(uint32_t)] = value; }
+
+  /**
+   * @brief Get the size of the block.
+   * @retval std::size_t Size in bytes.
+   */
+  std::size_t size(void) const { return length; }
+
+private:
+  /** Start of the mapped block. */
+  volatile uint32_t* base;
+
+  /** Size of the mapped block in bytes. */
+  std::size_t length;
+};
+
+#endif
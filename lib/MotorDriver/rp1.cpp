@@ -0,0 +1,93 @@
+/**
+ * @file    rp1.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the RP1 register motor driver backend implementation.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "rp1.h"
+#include <iostream>
+#include <stdexcept>
+
+namespace RP1 {
+
+std::shared_ptr<RegisterFile> MapPeripherals(const std::filesystem::path& device) {
+  return std::make_shared<RegisterFile>(device, PERIPHERAL_BASE, WINDOW_SIZE);
+}
+
+} // namespace RP1
+
+RP1PWM::RP1PWM(std::shared_ptr<RegisterFile> _registers, unsigned _channel, uint32_t clock_hz, std::size_t block)
+    : registers(std::move(_registers)), base(block), channel(_channel) {
+  if (channel > 3 || clock_hz == 0 || clock_hz >= 1000000000) {
+    std::cout << "Invalid RP1 PWM channel " << channel << " or clock rate " << clock_hz << "." << std::endl;
+    throw std::invalid_argument("Invalid RP1 PWM channel or clock rate.");
+  }
+
+  // Round up, so whole numbers of ticks aren't truncated to one less.
+  ticksPerNs = (((uint64_t)clock_hz << 32) + 999999999) / 1000000000;
+  globalCtrl = registers->read(base + RP1::PWM_GLOBAL_CTRL) & ~RP1::PWM_SET_UPDATE;
+}
+
+RP1PWM::~RP1PWM() { writeEnable(false); }
+
+bool RP1PWM::writePeriod(uint32_t period_ns) {
+  registers->write(base + RP1::PWM_CHAN_RANGE(channel), ticks(period_ns));
+  update();
+  return true;
+}
+
+bool RP1PWM::writeDuty(uint32_t duty_ns) {
+  registers->write(base + RP1::PWM_CHAN_DUTY(channel), ticks(duty_ns));
+  update();
+  return true;
+}
+
+bool RP1PWM::writeEnable(bool enable) {
+  if (enable) {
+    registers->write(base + RP1::PWM_CHAN_CTRL(channel), RP1::PWM_CHAN_DEFAULT);
+    globalCtrl |= 1u << channel;
+  }
+  else
+    globalCtrl &= ~(1u << channel);
+
+  update();
+  return true;
+}
+
+RP1DIR::RP1DIR(std::shared_ptr<RegisterFile> _registers, unsigned pin) : registers(std::move(_registers)), mask(1u << pin) {
+  if (pin >= RP1::BANK0_PINS) {
+    std::cout << "RP1 GPIO pin " << pin << " is not in bank 0." << std::endl;
+    throw std::invalid_argument("RP1 GPIO pin is not in bank 0.");
+  }
+
+  // Drive the pin low before enabling the output, so it doesn't glitch high.
+  registers->write(RP1::SYS_RIO0 + RP1::ALIAS_CLR + RP1::RIO_OUT, mask);
+  registers->write(RP1::SYS_RIO0 + RP1::ALIAS_SET + RP1::RIO_OE, mask);
+
+  // Hand the pin to registered I/O and enable its pad's output driver.
+  const std::size_t ctrl = RP1::IO_BANK0 + RP1::IO_GPIO_CTRL(pin);
+  registers->write(ctrl, (registers->read(ctrl) & ~RP1::IO_FUNCSEL_MASK) | RP1::IO_FUNCSEL_SYS_RIO);
+  const std::size_t pad = RP1::PADS_BANK0 + RP1::PADS_GPIO(pin);
+  registers->write(pad, registers->read(pad) & ~RP1::PADS_OUTPUT_DISABLE);
+}
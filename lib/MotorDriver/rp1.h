@@ -0,0 +1,172 @@
+/**
+ * @file    rp1.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains motor driver backends writing directly to the Raspberry Pi 5 RP1 registers.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RP1_H
+#define RP1_H
+
+#include <cstdint>
+#include <memory>
+#include "dir_backend.h"
+#include "pwm_backend.h"
+#include "register_file.h"
+
+/**
+ * @brief Register layout of the Raspberry Pi 5's RP1 I/O controller, as seen from the CPU.
+ * See the RP1 peripherals datasheet.
+ */
+namespace RP1 {
+
+/** Physical address of the RP1 peripherals, from the CPU side of the PCIe link. */
+constexpr off_t PERIPHERAL_BASE = 0x1f00000000;
+
+/** Size of the window mapped, covering every block below. */
+constexpr std::size_t WINDOW_SIZE = 0x100000;
+
+/** Offsets of the register blocks within the window. */
+constexpr std::size_t PWM0 = 0x98000;
+constexpr std::size_t PWM1 = 0x9c000;
+constexpr std::size_t IO_BANK0 = 0xd0000;
+constexpr std::size_t SYS_RIO0 = 0xe0000;
+constexpr std::size_t PADS_BANK0 = 0xf0000;
+
+/** Offsets of the atomic aliases of a block. A write to one only changes the bits that are set in it. */
+constexpr std::size_t ALIAS_XOR = 0x1000;
+constexpr std::size_t ALIAS_SET = 0x2000;
+constexpr std::size_t ALIAS_CLR = 0x3000;
+
+/** PWM block registers. */
+constexpr std::size_t PWM_GLOBAL_CTRL = 0x00;
+constexpr std::size_t PWM_CHAN_CTRL(unsigned channel) { return 0x14 + channel * 0x10; }
+constexpr std::size_t PWM_CHAN_RANGE(unsigned channel) { return 0x18 + channel * 0x10; }
+constexpr std::size_t PWM_CHAN_DUTY(unsigned channel) { return 0x20 + channel * 0x10; }
+constexpr uint32_t PWM_SET_UPDATE = 1u << 31;
+constexpr uint32_t PWM_CHAN_DEFAULT = (1u << 8) | 1u; // FIFO_POP_MASK, trailing-edge mark-space mode
+
+/** GPIO registers. */
+constexpr std::size_t IO_GPIO_CTRL(unsigned pin) { return 0x04 + pin * 8; }
+constexpr std::size_t PADS_GPIO(unsigned pin) { return 0x04 + pin * 4; }
+constexpr std::size_t RIO_OUT = 0x00;
+constexpr std::size_t RIO_OE = 0x04;
+constexpr uint32_t IO_FUNCSEL_MASK = 0x1f;
+constexpr uint32_t IO_FUNCSEL_SYS_RIO = 5;
+constexpr uint32_t PADS_OUTPUT_DISABLE = 1u << 7;
+constexpr unsigned BANK0_PINS = 28;
+
+/**
+ * @brief Map the RP1 peripherals through /dev/mem. Needs root (or CAP_SYS_RAWIO).
+ * Throws std::invalid_argument if they can't be mapped.
+ * @param device Device file to map them from.
+ * @retval std::shared_ptr<RegisterFile> Register window, to share between the backends.
+ */
+std::shared_ptr<RegisterFile> MapPeripherals(const std::filesystem::path& device = "/dev/mem");
+
+} // namespace RP1
+
+/**
+ * @brief PWM backend writing the RP1 PWM registers directly, so a duty cycle update is two posted
+ * register writes with no system call. The channel's pin must already be muxed to the PWM, e.g. by
+ * the pwm-2chan overlay that the sysfs backend relies on. Nothing here is thread safe; use it from
+ * one thread, like the other backends.
+ */
+class RP1PWM : public PWM_Backend {
+public:
+  /**
+   * @brief Constructor. Leaves the output as it was until writeEnable() is called.
+   * Throws std::invalid_argument for a channel or clock rate out of range.
+   * @param _registers RP1 register window (see RP1::MapPeripherals).
+   * @param _channel PWM channel, 0 to 3. Channel 2 of PWM0 is GPIO18, the same output as pwm2 of pwmchip2.
+   * @param clock_hz PWM clock rate in Hz.
+   * @param block Offset of the PWM block in the window.
+   */
+  RP1PWM(std::shared_ptr<RegisterFile> _registers, unsigned _channel = 2, uint32_t clock_hz = 50000000,
+	 std::size_t block = RP1::PWM0);
+
+  /**
+   * @brief Destructor. Disables the output.
+   */
+  ~RP1PWM();
+
+  virtual bool writePeriod(uint32_t period_ns) override;
+  virtual bool writeDuty(uint32_t duty_ns) override;
+  virtual bool writeEnable(bool enable) override;
+
+private:
+  /**
+   * @brief Convert nanoseconds to PWM clock ticks, without dividing.
+   * @param ns Time in nanoseconds.
+   * @retval uint32_t Time in clock ticks.
+   */
+  uint32_t ticks(uint32_t ns) const { return (uint32_t)(((uint64_t)ns * ticksPerNs) >> 32); }
+
+  /**
+   * @brief Latch the channel's new settings at the end of the current period.
+   */
+  void update(void) { registers->write(base + RP1::PWM_GLOBAL_CTRL, globalCtrl | RP1::PWM_SET_UPDATE); }
+
+  /** RP1 register window. */
+  std::shared_ptr<RegisterFile> registers;
+
+  /** Offset of the PWM block in the window. */
+  std::size_t base;
+
+  /** PWM channel. */
+  unsigned channel;
+
+  /** Clock ticks per nanosecond, as 32.32 fixed point. */
+  uint64_t ticksPerNs;
+
+  /** Copy of the global control register, so it isn't read back over PCIe on every update. */
+  uint32_t globalCtrl;
+};
+
+/**
+ * @brief Direction output writing the RP1 GPIO registers directly, through the atomic set and
+ * clear aliases of the registered I/O block, so a write is one posted register write with no system call.
+ */
+class RP1DIR : public DIR_Backend {
+public:
+  /**
+   * @brief Constructor. Hands the pin over to registered I/O as an output, initially low.
+   * Throws std::invalid_argument if the pin is not in bank 0.
+   * @param _registers RP1 register window (see RP1::MapPeripherals).
+   * @param pin GPIO pin.
+   */
+  RP1DIR(std::shared_ptr<RegisterFile> _registers, unsigned pin);
+
+  virtual void writeDirection(bool forward) override {
+    registers->write(RP1::SYS_RIO0 + (forward ? RP1::ALIAS_SET : RP1::ALIAS_CLR) + RP1::RIO_OUT, mask);
+  }
+
+private:
+  /** RP1 register window. */
+  std::shared_ptr<RegisterFile> registers;
+
+  /** Bit of the pin in the registered I/O registers. */
+  uint32_t mask;
+};
+
+#endif
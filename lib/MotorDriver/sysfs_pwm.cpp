@@ -0,0 +1,121 @@
+/**
+ * @file    sysfs_pwm.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the sysfs PWM backend implementation.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "sysfs_pwm.h"
+#include <chrono>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+/** How long to keep trying to open an attribute file after exporting, in milliseconds. */
+static constexpr int OPEN_TIMEOUT_MS = 1000;
+
+SysfsPWM::SysfsPWM(const std::filesystem::path& _chipDir, unsigned _channel) : chipDir(_chipDir), channel(_channel) {
+  // Export the channel, unless it already is (e.g. left over from a previous run).
+  if (!std::filesystem::exists(chipDir / ("pwm" + std::to_string(channel)))) {
+    std::ofstream exportFile(chipDir / "export");
+    if (!(exportFile << channel << std::endl)) {
+      std::cout << "Failed to create pwm" << channel << " directory." << std::endl; // Display an error message if file opening failed
+      throw std::invalid_argument("Failed to create pwm directory.");
+    }
+    exported = true;
+  }
+
+  periodFd = openAttribute("period");
+  dutyFd = openAttribute("duty_cycle");
+  enableFd = openAttribute("enable");
+}
+
+SysfsPWM::~SysfsPWM() {
+  if (enableFd >= 0)
+    writeEnable(false);
+
+  for (int fd : {periodFd, dutyFd, enableFd}) {
+    if (fd >= 0)
+      close(fd);
+  }
+
+  if (exported) {
+    std::ofstream unexportFile(chipDir / "unexport");
+    if (!(unexportFile << channel << std::endl))
+      std::cout << "Failed to unexport pwm" << channel << "." << std::endl;
+  }
+}
+
+int SysfsPWM::openAttribute(const char* name) {
+  const std::filesystem::path path = chipDir / ("pwm" + std::to_string(channel)) / name;
+
+  /* The attribute files exist as soon as the channel is exported, but can't be opened until
+   * udev has set their permissions, so keep trying for a while.
+   */
+  int fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+  for (int i = 0; fd < 0 && i < OPEN_TIMEOUT_MS; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+  }
+
+  if (fd < 0) {
+    std::cout << "Failed to open " << name << " file." << std::endl; // Display an error message if file opening failed
+    throw std::invalid_argument(std::string("Failed to open ") + name + " file.");
+  }
+  return fd;
+}
+
+bool SysfsPWM::writeValue(int fd, uint32_t value) {
+  // Format the digits backwards from the end of the buffer, followed by a newline.
+  char buffer[12];
+  char* end = buffer + sizeof(buffer);
+  char* start = end;
+  *--start = '\n';
+  do {
+    *--start = '0' + value % 10;
+    value /= 10;
+  } while (value);
+
+  const ssize_t length = end - start;
+  return pwrite(fd, start, length, 0) == length;
+}
+
+bool SysfsPWM::CreateStandIn(const std::filesystem::path& chipDir, unsigned channel) {
+  const std::filesystem::path channelDir = chipDir / ("pwm" + std::to_string(channel));
+  std::error_code err;
+  std::filesystem::create_directories(channelDir, err);
+  if (err)
+    return false;
+
+  for (const std::filesystem::path& path : {chipDir / "export", chipDir / "unexport", channelDir / "period",
+					    channelDir / "duty_cycle", channelDir / "enable"}) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!(file << 0 << std::endl))
+      return false;
+  }
+  return true;
+}
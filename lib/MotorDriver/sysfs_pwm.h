@@ -0,0 +1,100 @@
+/**
+ * @file    sysfs_pwm.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the sysfs PWM backend declarations.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SYSFS_PWM_H
+#define SYSFS_PWM_H
+
+#include <filesystem>
+#include "pwm_backend.h"
+
+/**
+ * @brief PWM backend using the kernel's sysfs PWM interface. The channel's attribute files are
+ * opened once and kept open, and each value is formatted into a stack buffer and written with a
+ * single pwrite(), so a duty cycle update is one system call with no stream formatting or flushing.
+ */
+class SysfsPWM : public PWM_Backend {
+public:
+  /**
+   * @brief Constructor. Exports the channel if it isn't already, opens its attribute files and
+   * leaves the output disabled. Throws std::invalid_argument if the files can't be opened.
+   * @param _chipDir Sysfs directory of the PWM chip.
+   * @param _channel PWM channel on the chip.
+   */
+  SysfsPWM(const std::filesystem::path& _chipDir = "/sys/class/pwm/pwmchip2", unsigned _channel = 2);
+
+  /**
+   * @brief Destructor. Disables the output, closes the attribute files and unexports the channel
+   * if this object exported it.
+   */
+  ~SysfsPWM();
+
+  virtual bool writePeriod(uint32_t period_ns) override { return writeValue(periodFd, period_ns); }
+  virtual bool writeDuty(uint32_t duty_ns) override { return writeValue(dutyFd, duty_ns); }
+  virtual bool writeEnable(bool enable) override { return writeValue(enableFd, enable ? 1 : 0); }
+
+  /**
+   * @brief Create a stand-in for a PWM chip's sysfs directory, made of regular files with the
+   * channel already exported, so the backend can be run anywhere, e.g. in a temp directory for tests.
+   * Values written to the stand-in files can be read back from their first line.
+   * @param chipDir Directory to create the stand-in in.
+   * @param channel PWM channel to create.
+   * @retval bool False if the files could not be created.
+   */
+  static bool CreateStandIn(const std::filesystem::path& chipDir, unsigned channel = 2);
+
+private:
+  /**
+   * @brief Open one of the channel's attribute files for writing.
+   * @param name Attribute name.
+   * @retval int File descriptor. Throws std::invalid_argument if it can't be opened.
+   */
+  int openAttribute(const char* name);
+
+  /**
+   * @brief Write a value to an attribute file as decimal text, at offset zero.
+   * @param fd File descriptor of the attribute.
+   * @param value Value to write.
+   * @retval bool False if the write failed.
+   */
+  static bool writeValue(int fd, uint32_t value);
+
+  /** Sysfs directory of the PWM chip. */
+  std::filesystem::path chipDir;
+
+  /** PWM channel on the chip. */
+  unsigned channel;
+
+  /** True if the constructor exported the channel. */
+  bool exported = false;
+
+  /** Attribute file descriptors. */
+  int periodFd = -1;
+  int dutyFd = -1;
+  int enableFd = -1;
+};
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * @file    cascade.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the callbacks that connect the sensors, PID controllers and motor driver
+ * into the cascade control loop of the anti-quake cup holder.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef CASCADE_H
+#define CASCADE_H
+
+#include "../pid/pid.h"
+#include "../MotorDriver/dutycycle_interface.h"
+#include "../pipeline/nodes.h"
+
+/**
+ * @brief Implementation of the PID_Interface for the inner PID controller,
+ * driving the motor driver. Wraps Pipeline::DriveMotor for cascades wired at
+ * runtime; Pipeline::Cascade wires the same node statically.
+ */
+class PID_MotorDriver : public PID_Interface
+{
+public:
+  /**
+   * @brief Constructor taking and assigning a motor driver object reference.
+   * @param _motorDriver The motor driver object (real or simulated).
+   * @param _telemetry Telemetry producer of the thread running the inner PID controller.
+   */
+  PID_MotorDriver(DutyCycle_Interface& _motorDriver, Telemetry::Producer& _telemetry)
+    : node(_motorDriver, _telemetry, INNER_PID) {}
+  
+  /**
+   * @brief PID controller callback implementation, passing the PID output to the provided motor driver object.
+   * @param pidOutput Output of the PID controller passed to the callback.
+   */
+  virtual void hasOutput(double pidOutput) override { node.hasOutput(pidOutput); }
+
+private:
+  /**
+   * @brief Node driving the motor driver.
+   */
+  Pipeline::DriveMotor<DutyCycle_Interface> node;
+};
+
+
+/**
+ * @brief Implementation of the PID_Interface for the outer PID controller,
+ * controlling position via torque outputs that are sent to the inner PID
+ * controller. Wraps Pipeline::DriveSetpoint for cascades wired at runtime.
+ */
+class PID_Position : public PID_Interface
+{
+public:
+  /**
+   * @brief Constructor taking and assigning a PID controller object reference.
+   * @param _pidController The PID controller object.
+   * @param _telemetry Telemetry producer of the thread running the outer PID controller.
+   */
+  PID_Position(PID& _pidController, Telemetry::Producer& _telemetry)
+    : node(_pidController, _telemetry) {}
+  
+  /**
+   * @brief PID controller callback implementation, passing the PID output to the provided PID controller object.
+   * @param pidOutput Output of the PID controller passed to the callback.
+   */
+  virtual void hasOutput(double pidOutput) override { node.hasOutput(pidOutput); }
+
+private:
+  /**
+   * @brief Node setting the inner PID controller's setpoint.
+   */
+  Pipeline::DriveSetpoint<PID> node;
+};
+
+
+/**
+ * @brief Implementation of the INA260Interface for feedback of current (torque)
+ * values as the process variable for the inner PID controller driving the motor driver.
+ * This is Pipeline::CurrentFeedback on the runtime wired PID class.
+ */
+using INA260_Feedback = Pipeline::CurrentFeedback<PID>;
+
+/**
+ * @brief Implementation of the MPU6050Interface. This is where the magic
+ * happens for calculating the cup holder's angular position based on the IMU
+ * measurements, using an attitude estimator. The caclulated angular position is
+ * then sent as input to the outer PID controller as the process variable.
+ * This is Pipeline::AngleFeedback on the runtime wired PID class.
+ */
+using MPU6050_Feedback = Pipeline::AngleFeedback<PID>;
+
+#endif
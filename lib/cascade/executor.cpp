@@ -0,0 +1,154 @@
+/**
+ * @file    executor.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the single-threaded executor that runs the cascaded control loops.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "executor.h"
+#include "../mpu6050/frame_convert.h"
+
+CascadeExecutor::CascadeExecutor(MPU6050_Driver::MPU6050Interface& _outer, INA260_Driver::INA260Interface& _inner, std::size_t queueCapacity)
+  : outer(_outer), inner(_inner), mpuPoster(*this), inaPoster(*this), mpuQueue(queueCapacity), inaQueue(queueCapacity) {
+  sem_init(&pending, 0, 0);
+}
+
+CascadeExecutor::~CascadeExecutor() {
+  end();
+  sem_destroy(&pending);
+}
+
+void CascadeExecutor::MPU6050_Poster::hasSample(MPU6050_Driver::MPU6050Sample& sample) {
+  if (executor.mpuQueue.push(sample))
+    sem_post(&executor.pending);
+}
+
+void CascadeExecutor::MPU6050_Poster::hasBatch(MPU6050_Driver::MPU6050Sample* samples, std::size_t count) {
+  // Queue the whole batch before waking the executor, so it runs as one burst.
+  std::size_t queued = 0;
+  for (std::size_t i = 0; i < count; i++)
+    queued += executor.mpuQueue.push(samples[i]);
+
+  if (queued > 0)
+    sem_post(&executor.pending);
+}
+
+void CascadeExecutor::MPU6050_Poster::hasAxes(const MPU6050_Driver::MPU6050Batch& batch) {
+  // Copy each frame straight into its queue slot, then wake the executor once for the whole batch.
+  std::size_t queued = 0;
+  for (uint16_t i = 0; i < batch.count; i++) {
+    MPU6050_Driver::MPU6050Sample* slot = executor.mpuQueue.claim();
+    if (slot == nullptr)
+      continue;
+
+    batch.toSample(i, *slot);
+    executor.mpuQueue.publish();
+    queued++;
+  }
+
+  if (queued > 0)
+    sem_post(&executor.pending);
+}
+
+void CascadeExecutor::INA260_Poster::hasSample(INA260_Driver::INA260Sample& sample) {
+  if (executor.inaQueue.push(sample))
+    sem_post(&executor.pending);
+}
+
+std::size_t CascadeExecutor::ProcessPending(void) {
+  std::size_t processed = 0;
+
+  if (passHook)
+    passHook->beforePass();
+
+  while (true) {
+    MPU6050_Driver::MPU6050Sample* mpuSample = mpuQueue.front();
+    INA260_Driver::INA260Sample* inaSample = inaQueue.front();
+    if (!mpuSample && !inaSample)
+      break;
+
+    // Run whichever sample is older. On a tie the outer loop goes first, so the inner loop uses the new setpoint.
+    if (mpuSample && (!inaSample || mpuSample->timestamp_ns <= inaSample->timestamp_ns)) {
+      // Take every MPU sample older than the next INA sample, so a FIFO burst reaches the outer loop as one batch.
+      std::size_t run = 0;
+      do {
+	mpuRun[run++] = *mpuSample;
+	mpuQueue.pop();
+	mpuSample = mpuQueue.front();
+      } while (mpuSample && run < MPU6050_Driver::FIFO_MAX_FRAMES
+	       && (!inaSample || mpuSample->timestamp_ns <= inaSample->timestamp_ns));
+
+      // Time the batch from its newest sample, the one the outer loop ends up acting on.
+      if (outerLatency) {
+	outerLatency->begin(mpuRun[run - 1].timestamp_ns);
+	Telemetry::LatencyTrace::stamp(Telemetry::LatencyStage::QUEUE);
+      }
+      if (run == 1)
+	outer.hasSample(mpuRun[0]);
+      else
+	outer.hasBatch(mpuRun, run);
+      Telemetry::LatencyTrace::end();
+      outerCount.fetch_add(run, std::memory_order_relaxed);
+      processed += run;
+    }
+    else {
+      if (innerLatency) {
+	innerLatency->begin(inaSample->timestamp_ns);
+	Telemetry::LatencyTrace::stamp(Telemetry::LatencyStage::QUEUE);
+      }
+      inner.hasSample(*inaSample);
+      Telemetry::LatencyTrace::end();
+      inaQueue.pop();
+      innerCount.fetch_add(1, std::memory_order_relaxed);
+      processed++;
+    }
+  }
+
+  return processed;
+}
+
+void CascadeExecutor::begin(void) {
+  if (executorRunning.exchange(true))
+    return;
+
+  executorThread = std::thread(&CascadeExecutor::run, this);
+}
+
+void CascadeExecutor::end(void) {
+  executorRunning = false;
+  sem_post(&pending);
+  if (executorThread.joinable())
+    executorThread.join();
+}
+
+void CascadeExecutor::run(void) {
+  threadConfigErrors = RealTime::ApplyThreadConfig(threadConfig, "control executor");
+
+  while (executorRunning) {
+    // Sleep until a sample is posted. Extra posts left over from a previous pass just cause an empty pass.
+    if (sem_wait(&pending) != 0)
+      continue;
+
+    ProcessPending();
+  }
+}
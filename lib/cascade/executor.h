@@ -0,0 +1,253 @@
+/**
+ * @file    executor.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the single-threaded executor that runs the cascaded control loops.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <semaphore.h>
+#include <thread>
+#include "../mpu6050/mpu6050.h"
+#include "../ina260/ina260.h"
+#include "../telemetry/latency.h"
+#include "../realtime/realtime.h"
+#include "../realtime/spsc_ring.h"
+
+/**
+ * @brief Runs both loops of the cascade on one thread. The data aquisition threads only read
+ * their sensor and post the sample into a lock-free queue; the executor thread then passes the
+ * samples to the outer (MPU) and inner (INA) feedback callbacks one at a time, so the PID
+ * controllers and the motor driver are only ever touched from one thread.
+ *
+ * The loops run at their own sensor's rate: the outer loop once per MPU sample and the inner
+ * loop once per INA sample. Queued samples are run oldest first by their edge timestamp, and an
+ * outer sample is run before an inner sample with the same timestamp, so the inner loop always
+ * sees the most recent torque setpoint.
+ */
+class CascadeExecutor
+{
+public:
+  /**
+   * @brief Callback run on the executor thread at the start of each pass, before any samples, e.g. to
+   * pick up new settings for the loops without touching them from another thread.
+   */
+  class PassInterface
+  {
+  public:
+    /**
+     * @brief Called at the start of each pass over the queued samples.
+     */
+    virtual void beforePass(void) = 0;
+  };
+
+  /**
+   * @brief Constructor.
+   * @param _outer Feedback callback of the outer loop, run for each MPU sample.
+   * @param _inner Feedback callback of the inner loop, run for each INA sample.
+   * @param queueCapacity Number of samples each queue can hold before samples are dropped.
+   */
+  CascadeExecutor(MPU6050_Driver::MPU6050Interface& _outer, INA260_Driver::INA260Interface& _inner, std::size_t queueCapacity = 256);
+
+  /**
+   * @brief Class destructor. Simply calls end() to stop the executor thread.
+   */
+  ~CascadeExecutor();
+
+  /**
+   * @brief Callback to register with the MPU6050 driver in place of the outer loop's.
+   * @retval MPU6050_Driver::MPU6050Interface& Callback posting MPU samples to the executor.
+   */
+  MPU6050_Driver::MPU6050Interface& mpuInput(void) { return mpuPoster; }
+
+  /**
+   * @brief Callback to register with the INA260 driver in place of the inner loop's.
+   * @retval INA260_Driver::INA260Interface& Callback posting INA samples to the executor.
+   */
+  INA260_Driver::INA260Interface& inaInput(void) { return inaPoster; }
+
+  /**
+   * @brief Run every queued sample through its loop, in order. This is one pass of the executor
+   * thread, so it can also be called directly, e.g. by a simulator, instead of using begin().
+   * @retval std::size_t Number of samples run.
+   */
+  std::size_t ProcessPending(void);
+
+  /**
+   * @brief  This function will begin running the loops in a separate thread.
+   * @param  None
+   * @retval None
+   */
+  void begin(void);
+
+  /**
+   * @brief  This method stops the executor thread. Samples still queued are left unprocessed.
+   * @param  None
+   * @retval None
+   */
+  void end(void);
+
+  /**
+   * @brief  Set the scheduling of the executor thread, applied by the thread itself when begin() starts it.
+   * @param  config Thread configuration.
+   * @retval None
+   */
+  void SetThreadConfig(const RealTime::ThreadConfig& config) { threadConfig = config; }
+
+  /**
+   * @brief  Parts of the thread configuration that could not be applied.
+   * @param  None
+   * @retval uint8_t RealTime::ThreadConfigError flags.
+   */
+  uint8_t GetThreadConfigErrors(void) { return threadConfigErrors; }
+
+  /**
+   * @brief  Trace the latency of each loop from the interrupt edge, through the queue, to the end of
+   * the loop. The traces are stamped on the executor thread, so they must not also be set on a driver.
+   * @param  outerTrace Trace for the outer loop, or nullptr.
+   * @param  innerTrace Trace for the inner loop, or nullptr.
+   * @retval None
+   */
+  void SetLatencyTrace(Telemetry::LatencyTrace* outerTrace, Telemetry::LatencyTrace* innerTrace) {
+    outerLatency = outerTrace;
+    innerLatency = innerTrace;
+  }
+
+  /**
+   * @brief  Set a callback to run at the start of each pass. Set it before begin().
+   * @param  hook Callback, or nullptr.
+   * @retval None
+   */
+  void SetPassHook(PassInterface* hook) { passHook = hook; }
+
+  /**
+   * @brief Number of times the outer loop has run.
+   * @retval uint64_t Outer loop count.
+   */
+  uint64_t GetOuterCount(void) const { return outerCount.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Number of times the inner loop has run.
+   * @retval uint64_t Inner loop count.
+   */
+  uint64_t GetInnerCount(void) const { return innerCount.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Number of samples dropped because a queue was full.
+   * @retval uint64_t Dropped sample count.
+   */
+  uint64_t GetDroppedCount(void) const { return mpuQueue.dropped() + inaQueue.dropped(); }
+
+private:
+  /**
+   * @brief Posts MPU samples into the executor's MPU queue.
+   */
+  class MPU6050_Poster : public MPU6050_Driver::MPU6050Interface
+  {
+  public:
+    MPU6050_Poster(CascadeExecutor& _executor) : executor(_executor) {}
+    virtual void hasSample(MPU6050_Driver::MPU6050Sample& sample) override;
+    virtual void hasBatch(MPU6050_Driver::MPU6050Sample* samples, std::size_t count) override;
+    virtual void hasAxes(const MPU6050_Driver::MPU6050Batch& batch) override;
+
+  private:
+    CascadeExecutor& executor;
+  };
+
+  /**
+   * @brief Posts INA samples into the executor's INA queue.
+   */
+  class INA260_Poster : public INA260_Driver::INA260Interface
+  {
+  public:
+    INA260_Poster(CascadeExecutor& _executor) : executor(_executor) {}
+    virtual void hasSample(INA260_Driver::INA260Sample& sample) override;
+
+  private:
+    CascadeExecutor& executor;
+  };
+
+  /**
+   * @brief Executor thread method. Waits for samples and runs them until end() is called.
+   * @param None
+   * @retval None
+   */
+  void run(void);
+
+  /** Outer loop feedback callback. */
+  MPU6050_Driver::MPU6050Interface& outer;
+
+  /** Inner loop feedback callback. */
+  INA260_Driver::INA260Interface& inner;
+
+  /** Callback registered with the MPU6050 driver. */
+  MPU6050_Poster mpuPoster;
+
+  /** Callback registered with the INA260 driver. */
+  INA260_Poster inaPoster;
+
+  /** Samples waiting for the outer loop. */
+  RealTime::SPSCRing<MPU6050_Driver::MPU6050Sample> mpuQueue;
+
+  /** Samples waiting for the inner loop. */
+  RealTime::SPSCRing<INA260_Driver::INA260Sample> inaQueue;
+
+  /** Run of consecutive MPU samples taken off the queue to pass to the outer loop as one batch. */
+  MPU6050_Driver::MPU6050Sample mpuRun[MPU6050_Driver::FIFO_MAX_FRAMES];
+
+  /** Posted once for each sample queued, and by end(), to wake the executor thread. */
+  sem_t pending;
+
+  /** Executor thread. */
+  std::thread executorThread;
+
+  /** Executor running flag. */
+  std::atomic<bool> executorRunning{false};
+
+  /** Scheduling settings for the executor thread. */
+  RealTime::ThreadConfig threadConfig;
+
+  /** Thread configuration errors, written by the executor thread. */
+  std::atomic<uint8_t> threadConfigErrors{RealTime::NONE};
+
+  /** Outer loop latency trace, if one has been set. */
+  Telemetry::LatencyTrace* outerLatency = nullptr;
+
+  /** Inner loop latency trace, if one has been set. */
+  Telemetry::LatencyTrace* innerLatency = nullptr;
+
+  /** Callback run at the start of each pass. */
+  PassInterface* passHook = nullptr;
+
+  /** Number of times the outer loop has run. */
+  std::atomic<uint64_t> outerCount{0};
+
+  /** Number of times the inner loop has run. */
+  std::atomic<uint64_t> innerCount{0};
+};
+
+#endif
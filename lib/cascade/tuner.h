@@ -0,0 +1,88 @@
+/**
+ * @file    tuner.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the live tuning of the cascade.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef TUNER_H
+#define TUNER_H
+
+#include <atomic>
+#include <cstdint>
+#include "../params/snapshot_store.h"
+#include "../params/tuning.h"
+#include "executor.h"
+
+/**
+ * @brief Applies tuning snapshots to a control pipeline. Registered as the control executor's pass hook, it
+ * checks for a new snapshot at the start of each pass, on the executor thread, so the controllers are only
+ * ever touched from that thread and the check is one atomic load with no locking.
+ */
+class CascadeTuner : public CascadeExecutor::PassInterface
+{
+public:
+  /**
+   * @brief Pipeline the tuning is applied to.
+   */
+  class TargetInterface
+  {
+  public:
+    /**
+     * @brief Apply tuning parameters. Called on the executor thread.
+     * @param tuning Parameters to apply. They stay put until the next call, so gain schedules can be used in place.
+     */
+    virtual void applyTuning(const Params::Tuning& tuning) = 0;
+  };
+
+  /**
+   * @brief Constructor. Applies the store's current snapshot straight away, so construct it before the
+   * executor thread is started.
+   * @param _store Store tuning snapshots are published to.
+   * @param _target Pipeline the tuning is applied to.
+   */
+  CascadeTuner(Params::SnapshotStore<Params::Tuning>& _store, TargetInterface& _target);
+
+  /**
+   * @brief Apply the newest tuning snapshot, if there is one.
+   */
+  virtual void beforePass(void) override;
+
+  /**
+   * @brief Number of snapshots applied, not counting the one applied on construction.
+   * @retval uint64_t Applied count.
+   */
+  uint64_t GetAppliedCount(void) const { return appliedCount.load(std::memory_order_relaxed); }
+
+private:
+  /** Store tuning snapshots are published to. */
+  Params::SnapshotStore<Params::Tuning>& store;
+
+  /** Pipeline the tuning is applied to. */
+  TargetInterface& target;
+
+  /** Number of snapshots applied. */
+  std::atomic<uint64_t> appliedCount{0};
+};
+
+#endif
@@ -0,0 +1,209 @@
+/**
+ * @file    estimator.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the attitude estimator implementation.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "estimator.h"
+#include "../mpu6050/frame_convert.h"
+#include <cmath>
+
+namespace Attitude {
+
+/** Standard gravity in m/s^2. */
+static constexpr float GRAVITY = 9.80665f;
+
+/** Degrees to radians. */
+static constexpr float DEG_TO_RAD = 3.14159265358979323846f / 180.0f;
+
+static constexpr float PI = 3.14159265358979323846f;
+static constexpr float HALF_PI = PI / 2;
+
+float FastAtan2(float y, float x) {
+  const float absX = std::fabs(x);
+  const float absY = std::fabs(y);
+  if (absX == 0 && absY == 0)
+    return 0;
+
+  // Minimax polynomial for atan on [0, 1], using the octant symmetries for the rest.
+  const bool swap = absY > absX;
+  const float z = swap ? absX / absY : absY / absX;
+  const float z2 = z * z;
+  float a = z * (0.99997726f + z2 * (-0.33262347f + z2 * (0.19354346f + z2 * (-0.11643287f + z2 * (0.05265332f + z2 * -0.01172120f)))));
+
+  if (swap)
+    a = HALF_PI - a;
+  if (x < 0)
+    a = PI - a;
+  return y < 0 ? -a : a;
+}
+
+Estimator::Estimator(Filter_t _filter, float _samplePeriod, float _radius)
+  : filter(_filter), samplePeriod(_samplePeriod), radius(_radius) {
+  setComplementaryTimeConstant(0.5f);
+}
+
+void Estimator::setComplementaryTimeConstant(float timeConstant) {
+  gyroWeight = timeConstant / (timeConstant + samplePeriod);
+}
+
+void Estimator::reset(void) {
+  initialised = false;
+  angle = 0;
+  rate = 0;
+  bias = 0;
+  gzPrev = 0;
+  gravityCos = 1;
+  gravitySin = 0;
+  P[0][0] = P[0][1] = P[1][0] = P[1][1] = 0;
+}
+
+/**
+ * @brief Gravity direction measured by the accelerometer, as the (unnormalised) cosine and sine of the tilt.
+ * The Y acceleration is corrected for the centripetal acceleration, and the X acceleration for the tangential
+ * acceleration from the change in gyro rate since the last sample (both in g).
+ * @param ax X acceleration in g.
+ * @param ay Y acceleration in g.
+ * @param gz Z rotation in rad/s.
+ * @param gzAccel Z angular acceleration in rad/s^2.
+ * @param radius Distance between MPU and axis of rotation.
+ * @param tiltCos Output for the cosine component.
+ * @param tiltSin Output for the sine component.
+ */
+static inline void measuredGravity(float ax, float ay, float gz, float gzAccel, float radius, float& tiltCos, float& tiltSin) {
+  tiltCos = ay + gz * gz * radius * (1.0f / GRAVITY);
+  tiltSin = -(ax + gzAccel * radius * (1.0f / GRAVITY));
+}
+
+float Estimator::accelTilt(const MPU6050_Driver::MPU6050Sample& sample) const {
+  float tiltCos, tiltSin;
+  const float gz = sample.gz * DEG_TO_RAD;
+  measuredGravity(sample.ax, sample.ay, gz, angularAcceleration(gz), radius, tiltCos, tiltSin);
+  return FastAtan2(tiltSin, tiltCos);
+}
+
+float Estimator::accelTilt(const MPU6050_Driver::MPU6050Frame& frame) const {
+  float tiltCos, tiltSin;
+  const float gz = frame.gz() * DEG_TO_RAD;
+  measuredGravity(frame.ax(), frame.ay(), gz, angularAcceleration(gz), radius, tiltCos, tiltSin);
+  return FastAtan2(tiltSin, tiltCos);
+}
+
+float Estimator::update(const MPU6050_Driver::MPU6050Sample& sample) {
+  return updateAxes(sample.ax, sample.ay, sample.gz);
+}
+
+float Estimator::update(const MPU6050_Driver::MPU6050Frame& frame) {
+  return updateAxes(frame.ax(), frame.ay(), frame.gz());
+}
+
+float Estimator::update(const MPU6050_Driver::MPU6050Batch& batch, uint16_t i) {
+  return updateAxes(batch.ax()[i], batch.ay()[i], batch.gz()[i]);
+}
+
+float Estimator::updateAxes(float ax, float ay, float gzDps) {
+  const float gz = gzDps * DEG_TO_RAD;
+  float tiltCos, tiltSin;
+  measuredGravity(ax, ay, gz, initialised ? angularAcceleration(gz) : 0, radius, tiltCos, tiltSin);
+  gzPrev = gz;
+
+  if (!initialised) {
+    const float norm = tiltCos * tiltCos + tiltSin * tiltSin;
+    if (norm == 0)
+      return angle;
+
+    initialised = true;
+    angle = FastAtan2(tiltSin, tiltCos);
+    rate = -gz;
+    gravityCos = tiltCos / std::sqrt(norm);
+    gravitySin = tiltSin / std::sqrt(norm);
+    P[0][0] = measurementNoise;
+    return angle;
+  }
+
+  // A positive angle is a negative Z rotation, so the angle changes at minus the gyro rate.
+  const float dt = samplePeriod;
+  switch (filter) {
+  case Filter_t::COMPLEMENTARY:
+    rate = -gz;
+    angle = gyroWeight * (angle + rate * dt) + (1 - gyroWeight) * FastAtan2(tiltSin, tiltCos);
+    break;
+
+  case Filter_t::MAHONY: {
+    // Error between the measured and estimated gravity directions, sin(tilt - angle), from their cross
+    // product. A free-falling (zero) measurement gives no correction.
+    const float norm = tiltCos * tiltCos + tiltSin * tiltSin;
+    const float error = norm > 0 ? (tiltSin * gravityCos - tiltCos * gravitySin) / std::sqrt(norm) : 0;
+    bias += mahonyKi * error * dt;
+    rate = bias - gz;
+
+    // Rotate the estimated gravity direction by the corrected rate, and renormalise.
+    const float delta = (rate + mahonyKp * error) * dt;
+    const float c = gravityCos * (1 - 0.5f * delta * delta) - gravitySin * delta;
+    const float s = gravitySin * (1 - 0.5f * delta * delta) + gravityCos * delta;
+    const float scale = 1.0f / std::sqrt(c * c + s * s);
+    gravityCos = c * scale;
+    gravitySin = s * scale;
+    angle = FastAtan2(gravitySin, gravityCos);
+    break;
+  }
+
+  case Filter_t::KALMAN: {
+    // Predict with the bias corrected gyro rate.
+    rate = bias - gz;
+    angle += rate * dt;
+    P[0][0] += dt * (dt * P[1][1] + P[0][1] + P[1][0] + angleNoise);
+    P[0][1] += dt * P[1][1];
+    P[1][0] += dt * P[1][1];
+    P[1][1] += biasNoise * dt;
+
+    // Correct with the accelerometer tilt.
+    const float innovation = FastAtan2(tiltSin, tiltCos) - angle;
+    const float S = P[0][0] + measurementNoise;
+    const float K0 = P[0][0] / S;
+    const float K1 = P[1][0] / S;
+    angle += K0 * innovation;
+    bias += K1 * innovation;
+
+    const float P00 = P[0][0];
+    const float P01 = P[0][1];
+    P[0][0] -= K0 * P00;
+    P[0][1] -= K0 * P01;
+    P[1][0] -= K1 * P00;
+    P[1][1] -= K1 * P01;
+    break;
+  }
+  }
+
+  return angle;
+}
+
+float Estimator::updateBatch(const MPU6050_Driver::MPU6050Sample* samples, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++)
+    update(samples[i]);
+
+  return angle;
+}
+
+} // namespace Attitude
@@ -0,0 +1,241 @@
+/**
+ * @file    estimator.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the attitude estimator declarations, fusing MPU6050 gyro rate with accelerometer tilt.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef ESTIMATOR_H
+#define ESTIMATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include "../mpu6050/mpu6050.h"
+
+namespace Attitude {
+
+  /**
+   * @brief Filters the estimator can run.
+   */
+  enum class Filter_t : uint8_t {
+    COMPLEMENTARY = 0, /**< Integrated gyro rate, pulled towards the accelerometer tilt with a fixed time constant. */
+    MAHONY = 1, /**< Gravity direction rotated by the gyro rate, corrected by a PI controller on the accelerometer error. */
+    KALMAN = 2 /**< Two state (angle and gyro bias) Kalman filter with the accelerometer tilt as the measurement. */
+  };
+
+  /**
+   * @brief Four quadrant arctangent, using a polynomial instead of the library call. Accurate to
+   * about 1e-5 rad, which is well below the accelerometer noise.
+   * @param y Y component.
+   * @param x X component.
+   * @retval float Angle in rad, between -pi and pi.
+   */
+  float FastAtan2(float y, float x);
+
+  /**
+   * @brief Estimates the angular position of the cup holder from MPU6050 samples. The gyro rate is
+   * integrated for a smooth, low latency angle, and the tilt of the measured gravity vector pulls
+   * the angle back so it doesn't drift.
+   *
+   * Angles follow the convention of the cascade: zero is upright, positive clockwise looking onto
+   * the face of the MPU. The Z axis points out of the face, so a positive angle is a negative Z
+   * rotation, and the angle changes at minus the gyro rate. The Y acceleration is corrected for the
+   * centripetal acceleration of the MPU using the gyro rate, and the X acceleration for the
+   * tangential acceleration using the change in gyro rate between samples.
+   */
+  class Estimator
+  {
+  public:
+    /**
+     * @brief Constructor.
+     * @param _filter Filter to run.
+     * @param _samplePeriod Time between samples in seconds.
+     * @param _radius Distance between MPU and axis of rotation in meters.
+     */
+    Estimator(Filter_t _filter, float _samplePeriod, float _radius);
+
+    /**
+     * @brief Update the estimate with a new sample. The first sample after construction or reset()
+     * sets the angle from the accelerometer alone.
+     * @param sample Sample from the MPU6050.
+     * @retval float Estimated angle in rad.
+     */
+    float update(const MPU6050_Driver::MPU6050Sample& sample);
+
+    /**
+     * @brief Update the estimate with a raw frame, as update(sample). Only the X and Y acceleration and
+     * Z rotation are converted, with the same results as converting the whole frame.
+     * @param frame Frame from the MPU6050.
+     * @retval float Estimated angle in rad.
+     */
+    float update(const MPU6050_Driver::MPU6050Frame& frame);
+
+    /**
+     * @brief Update the estimate with one frame of a converted FIFO batch, as update(sample).
+     * @param batch Batch from the MPU6050.
+     * @param i Index of the frame in the batch.
+     * @retval float Estimated angle in rad.
+     */
+    float update(const MPU6050_Driver::MPU6050Batch& batch, uint16_t i);
+
+    /**
+     * @brief Update the estimate with a batch of samples drained from the FIFO, oldest first.
+     * @param samples Array of samples.
+     * @param count Number of samples in the array.
+     * @retval float Estimated angle after the last sample, in rad.
+     */
+    float updateBatch(const MPU6050_Driver::MPU6050Sample* samples, std::size_t count);
+
+    /**
+     * @brief Tilt of the measured gravity vector, after the centripetal and tangential corrections, as
+     * the filters would measure it if the sample came next. This is what the filters use as their measurement.
+     * @param sample Sample from the MPU6050.
+     * @retval float Tilt in rad.
+     */
+    float accelTilt(const MPU6050_Driver::MPU6050Sample& sample) const;
+
+    /**
+     * @brief Tilt of the measured gravity vector of a raw frame, as accelTilt(sample).
+     * @param frame Frame from the MPU6050.
+     * @retval float Tilt in rad.
+     */
+    float accelTilt(const MPU6050_Driver::MPU6050Frame& frame) const;
+
+    /**
+     * @brief Estimated angle.
+     * @retval float Angle in rad.
+     */
+    float getAngle(void) const { return angle; }
+
+    /**
+     * @brief Angular velocity of the last sample: minus its gyro rate, less the estimated gyro bias.
+     * @retval float Angular velocity in rad/s.
+     */
+    float getRate(void) const { return rate; }
+
+    /**
+     * @brief Estimated bias of the Z gyro rate. Always zero for the complementary filter.
+     * @retval float Bias in rad/s.
+     */
+    float getGyroBias(void) const { return bias; }
+
+    /**
+     * @brief Selected filter.
+     * @retval Filter_t Filter.
+     */
+    Filter_t getFilter(void) const { return filter; }
+
+    /**
+     * @brief Forget the current estimate, so the next sample starts again from the accelerometer.
+     */
+    void reset(void);
+
+    /**
+     * @brief Set the time constant of the complementary filter. Longer trusts the gyro for longer.
+     * @param timeConstant Time constant in seconds.
+     */
+    void setComplementaryTimeConstant(float timeConstant);
+
+    /**
+     * @brief Set the gains of the Mahony filter.
+     * @param _mahonyKp Proportional gain on the accelerometer error, in rad/s per rad.
+     * @param _mahonyKi Integral gain on the accelerometer error, which tracks the gyro bias.
+     */
+    void setMahonyGains(float _mahonyKp, float _mahonyKi) { mahonyKp = _mahonyKp; mahonyKi = _mahonyKi; }
+
+    /**
+     * @brief Set the noise variances of the Kalman filter.
+     * @param _angleNoise Process noise of the angle, per second.
+     * @param _biasNoise Process noise of the gyro bias, per second.
+     * @param _measurementNoise Variance of the accelerometer tilt.
+     */
+    void setKalmanNoise(float _angleNoise, float _biasNoise, float _measurementNoise) {
+      angleNoise = _angleNoise;
+      biasNoise = _biasNoise;
+      measurementNoise = _measurementNoise;
+    }
+
+  private:
+    /**
+     * @brief Update the estimate with the axes the filters use.
+     * @param ax X acceleration in g.
+     * @param ay Y acceleration in g.
+     * @param gzDps Z rotation in deg/s.
+     * @retval float Estimated angle in rad.
+     */
+    float updateAxes(float ax, float ay, float gzDps);
+
+    /**
+     * @brief Z angular acceleration from the change in rotation since the last sample, for the tangential correction.
+     * @param gz Z rotation in rad/s.
+     * @retval float Angular acceleration in rad/s^2.
+     */
+    float angularAcceleration(float gz) const { return (gz - gzPrev) / samplePeriod; }
+
+    /** Selected filter. */
+    Filter_t filter;
+
+    /** Time between samples in seconds. */
+    float samplePeriod;
+
+    /** Radius from axis of rotation to MPU in meters. */
+    float radius;
+
+    /** False until the first sample has set the angle. */
+    bool initialised = false;
+
+    /** Estimated angle in rad. */
+    float angle = 0;
+
+    /** Bias corrected angular velocity in rad/s. */
+    float rate = 0;
+
+    /** Z rotation of the last sample in rad/s, for the tangential correction. */
+    float gzPrev = 0;
+
+    /** Estimated gyro bias in rad/s. */
+    float bias = 0;
+
+    /** Complementary filter weight of the gyro integral, from the time constant. */
+    float gyroWeight = 0;
+
+    /** Mahony filter gravity direction, as the cosine and sine of the angle. */
+    float gravityCos = 1;
+    float gravitySin = 0;
+
+    /** Mahony filter gains. */
+    float mahonyKp = 2.0f;
+    float mahonyKi = 0.5f;
+
+    /** Kalman filter noise variances. */
+    float angleNoise = 0.001f;
+    float biasNoise = 0.003f;
+    float measurementNoise = 0.03f;
+
+    /** Kalman filter error covariance. */
+    float P[2][2] = {{0, 0}, {0, 0}};
+  };
+
+} // namespace Attitude
+
+#endif
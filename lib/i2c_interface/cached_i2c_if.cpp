@@ -0,0 +1,277 @@
+/**
+  ******************************************************************************
+  * @file    cached_i2c_if.cpp
+  * @author  Adam Englebright
+  * @date    16.10.2026
+  * @brief   This file constains the implementation of an I2C interface decorator
+  * that keeps shadow copies of configuration registers.
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Adam Englebright
+  * 
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  * 
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  */
+#include "cached_i2c_if.h"
+#include <algorithm>
+
+/**
+  * @brief  I2C peripheral initialization method. Forwarded to the wrapped interface.
+  * @param  slaveAddress Address of the device that will be communicated
+  * @param  i2cFile Device file of I2C controller.
+  * @retval i2c_status_t
+  */
+i2c_status_t CACHED_I2C_IF::Init_I2C(uint8_t slaveAddress, std::string i2cFile)
+{
+	return bus->Init_I2C(slaveAddress, i2cFile);
+}
+
+/**
+  * @brief  Mark a register as volatile, so that it is never cached.
+  * @param  slaveAddress Slave chip I2C bus address
+  * @param  regAddress Register address
+  * @retval none
+  */
+void CACHED_I2C_IF::SetVolatile(uint8_t slaveAddress, uint8_t regAddress)
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	Shadow &shadow = shadows[Key(slaveAddress, regAddress)];
+	shadow = Shadow();
+	shadow.isVolatile = true;
+}
+
+/**
+  * @brief  Mark a list of registers as volatile.
+  * @param  slaveAddress Slave chip I2C bus address
+  * @param  regAddresses Array of register addresses
+  * @param  count Number of registers
+  * @retval none
+  */
+void CACHED_I2C_IF::SetVolatileRegisters(uint8_t slaveAddress, const uint8_t *regAddresses, uint8_t count)
+{
+	for (uint8_t i = 0; i < count; i++)
+		SetVolatile(slaveAddress, regAddresses[i]);
+}
+
+/**
+  * @brief  Start staging writes.
+  * @param  none
+  * @retval none
+  */
+void CACHED_I2C_IF::BeginUpdate(void)
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	updating = true;
+}
+
+/**
+  * @brief  Write every staged register whose value changed, once each.
+  * @param  none
+  * @retval i2c_status_t First error, or I2C_STATUS_SUCCESS
+  */
+i2c_status_t CACHED_I2C_IF::CommitUpdate(void)
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	i2c_status_t result = I2C_STATUS_SUCCESS;
+
+	for (uint16_t key : pendingKeys) {
+		Shadow &shadow = shadows[key];
+		shadow.pending = false;
+
+		// Several field updates may have put the register back how it was.
+		if (shadow.known && shadow.committed == shadow.staged) {
+			writesSkipped++;
+			continue;
+		}
+
+		i2c_status_t status = WriteBus(key >> 8, key & 0xFF, shadow.word, shadow.staged);
+		shadow.known = (status == I2C_STATUS_SUCCESS);
+		shadow.committed = shadow.staged;
+		if (status != I2C_STATUS_SUCCESS && result == I2C_STATUS_SUCCESS)
+			result = status;
+	}
+
+	pendingKeys.clear();
+	updating = false;
+	return result;
+}
+
+/**
+  * @brief  Forget the shadow copies of every register of a device.
+  * @param  slaveAddress Slave chip I2C bus address
+  * @retval none
+  */
+void CACHED_I2C_IF::Invalidate(uint8_t slaveAddress)
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	for (auto &entry : shadows) {
+		if ((entry.first >> 8) == slaveAddress) {
+			entry.second.known = false;
+			entry.second.pending = false;
+		}
+	}
+	// A staged write to an invalidated register must not reach the bus on commit.
+	pendingKeys.erase(std::remove_if(pendingKeys.begin(), pendingKeys.end(),
+		[slaveAddress](uint16_t key) { return (key >> 8) == slaveAddress; }), pendingKeys.end());
+}
+
+uint8_t CACHED_I2C_IF::ReadRegister(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status)
+{
+	return (uint8_t)Read(slaveAddress, regAddress, false, status);
+}
+
+uint16_t CACHED_I2C_IF::ReadRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status)
+{
+	uint16_t data = Read(slaveAddress, regAddress, true, status);
+	return (data >> 8) | (data << 8);
+}
+
+uint16_t CACHED_I2C_IF::ReadRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status)
+{
+	return Read(slaveAddress, regAddress, true, status);
+}
+
+i2c_status_t CACHED_I2C_IF::WriteRegister(uint8_t slaveAddress, uint8_t regAddress, uint8_t data)
+{
+	return Write(slaveAddress, regAddress, false, data);
+}
+
+i2c_status_t CACHED_I2C_IF::WriteRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data)
+{
+	return Write(slaveAddress, regAddress, true, (data >> 8) | (data << 8));
+}
+
+i2c_status_t CACHED_I2C_IF::WriteRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data)
+{
+	return Write(slaveAddress, regAddress, true, data);
+}
+
+/**
+  * @brief  Block reads are always data reads, so they go straight to the bus.
+  */
+i2c_status_t CACHED_I2C_IF::ReadRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data)
+{
+	return bus->ReadRegisterBlock(slaveAddress, regAddress, length, data);
+}
+
+/**
+  * @brief  Block writes go straight to the bus, and the shadow copies of the device are dropped
+  * since the registers written depend on how the device increments its register pointer.
+  */
+i2c_status_t CACHED_I2C_IF::WriteRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data)
+{
+	Invalidate(slaveAddress);
+	return bus->WriteRegisterBlock(slaveAddress, regAddress, length, data);
+}
+
+/**
+  * @brief  Combined transactions go straight to the bus. If any segment writes more than a register
+  * address, the shadow copies of that device are dropped.
+  */
+i2c_status_t CACHED_I2C_IF::TransferSegments(i2c_segment_t *segments, uint8_t count)
+{
+	for (uint8_t i = 0; i < count; i++) {
+		if (!segments[i].read && segments[i].length > 1)
+			Invalidate(segments[i].slaveAddress);
+	}
+
+	return bus->TransferSegments(segments, count);
+}
+
+/**
+  * @brief  Read a cached register, from the shadow copy if possible.
+  */
+uint16_t CACHED_I2C_IF::Read(uint8_t slaveAddress, uint8_t regAddress, bool word, i2c_status_t *status)
+{
+	std::unique_lock<std::mutex> lock(cacheMutex);
+	Shadow &shadow = shadows[Key(slaveAddress, regAddress)];
+
+	if (!shadow.isVolatile && shadow.word == word) {
+		if (shadow.pending) {
+			readsCached++;
+			status && (*status = I2C_STATUS_SUCCESS);
+			return shadow.staged;
+		}
+		if (shadow.known) {
+			readsCached++;
+			status && (*status = I2C_STATUS_SUCCESS);
+			return shadow.committed;
+		}
+	}
+
+	// Volatile, not cached yet, or last accessed with a different width.
+	i2c_status_t result;
+	uint16_t data = word ? bus->ReadRegisterWordBigEndian(slaveAddress, regAddress, &result)
+	                     : bus->ReadRegister(slaveAddress, regAddress, &result);
+	status && (*status = result);
+
+	if (!shadow.isVolatile && !shadow.pending) {
+		shadow.word = word;
+		shadow.known = (result == I2C_STATUS_SUCCESS);
+		shadow.committed = data;
+	}
+
+	return data;
+}
+
+/**
+  * @brief  Write a cached register, skipping or staging the write if possible.
+  */
+i2c_status_t CACHED_I2C_IF::Write(uint8_t slaveAddress, uint8_t regAddress, bool word, uint16_t data)
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	const uint16_t key = Key(slaveAddress, regAddress);
+	Shadow &shadow = shadows[key];
+
+	if (shadow.isVolatile)
+		return WriteBus(slaveAddress, regAddress, word, data);
+
+	// A change of width means the shadow copy no longer describes the register.
+	if (shadow.word != word) {
+		shadow.word = word;
+		shadow.known = false;
+	}
+
+	if (updating) {
+		if (!shadow.pending)
+			pendingKeys.push_back(key);
+		shadow.pending = true;
+		shadow.staged = data;
+		return I2C_STATUS_SUCCESS;
+	}
+
+	if (shadow.known && shadow.committed == data) {
+		writesSkipped++;
+		return I2C_STATUS_SUCCESS;
+	}
+
+	i2c_status_t result = WriteBus(slaveAddress, regAddress, word, data);
+	shadow.known = (result == I2C_STATUS_SUCCESS);
+	shadow.committed = data;
+	return result;
+}
+
+/**
+  * @brief  Write a register straight to the bus.
+  */
+i2c_status_t CACHED_I2C_IF::WriteBus(uint8_t slaveAddress, uint8_t regAddress, bool word, uint16_t data)
+{
+	return word ? bus->WriteRegisterWordBigEndian(slaveAddress, regAddress, data)
+	            : bus->WriteRegister(slaveAddress, regAddress, (uint8_t)data);
+}
@@ -0,0 +1,211 @@
+/**
+  ******************************************************************************
+  * @file    cached_i2c_if.h
+  * @author  Adam Englebright
+  * @date    16.10.2026
+  * @brief   This file constains the definition of an I2C interface decorator that
+  * keeps shadow copies of configuration registers.
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Adam Englebright
+  * 
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  * 
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  */
+
+#include "i2c_interface.h"
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#ifndef CACHED_I2C_IF_H
+#define CACHED_I2C_IF_H
+
+/** I2C interface decorator that keeps a shadow copy of every register it reads or writes,
+ * and forwards everything else to the wrapped interface. Reads of cached registers come from
+ * the shadow copy, and writes of a value the register already holds are skipped, which makes
+ * read-modify-write configuration cost one bus write (or none). Registers that change by
+ * themselves or have side effects when read (data, status, FIFO, self-clearing reset bits)
+ * must be marked volatile, and then always go straight to the bus. Block and combined
+ * transfers are never cached. */
+class CACHED_I2C_IF : public I2C_Interface
+{
+public:
+/**
+  * @brief  Class constructor.
+  * @param  _bus Interface used to talk to the bus.
+  * @retval none
+  */
+  CACHED_I2C_IF(I2C_Interface *_bus) : bus(_bus) {};
+
+/**
+  * @brief  I2C peripheral initialization method. Forwarded to the wrapped interface.
+  * @param  slaveAddress Address of the device that will be communicated
+  * @param  i2cFile Device file of I2C controller.
+  * @retval i2c_status_t
+  */
+  virtual i2c_status_t Init_I2C(uint8_t slaveAddress, std::string i2cFile) override;
+
+/**
+  * @brief  Mark a register as volatile, so that it is never cached.
+  * @param  slaveAddress Slave chip I2C bus address
+  * @param  regAddress Register address
+  * @retval none
+  */
+  void SetVolatile(uint8_t slaveAddress, uint8_t regAddress);
+
+/**
+  * @brief  Mark a list of registers as volatile, e.g. MPU6050_Driver::VOLATILE_REGS.
+  * @param  slaveAddress Slave chip I2C bus address
+  * @param  regAddresses Array of register addresses
+  * @param  count Number of registers
+  * @retval none
+  */
+  void SetVolatileRegisters(uint8_t slaveAddress, const uint8_t *regAddresses, uint8_t count);
+
+/**
+  * @brief  Start staging writes. Until CommitUpdate() is called, writes to cached registers only
+  * update the shadow copy (so later read-modify-writes see them), and nothing is sent to the bus.
+  * Writes to volatile registers still go straight to the bus. Only use from one thread at a time.
+  * @param  none
+  * @retval none
+  */
+  virtual void BeginUpdate(void) override;
+
+/**
+  * @brief  Write every staged register whose value changed, once each, in the order they were
+  * first staged.
+  * @param  none
+  * @retval i2c_status_t First error, or I2C_STATUS_SUCCESS
+  */
+  virtual i2c_status_t CommitUpdate(void) override;
+
+/**
+  * @brief  Forget the shadow copies of every register of a device, e.g. after resetting it.
+  * Volatile markings are kept.
+  * @param  slaveAddress Slave chip I2C bus address
+  * @retval none
+  */
+  virtual void Invalidate(uint8_t slaveAddress) override;
+
+/**
+  * @brief  Number of reads served from the shadow copies.
+  * @param  none
+  * @retval uint32_t Cache hits
+  */
+  uint32_t GetReadsCached(void) { return readsCached; }
+
+/**
+  * @brief  Number of writes skipped because the register already held the value.
+  * @param  none
+  * @retval uint32_t Skipped writes
+  */
+  uint32_t GetWritesSkipped(void) { return writesSkipped; }
+
+  virtual uint8_t ReadRegister(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status = nullptr) override;
+  virtual uint16_t ReadRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status = nullptr) override;
+  virtual uint16_t ReadRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status = nullptr) override;
+  virtual i2c_status_t WriteRegister(uint8_t slaveAddress, uint8_t regAddress, uint8_t data) override;
+  virtual i2c_status_t WriteRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data) override;
+  virtual i2c_status_t WriteRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data) override;
+  virtual i2c_status_t ReadRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data) override;
+  virtual i2c_status_t WriteRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data) override;
+  virtual i2c_status_t TransferSegments(i2c_segment_t *segments, uint8_t count) override;
+
+private:
+/**
+  * @brief  Shadow copy of one register. Word registers are stored big endian (MSB at the register address).
+  */
+  struct Shadow
+  {
+    bool isVolatile = false; // Never cached
+    bool known = false;      // committed matches the device
+    bool pending = false;    // staged is waiting for CommitUpdate()
+    bool word = false;       // Register was accessed as a word
+    uint16_t committed = 0;  // Last value read from or written to the device
+    uint16_t staged = 0;     // Value staged by a write during an update
+  };
+
+/**
+  * @brief  Read a cached register, from the shadow copy if possible.
+  * @param  slaveAddress Slave chip I2C bus address
+  * @param  regAddress Register address
+  * @param  word True for a word register
+  * @param  status Pointer for operation status
+  * @retval uint16_t Register value (big endian for words)
+  */
+  uint16_t Read(uint8_t slaveAddress, uint8_t regAddress, bool word, i2c_status_t *status);
+
+/**
+  * @brief  Write a cached register, skipping or staging the write if possible.
+  * @param  slaveAddress Slave chip I2C bus address
+  * @param  regAddress Register address
+  * @param  word True for a word register
+  * @param  data Register value (big endian for words)
+  * @retval i2c_status_t
+  */
+  i2c_status_t Write(uint8_t slaveAddress, uint8_t regAddress, bool word, uint16_t data);
+
+/**
+  * @brief  Write a register straight to the bus.
+  */
+  i2c_status_t WriteBus(uint8_t slaveAddress, uint8_t regAddress, bool word, uint16_t data);
+
+/**
+  * @brief  Key of a register in the shadow map.
+  */
+  static uint16_t Key(uint8_t slaveAddress, uint8_t regAddress) { return ((uint16_t)slaveAddress << 8) | regAddress; }
+
+/**
+  * @brief  Wrapped interface.
+  */
+  I2C_Interface *bus;
+
+/**
+  * @brief  Shadow copies, by Key().
+  */
+  std::unordered_map<uint16_t, Shadow> shadows;
+
+/**
+  * @brief  Keys of staged registers, in the order they were first staged.
+  */
+  std::vector<uint16_t> pendingKeys;
+
+/**
+  * @brief  True between BeginUpdate() and CommitUpdate().
+  */
+  bool updating = false;
+
+/**
+  * @brief  Serialises access to the shadow copies.
+  */
+  std::mutex cacheMutex;
+
+/**
+  * @brief  Reads served from the shadow copies.
+  */
+  uint32_t readsCached = 0;
+
+/**
+  * @brief  Writes skipped because the register already held the value.
+  */
+  uint32_t writesSkipped = 0;
+};
+
+#endif
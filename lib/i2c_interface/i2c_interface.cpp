@@ -63,3 +63,78 @@ i2c_status_t I2C_Interface::WriteRegisterBit(uint8_t slaveAddress, uint8_t regAd
 
     return status;
 }
+
+/**
+  * @brief  This method will be used to read a block of bytes of any length, starting from the given register
+  * of the slave device with the given address, in one transaction.
+  * @param  slaveAddress Slave chip I2C bus address
+  * @param  regAddress Lowest address of the registers to be read from
+  * @param  length Number of bytes to be read
+  * @param  data Pointer to the array of bytes to be writen to
+  * @retval i2c_status_t
+  */
+i2c_status_t I2C_Interface::ReadRegisterBlockLong(uint8_t slaveAddress, uint8_t regAddress, uint16_t length, uint8_t *data)
+{
+    // Write the register address, then read the block after a repeated start.
+    i2c_segment_t segments[2] = {
+        {slaveAddress, false, 1, &regAddress},
+        {slaveAddress, true, length, data}
+    };
+    i2c_status_t status = TransferSegments(segments, 2);
+
+    // Fall back to an ordinary block read where it is long enough.
+    if(status == I2C_STATUS_NONE && length <= 32)
+    {
+        status = ReadRegisterBlock(slaveAddress, regAddress, (uint8_t)length, data);
+    }
+
+    return status;
+}
+
+/**
+  * @brief  This method will be used to read several word registers of the slave device with the given address
+  * in one transaction. Interprets register data as big endian (MSB stored in lower address).
+  * @param  slaveAddress Slave chip I2C bus address
+  * @param  regAddresses Array of register addresses to be read
+  * @param  count Number of registers, I2C_MAX_SEGMENTS / 2 max
+  * @param  data Pointer to the array of words to be writen to
+  * @retval i2c_status_t
+  */
+i2c_status_t I2C_Interface::ReadRegisterWordsBigEndian(uint8_t slaveAddress, const uint8_t *regAddresses, uint8_t count, uint16_t *data)
+{
+    if(count > I2C_MAX_SEGMENTS / 2)
+    {
+        return I2C_STATUS_ERROR;
+    }
+
+    // Each register is a pointer write followed by a two byte read.
+    uint8_t regs[I2C_MAX_SEGMENTS / 2];
+    uint8_t bytes[I2C_MAX_SEGMENTS];
+    i2c_segment_t segments[I2C_MAX_SEGMENTS];
+    for(uint8_t i = 0; i < count; i++)
+    {
+        regs[i] = regAddresses[i];
+        segments[2 * i] = {slaveAddress, false, 1, &regs[i]};
+        segments[2 * i + 1] = {slaveAddress, true, 2, &bytes[2 * i]};
+    }
+
+    i2c_status_t status = TransferSegments(segments, 2 * count);
+    if(status == I2C_STATUS_SUCCESS)
+    {
+        for(uint8_t i = 0; i < count; i++)
+        {
+            data[i] = ((uint16_t)bytes[2 * i] << 8) | bytes[2 * i + 1];
+        }
+    }
+    else if(status == I2C_STATUS_NONE)
+    {
+        // No combined transaction support, so read the registers one at a time.
+        status = I2C_STATUS_SUCCESS;
+        for(uint8_t i = 0; i < count && status == I2C_STATUS_SUCCESS; i++)
+        {
+            data[i] = ReadRegisterWordBigEndian(slaveAddress, regAddresses[i], &status);
+        }
+    }
+
+    return status;
+}
@@ -45,6 +45,19 @@ enum i2c_status_t
   I2C_STATUS_NONE = 0x02
 };
 
+/** Maximum number of segments in one combined transaction (I2C_RDWR_IOCTL_MAX_MSGS on Linux). */
+#define I2C_MAX_SEGMENTS 42
+
+/** One read or write segment of a combined I2C transaction. Segments are sent back to back
+ * with repeated starts between them, and a single stop at the end of the transaction. */
+struct i2c_segment_t
+{
+  uint8_t slaveAddress; // Slave chip I2C bus address
+  bool read;            // True to read into data, false to write data out
+  uint16_t length;      // Number of bytes to transfer
+  uint8_t *data;        // Buffer to read into or write from
+};
+
 /** I2C clock speed types */
 enum class i2c_clockspeed_t
 {
@@ -198,6 +211,64 @@ public:
    * @retval i2c_status_t
    */
   virtual i2c_status_t WriteRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data) = 0;
+
+  /**
+   * @brief  This method will be used to send a list of read and write segments as a single combined
+   * transaction, with no stop between segments. Implementations that can't do this return I2C_STATUS_NONE,
+   * and the helper methods below fall back to separate transactions.
+   * @param  segments Array of segments, in bus order
+   * @param  count Number of segments, I2C_MAX_SEGMENTS max
+   * @retval i2c_status_t
+   */
+  virtual i2c_status_t TransferSegments(i2c_segment_t *segments, uint8_t count) {return I2C_STATUS_NONE;};
+
+  /**
+   * @brief  This method will be used to read a block of bytes of any length, starting from the given register
+   * of the slave device with the given address, in one transaction. Without TransferSegments() support, only
+   * blocks up to 32 bytes long can be read, and longer reads return I2C_STATUS_NONE.
+   * @param  slaveAddress Slave chip I2C bus address
+   * @param  regAddress Lowest address of the registers to be read from
+   * @param  length Number of bytes to be read
+   * @param  data Pointer to the array of bytes to be writen to
+   * @retval i2c_status_t
+   */
+  i2c_status_t ReadRegisterBlockLong(uint8_t slaveAddress, uint8_t regAddress, uint16_t length, uint8_t *data);
+
+  /**
+   * @brief  This method will be used to read several word registers of the slave device with the given address
+   * in one transaction. Registers are read in the order given, so reads with side effects (e.g. clearing an alert)
+   * happen in a known order. Interprets register data as big endian (MSB stored in lower address).
+   * @param  slaveAddress Slave chip I2C bus address
+   * @param  regAddresses Array of register addresses to be read
+   * @param  count Number of registers, I2C_MAX_SEGMENTS / 2 max
+   * @param  data Pointer to the array of words to be writen to
+   * @retval i2c_status_t
+   */
+  i2c_status_t ReadRegisterWordsBigEndian(uint8_t slaveAddress, const uint8_t *regAddresses, uint8_t count, uint16_t *data);
+
+  /**
+   * @brief  This method will be used to start a group of configuration writes. Interfaces that cache registers
+   * may hold the writes back until CommitUpdate(), so that several fields of one register cost a single write.
+   * Other interfaces write straight away, and this does nothing.
+   * @param  none
+   * @retval none
+   */
+  virtual void BeginUpdate(void) {};
+
+  /**
+   * @brief  This method will be used to finish a group of configuration writes started with BeginUpdate().
+   * @param  none
+   * @retval i2c_status_t I2C_STATUS_NONE if the interface doesn't hold writes back
+   */
+  virtual i2c_status_t CommitUpdate(void) {return I2C_STATUS_NONE;};
+
+  /**
+   * @brief  This method will be used to tell interfaces that cache registers that every register of the slave
+   * device with the given address may have changed, e.g. after a device reset. Other interfaces do nothing.
+   * @param  slaveAddress Slave chip I2C bus address
+   * @retval none
+   */
+  virtual void Invalidate(uint8_t slaveAddress) {};
 };
 
 #endif /* include guard */
@@ -0,0 +1,89 @@
+/**
+  ******************************************************************************
+  * @file    i2c_trace.h
+  * @author  Adam Englebright
+  * @date    16.10.2026
+  * @brief   This file constains the layout of the binary files that I2C transactions
+  * are recorded to and replayed from.
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Adam Englebright
+  * 
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  * 
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  */
+
+#include <cstdint>
+
+#ifndef I2C_TRACE_H
+#define I2C_TRACE_H
+
+/** Magic number at the start of every I2C trace file ("I2CT"). */
+#define I2C_TRACE_MAGIC 0x54433249
+
+/** Version of the I2C trace file format. */
+#define I2C_TRACE_VERSION 1
+
+/** Kinds of transaction recorded in an I2C trace. Word registers are recorded big endian, whichever
+ * byte order they were accessed with. */
+enum i2c_trace_op_t : uint8_t
+{
+  I2C_TRACE_READ_BYTE = 0x00,   // ReadRegister(), payload is the byte read
+  I2C_TRACE_READ_WORD = 0x01,   // ReadRegisterWord...(), payload is the word read
+  I2C_TRACE_WRITE_BYTE = 0x02,  // WriteRegister(), payload is the byte written
+  I2C_TRACE_WRITE_WORD = 0x03,  // WriteRegisterWord...(), payload is the word written
+  I2C_TRACE_READ_BLOCK = 0x04,  // ReadRegisterBlock(), payload is the bytes read
+  I2C_TRACE_WRITE_BLOCK = 0x05, // WriteRegisterBlock(), payload is the bytes written
+  I2C_TRACE_TRANSFER = 0x06     // TransferSegments(), payload is each segment in turn
+};
+
+/** Header of one recorded transaction, followed in the file by length bytes of payload. */
+struct i2c_trace_record_t
+{
+  uint32_t gap_ns;       // Time from the end of the previous transaction to the start of this one, saturating
+  uint32_t duration_ns;  // Time the transaction took, saturating
+  uint16_t length;       // Number of payload bytes
+  uint8_t op;            // i2c_trace_op_t
+  uint8_t status;        // i2c_status_t returned
+  uint8_t slaveAddress;  // Slave chip I2C bus address (0 for transfers)
+  uint8_t regAddress;    // Register address (0 for transfers)
+  uint16_t segments;     // Number of segments of a transfer (0 otherwise)
+};
+
+/** Header of one segment in the payload of a recorded transfer, followed by length bytes of data:
+ * what was written for a write segment, or what was read for a read segment. */
+struct i2c_trace_segment_t
+{
+  uint8_t slaveAddress;  // Slave chip I2C bus address
+  uint8_t read;          // 1 for a read segment, 0 for a write
+  uint16_t length;       // Number of bytes transferred
+};
+
+/** Header at the start of an I2C trace file. */
+struct i2c_trace_header_t
+{
+  uint32_t magic = I2C_TRACE_MAGIC;                 // Always I2C_TRACE_MAGIC
+  uint16_t version = I2C_TRACE_VERSION;             // File format version
+  uint16_t recordSize = sizeof(i2c_trace_record_t); // So readers can check the record layout matches
+};
+
+static_assert(sizeof(i2c_trace_record_t) == 16, "I2C trace records must be packed");
+static_assert(sizeof(i2c_trace_segment_t) == 4, "I2C trace segments must be packed");
+
+#endif
@@ -0,0 +1,295 @@
+/**
+  ******************************************************************************
+  * @file    replay_i2c_if.cpp
+  * @author  Adam Englebright
+  * @date    16.10.2026
+  * @brief   This file constains the implementation of an I2C interface that serves
+  * transactions back from a trace file.
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Adam Englebright
+  * 
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  * 
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  */
+#include "replay_i2c_if.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+/**
+  * @brief  Class constructor. Loads the trace, and checks every record is whole.
+  * @param  path Trace file to replay.
+  * @retval none
+  */
+REPLAY_I2C_IF::REPLAY_I2C_IF(const std::string &path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open()) {
+		std::cout << "Failed to open I2C trace file " << path << "." << std::endl;
+		throw std::invalid_argument("Failed to open I2C trace file.");
+	}
+
+	i2c_trace_header_t header;
+	file.read(reinterpret_cast<char *>(&header), sizeof(header));
+	if (!file || header.magic != I2C_TRACE_MAGIC || header.version != I2C_TRACE_VERSION
+	    || header.recordSize != sizeof(i2c_trace_record_t)) {
+		std::cout << path << " is not an I2C trace, or was written by an incompatible version." << std::endl;
+		throw std::invalid_argument("Not an I2C trace file.");
+	}
+
+	trace.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+	for (std::size_t offset = 0; offset < trace.size(); recordCount++) {
+		if (trace.size() - offset < sizeof(i2c_trace_record_t)
+		    || trace.size() - offset - sizeof(i2c_trace_record_t) < RecordAt(offset).length) {
+			std::cout << "I2C trace " << path << " is cut short after " << recordCount << " transactions." << std::endl;
+			throw std::invalid_argument("I2C trace file is cut short.");
+		}
+
+		i2c_trace_record_t record = RecordAt(offset);
+		hasTransfers = hasTransfers || record.op == I2C_TRACE_TRANSFER;
+		offset += sizeof(record) + record.length;
+	}
+}
+
+/**
+  * @brief  Start again from the first recorded transaction.
+  * @param  none
+  * @retval none
+  */
+void REPLAY_I2C_IF::Rewind(void)
+{
+	position = 0;
+	clock_ns = 0;
+	timestamp_ns = 0;
+}
+
+uint8_t REPLAY_I2C_IF::ReadRegister(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status)
+{
+	uint8_t data;
+	i2c_status_t result = Read(I2C_TRACE_READ_BYTE, slaveAddress, regAddress, 1, &data);
+	status && (*status = result);
+	return data;
+}
+
+uint16_t REPLAY_I2C_IF::ReadRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status)
+{
+	uint16_t data = ReadRegisterWordBigEndian(slaveAddress, regAddress, status);
+	return (data >> 8) | (data << 8);
+}
+
+uint16_t REPLAY_I2C_IF::ReadRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status)
+{
+	uint8_t bytes[2];
+	i2c_status_t result = Read(I2C_TRACE_READ_WORD, slaveAddress, regAddress, 2, bytes);
+	status && (*status = result);
+	return ((uint16_t)bytes[0] << 8) | bytes[1];
+}
+
+i2c_status_t REPLAY_I2C_IF::WriteRegister(uint8_t slaveAddress, uint8_t regAddress, uint8_t data)
+{
+	return Write(I2C_TRACE_WRITE_BYTE, slaveAddress, regAddress, 1, &data);
+}
+
+i2c_status_t REPLAY_I2C_IF::WriteRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data)
+{
+	return WriteRegisterWordBigEndian(slaveAddress, regAddress, (data >> 8) | (data << 8));
+}
+
+i2c_status_t REPLAY_I2C_IF::WriteRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data)
+{
+	uint8_t bytes[2] = {(uint8_t)(data >> 8), (uint8_t)data};
+	return Write(I2C_TRACE_WRITE_WORD, slaveAddress, regAddress, 2, bytes);
+}
+
+i2c_status_t REPLAY_I2C_IF::ReadRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data)
+{
+	return Read(I2C_TRACE_READ_BLOCK, slaveAddress, regAddress, length, data);
+}
+
+i2c_status_t REPLAY_I2C_IF::WriteRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data)
+{
+	return Write(I2C_TRACE_WRITE_BLOCK, slaveAddress, regAddress, length, data);
+}
+
+/**
+  * @brief  Transfers are served like reads, from the next recorded transfer with the same segments writing
+  * the same data. If the recorded interface never did a transfer, I2C_STATUS_NONE is returned as it would
+  * have been, so the caller falls back to separate transactions as it did when recording.
+  */
+i2c_status_t REPLAY_I2C_IF::TransferSegments(i2c_segment_t *segments, uint8_t count)
+{
+	if (!hasTransfers)
+		return I2C_STATUS_NONE;
+
+	if (!Find([this, segments, count](std::size_t offset, const i2c_trace_record_t &) {
+		    return TransferMatches(offset, segments, count);
+	    })) {
+		mismatchCount++;
+		return I2C_STATUS_ERROR;
+	}
+
+	i2c_trace_record_t record = RecordAt(position);
+	std::size_t offset = position + sizeof(record);
+	for (uint8_t i = 0; i < count; i++) {
+		offset += sizeof(i2c_trace_segment_t);
+		if (segments[i].read)
+			std::memcpy(segments[i].data, &trace[offset], segments[i].length);
+		offset += segments[i].length;
+	}
+
+	Consume(record);
+	servedCount++;
+	return (i2c_status_t)record.status;
+}
+
+/**
+  * @brief  Get the header of the record at an offset into the trace.
+  */
+i2c_trace_record_t REPLAY_I2C_IF::RecordAt(std::size_t offset) const
+{
+	i2c_trace_record_t record;
+	std::memcpy(&record, &trace[offset], sizeof(record));
+	return record;
+}
+
+/**
+  * @brief  Find the next recorded read of a register or block, serve its data, and move past it.
+  */
+i2c_status_t REPLAY_I2C_IF::Read(i2c_trace_op_t op, uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data)
+{
+	if (!Find([=](std::size_t, const i2c_trace_record_t &record) {
+		    return record.op == op && record.slaveAddress == slaveAddress && record.regAddress == regAddress
+		           && record.length == length;
+	    })) {
+		mismatchCount++;
+		std::memset(data, 0, length);
+		return I2C_STATUS_ERROR;
+	}
+
+	i2c_trace_record_t record = RecordAt(position);
+	std::memcpy(data, &trace[position + sizeof(record)], length);
+	Consume(record);
+	servedCount++;
+	return (i2c_status_t)record.status;
+}
+
+/**
+  * @brief  Check a write against the next recorded transaction, and use it up if it's the same write.
+  * A write of different data is still used up, so the replay stays in step.
+  */
+i2c_status_t REPLAY_I2C_IF::Write(i2c_trace_op_t op, uint8_t slaveAddress, uint8_t regAddress, uint8_t length, const uint8_t *data)
+{
+	if (looping && AtEnd())
+		position = 0;
+
+	if (!AtEnd()) {
+		i2c_trace_record_t record = RecordAt(position);
+		if (record.op == op && record.slaveAddress == slaveAddress && record.regAddress == regAddress
+		    && record.length == length) {
+			if (std::memcmp(data, &trace[position + sizeof(record)], length) != 0)
+				mismatchCount++;
+
+			Consume(record);
+			servedCount++;
+			return (i2c_status_t)record.status;
+		}
+	}
+
+	mismatchCount++;
+	return I2C_STATUS_SUCCESS;
+}
+
+/**
+  * @brief  Whether a recorded transfer is the same as the one asked for.
+  */
+bool REPLAY_I2C_IF::TransferMatches(std::size_t offset, const i2c_segment_t *segments, uint8_t count) const
+{
+	i2c_trace_record_t record = RecordAt(offset);
+	if (record.op != I2C_TRACE_TRANSFER || record.segments != count)
+		return false;
+
+	const std::size_t end = offset + sizeof(record) + record.length;
+	offset += sizeof(record);
+	for (uint8_t i = 0; i < count; i++) {
+		i2c_trace_segment_t segment;
+		if (end - offset < sizeof(segment))
+			return false;
+		std::memcpy(&segment, &trace[offset], sizeof(segment));
+		offset += sizeof(segment);
+
+		if (segment.slaveAddress != segments[i].slaveAddress || segment.read != segments[i].read
+		    || segment.length != segments[i].length || end - offset < segment.length)
+			return false;
+		if (!segments[i].read && std::memcmp(&trace[offset], segments[i].data, segment.length) != 0)
+			return false;
+		offset += segment.length;
+	}
+
+	return true;
+}
+
+/**
+  * @brief  Search forward for a record, wrapping around if looping. When wrapping, the clock keeps
+  * running, so timestamps keep going up. If nothing is found, nothing changes.
+  */
+template <typename Matches>
+bool REPLAY_I2C_IF::Find(Matches matches)
+{
+	std::size_t offset = position;
+	uint64_t clock = clock_ns;
+	uint32_t passed = 0;
+	bool wrapped = false;
+
+	while (true) {
+		if (offset == trace.size()) {
+			if (!looping || wrapped)
+				return false;
+			offset = 0;
+			wrapped = true;
+		}
+		if (wrapped && offset >= position)
+			return false;
+
+		i2c_trace_record_t record = RecordAt(offset);
+		if (matches(offset, record)) {
+			position = offset;
+			clock_ns = clock;
+			skippedCount += passed;
+			return true;
+		}
+
+		clock += (uint64_t)record.gap_ns + record.duration_ns;
+		offset += sizeof(record) + record.length;
+		passed++;
+	}
+}
+
+/**
+  * @brief  Move past the record at position, taking its time.
+  */
+void REPLAY_I2C_IF::Consume(const i2c_trace_record_t &record)
+{
+	clock_ns += (uint64_t)record.gap_ns + record.duration_ns;
+	timestamp_ns = clock_ns;
+	position += sizeof(record) + record.length;
+}
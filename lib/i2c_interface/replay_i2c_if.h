@@ -0,0 +1,229 @@
+/**
+  ******************************************************************************
+  * @file    replay_i2c_if.h
+  * @author  Adam Englebright
+  * @date    16.10.2026
+  * @brief   This file constains the definition of an I2C interface that serves
+  * transactions back from a trace file.
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Adam Englebright
+  * 
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  * 
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  */
+
+#include "i2c_interface.h"
+#include "i2c_trace.h"
+#include <vector>
+
+#ifndef REPLAY_I2C_IF_H
+#define REPLAY_I2C_IF_H
+
+/** I2C interface that serves back the transactions recorded by TRACE_I2C_IF, with no hardware.
+ * The whole trace is loaded at construction, so replaying never touches the file system and gives the
+ * same results every run. Each read is served from the next recorded read of the same register (or
+ * the same transfer), passing over any recorded transactions in between, so a driver can replay a
+ * subset of what was recorded, e.g. only the sample reads. A read that isn't in the rest of the trace
+ * fails with I2C_STATUS_ERROR. Writes are checked against the next recorded transaction: the same
+ * write is used up, and anything else is counted as a mismatch and otherwise ignored. */
+class REPLAY_I2C_IF : public I2C_Interface
+{
+public:
+/**
+  * @brief  Class constructor. Loads and checks the trace.
+  * Throws std::invalid_argument if the file can't be read, isn't a trace, or is cut short.
+  * @param  path Trace file to replay.
+  * @retval none
+  */
+  REPLAY_I2C_IF(const std::string &path);
+
+/**
+  * @brief  Set whether reads past the end of the trace start again from the beginning, e.g. to
+  * benchmark on a short recording.
+  * @param  loop True to wrap around at the end
+  * @retval none
+  */
+  void SetLoop(bool loop) { looping = loop; }
+
+/**
+  * @brief  Start again from the first recorded transaction. The counters are kept.
+  * @param  none
+  * @retval none
+  */
+  void Rewind(void);
+
+/**
+  * @brief  Whether every recorded transaction has been served or passed over.
+  * @param  none
+  * @retval bool True at the end of the trace
+  */
+  bool AtEnd(void) const { return position == trace.size(); }
+
+/**
+  * @brief  Time the last transaction served finished, from the start of the first recorded transaction.
+  * @param  none
+  * @retval uint64_t Time in nanoseconds
+  */
+  uint64_t GetTimestamp(void) const { return timestamp_ns; }
+
+/**
+  * @brief  Number of transactions recorded in the trace.
+  * @param  none
+  * @retval uint32_t Recorded transactions
+  */
+  uint32_t GetRecordCount(void) const { return recordCount; }
+
+/**
+  * @brief  Number of transactions served from the trace.
+  * @param  none
+  * @retval uint32_t Transactions served
+  */
+  uint32_t GetServedCount(void) const { return servedCount; }
+
+/**
+  * @brief  Number of recorded transactions passed over to find a read.
+  * @param  none
+  * @retval uint32_t Transactions passed over
+  */
+  uint32_t GetSkippedCount(void) const { return skippedCount; }
+
+/**
+  * @brief  Number of writes that didn't match the trace, and reads that weren't found in it.
+  * @param  none
+  * @retval uint32_t Mismatches
+  */
+  uint32_t GetMismatchCount(void) const { return mismatchCount; }
+
+  virtual uint8_t ReadRegister(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status = nullptr) override;
+  virtual uint16_t ReadRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status = nullptr) override;
+  virtual uint16_t ReadRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status = nullptr) override;
+  virtual i2c_status_t WriteRegister(uint8_t slaveAddress, uint8_t regAddress, uint8_t data) override;
+  virtual i2c_status_t WriteRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data) override;
+  virtual i2c_status_t WriteRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data) override;
+  virtual i2c_status_t ReadRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data) override;
+  virtual i2c_status_t WriteRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data) override;
+  virtual i2c_status_t TransferSegments(i2c_segment_t *segments, uint8_t count) override;
+
+private:
+/**
+  * @brief  Get the header of the record at an offset into the trace.
+  * @param  offset Offset of the record
+  * @retval i2c_trace_record_t Record header
+  */
+  i2c_trace_record_t RecordAt(std::size_t offset) const;
+
+/**
+  * @brief  Find the next recorded read of a register or block, serve its data, and move past it.
+  * @param  op Kind of read
+  * @param  slaveAddress Slave chip I2C bus address
+  * @param  regAddress Register address
+  * @param  length Number of bytes to read
+  * @param  data Pointer to the array of bytes to be writen to
+  * @retval i2c_status_t Recorded result, or I2C_STATUS_ERROR if not found
+  */
+  i2c_status_t Read(i2c_trace_op_t op, uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data);
+
+/**
+  * @brief  Check a write against the next recorded transaction, and use it up if it's the same write.
+  * @param  op Kind of write
+  * @param  slaveAddress Slave chip I2C bus address
+  * @param  regAddress Register address
+  * @param  length Number of bytes written
+  * @param  data Pointer to the array of bytes written
+  * @retval i2c_status_t Recorded result, or I2C_STATUS_SUCCESS if it wasn't recorded next
+  */
+  i2c_status_t Write(i2c_trace_op_t op, uint8_t slaveAddress, uint8_t regAddress, uint8_t length, const uint8_t *data);
+
+/**
+  * @brief  Whether a recorded transfer is the same as the one asked for: the same segments, writing the same data.
+  * @param  offset Offset of the recorded transfer
+  * @param  segments Array of segments asked for
+  * @param  count Number of segments
+  * @retval bool True if it matches
+  */
+  bool TransferMatches(std::size_t offset, const i2c_segment_t *segments, uint8_t count) const;
+
+/**
+  * @brief  Search forward for a record, wrapping around if looping, and move to it.
+  * @param  matches Function taking a record offset and header, returning true for the record wanted.
+  * @retval bool True if found, with position at the record
+  */
+  template <typename Matches>
+  bool Find(Matches matches);
+
+/**
+  * @brief  Move past the record at position, taking its time.
+  * @param  record Header of the record at position
+  * @retval none
+  */
+  void Consume(const i2c_trace_record_t &record);
+
+/**
+  * @brief  Recorded transactions, without the file header.
+  */
+  std::vector<uint8_t> trace;
+
+/**
+  * @brief  Offset of the next record.
+  */
+  std::size_t position = 0;
+
+/**
+  * @brief  Time the record at position starts after, from the start of the trace.
+  */
+  uint64_t clock_ns = 0;
+
+/**
+  * @brief  Time the last transaction served finished.
+  */
+  uint64_t timestamp_ns = 0;
+
+/**
+  * @brief  Wrap around at the end of the trace.
+  */
+  bool looping = false;
+
+/**
+  * @brief  Whether the recorded interface did combined transfers. If not, nor does the replay.
+  */
+  bool hasTransfers = false;
+
+/**
+  * @brief  Transactions recorded.
+  */
+  uint32_t recordCount = 0;
+
+/**
+  * @brief  Transactions served.
+  */
+  uint32_t servedCount = 0;
+
+/**
+  * @brief  Recorded transactions passed over.
+  */
+  uint32_t skippedCount = 0;
+
+/**
+  * @brief  Unmatched writes and reads.
+  */
+  uint32_t mismatchCount = 0;
+};
+
+#endif
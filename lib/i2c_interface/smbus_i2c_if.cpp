@@ -40,6 +40,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 extern "C" {
+#include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 #include <i2c/smbus.h>
 }
@@ -275,6 +276,47 @@ i2c_status_t SMBUS_I2C_IF::WriteRegisterBlock(uint8_t slaveAddress, uint8_t regA
   return I2C_STATUS_SUCCESS;
 }
 
+/**
+ * @brief  This method will be used to send a list of read and write segments as a single combined
+ * transaction, using the I2C_RDWR ioctl.
+ * @param  segments Array of segments, in bus order
+ * @param  count Number of segments, I2C_MAX_SEGMENTS max
+ * @retval i2c_status_t
+ */
+i2c_status_t SMBUS_I2C_IF::TransferSegments(i2c_segment_t *segments, uint8_t count)
+{
+  int status; // Returned value from ioctl(). Negative if error, else the number of messages transferred.
+
+  // Check the kernel will accept this many messages
+  if (count == 0 || count > I2C_MAX_SEGMENTS) {
+    std::cout << "ERROR: smbus_i2c_if.cpp: SMBUS_I2C_IF::TransferSegments(): I2C_RDWR transaction must have between 1 and "
+	      << I2C_MAX_SEGMENTS << " segments." << std::endl;
+    return I2C_STATUS_ERROR;
+  }
+
+  // Translate segments into kernel I2C messages.
+  struct i2c_msg msgs[I2C_MAX_SEGMENTS];
+  for (uint8_t i = 0; i < count; i++) {
+    msgs[i].addr = segments[i].slaveAddress;
+    msgs[i].flags = segments[i].read ? I2C_M_RD : 0;
+    msgs[i].len = segments[i].length;
+    msgs[i].buf = segments[i].data;
+  }
+
+  struct i2c_rdwr_ioctl_data transaction;
+  transaction.msgs = msgs;
+  transaction.nmsgs = count;
+
+  status = ioctl(fd, I2C_RDWR, &transaction);
+  if (status < 0) { // Catch errors
+    std::cout << "ERROR: smbus_i2c_if.cpp: SMBUS_I2C_IF::TransferSegments(): Could not transfer " << unsigned(count)
+	      << " segments to device at address " << unsigned(segments[0].slaveAddress) << ". Error code " << status << std::endl;
+    return I2C_STATUS_ERROR;
+  }
+
+  return I2C_STATUS_SUCCESS;
+}
+
 /**
   * @brief  Class destructor.
   * @param  none
@@ -136,6 +136,16 @@ public:
    */
   virtual i2c_status_t WriteRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data) override;
 
+  /**
+   * @brief  This method will be used to send a list of read and write segments as a single combined
+   * transaction, using the I2C_RDWR ioctl. Unlike the SMBus calls, segments can be longer than 32 bytes,
+   * and the slave address of each segment is used.
+   * @param  segments Array of segments, in bus order
+   * @param  count Number of segments, I2C_MAX_SEGMENTS max
+   * @retval i2c_status_t
+   */
+  virtual i2c_status_t TransferSegments(i2c_segment_t *segments, uint8_t count) override;
+
 /**
   * @brief  Class destructor.
   * @param  none
@@ -0,0 +1,253 @@
+/**
+  ******************************************************************************
+  * @file    trace_i2c_if.cpp
+  * @author  Adam Englebright
+  * @date    16.10.2026
+  * @brief   This file constains the implementation of an I2C interface decorator that
+  * records every transaction to a trace file.
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Adam Englebright
+  * 
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  * 
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  */
+#include "trace_i2c_if.h"
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+/**
+  * @brief  Class constructor. Creates the trace file and writes its header.
+  * @param  _bus Interface used to talk to the bus.
+  * @param  path Trace file to write.
+  * @retval none
+  */
+TRACE_I2C_IF::TRACE_I2C_IF(I2C_Interface *_bus, const std::string &path)
+	: bus(_bus), file(path, std::ios::binary | std::ios::trunc)
+{
+	if (!file.is_open()) {
+		std::cout << "Failed to open I2C trace file " << path << "." << std::endl;
+		throw std::invalid_argument("Failed to open I2C trace file.");
+	}
+
+	i2c_trace_header_t header;
+	file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	buffer.reserve(TRACE_FLUSH_BYTES + 1024);
+}
+
+/**
+  * @brief  Class destructor. Writes out any records not yet written.
+  * @param  none
+  * @retval none
+  */
+TRACE_I2C_IF::~TRACE_I2C_IF()
+{
+	Flush();
+}
+
+/**
+  * @brief  I2C peripheral initialization method. Forwarded to the wrapped interface, and not recorded.
+  * @param  slaveAddress Address of the device that will be communicated
+  * @param  i2cFile Device file of I2C controller.
+  * @retval i2c_status_t
+  */
+i2c_status_t TRACE_I2C_IF::Init_I2C(uint8_t slaveAddress, std::string i2cFile)
+{
+	return bus->Init_I2C(slaveAddress, i2cFile);
+}
+
+/**
+  * @brief  Write out every record collected so far.
+  * @param  none
+  * @retval none
+  */
+void TRACE_I2C_IF::Flush(void)
+{
+	std::lock_guard<std::mutex> lock(traceMutex);
+	WriteOut();
+	file.flush();
+}
+
+uint8_t TRACE_I2C_IF::ReadRegister(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status)
+{
+	uint64_t start = Now();
+	i2c_status_t result;
+	uint8_t data = bus->ReadRegister(slaveAddress, regAddress, &result);
+	status && (*status = result);
+
+	Record(I2C_TRACE_READ_BYTE, slaveAddress, regAddress, result, start, &data, 1);
+	return data;
+}
+
+uint16_t TRACE_I2C_IF::ReadRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status)
+{
+	uint16_t data = ReadRegisterWordBigEndian(slaveAddress, regAddress, status);
+	return (data >> 8) | (data << 8);
+}
+
+uint16_t TRACE_I2C_IF::ReadRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status)
+{
+	uint64_t start = Now();
+	i2c_status_t result;
+	uint16_t data = bus->ReadRegisterWordBigEndian(slaveAddress, regAddress, &result);
+	status && (*status = result);
+
+	uint8_t bytes[2] = {(uint8_t)(data >> 8), (uint8_t)data};
+	Record(I2C_TRACE_READ_WORD, slaveAddress, regAddress, result, start, bytes, 2);
+	return data;
+}
+
+i2c_status_t TRACE_I2C_IF::WriteRegister(uint8_t slaveAddress, uint8_t regAddress, uint8_t data)
+{
+	uint64_t start = Now();
+	i2c_status_t result = bus->WriteRegister(slaveAddress, regAddress, data);
+
+	Record(I2C_TRACE_WRITE_BYTE, slaveAddress, regAddress, result, start, &data, 1);
+	return result;
+}
+
+i2c_status_t TRACE_I2C_IF::WriteRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data)
+{
+	return WriteRegisterWordBigEndian(slaveAddress, regAddress, (data >> 8) | (data << 8));
+}
+
+i2c_status_t TRACE_I2C_IF::WriteRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data)
+{
+	uint64_t start = Now();
+	i2c_status_t result = bus->WriteRegisterWordBigEndian(slaveAddress, regAddress, data);
+
+	uint8_t bytes[2] = {(uint8_t)(data >> 8), (uint8_t)data};
+	Record(I2C_TRACE_WRITE_WORD, slaveAddress, regAddress, result, start, bytes, 2);
+	return result;
+}
+
+i2c_status_t TRACE_I2C_IF::ReadRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data)
+{
+	uint64_t start = Now();
+	i2c_status_t result = bus->ReadRegisterBlock(slaveAddress, regAddress, length, data);
+
+	Record(I2C_TRACE_READ_BLOCK, slaveAddress, regAddress, result, start, data, length);
+	return result;
+}
+
+i2c_status_t TRACE_I2C_IF::WriteRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data)
+{
+	uint64_t start = Now();
+	i2c_status_t result = bus->WriteRegisterBlock(slaveAddress, regAddress, length, data);
+
+	Record(I2C_TRACE_WRITE_BLOCK, slaveAddress, regAddress, result, start, data, length);
+	return result;
+}
+
+/**
+  * @brief  Transfers are recorded with each segment's header and data, after the transfer is done,
+  * so read segments hold what was read.
+  */
+i2c_status_t TRACE_I2C_IF::TransferSegments(i2c_segment_t *segments, uint8_t count)
+{
+	uint64_t start = Now();
+	i2c_status_t result = bus->TransferSegments(segments, count);
+
+	std::size_t length = 0;
+	for (uint8_t i = 0; i < count; i++)
+		length += sizeof(i2c_trace_segment_t) + segments[i].length;
+
+	std::lock_guard<std::mutex> lock(traceMutex);
+	if (length > UINT16_MAX) {
+		droppedCount++;
+		return result;
+	}
+
+	AppendRecord(I2C_TRACE_TRANSFER, 0, 0, result, start, length, count);
+	for (uint8_t i = 0; i < count; i++) {
+		i2c_trace_segment_t segment = {segments[i].slaveAddress, segments[i].read, segments[i].length};
+		AppendPayload(&segment, sizeof(segment));
+		AppendPayload(segments[i].data, segments[i].length);
+	}
+
+	if (buffer.size() >= TRACE_FLUSH_BYTES)
+		WriteOut();
+	return result;
+}
+
+/**
+  * @brief  Read the monotonic clock.
+  */
+uint64_t TRACE_I2C_IF::Now(void)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+  * @brief  Append the header of a record, timed from the end of the previous transaction.
+  */
+void TRACE_I2C_IF::AppendRecord(i2c_trace_op_t op, uint8_t slaveAddress, uint8_t regAddress, i2c_status_t status,
+                                uint64_t start_ns, uint16_t length, uint16_t segments)
+{
+	uint64_t end_ns = Now();
+	uint64_t gap = (lastEnd_ns && start_ns > lastEnd_ns) ? start_ns - lastEnd_ns : 0;
+	uint64_t duration = end_ns - start_ns;
+	lastEnd_ns = end_ns;
+
+	i2c_trace_record_t record;
+	record.gap_ns = gap > UINT32_MAX ? UINT32_MAX : gap;
+	record.duration_ns = duration > UINT32_MAX ? UINT32_MAX : duration;
+	record.length = length;
+	record.op = op;
+	record.status = status;
+	record.slaveAddress = slaveAddress;
+	record.regAddress = regAddress;
+	record.segments = segments;
+	AppendPayload(&record, sizeof(record));
+	recordCount++;
+}
+
+/**
+  * @brief  Append payload bytes.
+  */
+void TRACE_I2C_IF::AppendPayload(const void *data, std::size_t length)
+{
+	const uint8_t *bytes = static_cast<const uint8_t *>(data);
+	buffer.insert(buffer.end(), bytes, bytes + length);
+}
+
+/**
+  * @brief  Record a register or block transaction, and write out the records if there are enough.
+  */
+void TRACE_I2C_IF::Record(i2c_trace_op_t op, uint8_t slaveAddress, uint8_t regAddress, i2c_status_t status,
+                          uint64_t start_ns, const uint8_t *data, uint16_t length)
+{
+	std::lock_guard<std::mutex> lock(traceMutex);
+	AppendRecord(op, slaveAddress, regAddress, status, start_ns, length);
+	AppendPayload(data, length);
+
+	if (buffer.size() >= TRACE_FLUSH_BYTES)
+		WriteOut();
+}
+
+/**
+  * @brief  Write out the collected records.
+  */
+void TRACE_I2C_IF::WriteOut(void)
+{
+	file.write(reinterpret_cast<const char *>(buffer.data()), buffer.size());
+	buffer.clear();
+}
@@ -0,0 +1,190 @@
+/**
+  ******************************************************************************
+  * @file    trace_i2c_if.h
+  * @author  Adam Englebright
+  * @date    16.10.2026
+  * @brief   This file constains the definition of an I2C interface decorator that
+  * records every transaction to a trace file.
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Adam Englebright
+  * 
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  * 
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  */
+
+#include "i2c_interface.h"
+#include "i2c_trace.h"
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#ifndef TRACE_I2C_IF_H
+#define TRACE_I2C_IF_H
+
+/** I2C interface decorator that forwards everything to the wrapped interface, and records every
+ * transaction, with its timing, result and data, to a binary trace file (see i2c_trace.h). The trace
+ * can be served back by REPLAY_I2C_IF, so drivers can be tested and benchmarked on real captured data
+ * with no hardware. Records are collected in memory and written out in large chunks, so recording
+ * costs a copy per transaction and a file write every TRACE_FLUSH_BYTES. Put it underneath any cache,
+ * so the trace holds the transactions that actually went over the bus. */
+class TRACE_I2C_IF : public I2C_Interface
+{
+public:
+/**
+  * @brief  Class constructor. Creates the trace file and writes its header.
+  * Throws std::invalid_argument if the file can't be created.
+  * @param  _bus Interface used to talk to the bus.
+  * @param  path Trace file to write.
+  * @retval none
+  */
+  TRACE_I2C_IF(I2C_Interface *_bus, const std::string &path);
+
+/**
+  * @brief  Class destructor. Writes out any records not yet written.
+  * @param  none
+  * @retval none
+  */
+  virtual ~TRACE_I2C_IF() override;
+
+/**
+  * @brief  I2C peripheral initialization method. Forwarded to the wrapped interface, and not recorded.
+  * @param  slaveAddress Address of the device that will be communicated
+  * @param  i2cFile Device file of I2C controller.
+  * @retval i2c_status_t
+  */
+  virtual i2c_status_t Init_I2C(uint8_t slaveAddress, std::string i2cFile) override;
+
+/**
+  * @brief  Write out every record collected so far.
+  * @param  none
+  * @retval none
+  */
+  void Flush(void);
+
+/**
+  * @brief  Number of transactions recorded.
+  * @param  none
+  * @retval uint32_t Transactions recorded
+  */
+  uint32_t GetRecordCount(void) { return recordCount; }
+
+/**
+  * @brief  Number of transfers too large to record (over 64 KiB of payload).
+  * @param  none
+  * @retval uint32_t Transfers not recorded
+  */
+  uint32_t GetDroppedCount(void) { return droppedCount; }
+
+  virtual uint8_t ReadRegister(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status = nullptr) override;
+  virtual uint16_t ReadRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status = nullptr) override;
+  virtual uint16_t ReadRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status = nullptr) override;
+  virtual i2c_status_t WriteRegister(uint8_t slaveAddress, uint8_t regAddress, uint8_t data) override;
+  virtual i2c_status_t WriteRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data) override;
+  virtual i2c_status_t WriteRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data) override;
+  virtual i2c_status_t ReadRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data) override;
+  virtual i2c_status_t WriteRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data) override;
+  virtual i2c_status_t TransferSegments(i2c_segment_t *segments, uint8_t count) override;
+  virtual void BeginUpdate(void) override { bus->BeginUpdate(); }
+  virtual i2c_status_t CommitUpdate(void) override { return bus->CommitUpdate(); }
+  virtual void Invalidate(uint8_t slaveAddress) override { bus->Invalidate(slaveAddress); }
+
+private:
+/**
+  * @brief  Size the collected records reach before they are written out.
+  */
+  static constexpr std::size_t TRACE_FLUSH_BYTES = 64 * 1024;
+
+/**
+  * @brief  Read the monotonic clock.
+  * @retval uint64_t Time in nanoseconds
+  */
+  static uint64_t Now(void);
+
+/**
+  * @brief  Append the header of a record. The payload must be appended straight after.
+  * Must be called with traceMutex held.
+  * @param  op Kind of transaction
+  * @param  slaveAddress Slave chip I2C bus address
+  * @param  regAddress Register address
+  * @param  status Result of the transaction
+  * @param  start_ns Time the transaction started
+  * @param  length Number of payload bytes
+  * @param  segments Number of segments of a transfer
+  * @retval none
+  */
+  void AppendRecord(i2c_trace_op_t op, uint8_t slaveAddress, uint8_t regAddress, i2c_status_t status,
+                    uint64_t start_ns, uint16_t length, uint16_t segments = 0);
+
+/**
+  * @brief  Append payload bytes.
+  * @param  data Bytes to append
+  * @param  length Number of bytes
+  * @retval none
+  */
+  void AppendPayload(const void *data, std::size_t length);
+
+/**
+  * @brief  Record a register or block transaction, and write out the records if there are enough.
+  */
+  void Record(i2c_trace_op_t op, uint8_t slaveAddress, uint8_t regAddress, i2c_status_t status,
+              uint64_t start_ns, const uint8_t *data, uint16_t length);
+
+/**
+  * @brief  Write out the collected records. Must be called with traceMutex held.
+  */
+  void WriteOut(void);
+
+/**
+  * @brief  Wrapped interface.
+  */
+  I2C_Interface *bus;
+
+/**
+  * @brief  Trace file.
+  */
+  std::ofstream file;
+
+/**
+  * @brief  Records collected since they were last written out.
+  */
+  std::vector<uint8_t> buffer;
+
+/**
+  * @brief  Time the previous transaction finished, or 0 before the first.
+  */
+  uint64_t lastEnd_ns = 0;
+
+/**
+  * @brief  Serialises recording.
+  */
+  std::mutex traceMutex;
+
+/**
+  * @brief  Transactions recorded.
+  */
+  uint32_t recordCount = 0;
+
+/**
+  * @brief  Transfers too large to record.
+  */
+  uint32_t droppedCount = 0;
+};
+
+#endif
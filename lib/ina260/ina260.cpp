@@ -1,4 +1,5 @@
 #include "ina260.h"
+#include "../telemetry/telemetry.h"
 #include <cstdint>
 #include <gpiod.hpp>
 
@@ -42,6 +43,11 @@ i2c_status_t INA260::InitializeSensor(Alert_Conf alert_mode,
                                       Op_Mode operating_mode) {
   i2c_status_t result = AlertSet(alert_mode);
 
+  // The rest are all fields of CONF_REG. With a caching I2C interface they are
+  // merged into one write when committed.
+  const Op_Mode committedMode = operatingMode;
+  i2c->BeginUpdate();
+
   if (result == I2C_STATUS_SUCCESS)
     result = CurrentConvTime(curr_conv_time);
 
@@ -53,6 +59,15 @@ i2c_status_t INA260::InitializeSensor(Alert_Conf alert_mode,
 
   if (result == I2C_STATUS_SUCCESS)
     result = OperatingMode(operating_mode);
+
+  i2c_status_t commit = i2c->CommitUpdate();
+  if (result == I2C_STATUS_SUCCESS && commit != I2C_STATUS_NONE)
+    result = commit;
+
+  // OperatingMode() only staged the new mode, so it stands only if the commit
+  // reached the sensor.
+  if (result != I2C_STATUS_SUCCESS)
+    operatingMode = committedMode;
   return result;
 }
 
@@ -63,7 +78,11 @@ i2c_status_t INA260::InitializeSensor(Alert_Conf alert_mode,
  */
 void INA260::begin(void) {
   dataAquisitionRunning = true;
-  dataAquisitionThread = std::thread(&INA260::dataAquisition, this);
+  dataAquisitionThread = std::thread([this]() {
+    // Set up scheduling from inside the thread, so the stack prefault touches this thread's stack.
+    threadConfigErrors = RealTime::ApplyThreadConfig(threadConfig, "INA260");
+    dataAquisition();
+  });
 }
 
 /**
@@ -73,7 +92,8 @@ void INA260::begin(void) {
  */
 void INA260::end(void) {
   dataAquisitionRunning = false;
-  dataAquisitionThread.join();
+  if (dataAquisitionThread.joinable())
+    dataAquisitionThread.join();
 }
 
 /**
@@ -96,65 +116,121 @@ void INA260::dataAquisition(void) {
 	                   .set_bias(gpiod::line::bias::PULL_UP)) // INA260 int pin is open drain, and can thus only pull down, so we need pull-up here.
           .do_request();
   gpiod::edge_event_buffer buffer(1);
-
-  INA260Sample sample;
+  uint64_t edge_ns = 0;
 
   while (dataAquisitionRunning) {
-    sample.current = ReadCurrent();
-    sample.voltage = ReadVoltage();
-
-    ina260cb->hasSample(sample);
+    ProcessSample(edge_ns);
 
+    // Keep the kernel's edge timestamp to time the next sample from.
     request.read_edge_events(buffer);
+    edge_ns = buffer.get_event(0).timestamp_ns().ns();
   }
 }
 
+/**
+ * @brief  This method reads one sample and sends it to the registered callback.
+ * Samples that fail to read are counted and not passed on.
+ * @param  origin_ns Monotonic timestamp of the alert edge in nanoseconds, or zero for now.
+ * @retval i2c_status_t
+ */
+i2c_status_t INA260::ProcessSample(uint64_t origin_ns) {
+  sample.timestamp_ns = origin_ns ? origin_ns : Telemetry::Producer::now_ns();
+
+  if (latencyTrace) {
+    latencyTrace->begin(sample.timestamp_ns);
+    Telemetry::LatencyTrace::stamp(Telemetry::LatencyStage::WAKEUP);
+  }
+
+  i2c_status_t status = ReadSample(sample);
+  if (status == I2C_STATUS_SUCCESS) {
+    Telemetry::LatencyTrace::stamp(Telemetry::LatencyStage::I2C_READ);
+    ina260cb->hasSample(sample);
+  }
+  else
+    readErrorCount++;
+
+  Telemetry::LatencyTrace::end();
+  return status;
+}
+
+/**
+ * @brief Read a whole sample in one transaction. Only the measurements
+ * converted in the configured operating mode are read, followed by the
+ * mask/enable register to clear the alert.
+ * @param  sample Sample to read into.
+ * @retval i2c_status_t
+ */
+i2c_status_t INA260::ReadSample(INA260Sample &sample) {
+  const uint8_t mode = static_cast<uint8_t>(operatingMode);
+  const bool readCurrent = mode & 0b001; // Shunt current converted
+  const bool readVoltage = mode & 0b010; // Bus voltage converted
+
+  uint8_t regs[3];
+  uint16_t data[3];
+  uint8_t count = 0;
+  if (readCurrent)
+    regs[count++] = Sensor_Regs::CURRENT_REG;
+  if (readVoltage)
+    regs[count++] = Sensor_Regs::VOLTAGE_REG;
+  regs[count++] = Sensor_Regs::MASKEN_REG;
+
+  i2c_status_t status =
+      i2c->ReadRegisterWordsBigEndian(INA260_ADDRESS, regs, count, data);
+  if (status != I2C_STATUS_SUCCESS)
+    return status;
+
+  count = 0;
+  if (readCurrent)
+    sample.current = ReadingBases::CURRENT * (int16_t)data[count++];
+  if (readVoltage)
+    sample.voltage = ReadingBases::VOLTAGE * (int16_t)data[count++];
+  sample.maskEnable = data[count];
+
+  return status;
+}
+
+/**
+ * @brief Read a measurement register, then the mask/enable register to clear
+ * the interrupt pin, in one transaction.
+ * @param  reg Measurement register.
+ * @param  status Pointer for operation status
+ * @retval int16_t Raw measurement.
+ */
+int16_t INA260::ReadMeasurement(uint8_t reg, i2c_status_t *status) {
+  const uint8_t regs[2] = {reg, Sensor_Regs::MASKEN_REG};
+  uint16_t data[2] = {0, 0};
+  i2c_status_t result =
+      i2c->ReadRegisterWordsBigEndian(INA260_ADDRESS, regs, 2, data);
+
+  status && (*status = result);
+  return (result == I2C_STATUS_SUCCESS) ? data[0] : 0;
+}
+
 /**
  * @brief Read the voltage through the sensor.
- * @param  None
+ * @param  status Pointer for operation status
  * @retval float Voltage.
  */
-float INA260::ReadVoltage(void) {
-  i2c_status_t status;
-  int16_t voltage_data = i2c->ReadRegisterWordBigEndian(
-      INA260_ADDRESS, Sensor_Regs::VOLTAGE_REG, &status);
-
-  // Read the mask/enable register to clear the interrupt pin.
-  i2c->ReadRegisterWordBigEndian(INA260_ADDRESS, Sensor_Regs::MASKEN_REG,
-                                 &status);
-  return ReadingBases::VOLTAGE * voltage_data;
+float INA260::ReadVoltage(i2c_status_t *status) {
+  return ReadingBases::VOLTAGE * ReadMeasurement(Sensor_Regs::VOLTAGE_REG, status);
 }
 
 /**
  * @brief Read the current through the sensor.
- * @param  None
+ * @param  status Pointer for operation status
  * @retval float Current.
  */
-float INA260::ReadCurrent(void) {
-  i2c_status_t status;
-  int16_t current_data = i2c->ReadRegisterWordBigEndian(
-      INA260_ADDRESS, Sensor_Regs::CURRENT_REG, &status);
-
-  // Read the mask/enable register to clear the interrupt pin.
-  i2c->ReadRegisterWordBigEndian(INA260_ADDRESS, Sensor_Regs::MASKEN_REG,
-                                 &status);
-  return ReadingBases::CURRENT * current_data;
+float INA260::ReadCurrent(i2c_status_t *status) {
+  return ReadingBases::CURRENT * ReadMeasurement(Sensor_Regs::CURRENT_REG, status);
 }
 
 /**
  * @brief Read the power through the sensor.
- * @param  None
+ * @param  status Pointer for operation status
  * @retval float Power
  */
-float INA260::ReadPower(void) {
-  i2c_status_t status;
-  int16_t power_data = i2c->ReadRegisterWordBigEndian(
-      INA260_ADDRESS, Sensor_Regs::POWER_REG, &status);
-
-  // Read the mask/enable register to clear the interrupt pin.
-  i2c->ReadRegisterWordBigEndian(INA260_ADDRESS, Sensor_Regs::MASKEN_REG,
-                                 &status);
-  return ReadingBases::POWER * power_data;
+float INA260::ReadPower(i2c_status_t *status) {
+  return ReadingBases::POWER * ReadMeasurement(Sensor_Regs::POWER_REG, status);
 }
 
 /**
@@ -179,6 +255,8 @@ i2c_status_t INA260::CurrentConvTime(Conv_Time convert_time) {
   i2c_status_t status;
   uint16_t conv_time_reg = i2c->ReadRegisterWordBigEndian(
       INA260_ADDRESS, Sensor_Regs::CONF_REG, &status);
+  if (status != I2C_STATUS_SUCCESS)
+    return status;
   uint16_t mask = ~0b0000000000111000;
   conv_time_reg = conv_time_reg & mask;
   conv_time_reg = conv_time_reg | ((uint16_t)convert_time << 3);
@@ -196,6 +274,8 @@ i2c_status_t INA260::VoltageConvTime(Conv_Time convert_time) {
   i2c_status_t status;
   uint16_t conv_time_reg = i2c->ReadRegisterWordBigEndian(
       INA260_ADDRESS, Sensor_Regs::CONF_REG, &status);
+  if (status != I2C_STATUS_SUCCESS)
+    return status;
   uint16_t mask = ~0b0000000111000000;
   conv_time_reg = conv_time_reg & mask;
   conv_time_reg = conv_time_reg | ((uint16_t)convert_time << 6);
@@ -213,13 +293,22 @@ i2c_status_t INA260::OperatingMode(Op_Mode operate_mode) {
   i2c_status_t status;
   uint16_t conf_reg_data = i2c->ReadRegisterWordBigEndian(
       INA260_ADDRESS, Sensor_Regs::CONF_REG, &status);
+  if (status != I2C_STATUS_SUCCESS)
+    return status;
   uint16_t mask = ~0b0000000000000111;
   conf_reg_data = conf_reg_data & mask;
   conf_reg_data = conf_reg_data | ((uint16_t)operate_mode);
   std::cout << "Data sent to config register: " << std::hex << conf_reg_data
             << std::endl;
-  return i2c->WriteRegisterWordBigEndian(INA260_ADDRESS, Sensor_Regs::CONF_REG,
-                                         conf_reg_data);
+  i2c_status_t result = i2c->WriteRegisterWordBigEndian(
+      INA260_ADDRESS, Sensor_Regs::CONF_REG, conf_reg_data);
+
+  // Remember the mode so ReadSample() only reads what is converted. Under
+  // BeginUpdate() the write is only staged, and InitializeSensor() puts the
+  // mode back if the commit fails.
+  if (result == I2C_STATUS_SUCCESS)
+    operatingMode = operate_mode;
+  return result;
 }
 
 /**
@@ -232,6 +321,8 @@ i2c_status_t INA260::AveragingMode(Ave_Mode ave_setting) {
   i2c_status_t status;
   uint16_t conf_reg_data = i2c->ReadRegisterWordBigEndian(
       INA260_ADDRESS, Sensor_Regs::CONF_REG, &status);
+  if (status != I2C_STATUS_SUCCESS)
+    return status;
   uint16_t mask = ~0b0000111000000000;
   conf_reg_data = conf_reg_data & mask;
   conf_reg_data = conf_reg_data | ((uint16_t)ave_setting << 9);
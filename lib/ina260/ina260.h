@@ -1,6 +1,9 @@
 #ifndef INA260_H
 #define INA260_H
 #include "../i2c_interface/i2c_interface.h"
+#include "../telemetry/latency.h"
+#include "../realtime/realtime.h"
+#include <atomic>
 #include <gpiod.hpp>
 #include <thread>
 
@@ -21,6 +24,13 @@ SensorConst MAN_ID = 0xfe;
 SensorConst DIE_ID = 0xff;
 }; // namespace Sensor_Regs
 
+/** Registers that change by themselves or have side effects when read, and so
+ * must never be cached (see CACHED_I2C_IF). MASKEN holds the alert flags, and
+ * reading it clears the alert. */
+static constexpr uint8_t VOLATILE_REGS[] = {
+    Sensor_Regs::CURRENT_REG, Sensor_Regs::VOLTAGE_REG, Sensor_Regs::POWER_REG,
+    Sensor_Regs::MASKEN_REG};
+
 namespace ReadingBases {
 ReadingBasesConst CURRENT = 0.00125;
 ReadingBasesConst VOLTAGE = 0.00125;
@@ -82,6 +92,16 @@ struct INA260Sample {
    * @brief Measured voltage.
    */
   float voltage = 0;
+
+  /**
+   * @brief Mask/enable register, read to clear the alert. Holds the conversion ready and alert flags.
+   */
+  uint16_t maskEnable = 0;
+
+  /**
+   * @brief Monotonic timestamp of the alert edge that announced the sample, in nanoseconds.
+   */
+  uint64_t timestamp_ns = 0;
 };
 
 /**
@@ -131,6 +151,39 @@ public:
                                 Conv_Time curr_conv_time = Conv_Time::TU140,
                                 Ave_Mode averaging_mode = Ave_Mode::AV1,
                                 Op_Mode operating_mode = Op_Mode::CURVOLCONT);
+  /**
+   * @brief  This method reads one sample and sends it to the registered callback. It is one pass
+   * of the aquisition loop, without waiting for the alert, so it can also be called directly,
+   * e.g. by a simulator stepping in virtual time, instead of using begin().
+   * @param  origin_ns Monotonic timestamp of the alert edge in nanoseconds, or zero for now.
+   * @retval i2c_status_t
+   */
+  i2c_status_t ProcessSample(uint64_t origin_ns = 0);
+
+  /**
+   * @brief  Trace the latency of each sample from the alert edge through the control loop.
+   * @param  trace Trace to record into, or nullptr to stop tracing.
+   * @retval None
+   */
+  void SetLatencyTrace(Telemetry::LatencyTrace* trace) { latencyTrace = trace; }
+
+  /**
+   * @brief  Set the scheduling of the data aquisition thread (SCHED_FIFO priority, CPU affinity,
+   * memory locking and stack prefaulting). It is applied by the thread itself when begin() starts it,
+   * before the aquisition loop runs.
+   * @param  config Thread configuration.
+   * @retval None
+   */
+  void SetThreadConfig(const RealTime::ThreadConfig& config) { threadConfig = config; }
+
+  /**
+   * @brief  Parts of the thread configuration that could not be applied, e.g. for lack of permissions.
+   * Only meaningful once the data aquisition thread has started.
+   * @param  None
+   * @retval uint8_t RealTime::ThreadConfigError flags.
+   */
+  uint8_t GetThreadConfigErrors(void) { return threadConfigErrors; }
+
   /**
    * @brief  This function will begin data aquisition in a separate thread.
    * @param  None
@@ -189,26 +242,42 @@ public:
    */
   i2c_status_t AlertSet(Alert_Conf alert_mode = Alert_Conf::CNVR);
 
+  /**
+   * @brief Read a whole sample in one transaction. Only the measurements converted in the
+   * configured operating mode are read, followed by the mask/enable register to clear the alert.
+   * Measurements that are not converted are left unchanged in the sample.
+   * @param  sample Sample to read into.
+   * @retval i2c_status_t
+   */
+  i2c_status_t ReadSample(INA260Sample &sample);
+
   /**
    * @brief Read the current through the sensor.
-   * @param  None
+   * @param  status Pointer for operation status
    * @retval float Current.
    */
-  float ReadCurrent(void);
+  float ReadCurrent(i2c_status_t *status = nullptr);
 
   /**
    * @brief Read the voltage through the sensor.
-   * @param  None
+   * @param  status Pointer for operation status
    * @retval float Voltage.
    */
-  float ReadVoltage(void);
+  float ReadVoltage(i2c_status_t *status = nullptr);
 
   /**
    * @brief Read the power through the sensor.
-   * @param  None
+   * @param  status Pointer for operation status
    * @retval float Power
    */
-  float ReadPower(void);
+  float ReadPower(i2c_status_t *status = nullptr);
+
+  /**
+   * @brief Number of samples dropped during data aquisition because they could not be read.
+   * @param  None
+   * @retval uint32_t Failed read count.
+   */
+  uint32_t GetReadErrorCount(void) { return readErrorCount; }
 
 private:
   /** Pointer to registered I2C interface. */
@@ -226,6 +295,24 @@ private:
   /** Data aquisition flag. */
   bool dataAquisitionRunning;
 
+  /** Operating mode last written to the sensor, used to choose which registers to read. Staged writes only count once committed. */
+  Op_Mode operatingMode = Op_Mode::CURVOLCONT;
+
+  /** Number of samples that failed to read during data aquisition. */
+  uint32_t readErrorCount = 0;
+
+  /** Last sample read. Measurements not converted in the operating mode keep their last value. */
+  INA260Sample sample;
+
+  /** Latency trace, if one has been set. */
+  Telemetry::LatencyTrace* latencyTrace = nullptr;
+
+  /** Scheduling settings for the data aquisition thread. */
+  RealTime::ThreadConfig threadConfig;
+
+  /** Thread configuration errors, written by the data aquisition thread. */
+  std::atomic<uint8_t> threadConfigErrors{RealTime::NONE};
+
   /**
    * @brief Data aquisition method that, in the loop, will block until and
    * interupt is generated by the INA260
@@ -233,6 +320,15 @@ private:
    * @retval None
    */
   void dataAquisition(void);
+
+  /**
+   * @brief Read a measurement register, then the mask/enable register to clear
+   * the interrupt pin, in one transaction.
+   * @param  reg Measurement register.
+   * @param  status Pointer for operation status
+   * @retval int16_t Raw measurement.
+   */
+  int16_t ReadMeasurement(uint8_t reg, i2c_status_t *status);
 };
 } // namespace INA260_Driver
 
@@ -0,0 +1,274 @@
+/**
+ * @file    frame_convert.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the batch conversion of raw MPU6050 frames into physical units.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "frame_convert.h"
+#include <algorithm>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FRAME_CONVERT_NEON
+#elif defined(__SSE2__)
+#include <immintrin.h>
+#define FRAME_CONVERT_SSE2
+#endif
+
+namespace MPU6050_Driver {
+
+/** Number of frames the vector paths convert at once, one 16 bit lane each. */
+static constexpr uint16_t VECTOR_FRAMES = 8;
+
+/**
+ * @brief Convert frames one at a time, with the same expressions as MPU6050Frame::convert().
+ * @param frames Frames to convert
+ * @param first First frame to convert
+ * @param count Number of frames in the array
+ * @param scale Scale factors to convert with
+ * @param batch Batch to write to
+ */
+static void convertScalar(const uint8_t* frames, uint16_t first, uint16_t count, const MPU6050Scale& scale,
+			  MPU6050Batch& batch) {
+  for (uint16_t i = first; i < count; i++) {
+    const uint8_t* frame = frames + i * FIFO_FRAME_SIZE;
+    for (int word = 0; word < 7; word++) {
+      const int16_t raw = (int16_t)((frame[2 * word] << 8) | frame[2 * word + 1]);
+      batch.words[word][i] = word == MPU6050Frame::TEMP ? raw / 340.0f + 36.53f // Conversion taken from datasheet.
+							: raw * scale.perLsb[word];
+    }
+  }
+}
+
+#if defined(FRAME_CONVERT_NEON)
+
+/**
+ * @brief Load eight frames, and transpose them so each vector holds one word of every frame.
+ * @param frames First of the eight frames
+ * @param words Words 0 to 7 (7 is zero), little endian
+ */
+static inline void loadWords(const uint8_t* frames, int16x8_t words[8]) {
+  int16x8_t rows[8];
+  for (int k = 0; k < 7; k++)
+    rows[k] = vreinterpretq_s16_u8(vrev16q_u8(vld1q_u8(frames + k * FIFO_FRAME_SIZE)));
+
+  // Frames are 14 bytes, so a 16 byte load of the last one would read past the end of the array.
+  // Load it two bytes early instead, and shift it down.
+  rows[7] = vreinterpretq_s16_u8(vrev16q_u8(vextq_u8(vld1q_u8(frames + 7 * FIFO_FRAME_SIZE - 2), vdupq_n_u8(0), 2)));
+
+  // 8x8 transpose: swap 16 bit pairs, then 32 bit pairs, then 64 bit halves.
+  const int16x8x2_t t01 = vtrnq_s16(rows[0], rows[1]);
+  const int16x8x2_t t23 = vtrnq_s16(rows[2], rows[3]);
+  const int16x8x2_t t45 = vtrnq_s16(rows[4], rows[5]);
+  const int16x8x2_t t67 = vtrnq_s16(rows[6], rows[7]);
+  const int32x4x2_t u02 = vtrnq_s32(vreinterpretq_s32_s16(t01.val[0]), vreinterpretq_s32_s16(t23.val[0]));
+  const int32x4x2_t u13 = vtrnq_s32(vreinterpretq_s32_s16(t01.val[1]), vreinterpretq_s32_s16(t23.val[1]));
+  const int32x4x2_t u46 = vtrnq_s32(vreinterpretq_s32_s16(t45.val[0]), vreinterpretq_s32_s16(t67.val[0]));
+  const int32x4x2_t u57 = vtrnq_s32(vreinterpretq_s32_s16(t45.val[1]), vreinterpretq_s32_s16(t67.val[1]));
+  words[0] = vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(u02.val[0]), vget_low_s32(u46.val[0])));
+  words[1] = vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(u13.val[0]), vget_low_s32(u57.val[0])));
+  words[2] = vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(u02.val[1]), vget_low_s32(u46.val[1])));
+  words[3] = vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(u13.val[1]), vget_low_s32(u57.val[1])));
+  words[4] = vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(u02.val[0]), vget_high_s32(u46.val[0])));
+  words[5] = vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(u13.val[0]), vget_high_s32(u57.val[0])));
+  words[6] = vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(u02.val[1]), vget_high_s32(u46.val[1])));
+  words[7] = vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(u13.val[1]), vget_high_s32(u57.val[1])));
+}
+
+/**
+ * @brief Convert whole groups of eight frames with NEON.
+ * @return uint16_t Number of frames converted.
+ */
+static uint16_t convertVector(const uint8_t* frames, uint16_t count, const MPU6050Scale& scale, MPU6050Batch& batch) {
+  uint16_t i = 0;
+  for (; i + VECTOR_FRAMES <= count; i += VECTOR_FRAMES) {
+    int16x8_t words[8];
+    loadWords(frames + i * FIFO_FRAME_SIZE, words);
+    for (int word = 0; word < 7; word++) {
+      float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(words[word])));
+      float32x4_t high = vcvtq_f32_s32(vmovl_high_s16(words[word]));
+      if (word == MPU6050Frame::TEMP) {
+	low = vaddq_f32(vdivq_f32(low, vdupq_n_f32(340.0f)), vdupq_n_f32(36.53f));
+	high = vaddq_f32(vdivq_f32(high, vdupq_n_f32(340.0f)), vdupq_n_f32(36.53f));
+      } else {
+	low = vmulq_f32(low, vdupq_n_f32(scale.perLsb[word]));
+	high = vmulq_f32(high, vdupq_n_f32(scale.perLsb[word]));
+      }
+      vst1q_f32(&batch.words[word][i], low);
+      vst1q_f32(&batch.words[word][i + 4], high);
+    }
+  }
+  return i;
+}
+
+#elif defined(FRAME_CONVERT_SSE2)
+
+/**
+ * @brief Swap the bytes of each 16 bit lane.
+ * @param v Vector to swap
+ * @return __m128i Swapped vector
+ */
+static inline __m128i swapBytes(__m128i v) {
+  return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+/**
+ * @brief Load eight frames, and transpose them so each vector holds one word of every frame.
+ * @param frames First of the eight frames
+ * @param words Words 0 to 7 (7 is zero), little endian
+ */
+static inline void loadWords(const uint8_t* frames, __m128i words[8]) {
+  __m128i rows[8];
+  for (int k = 0; k < 7; k++)
+    rows[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(frames + k * FIFO_FRAME_SIZE));
+
+  // Frames are 14 bytes, so a 16 byte load of the last one would read past the end of the array.
+  // Load it two bytes early instead, and shift it down.
+  rows[7] = _mm_srli_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(frames + 7 * FIFO_FRAME_SIZE - 2)), 2);
+
+  // 8x8 transpose: interleave 16 bit words, then 32 bit pairs, then 64 bit halves.
+  const __m128i t0 = _mm_unpacklo_epi16(rows[0], rows[1]);
+  const __m128i t1 = _mm_unpackhi_epi16(rows[0], rows[1]);
+  const __m128i t2 = _mm_unpacklo_epi16(rows[2], rows[3]);
+  const __m128i t3 = _mm_unpackhi_epi16(rows[2], rows[3]);
+  const __m128i t4 = _mm_unpacklo_epi16(rows[4], rows[5]);
+  const __m128i t5 = _mm_unpackhi_epi16(rows[4], rows[5]);
+  const __m128i t6 = _mm_unpacklo_epi16(rows[6], rows[7]);
+  const __m128i t7 = _mm_unpackhi_epi16(rows[6], rows[7]);
+  const __m128i u0 = _mm_unpacklo_epi32(t0, t2);
+  const __m128i u1 = _mm_unpackhi_epi32(t0, t2);
+  const __m128i u2 = _mm_unpacklo_epi32(t1, t3);
+  const __m128i u3 = _mm_unpackhi_epi32(t1, t3);
+  const __m128i u4 = _mm_unpacklo_epi32(t4, t6);
+  const __m128i u5 = _mm_unpackhi_epi32(t4, t6);
+  const __m128i u6 = _mm_unpacklo_epi32(t5, t7);
+  const __m128i u7 = _mm_unpackhi_epi32(t5, t7);
+  words[0] = swapBytes(_mm_unpacklo_epi64(u0, u4));
+  words[1] = swapBytes(_mm_unpackhi_epi64(u0, u4));
+  words[2] = swapBytes(_mm_unpacklo_epi64(u1, u5));
+  words[3] = swapBytes(_mm_unpackhi_epi64(u1, u5));
+  words[4] = swapBytes(_mm_unpacklo_epi64(u2, u6));
+  words[5] = swapBytes(_mm_unpackhi_epi64(u2, u6));
+  words[6] = swapBytes(_mm_unpacklo_epi64(u3, u7));
+  words[7] = swapBytes(_mm_unpackhi_epi64(u3, u7));
+}
+
+/**
+ * @brief Convert whole groups of eight frames with AVX2, widening and scaling all eight at once. Built for
+ * AVX2 whatever the build flags, so only call it if the CPU has AVX2.
+ * @return uint16_t Number of frames converted.
+ */
+__attribute__((target("avx2")))
+static uint16_t convertAVX2(const uint8_t* frames, uint16_t count, const MPU6050Scale& scale, MPU6050Batch& batch) {
+  uint16_t i = 0;
+  for (; i + VECTOR_FRAMES <= count; i += VECTOR_FRAMES) {
+    __m128i words[8];
+    loadWords(frames + i * FIFO_FRAME_SIZE, words);
+    for (int word = 0; word < 7; word++) {
+      __m256 values = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(words[word]));
+      if (word == MPU6050Frame::TEMP)
+	values = _mm256_add_ps(_mm256_div_ps(values, _mm256_set1_ps(340.0f)), _mm256_set1_ps(36.53f));
+      else
+	values = _mm256_mul_ps(values, _mm256_set1_ps(scale.perLsb[word]));
+      _mm256_store_ps(&batch.words[word][i], values);
+    }
+  }
+  return i;
+}
+
+/**
+ * @brief Convert whole groups of eight frames with SSE2, four at a time.
+ * @return uint16_t Number of frames converted.
+ */
+static uint16_t convertSSE2(const uint8_t* frames, uint16_t count, const MPU6050Scale& scale, MPU6050Batch& batch) {
+  uint16_t i = 0;
+  for (; i + VECTOR_FRAMES <= count; i += VECTOR_FRAMES) {
+    __m128i words[8];
+    loadWords(frames + i * FIFO_FRAME_SIZE, words);
+    for (int word = 0; word < 7; word++) {
+      // Sign extend to 32 bits by putting each word in the top half of a lane and shifting it back down.
+      __m128 low = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(words[word], words[word]), 16));
+      __m128 high = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(words[word], words[word]), 16));
+      if (word == MPU6050Frame::TEMP) {
+	low = _mm_add_ps(_mm_div_ps(low, _mm_set1_ps(340.0f)), _mm_set1_ps(36.53f));
+	high = _mm_add_ps(_mm_div_ps(high, _mm_set1_ps(340.0f)), _mm_set1_ps(36.53f));
+      } else {
+	low = _mm_mul_ps(low, _mm_set1_ps(scale.perLsb[word]));
+	high = _mm_mul_ps(high, _mm_set1_ps(scale.perLsb[word]));
+      }
+      _mm_store_ps(&batch.words[word][i], low);
+      _mm_store_ps(&batch.words[word][i + 4], high);
+    }
+  }
+  return i;
+}
+
+/**
+ * @brief Whether the CPU running the program has AVX2. Every x86-64 CPU has SSE2, so the build only
+ * assumes that, and the AVX2 path is picked at run time.
+ * @return bool True if convertAVX2() can be used.
+ */
+static bool hasAVX2(void) {
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+}
+
+/**
+ * @brief Convert whole groups of eight frames with AVX2 if the CPU has it, otherwise SSE2.
+ * @return uint16_t Number of frames converted.
+ */
+static uint16_t convertVector(const uint8_t* frames, uint16_t count, const MPU6050Scale& scale, MPU6050Batch& batch) {
+  return hasAVX2() ? convertAVX2(frames, count, scale, batch) : convertSSE2(frames, count, scale, batch);
+}
+
+#endif
+
+void ConvertFrames(const uint8_t* frames, uint16_t count, const MPU6050Scale& scale, MPU6050Batch& batch) {
+  count = std::min(count, BATCH_CAPACITY);
+#if defined(FRAME_CONVERT_NEON) || defined(FRAME_CONVERT_SSE2)
+  const uint16_t first = convertVector(frames, count, scale, batch);
+#else
+  const uint16_t first = 0;
+#endif
+  convertScalar(frames, first, count, scale, batch);
+  batch.count = count;
+}
+
+void ConvertFramesScalar(const uint8_t* frames, uint16_t count, const MPU6050Scale& scale, MPU6050Batch& batch) {
+  count = std::min(count, BATCH_CAPACITY);
+  convertScalar(frames, 0, count, scale, batch);
+  batch.count = count;
+}
+
+const char* ConvertFramesISA(void) {
+#if defined(FRAME_CONVERT_NEON)
+  return "neon";
+#elif defined(FRAME_CONVERT_SSE2)
+  return hasAVX2() ? "avx2" : "sse2";
+#else
+  return "scalar";
+#endif
+}
+
+} // namespace MPU6050_Driver
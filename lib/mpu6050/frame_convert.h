@@ -0,0 +1,132 @@
+/**
+ * @file    frame_convert.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the batch conversion of raw MPU6050 frames into physical units.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef FRAME_CONVERT_H
+#define FRAME_CONVERT_H
+
+#include <cstdint>
+#include "mpu6050.h"
+
+namespace MPU6050_Driver {
+
+  /** Number of frames a batch holds. FIFO_MAX_FRAMES rounded up to whole vectors, so every row stays aligned. */
+  static constexpr uint16_t BATCH_CAPACITY = (FIFO_MAX_FRAMES + 7) / 8 * 8;
+
+  /**
+   * @brief  Frames converted into physical units, as one array per word (structure of arrays), so a
+   * consumer working through one axis reads contiguous floats.
+   */
+  struct MPU6050Batch {
+    /**
+     * @brief  Converted words, indexed by MPU6050Frame::Word, oldest frame first. Acceleration in g,
+     * temperature in celcius and rotation in deg/s.
+     */
+    alignas(32) float words[7][BATCH_CAPACITY];
+
+    /**
+     * @brief  Monotonic timestamp of each frame in nanoseconds, as for MPU6050Sample. Not set by
+     * ConvertFrames(); MPU6050::ProcessBatch() back-dates them from the drain.
+     */
+    uint64_t timestamp_ns[BATCH_CAPACITY];
+
+    /**
+     * @brief  Number of frames converted.
+     */
+    uint16_t count = 0;
+
+    /** @brief  X Accelerations in g */
+    const float* ax() const { return words[MPU6050Frame::ACCEL_X]; }
+
+    /** @brief  Y Accelerations in g */
+    const float* ay() const { return words[MPU6050Frame::ACCEL_Y]; }
+
+    /** @brief  Z Accelerations in g */
+    const float* az() const { return words[MPU6050Frame::ACCEL_Z]; }
+
+    /** @brief  Temperatures in celcius */
+    const float* temp() const { return words[MPU6050Frame::TEMP]; }
+
+    /** @brief  X Rotations in deg/s */
+    const float* gx() const { return words[MPU6050Frame::GYRO_X]; }
+
+    /** @brief  Y Rotations in deg/s */
+    const float* gy() const { return words[MPU6050Frame::GYRO_Y]; }
+
+    /** @brief  Z Rotations in deg/s */
+    const float* gz() const { return words[MPU6050Frame::GYRO_Z]; }
+
+    /**
+     * @brief  Copy one frame out into a sample.
+     * @param  i Index of the frame, oldest first
+     * @param  sample Sample to write to
+     * @retval None
+     */
+    void toSample(uint16_t i, MPU6050Sample& sample) const {
+      sample.ax = words[MPU6050Frame::ACCEL_X][i];
+      sample.ay = words[MPU6050Frame::ACCEL_Y][i];
+      sample.az = words[MPU6050Frame::ACCEL_Z][i];
+      sample.temp = words[MPU6050Frame::TEMP][i];
+      sample.gx = words[MPU6050Frame::GYRO_X][i];
+      sample.gy = words[MPU6050Frame::GYRO_Y][i];
+      sample.gz = words[MPU6050Frame::GYRO_Z][i];
+      sample.timestamp_ns = timestamp_ns[i];
+    }
+  };
+
+  /**
+   * @brief  Byte swap and scale an array of raw frames into a batch, eight frames at a time with vector
+   * instructions: NEON on aarch64, and on x86-64 AVX2 if the CPU has it, otherwise SSE2. Other targets,
+   * and the last few frames, use ConvertFramesScalar(). Every path gives exactly the same results as
+   * MPU6050Frame::convert().
+   * @param  frames Frames of FIFO_FRAME_SIZE bytes each, in ACCEL_X_OUT_H..GYRO_Z_OUT_L layout
+   * @param  count Number of frames, at most BATCH_CAPACITY; any more are left out
+   * @param  scale Scale factors to convert with
+   * @param  batch Batch to write to
+   * @retval None
+   */
+  void ConvertFrames(const uint8_t* frames, uint16_t count, const MPU6050Scale& scale, MPU6050Batch& batch);
+
+  /**
+   * @brief  As ConvertFrames(), one frame at a time, without vector instructions.
+   * @param  frames Frames of FIFO_FRAME_SIZE bytes each, in ACCEL_X_OUT_H..GYRO_Z_OUT_L layout
+   * @param  count Number of frames, at most BATCH_CAPACITY; any more are left out
+   * @param  scale Scale factors to convert with
+   * @param  batch Batch to write to
+   * @retval None
+   */
+  void ConvertFramesScalar(const uint8_t* frames, uint16_t count, const MPU6050Scale& scale, MPU6050Batch& batch);
+
+  /**
+   * @brief  Vector instructions ConvertFrames() uses on this CPU.
+   * @param  None
+   * @retval const char* "neon", "avx2", "sse2" or "scalar".
+   */
+  const char* ConvertFramesISA(void);
+
+} // namespace MPU6050_Driver
+
+#endif
@@ -30,6 +30,11 @@
  * SOFTWARE.
  */
 #include "mpu6050.h"
+#include "frame_convert.h"
+#include "../telemetry/telemetry.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <gpiod.hpp>
 
 namespace MPU6050_Driver {
@@ -50,13 +55,38 @@ MPU6050::MPU6050(I2C_Interface *comInterface, MPU6050Interface *mpuInterface,
     this->i2c = comInterface;
   if (mpuInterface)
     this->mpu6050cb = mpuInterface;
+
+  fifoBatch.reset(new MPU6050Batch);
+  ResolveScale();
+}
+
+/**
+ * @brief  Class destructor. Simply calls end() to stop data aquisition.
+ */
+MPU6050::~MPU6050() { end(); }
+
+/**
+ * @brief  Default batch callback. Copies the frames out of the batch into
+ * samples, a FIFO's worth at a time, and passes them to hasBatch().
+ * @param  batch Converted frames.
+ * @retval None
+ */
+void MPU6050Interface::hasAxes(const MPU6050Batch &batch) {
+  MPU6050Sample samples[FIFO_MAX_FRAMES];
+  for (uint16_t start = 0; start < batch.count; start += FIFO_MAX_FRAMES) {
+    const uint16_t count = std::min<uint16_t>(batch.count - start, FIFO_MAX_FRAMES);
+    for (uint16_t i = 0; i < count; i++)
+      batch.toSample(start + i, samples[i]);
+    hasBatch(samples, count);
+  }
 }
 
 /**
  * @brief  This method wakes up the sensor and configures the accelerometer and
  * gyroscope full scale renges with given parameters. It also configures the
- * DLPF, sample rate divider, interrput configuration, and also calibrates
- * the accelerometers and gyros.
+ * DLPF, sample rate divider and interrput configuration. The offsets are left
+ * at the factory trim; calibrate them with CalibrateOffsets() afterwards, which
+ * takes the rest targets.
  * It returns the result of the process.
  * @param  gyroScale Gyroscope scale value to be set
  * @param  accelScale Accelerometer scale value to be set
@@ -64,23 +94,14 @@ MPU6050::MPU6050(I2C_Interface *comInterface, MPU6050Interface *mpuInterface,
  * @param  SRdiv Sample rate divider
  * @param  INTconf Interrupt configuration
  * @param  INTenable Interrput types enabled
- * @param  accelCalX Target acceleration in the X axis for calibration (units g)
- * @param  accelCalY Target acceleration in the Y axis for calibration (units g)
- * @param  accelCalZ Target acceleration in the Z axis for calibration (units g)
- * @param  gyroCalX Target angular velocity in the X axis for calibration
- * (units deg/s)
- * @param  gyroCalY Target angular velocity in the Y axis for calibration
- * (units deg/s)
- * @param  gyroCalZ Target angular velocity in the Z axis for calibration
- * (units deg/s)
  * @retval i2c_status_t Success status
  */
 i2c_status_t MPU6050::InitializeSensor(
     Gyro_FS_t gyroScale, Accel_FS_t accelScale, DLPF_t DLPFconf, uint8_t SRdiv,
-    uint8_t INTconf, uint8_t INTenable, float accelCalX, float accelCalY,
-    float accelCalZ, float gyroCalX, float gyroCalY, float gyroCalZ) {
+    uint8_t INTconf, uint8_t INTenable) {
   accelFSRange = accelScale;
   gyroFSRange = gyroScale;
+  ResolveScale();
 
   i2c_status_t result = WakeUpSensor();
   //std::cout << "Woken" << std::endl;
@@ -107,59 +128,151 @@ i2c_status_t MPU6050::InitializeSensor(
   if (result == I2C_STATUS_SUCCESS)
     result = SetSensor_InterruptEnable(INTenable);
 
-  /* The below calibration methods did not work correctly for us, and we found the factory calibration
-   * to be sufficiently accurate, so we have not used them.
+  /* Calibrate_Accel_Registers() and Calibrate_Gyro_Registers() did not work correctly for us, since they
+   * throw the factory trim away, so the offsets are calibrated by CalibrateOffsets() instead. It takes
+   * seconds, so it is left to the caller, which can load a saved calibration instead.
    */
-  
-  //std::cout << "int en" << std::endl;
-  //    if(result == I2C_STATUS_SUCCESS)
-  // result = Calibrate_Accel_Registers(accelCalX, accelCalY, accelCalZ);
+  return result;
+}
+
+/**
+ * Configure the FIFO and interrupt enable register for the selected mode. In
+ * FIFO_BURST mode the batch period is also worked out from the current sample
+ * rate, so this must be called after the sample rate divider and DLPF are set.
+ */
+i2c_status_t MPU6050::SetAcquisitionMode(Acquisition_t mode, uint16_t framesPerBatch) {
+  i2c_status_t result = SetSensor_FIFO_Enable(false);
+
+  if (mode == Acquisition_t::DATA_READY) {
+    if (result == I2C_STATUS_SUCCESS)
+      result = SetSensor_FIFO_Config(0x00);
 
-  //std::cout << "cal accel" << std::endl;
-  //    if(result == I2C_STATUS_SUCCESS)
-  // result = Calibrate_Gyro_Registers(gyroCalX, gyroCalY, gyroCalZ);
+    if (result == I2C_STATUS_SUCCESS)
+      result = SetSensor_InterruptEnable(Regbits_INT_ENABLE::BIT_DATA_RDY_EN);
+
+    if (result == I2C_STATUS_SUCCESS)
+      acquisitionMode = mode;
+
+    return result;
+  }
+
+  // Keep a full batch well clear of the end of the FIFO, so a late wakeup
+  // doesn't immediately overflow it.
+  if (framesPerBatch == 0)
+    framesPerBatch = 1;
+  if (framesPerBatch > FIFO_MAX_FRAMES / 2)
+    framesPerBatch = FIFO_MAX_FRAMES / 2;
+
+  float sampleRate_Hz = 0;
+  if (result == I2C_STATUS_SUCCESS)
+    sampleRate_Hz = GetSensor_CurrentSampleRate_Hz(&result);
+
+  // Frames are written in the same order as the data registers, so that they
+  // can be unpacked the same way as ReadAllRawData().
+  if (result == I2C_STATUS_SUCCESS)
+    result = SetSensor_FIFO_Config(Regbits_FIFO_EN::BIT_ACCEL_FIFO_EN |
+                                   Regbits_FIFO_EN::BIT_TEMP_FIFO_EN |
+                                   Regbits_FIFO_EN::BIT_XG_FIFO_EN |
+                                   Regbits_FIFO_EN::BIT_YG_FIFO_EN |
+                                   Regbits_FIFO_EN::BIT_ZG_FIFO_EN);
+
+  // There is no FIFO watermark interrupt, but DATA_RDY rises as each frame
+  // lands in the FIFO, so its edges time the frames. Draining is paced by the
+  // batch period, and DrainFIFO() catches an overflow from the FIFO count.
+  if (result == I2C_STATUS_SUCCESS)
+    result = SetSensor_InterruptEnable(Regbits_INT_ENABLE::BIT_DATA_RDY_EN);
+
+  if (result == I2C_STATUS_SUCCESS)
+    result = Reset_Sensor_FIFO();
+
+  if (result == I2C_STATUS_SUCCESS)
+    result = SetSensor_FIFO_Enable(true);
+
+  if (result == I2C_STATUS_SUCCESS) {
+    acquisitionMode = mode;
+    batchPeriod_ns = static_cast<int64_t>(framesPerBatch * 1e9 / sampleRate_Hz);
+    samplePeriod_ns = static_cast<int64_t>(1e9 / sampleRate_Hz);
+  }
 
-  //std::cout << "cal gyro" << std::endl;
   return result;
 }
 
-/** Begin dataAquisition() method in a separate thread in a running state. */
+/** Begin dataAquisition() or fifoAquisition() method in a separate thread in a running state. */
 void MPU6050::begin(void) {
   dataAquisitionRunning = true;
-  dataAquisitionThread = std::thread(&MPU6050::dataAquisition, this);
+  dataAquisitionThread = std::thread([this]() {
+    // Set up scheduling from inside the thread, so the stack prefault touches this thread's stack.
+    threadConfigErrors = RealTime::ApplyThreadConfig(threadConfig, "MPU6050");
+
+    if (acquisitionMode == Acquisition_t::FIFO_BURST)
+      fifoAquisition();
+    else
+      dataAquisition();
+  });
 }
 
-/** Stop dataAquisition() method and close the thread running it. */
+/** Stop data aquisition and close the thread running it. */
 void MPU6050::end(void) {
   dataAquisitionRunning = false;
-  dataAquisitionThread.join();
+  if (dataAquisitionThread.joinable())
+    dataAquisitionThread.join();
 }
 
 /**
- * @brief  This method will read all raw sensor data (accel, gyro, temp) into
- * the rawData array.
- * @param  None
+ * @brief  This method will read all raw sensor data (accel, gyro, temp) straight
+ * into a frame. The bytes are left big endian until a consumer converts them.
+ * @param  frame Frame to read into
  * @retval i2c_status_t
  */
-i2c_status_t MPU6050::ReadAllRawData(void) {
-  // Read all sensor data (big endian) in one block read and arrange
-  // appropriately (little endian) into rawData array.
-  uint8_t tmpArray[sizeof(rawData)];
-  i2c_status_t err;
-  err = i2c->ReadRegisterBlock(MPU6050_ADDRESS, Sensor_Regs::ACCEL_X_OUT_H,
-                               sizeof(rawData), tmpArray);
+i2c_status_t MPU6050::ReadAllRawData(MPU6050Frame &frame) {
+  frame.scale = &scale;
+  return i2c->ReadRegisterBlock(MPU6050_ADDRESS, Sensor_Regs::ACCEL_X_OUT_H,
+                                sizeof(frame.bytes), frame.bytes);
+}
 
-  if (err != I2C_STATUS_SUCCESS)
-    return err;
+/**
+ * Resolve the per word scale factors once, so converting a frame is a plain
+ * multiply.
+ */
+void MPU6050::ResolveScale(void) {
+  const float accelConst = GetAccel_MG_Constant(accelFSRange);
+  const float gyroConst = GetGyro_DPS_Constant(gyroFSRange);
+  const float perLsb[8] = {accelConst, accelConst, accelConst, 0.0f,
+                           gyroConst,  gyroConst,  gyroConst,  0.0f};
+  std::copy(perLsb, perLsb + 8, scale.perLsb);
+}
 
-  rawData[0] = ((int16_t)tmpArray[0] << 8) | (int16_t)tmpArray[1];
-  rawData[1] = ((int16_t)tmpArray[2] << 8) | (int16_t)tmpArray[3];
-  rawData[2] = ((int16_t)tmpArray[4] << 8) | (int16_t)tmpArray[5];
-  rawData[3] = ((int16_t)tmpArray[6] << 8) | (int16_t)tmpArray[7];
-  rawData[4] = ((int16_t)tmpArray[8] << 8) | (int16_t)tmpArray[9];
-  rawData[5] = ((int16_t)tmpArray[10] << 8) | (int16_t)tmpArray[11];
-  rawData[6] = ((int16_t)tmpArray[12] << 8) | (int16_t)tmpArray[13];
-  return err;
+/**
+ * Convert every axis of the frame into the sample.
+ */
+void MPU6050Frame::toSample(MPU6050Sample &sample) const {
+  convert(bytes, *scale, sample);
+}
+
+/**
+ * Byte swap and scale all the words of a frame together. The words are padded
+ * to eight so the loops vectorise without a remainder; the pad and temperature
+ * words are scaled by zero, and the temperature is converted on its own.
+ */
+void MPU6050Frame::convert(const uint8_t *bytes, const MPU6050Scale &scale,
+                           MPU6050Sample &sample) {
+  int16_t raw[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  for (int i = 0; i < 7; i++)
+    raw[i] = (int16_t)((bytes[2 * i] << 8) | bytes[2 * i + 1]);
+
+  float scaled[8];
+  for (int i = 0; i < 8; i++)
+    scaled[i] = raw[i] * scale.perLsb[i];
+
+  sample.ax = scaled[ACCEL_X];
+  sample.ay = scaled[ACCEL_Y];
+  sample.az = scaled[ACCEL_Z];
+
+  sample.temp = raw[TEMP] / 340.0f + 36.53f; // Conversion taken from datasheet.
+
+  sample.gx = scaled[GYRO_X];
+  sample.gy = scaled[GYRO_Y];
+  sample.gz = scaled[GYRO_Z];
 }
 
 /**
@@ -185,8 +298,13 @@ i2c_status_t MPU6050::WakeUpSensor(void) {
  * @retval i2c_status_t
  */
 i2c_status_t MPU6050::ResetSensor(void) {
-  return i2c->WriteRegisterBit(MPU6050_ADDRESS, Sensor_Regs::PWR_MGMT_1,
-                               Regbits_PWR_MGMT_1::BIT_DEVICE_RESET, true);
+  i2c_status_t result = i2c->WriteRegisterBit(
+      MPU6050_ADDRESS, Sensor_Regs::PWR_MGMT_1,
+      Regbits_PWR_MGMT_1::BIT_DEVICE_RESET, true);
+
+  // Every register is back at its reset value, so drop any cached copies.
+  i2c->Invalidate(MPU6050_ADDRESS);
+  return result;
 }
 
 /**
@@ -196,8 +314,14 @@ i2c_status_t MPU6050::ResetSensor(void) {
  * @retval i2c_status_t
  */
 i2c_status_t MPU6050::SetGyroFullScale(Gyro_FS_t gyroScale) {
-  return i2c->WriteRegister(MPU6050_ADDRESS, Sensor_Regs::GYRO_CONFIG,
-                            ((uint8_t)gyroScale << 3));
+  i2c_status_t result = i2c->WriteRegister(MPU6050_ADDRESS, Sensor_Regs::GYRO_CONFIG,
+                                           ((uint8_t)gyroScale << 3));
+  // Scale samples by the range actually set.
+  if (result == I2C_STATUS_SUCCESS) {
+    gyroFSRange = gyroScale;
+    ResolveScale();
+  }
+  return result;
 }
 
 /**
@@ -280,8 +404,14 @@ int16_t MPU6050::GetGyro_Z_Raw(i2c_status_t *error) {
  * @retval i2c_status_t
  */
 i2c_status_t MPU6050::SetAccelFullScale(Accel_FS_t accelScale) {
-  return i2c->WriteRegister(MPU6050_ADDRESS, Sensor_Regs::ACCEL_CONFIG,
-                            ((uint8_t)accelScale << 3));
+  i2c_status_t result = i2c->WriteRegister(MPU6050_ADDRESS, Sensor_Regs::ACCEL_CONFIG,
+                                           ((uint8_t)accelScale << 3));
+  // Scale samples by the range actually set.
+  if (result == I2C_STATUS_SUCCESS) {
+    accelFSRange = accelScale;
+    ResolveScale();
+  }
+  return result;
 }
 
 /**
@@ -936,6 +1066,211 @@ i2c_status_t MPU6050::Calibrate_Accel_Registers(float targetX_MG,
   return result;
 }
 
+/**
+ * @brief  This method reads all six offset registers.
+ * @param offsets Offsets read
+ * @retval i2c_status_t
+ */
+i2c_status_t MPU6050::GetOffsets(MPU6050Offsets &offsets) {
+  i2c_status_t result = I2C_STATUS_NONE;
+  offsets.accel[0] = GetAccel_X_Offset(&result);
+  if (result == I2C_STATUS_SUCCESS)
+    offsets.accel[1] = GetAccel_Y_Offset(&result);
+  if (result == I2C_STATUS_SUCCESS)
+    offsets.accel[2] = GetAccel_Z_Offset(&result);
+  if (result == I2C_STATUS_SUCCESS)
+    offsets.gyro[0] = GetGyro_X_Offset(&result);
+  if (result == I2C_STATUS_SUCCESS)
+    offsets.gyro[1] = GetGyro_Y_Offset(&result);
+  if (result == I2C_STATUS_SUCCESS)
+    offsets.gyro[2] = GetGyro_Z_Offset(&result);
+  return result;
+}
+
+/**
+ * @brief  This method writes all six offset registers.
+ * @param offsets Offsets to write
+ * @retval i2c_status_t
+ */
+i2c_status_t MPU6050::SetOffsets(const MPU6050Offsets &offsets) {
+  i2c_status_t result = SetAccel_X_Offset(offsets.accel[0]);
+  if (result == I2C_STATUS_SUCCESS)
+    result = SetAccel_Y_Offset(offsets.accel[1]);
+  if (result == I2C_STATUS_SUCCESS)
+    result = SetAccel_Z_Offset(offsets.accel[2]);
+  if (result == I2C_STATUS_SUCCESS)
+    result = SetGyro_X_Offset(offsets.gyro[0]);
+  if (result == I2C_STATUS_SUCCESS)
+    result = SetGyro_Y_Offset(offsets.gyro[1]);
+  if (result == I2C_STATUS_SUCCESS)
+    result = SetGyro_Z_Offset(offsets.gyro[2]);
+  return result;
+}
+
+/**
+ * @brief  This method calibrates the offset registers from the mean of a long
+ * FIFO burst, correcting the current offsets by the bias from the targets, one
+ * pass at a time until there's nothing left to correct. Unlike
+ * Calibrate_Accel_Registers() and Calibrate_Gyro_Registers(), this keeps the
+ * factory trim, and reads every axis from the same frames in bulk rather than
+ * a register at a time.
+ * @param offsets Offsets in the sensor afterwards
+ * @param accelCalX Target acceleration in the X axis (units g)
+ * @param accelCalY Target acceleration in the Y axis (units g)
+ * @param accelCalZ Target acceleration in the Z axis (units g)
+ * @param gyroCalX Target angular velocity in the X axis (units deg/s)
+ * @param gyroCalY Target angular velocity in the Y axis (units deg/s)
+ * @param gyroCalZ Target angular velocity in the Z axis (units deg/s)
+ * @param frames Frames averaged in each pass
+ * @retval Calibration_t Outcome of the calibration
+ */
+Calibration_t MPU6050::CalibrateOffsets(MPU6050Offsets &offsets,
+                                        float accelCalX, float accelCalY,
+                                        float accelCalZ, float gyroCalX,
+                                        float gyroCalY, float gyroCalZ,
+                                        uint16_t frames) {
+  const float accelTarget[3] = {accelCalX, accelCalY, accelCalZ};
+  const float gyroTarget[3] = {gyroCalX, gyroCalY, gyroCalZ};
+  if (frames == 0)
+    frames = 1;
+
+  /* Keep what calibration changes, to put it back afterwards. */
+  i2c_status_t result = GetOffsets(offsets);
+  const MPU6050Offsets startingOffsets = offsets;
+  uint8_t fifoConfig = 0, sampleRateDivider = 0;
+  bool fifoEnabled = false;
+  float sampleRate_Hz = 0;
+  if (result == I2C_STATUS_SUCCESS)
+    fifoConfig = GetSensor_FIFO_Config(&result);
+  if (result == I2C_STATUS_SUCCESS)
+    fifoEnabled = GetSensor_FIFO_Enable(&result);
+  if (result == I2C_STATUS_SUCCESS)
+    sampleRateDivider = GetGyro_SampleRateDivider(&result);
+  if (result == I2C_STATUS_SUCCESS)
+    sampleRate_Hz = GetSensor_CurrentSampleRate_Hz(&result);
+  if (result != I2C_STATUS_SUCCESS)
+    return Calibration_t::BUS_ERROR;
+
+  /* Sample at 1 kHz, so a long burst takes about a second whatever the sample
+   * rate is set to. The DLPF isn't changed, so neither is the bias. */
+  const float gyroOutRate_Hz = sampleRate_Hz * (1 + sampleRateDivider);
+  const uint8_t calibrationDivider =
+      static_cast<uint8_t>(gyroOutRate_Hz / 1000.0f + 0.5f) - 1;
+  result = SetGyro_SampleRateDivider(calibrationDivider);
+  if (result == I2C_STATUS_SUCCESS)
+    result = SetSensor_FIFO_Config(Regbits_FIFO_EN::BIT_ACCEL_FIFO_EN |
+                                   Regbits_FIFO_EN::BIT_TEMP_FIFO_EN |
+                                   Regbits_FIFO_EN::BIT_XG_FIFO_EN |
+                                   Regbits_FIFO_EN::BIT_YG_FIFO_EN |
+                                   Regbits_FIFO_EN::BIT_ZG_FIFO_EN);
+
+  Calibration_t outcome = result == I2C_STATUS_SUCCESS
+                              ? Calibration_t::UNSETTLED
+                              : Calibration_t::BUS_ERROR;
+  for (uint8_t pass = 0;
+       pass < CALIBRATION_PASSES && outcome == Calibration_t::UNSETTLED;
+       pass++) {
+    int64_t sums[7], squares[7];
+    result = SumFIFOFrames(frames, gyroOutRate_Hz / (1 + calibrationDivider),
+                           sums, squares);
+    if (result != I2C_STATUS_SUCCESS) {
+      outcome = Calibration_t::BUS_ERROR;
+      break;
+    }
+
+    /* A rig that isn't at rest gives a bias that's really its motion. */
+    for (uint8_t axis = 0; axis < 3; axis++) {
+      const uint8_t word = MPU6050Frame::GYRO_X + axis;
+      const double mean = (double)sums[word] / frames;
+      const double variance = (double)squares[word] / frames - mean * mean;
+      if (std::sqrt(std::max(variance, 0.0)) * scale.perLsb[word] >
+          CALIBRATION_MAX_GYRO_SD_DPS)
+        outcome = Calibration_t::MOVING;
+    }
+    if (outcome == Calibration_t::MOVING)
+      break;
+
+    /* Take the bias off the offsets. Accel offsets move in steps of 2, so bit
+     * 0 is left as it is. A bias within three quarters of a step is left, so
+     * one that sits on a half step can't keep the offsets moving back and
+     * forth. */
+    auto steps = [](float bias) {
+      return std::fabs(bias) < 0.75f ? 0L : std::lround(bias);
+    };
+    MPU6050Offsets corrected = offsets;
+    bool settled = true;
+    for (uint8_t axis = 0; axis < 3; axis++) {
+      const float accelBias_g =
+          (float)sums[MPU6050Frame::ACCEL_X + axis] / frames *
+              scale.perLsb[MPU6050Frame::ACCEL_X + axis] -
+          accelTarget[axis];
+      const long accelStep = 2 * steps(accelBias_g * accel_offset_1g / 2);
+      const long bit0 = offsets.accel[axis] & 1;
+      corrected.accel[axis] = (int16_t)std::clamp<long>(
+          offsets.accel[axis] - accelStep, INT16_MIN + bit0, INT16_MAX - 1 + bit0);
+
+      const float gyroBias_dps =
+          (float)sums[MPU6050Frame::GYRO_X + axis] / frames *
+              scale.perLsb[MPU6050Frame::GYRO_X + axis] -
+          gyroTarget[axis];
+      const long gyroStep = steps(gyroBias_dps * gyro_offset_1dps);
+      corrected.gyro[axis] = (int16_t)std::clamp<long>(
+          offsets.gyro[axis] - gyroStep, INT16_MIN, INT16_MAX);
+
+      settled = settled && accelStep == 0 && gyroStep == 0;
+    }
+    if (settled) {
+      outcome = Calibration_t::DONE;
+      break;
+    }
+
+    result = SetOffsets(corrected);
+    if (result != I2C_STATUS_SUCCESS) {
+      outcome = Calibration_t::BUS_ERROR;
+      break;
+    }
+    offsets = corrected;
+  }
+
+  if (outcome == Calibration_t::MOVING) {
+    offsets = startingOffsets;
+    if (SetOffsets(offsets) != I2C_STATUS_SUCCESS)
+      outcome = Calibration_t::BUS_ERROR;
+  }
+
+  /* Put the FIFO and sample rate back the way they were. */
+  result = SetSensor_FIFO_Enable(false);
+  if (result == I2C_STATUS_SUCCESS)
+    result = SetSensor_FIFO_Config(fifoConfig);
+  if (result == I2C_STATUS_SUCCESS)
+    result = Reset_Sensor_FIFO();
+  if (result == I2C_STATUS_SUCCESS)
+    result = SetSensor_FIFO_Enable(fifoEnabled);
+  if (result == I2C_STATUS_SUCCESS)
+    result = SetGyro_SampleRateDivider(sampleRateDivider);
+  if (result != I2C_STATUS_SUCCESS)
+    outcome = Calibration_t::BUS_ERROR;
+
+  return outcome;
+}
+
+/**
+ * @brief  This method reads the factory self test registers, which tell one
+ * sensor from another.
+ * @param error Result of the operation
+ * @retval uint32_t SELF_TEST_X..SELF_TEST_A, X in the highest byte
+ */
+uint32_t MPU6050::GetDeviceID(i2c_status_t *error) {
+  uint8_t selfTest[4];
+  *error = i2c->ReadRegisterBlock(MPU6050_ADDRESS, Sensor_Regs::SELF_TEST_X,
+                                  sizeof(selfTest), selfTest);
+  if (*error != I2C_STATUS_SUCCESS)
+    return 0x00;
+
+  return (uint32_t)selfTest[0] << 24 | (uint32_t)selfTest[1] << 16 |
+         (uint32_t)selfTest[2] << 8 | selfTest[3];
+}
+
 /**
  * @brief  This method returns the MG (Gravity) coversion value depending on
  * the accelerometer full scale range. MG value is used to convert raw sensor
@@ -1044,14 +1379,13 @@ float MPU6050::GetSensor_CurrentSampleRate_Hz(i2c_status_t *error) {
  * @retval uint16_t Number of samples in the FIFO buffer in bytes
  */
 uint16_t MPU6050::GetSensor_FIFOCount(i2c_status_t *error) {
-  uint16_t fifoCount = i2c->ReadRegister(
-      MPU6050_ADDRESS, Sensor_Regs::FIFO_COUNT_H, error); // higher 8 bits
-  if (*error == I2C_STATUS_SUCCESS) {
-    fifoCount = (fifoCount << 8) |
-                i2c->ReadRegister(MPU6050_ADDRESS, Sensor_Regs::FIFO_COUNT_L,
-                                  error); // assemble higher and lower bytes
-    return fifoCount;
-  }
+  // Read both bytes in one transaction, so the count can't change between
+  // reading the higher and lower bytes.
+  uint8_t countBytes[2];
+  *error = i2c->ReadRegisterBlock(MPU6050_ADDRESS, Sensor_Regs::FIFO_COUNT_H,
+                                  sizeof(countBytes), countBytes);
+  if (*error == I2C_STATUS_SUCCESS)
+    return ((uint16_t)countBytes[0] << 8) | countBytes[1];
 
   return 0x00;
 }
@@ -1129,6 +1463,22 @@ i2c_status_t MPU6050::Reset_Sensor_FIFO(void) {
                                Regbits_USER_CTRL::BIT_FIFO_RESET, true);
 }
 
+/**
+ * @brief This function empties the sensor FIFO so it starts again on a frame
+ * boundary. FIFO_EN is cleared first, so no frame is written part way through
+ * the reset.
+ * @param none
+ * @retval i2c_status_t
+ */
+i2c_status_t MPU6050::Resync_Sensor_FIFO(void) {
+  i2c_status_t result = SetSensor_FIFO_Enable(false);
+  if (result == I2C_STATUS_SUCCESS)
+    result = Reset_Sensor_FIFO();
+  if (result == I2C_STATUS_SUCCESS)
+    result = SetSensor_FIFO_Enable(true);
+  return result;
+}
+
 /**
  * @brief This function gets the sensor interrput status (INT_STATUS) register.
  * @param error Result of the operation
@@ -1147,6 +1497,150 @@ uint8_t MPU6050::GetSensor_FIFO_Data(i2c_status_t *error) {
   return i2c->ReadRegister(MPU6050_ADDRESS, Sensor_Regs::FIFO_R_W, error);
 }
 
+/**
+ * @brief This function reads a block of bytes from the sensor FIFO data register.
+ * FIFO_R_W doesn't auto increment, so every byte of a block read comes from the
+ * FIFO. Where the I2C interface supports it, the whole block is read in one
+ * transaction, otherwise it is split into 32 byte block reads.
+ * @param data Array the FIFO bytes are written to.
+ * @param length Number of bytes to read.
+ * @retval i2c_status_t
+ */
+i2c_status_t MPU6050::GetSensor_FIFO_Block(uint8_t *data, uint16_t length) {
+  i2c_status_t err = i2c->ReadRegisterBlockLong(
+      MPU6050_ADDRESS, Sensor_Regs::FIFO_R_W, length, data);
+  if (err != I2C_STATUS_NONE)
+    return err;
+
+  err = I2C_STATUS_SUCCESS;
+  uint16_t offset = 0;
+  while (offset < length && err == I2C_STATUS_SUCCESS) {
+    uint8_t chunk = (length - offset > FIFO_BLOCK_READ_MAX)
+                        ? FIFO_BLOCK_READ_MAX
+                        : length - offset;
+    err = i2c->ReadRegisterBlock(MPU6050_ADDRESS, Sensor_Regs::FIFO_R_W, chunk,
+                                 data + offset);
+    offset += chunk;
+  }
+
+  return err;
+}
+
+/**
+ * @brief This function drains every whole frame in the FIFO (up to maxFrames),
+ * and converts them into samples. Any partial frame is left in the FIFO for the
+ * next call.
+ * @param samples Array the samples are written to, oldest first.
+ * @param maxFrames Size of the samples array.
+ * @param error Result of the operation.
+ * @retval uint16_t Number of samples written.
+ */
+uint16_t MPU6050::ReadFIFOFrames(MPU6050Sample *samples, uint16_t maxFrames,
+                                 i2c_status_t *error) {
+  uint16_t frames = DrainFIFO(maxFrames, error);
+
+  for (uint16_t i = 0; i < frames; i++)
+    MPU6050Frame::convert(&fifoBuffer[i * FIFO_FRAME_SIZE], scale, samples[i]);
+
+  return frames;
+}
+
+/**
+ * @brief This function drains every whole frame in the FIFO, and converts them
+ * all at once into a batch. Any partial frame is left in the FIFO for the next
+ * call.
+ * @param batch Batch the frames are converted into, oldest first.
+ * @param error Result of the operation.
+ * @retval uint16_t Number of frames converted.
+ */
+uint16_t MPU6050::ReadFIFOBatch(MPU6050Batch &batch, i2c_status_t *error) {
+  uint16_t frames = DrainFIFO(FIFO_MAX_FRAMES, error);
+  ConvertFrames(fifoBuffer, frames, scale, batch);
+  return frames;
+}
+
+/**
+ * Read every whole frame in the FIFO, up to maxFrames, into fifoBuffer. A full
+ * FIFO has overflowed, and since its size isn't a whole number of frames, what
+ * is left no longer starts on a frame boundary, so it is thrown away instead.
+ */
+uint16_t MPU6050::DrainFIFO(uint16_t maxFrames, i2c_status_t *error) {
+  const uint16_t count = GetSensor_FIFOCount(error);
+  if (*error != I2C_STATUS_SUCCESS)
+    return 0;
+
+  if (count >= FIFO_SIZE) {
+    fifoOverflowCount++;
+    *error = Resync_Sensor_FIFO();
+    return 0;
+  }
+
+  uint16_t frames = count / FIFO_FRAME_SIZE;
+
+  if (frames > maxFrames)
+    frames = maxFrames;
+  if (frames > FIFO_MAX_FRAMES)
+    frames = FIFO_MAX_FRAMES;
+  if (frames == 0)
+    return 0;
+
+  *error = GetSensor_FIFO_Block(fifoBuffer, frames * FIFO_FRAME_SIZE);
+  if (*error != I2C_STATUS_SUCCESS)
+    return 0;
+
+  return frames;
+}
+
+/**
+ * Reset the FIFO, then sum the words of the frames written to it, dropping the
+ * first few while the outputs settle. The FIFO is drained a quarter full, well
+ * before it can overflow, but if it does the frames are no longer aligned, so
+ * it is reset and the frames lost are made up.
+ */
+i2c_status_t MPU6050::SumFIFOFrames(uint16_t frames, float sampleRate_Hz,
+                                    int64_t sums[7], int64_t squares[7]) {
+  std::fill(sums, sums + 7, 0);
+  std::fill(squares, squares + 7, 0);
+  const auto drainPeriod = std::chrono::nanoseconds(
+      static_cast<int64_t>(FIFO_MAX_FRAMES / 4 * 1e9 / sampleRate_Hz));
+
+  i2c_status_t result = Resync_Sensor_FIFO();
+
+  uint16_t settling = CALIBRATION_SETTLE_FRAMES, summed = 0;
+  while (summed < frames && result == I2C_STATUS_SUCCESS) {
+    std::this_thread::sleep_for(drainPeriod);
+
+    const uint16_t count = GetSensor_FIFOCount(&result);
+    if (result == I2C_STATUS_SUCCESS && count >= FIFO_SIZE) {
+      result = Resync_Sensor_FIFO();
+      continue;
+    }
+
+    const uint16_t available = count / FIFO_FRAME_SIZE;
+    if (result == I2C_STATUS_SUCCESS && available > 0)
+      result = GetSensor_FIFO_Block(fifoBuffer, available * FIFO_FRAME_SIZE);
+    if (result != I2C_STATUS_SUCCESS)
+      break;
+
+    for (uint16_t i = 0; i < available && summed < frames; i++) {
+      if (settling > 0) {
+	settling--;
+	continue;
+      }
+
+      const uint8_t *frame = &fifoBuffer[i * FIFO_FRAME_SIZE];
+      for (uint8_t word = 0; word < 7; word++) {
+	const int16_t raw = (int16_t)(frame[2 * word] << 8 | frame[2 * word + 1]);
+	sums[word] += raw;
+	squares[word] += (int32_t)raw * raw;
+      }
+      summed++;
+    }
+  }
+
+  return result;
+}
+
 /**
  * @brief This function returns sensor interrupt pin config register value.
  * @param error Result of the operation.
@@ -1170,8 +1664,8 @@ i2c_status_t MPU6050::SetSensor_InterruptPinConfig(uint8_t intPinConfig) {
  * Enter a while loop dependent on the value of dataAquisitionRunning. In this
  * loop, have blocking IO that will only continue when an interrupt is raised by
  * the MPU6050 on one of the GPIO pins. After continuing, read new data from the
- * MPU6050 and package this data into an instance of the MPU6050Sample struct,
- * then send this struct to the registered mpu6050cb callback for processing.
+ * MPU6050 into an MPU6050Frame, then send the frame to the registered mpu6050cb
+ * callback for processing.
  */
 void MPU6050::dataAquisition(void) {
   // Set up GPIO pin for detecting edges from the MPU6050 interrupt pin.
@@ -1193,32 +1687,120 @@ void MPU6050::dataAquisition(void) {
   // Create buffer for storing edge events.
   gpiod::edge_event_buffer buffer(1);
 
-  // Create MPU6050Sample struct to store data for transfer to the registered
-  // callback.
-  MPU6050Sample sample;
-
   // Start data aquisition loop
   while (dataAquisitionRunning) {
     // Block until edge is detected
     request.read_edge_events(buffer);
-    
-    // Read raw data from MPU6050
-    ReadAllRawData();
 
-    // Store data in sample struct, in float format with proper units.
-    sample.ax = rawData[0] * GetAccel_MG_Constant(accelFSRange);
-    sample.ay = rawData[1] * GetAccel_MG_Constant(accelFSRange);
-    sample.az = rawData[2] * GetAccel_MG_Constant(accelFSRange);
+    // Read and send the new sample, timed from the kernel's edge timestamp.
+    ProcessSample(buffer.get_event(0).timestamp_ns().ns());
+  }
+}
 
-    sample.temp =
-        rawData[3] / 340.0f + 36.53f; // Conversion taken from datasheet.
+/**
+ * Read new data from the MPU6050 into an MPU6050Frame, then send the frame to
+ * the registered mpu6050cb callback for processing.
+ */
+i2c_status_t MPU6050::ProcessSample(uint64_t origin_ns) {
+  // Read straight into a frame, which is passed to the registered callback
+  // unconverted.
+  MPU6050Frame frame;
+  frame.timestamp_ns = origin_ns ? origin_ns : Telemetry::Producer::now_ns();
+
+  if (latencyTrace) {
+    latencyTrace->begin(frame.timestamp_ns);
+    Telemetry::LatencyTrace::stamp(Telemetry::LatencyStage::WAKEUP);
+  }
+
+  // Read raw data from MPU6050
+  i2c_status_t err = ReadAllRawData(frame);
+  if (err != I2C_STATUS_SUCCESS) {
+    Telemetry::LatencyTrace::end();
+    return err;
+  }
+  Telemetry::LatencyTrace::stamp(Telemetry::LatencyStage::I2C_READ);
+
+  // Send data to the registered callback, which converts the axes it needs.
+  // The rest of the control loop stamps the trace from inside the callback.
+  mpu6050cb->hasFrame(frame);
+  Telemetry::LatencyTrace::end();
+  return err;
+}
+
+/**
+ * Drain the FIFO, convert every frame at once into one array per axis, and
+ * send them to the registered mpu6050cb callback as one batch.
+ */
+i2c_status_t MPU6050::ProcessBatch(uint64_t origin_ns) {
+  if (origin_ns == 0)
+    origin_ns = Telemetry::Producer::now_ns();
+
+  // Trace from the edge of the newest frame, so the wait for the drain counts.
+  if (latencyTrace) {
+    latencyTrace->begin(origin_ns);
+    Telemetry::LatencyTrace::stamp(Telemetry::LatencyStage::WAKEUP);
+  }
+
+  i2c_status_t err;
+  uint16_t frames = ReadFIFOBatch(*fifoBatch, &err);
+  if (err == I2C_STATUS_SUCCESS && frames > 0) {
+    Telemetry::LatencyTrace::stamp(Telemetry::LatencyStage::I2C_READ);
 
-    sample.gx = rawData[4] * GetGyro_DPS_Constant(gyroFSRange);
-    sample.gy = rawData[5] * GetGyro_DPS_Constant(gyroFSRange);
-    sample.gz = rawData[6] * GetGyro_DPS_Constant(gyroFSRange);
+    // The newest frame was sampled at the origin, and the rest one sample
+    // period apart before it.
+    for (uint16_t i = 0; i < frames; i++)
+      fifoBatch->timestamp_ns[i] = origin_ns - (frames - 1 - i) * samplePeriod_ns;
+
+    mpu6050cb->hasAxes(*fifoBatch);
+  }
+
+  Telemetry::LatencyTrace::end();
+  return err;
+}
+
+/**
+ * Enter a while loop dependent on the value of dataAquisitionRunning. In this
+ * loop, wait for one batch period for the FIFO to fill, then read the DATA_RDY
+ * edges queued in that time. The newest edge is when the newest frame landed in
+ * the FIFO. Drain every whole frame from the FIFO in a few block reads, and send
+ * them to the registered mpu6050cb callback as one batch, timed from that edge.
+ */
+void MPU6050::fifoAquisition(void) {
+  // Set up GPIO pin for detecting edges from the MPU6050 interrupt pin.
+  const std::filesystem::path chip_path("/dev/gpiochip4");
+
+  // Set up edge events for the DATA_RDY interrupt.
+  auto request =
+      gpiod::chip(chip_path)
+          .prepare_request()
+          .set_consumer("watch-line-value")
+          .add_line_settings(gpioPin,
+                             gpiod::line_settings()
+                                 .set_direction(gpiod::line::direction::INPUT)
+                                 .set_edge_detection(gpiod::line::edge::RISING)
+			         .set_bias(gpiod::line::bias::DISABLED)) // MPU6050 int pin can push and pull
+          .do_request();
+
+  // Room for an edge per frame the FIFO holds. If the kernel's queue fills
+  // first it drops the oldest edges, so the newest is always kept.
+  gpiod::edge_event_buffer buffer(FIFO_MAX_FRAMES);
+
+  const std::chrono::nanoseconds batchPeriod(batchPeriod_ns);
+
+  // Start data aquisition loop
+  while (dataAquisitionRunning) {
+    std::this_thread::sleep_for(batchPeriod);
+
+    uint64_t newest_ns = 0;
+    while (request.wait_edge_events(std::chrono::nanoseconds(0))) {
+      const std::size_t events = request.read_edge_events(buffer);
+      if (events == 0)
+	break;
+      newest_ns = buffer.get_event(events - 1).timestamp_ns().ns();
+    }
 
-    // Send data to the registered callback.
-    mpu6050cb->hasSample(sample);
+    // Drain the FIFO and send the batch to the registered callback.
+    ProcessBatch(newest_ns);
   }
 }
 
@@ -33,6 +33,11 @@
 #define MPU6050_H
 
 #include "../i2c_interface/i2c_interface.h"
+#include "../telemetry/latency.h"
+#include "../realtime/realtime.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
 #include <thread>
 #include <gpiod.hpp>
 
@@ -110,6 +115,11 @@ namespace MPU6050_Driver {
     SensorConst YA_OFFS_USR_L = 0x09;
     SensorConst ZA_OFFS_USR_H = 0x0A;
     SensorConst ZA_OFFS_USR_L = 0x0B;
+    /* Factory self test SensorConstisters */
+    SensorConst SELF_TEST_X = 0x0D;
+    SensorConst SELF_TEST_Y = 0x0E;
+    SensorConst SELF_TEST_Z = 0x0F;
+    SensorConst SELF_TEST_A = 0x10;
 
     SensorConst SMPRT_DIV = 0x19; // sample rate divider
     SensorConst CONFIG = 0x1A;    // digital low passand extra sync configutation
@@ -161,6 +171,47 @@ namespace MPU6050_Driver {
     SensorConst BIT_INT_LEVEL = BIT_7;
   }
 
+  /** Registers that change by themselves, have side effects when read, or have self clearing
+   * bits, and so must never be cached (see CACHED_I2C_IF) */
+  static constexpr uint8_t VOLATILE_REGS[] = {
+    Sensor_Regs::INT_STATUS,
+    Sensor_Regs::ACCEL_X_OUT_H, Sensor_Regs::ACCEL_X_OUT_L,
+    Sensor_Regs::ACCEL_Y_OUT_H, Sensor_Regs::ACCEL_Y_OUT_L,
+    Sensor_Regs::ACCEL_Z_OUT_H, Sensor_Regs::ACCEL_Z_OUT_L,
+    Sensor_Regs::TEMP_OUT_H, Sensor_Regs::TEMP_OUT_L,
+    Sensor_Regs::GYRO_X_OUT_H, Sensor_Regs::GYRO_X_OUT_L,
+    Sensor_Regs::GYRO_Y_OUT_H, Sensor_Regs::GYRO_Y_OUT_L,
+    Sensor_Regs::GYRO_Z_OUT_H, Sensor_Regs::GYRO_Z_OUT_L,
+    Sensor_Regs::FIFO_COUNT_H, Sensor_Regs::FIFO_COUNT_L, Sensor_Regs::FIFO_R_W,
+    Sensor_Regs::USER_CTRL,  // FIFO_RESET bit clears itself
+    Sensor_Regs::PWR_MGMT_1  // DEVICE_RESET bit clears itself
+  };
+
+  /** Size of the sensor FIFO in bytes */
+  static constexpr uint16_t FIFO_SIZE = 1024;
+
+  /** Size of one FIFO frame in bytes, when accel, temp and gyro are all written to the FIFO.
+   * Frames use the same layout as the ACCEL_X_OUT_H..GYRO_Z_OUT_L registers. */
+  static constexpr uint16_t FIFO_FRAME_SIZE = 14;
+
+  /** Maximum number of whole frames the FIFO can hold */
+  static constexpr uint16_t FIFO_MAX_FRAMES = FIFO_SIZE / FIFO_FRAME_SIZE;
+
+  /** Largest block read used to drain the FIFO (the SMBus block limit) */
+  static constexpr uint8_t FIFO_BLOCK_READ_MAX = 32;
+
+  /** Frames averaged in each pass of MPU6050::CalibrateOffsets() */
+  static constexpr uint16_t CALIBRATION_FRAMES = 1024;
+
+  /** Most passes of MPU6050::CalibrateOffsets(), each measuring the bias left by the last */
+  static constexpr uint8_t CALIBRATION_PASSES = 3;
+
+  /** Frames dropped at the start of each calibration pass, while the outputs settle on new offsets */
+  static constexpr uint16_t CALIBRATION_SETTLE_FRAMES = 16;
+
+  /** Largest standard deviation of any gyro axis (deg/s) that calibration takes as the rig being at rest */
+  static constexpr float CALIBRATION_MAX_GYRO_SD_DPS = 0.5f;
+
   /** Gyroscope full scale ranges in degrees per second */
   enum class Gyro_FS_t
   {
@@ -192,6 +243,39 @@ namespace MPU6050_Driver {
     RESERVED = 7
   };
 
+  /** Data aquisition modes */
+  enum class Acquisition_t
+  {
+    DATA_READY = 0, // Wake on every DATA_RDY interrupt and read one sample from the data registers
+    FIFO_BURST = 1  // Wake once per batch and drain all whole frames from the sensor FIFO
+  };
+
+  /** Outcomes of an offset calibration */
+  enum class Calibration_t
+  {
+    DONE = 0,      // Offsets written, and the last pass found no bias left to correct
+    UNSETTLED = 1, // Offsets written, but the last pass still corrected them
+    MOVING = 2,    // The rig wasn't at rest, so the starting offsets were kept
+    BUS_ERROR = 3  // An I2C transaction failed
+  };
+
+  /**
+   * @brief  Accelerometer and gyroscope offset registers. The accelerometer offsets are in LSBs of the
+   * +-16g range, with bit 0 kept for the sensor's temperature compensation, and the gyroscope offsets are
+   * in LSBs of the +-1000 deg/s range, whatever ranges the sensor is set to.
+   */
+  struct MPU6050Offsets {
+    /**
+     * @brief  X, Y, Z accelerometer offsets
+     */
+    int16_t accel[3] = {0, 0, 0};
+
+    /**
+     * @brief  X, Y, Z gyroscope offsets
+     */
+    int16_t gyro[3] = {0, 0, 0};
+  };
+
   /**
    * @brief  Sample from the MPU6050
    */
@@ -230,8 +314,110 @@ namespace MPU6050_Driver {
      * @brief  Z Rotation in deg/s
      */
     float gz = 0;
+
+    /**
+     * @brief  Monotonic timestamp of the sample in nanoseconds. In DATA_READY mode this is the
+     * interrupt edge; in FIFO_BURST mode it is back-dated from the drain by the sample period.
+     */
+    uint64_t timestamp_ns = 0;
   };
 
+  /**
+   * @brief  Scale factors of each word of a raw frame, resolved by the driver whenever a full scale
+   * range changes, so converting a frame needs no lookups. The words are in frame order, with the
+   * temperature, which has its own conversion, and a pad word scaled by zero, so all eight can be
+   * converted at once.
+   */
+  struct MPU6050Scale {
+    /**
+     * @brief  Accel X, Y, Z in g per LSB, zero, gyro X, Y, Z in deg/s per LSB, zero.
+     */
+    float perLsb[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  };
+
+  /**
+   * @brief  One sample from the MPU6050 as read, i.e. big endian words in ACCEL_X_OUT_H..GYRO_Z_OUT_L
+   * layout, along with the scale factors in force when it was read. Nothing is converted until a
+   * consumer asks for an axis, so a consumer that only needs a few axes only pays for those.
+   * The scale factors belong to the driver, so a frame is only valid during the callback it is
+   * passed to; keep an MPU6050Sample instead.
+   */
+  struct MPU6050Frame {
+    /** Words of a frame */
+    enum Word : uint8_t {
+      ACCEL_X = 0,
+      ACCEL_Y = 1,
+      ACCEL_Z = 2,
+      TEMP = 3,
+      GYRO_X = 4,
+      GYRO_Y = 5,
+      GYRO_Z = 6
+    };
+
+    /**
+     * @brief  Raw big endian bytes, as read from the sensor.
+     */
+    uint8_t bytes[FIFO_FRAME_SIZE];
+
+    /**
+     * @brief  Scale factors of the driver that read the frame.
+     */
+    const MPU6050Scale* scale = nullptr;
+
+    /**
+     * @brief  Monotonic timestamp of the sample in nanoseconds, as for MPU6050Sample.
+     */
+    uint64_t timestamp_ns = 0;
+
+    /**
+     * @brief  Raw value of one word.
+     * @param  word Word to read
+     * @retval int16_t
+     */
+    int16_t raw(Word word) const { return (int16_t)((bytes[2 * word] << 8) | bytes[2 * word + 1]); }
+
+    /** @brief  X Acceleration in g */
+    float ax() const { return raw(ACCEL_X) * scale->perLsb[ACCEL_X]; }
+
+    /** @brief  Y Acceleration in g */
+    float ay() const { return raw(ACCEL_Y) * scale->perLsb[ACCEL_Y]; }
+
+    /** @brief  Z Acceleration in g */
+    float az() const { return raw(ACCEL_Z) * scale->perLsb[ACCEL_Z]; }
+
+    /** @brief  Temperature in celcius */
+    float temp() const { return raw(TEMP) / 340.0f + 36.53f; } // Conversion taken from datasheet.
+
+    /** @brief  X Rotation in deg/s */
+    float gx() const { return raw(GYRO_X) * scale->perLsb[GYRO_X]; }
+
+    /** @brief  Y Rotation in deg/s */
+    float gy() const { return raw(GYRO_Y) * scale->perLsb[GYRO_Y]; }
+
+    /** @brief  Z Rotation in deg/s */
+    float gz() const { return raw(GYRO_Z) * scale->perLsb[GYRO_Z]; }
+
+    /**
+     * @brief  Convert every axis into a sample, with the same results as the axis accessors.
+     * @param  sample Sample to write to
+     * @retval None
+     */
+    void toSample(MPU6050Sample& sample) const;
+
+    /**
+     * @brief  Convert the raw bytes of one frame into a sample. All the words are byte swapped and
+     * scaled together, in a loop the compiler can vectorise.
+     * @param  bytes FIFO_FRAME_SIZE bytes of raw data
+     * @param  scale Scale factors to convert with
+     * @param  sample Sample to write to
+     * @retval None
+     */
+    static void convert(const uint8_t* bytes, const MPU6050Scale& scale, MPU6050Sample& sample);
+  };
+
+  /** Frames converted into one array per axis, see frame_convert.h */
+  struct MPU6050Batch;
+
   /**
    * @brief Callback interface where the callback needs to be
    * implemented by the host application.
@@ -242,6 +428,38 @@ namespace MPU6050_Driver {
      * @brief  Called after a sample has arrived.
      */
     virtual void hasSample(MPU6050Sample& sample) = 0;
+
+    /**
+     * @brief  Called after a batch of samples has been drained from the FIFO, oldest first.
+     * The default implementation simply passes each sample to hasSample().
+     * @param  samples Array of samples.
+     * @param  count Number of samples in the array.
+     */
+    virtual void hasBatch(MPU6050Sample* samples, std::size_t count) {
+      for (std::size_t i = 0; i < count; i++)
+        hasSample(samples[i]);
+    }
+
+    /**
+     * @brief  Called after a sample has been read from the data registers, before it is converted.
+     * The default implementation converts every axis and passes the sample to hasSample(), so only
+     * override this to skip converting axes that aren't needed.
+     * @param  frame Raw sample, only valid during the call.
+     */
+    virtual void hasFrame(const MPU6050Frame& frame) {
+      MPU6050Sample sample;
+      frame.toSample(sample);
+      sample.timestamp_ns = frame.timestamp_ns;
+      hasSample(sample);
+    }
+
+    /**
+     * @brief  Called after a batch of frames has been drained from the FIFO and converted into one array
+     * per axis, oldest first. The default implementation copies the frames into samples and passes them
+     * to hasBatch(), so only override this to work through the axes directly.
+     * @param  batch Converted frames, only valid during the call.
+     */
+    virtual void hasAxes(const MPU6050Batch& batch);
   };
 
   /**
@@ -265,8 +483,9 @@ namespace MPU6050_Driver {
     /**
      * @brief  This method wakes up the sensor and configures the accelerometer and
      * gyroscop0e full scale renges with given parameters. It also configures the
-     * DLPF, sample rate divider, interrput configuration, and also calibrates
-     * the accelerometers and gyros.
+     * DLPF, sample rate divider and interrput configuration. The offsets are left
+     * at the factory trim; calibrate them with CalibrateOffsets() afterwards, which
+     * takes the rest targets.
      * It returns the result of the process.
      * @param  gyroScale Gyroscope scale value to be set
      * @param  accelScale Accelerometer scale value to be set
@@ -274,15 +493,6 @@ namespace MPU6050_Driver {
      * @param  SRdiv Sample rate divider
      * @param  INTconf Interrupt configuration
      * @param  INTenable Interrput types enabled
-     * @param  accelCalX Target acceleration in the X axis for calibration (units g)
-     * @param  accelCalY Target acceleration in the Y axis for calibration (units g)
-     * @param  accelCalZ Target acceleration in the Z axis for calibration (units g)
-     * @param  gyroCalX Target angular velocity in the X axis for calibration
-     * (units deg/s)
-     * @param  gyroCalY Target angular velocity in the Y axis for calibration
-     * (units deg/s)
-     * @param  gyroCalZ Target angular velocity in the Z axis for calibration
-     * (units deg/s)
      * @retval i2c_status_t Success status
      */
     i2c_status_t InitializeSensor(
@@ -291,13 +501,7 @@ namespace MPU6050_Driver {
 	DLPF_t DLPFconf = DLPF_t::BW_260Hz,
 	uint8_t SRdiv = 7,  // Sample Rate = Gyroscope Output Rate / (1 + SRdiv)
 	uint8_t INTconf = Regbits_INT_PIN_CFG::BIT_INT_RD_CLEAR,
-	uint8_t INTenable = Regbits_INT_ENABLE::BIT_DATA_RDY_EN,
-	float accelCalX = 0,
-	float accelCalY = 0,
-	float accelCalZ = 1,
-	float gyroCalX = 0,
-	float gyroCalY = 0,
-	float gyroCalZ = 0);
+	uint8_t INTenable = Regbits_INT_ENABLE::BIT_DATA_RDY_EN);
 
     /*
      * @brief  This function sets the callback to be called when data becomes available.
@@ -308,6 +512,63 @@ namespace MPU6050_Driver {
       mpu6050cb = cb;
     }*/
 
+    /**
+     * @brief  This method selects how data aquisition gets samples from the sensor, and configures
+     * the FIFO and interrupts to match. In FIFO_BURST mode, the accel, temp and gyro are written to
+     * the FIFO, and the DATA_RDY interrupt stays enabled to time the frames. The aquisition thread
+     * then wakes once every framesPerBatch sample periods, drains every whole frame in the FIFO, and
+     * passes them to the hasAxes() callback, with the newest frame stamped at the last DATA_RDY edge.
+     * In DATA_READY mode, the FIFO is disabled and only the DATA_RDY interrupt is enabled. Call after
+     * InitializeSensor() and before begin().
+     * @param  mode Data aquisition mode
+     * @param  framesPerBatch Number of sample periods between FIFO drains (FIFO_BURST only)
+     * @retval i2c_status_t
+     */
+    i2c_status_t SetAcquisitionMode(Acquisition_t mode, uint16_t framesPerBatch = 8);
+
+    /**
+     * @brief  This method reads one sample from the data registers and sends it to the registered callback.
+     * It is one pass of the DATA_READY aquisition loop, without waiting for the interrupt, so it can also
+     * be called directly, e.g. by a simulator stepping in virtual time, instead of using begin().
+     * @param  origin_ns Monotonic timestamp of the interrupt edge in nanoseconds, or zero for now.
+     * @retval i2c_status_t
+     */
+    i2c_status_t ProcessSample(uint64_t origin_ns = 0);
+
+    /**
+     * @brief  This method drains the FIFO and sends the samples to the registered callback in one batch.
+     * It is one pass of the FIFO_BURST aquisition loop, without waiting for the batch period.
+     * @param  origin_ns Monotonic timestamp of the DATA_RDY edge of the newest frame in nanoseconds,
+     *         or zero for now.
+     * @retval i2c_status_t
+     */
+    i2c_status_t ProcessBatch(uint64_t origin_ns = 0);
+
+    /**
+     * @brief  Trace the latency of each sample from the interrupt edge through the control loop.
+     * In FIFO_BURST mode the trace starts when the FIFO is drained, so there is no wakeup stage.
+     * @param  trace Trace to record into, or nullptr to stop tracing.
+     * @retval None
+     */
+    void SetLatencyTrace(Telemetry::LatencyTrace* trace) { latencyTrace = trace; }
+
+    /**
+     * @brief  Set the scheduling of the data aquisition thread (SCHED_FIFO priority, CPU affinity,
+     * memory locking and stack prefaulting). It is applied by the thread itself when begin() starts it,
+     * before the aquisition loop runs.
+     * @param  config Thread configuration.
+     * @retval None
+     */
+    void SetThreadConfig(const RealTime::ThreadConfig& config) { threadConfig = config; }
+
+    /**
+     * @brief  Parts of the thread configuration that could not be applied, e.g. for lack of permissions.
+     * Only meaningful once the data aquisition thread has started.
+     * @param  None
+     * @retval uint8_t RealTime::ThreadConfigError flags.
+     */
+    uint8_t GetThreadConfigErrors(void) { return threadConfigErrors; }
+
     /**
      * @brief  This function will begin data aquisition in a separate thread.
      * @param  None
@@ -325,14 +586,22 @@ namespace MPU6050_Driver {
     /**
      * @brief  Class destructor. Simply calls end() to stop data aquisition
      */
-    ~MPU6050() { end(); }
+    ~MPU6050();
 
     /**
-     * @brief  This method will read all raw sensor data (accel, gyro, temp) into the rawData array.
-     * @param  None
+     * @brief  This method will read all raw sensor data (accel, gyro, temp) straight into a frame, and
+     * point the frame at the current scale factors. Nothing is converted.
+     * @param  frame Frame to read into
      * @retval i2c_status_t
      */
-    i2c_status_t ReadAllRawData(void);
+    i2c_status_t ReadAllRawData(MPU6050Frame& frame);
+
+    /**
+     * @brief  Scale factors for the current full scale ranges, as used to convert frames.
+     * @param  None
+     * @retval const MPU6050Scale&
+     */
+    const MPU6050Scale& GetScale(void) const { return scale; }
 
     /**
     * @brief  This method wakes the sensor up by cleraing the REG_PWR_MGMT_1
@@ -493,7 +762,8 @@ namespace MPU6050_Driver {
     int16_t GetGyro_Z_Offset(i2c_status_t* error);
 
     /**
-    * @brief  This method used for calibrating the gyroscope registers to given target values.
+    * @brief  This method used for calibrating the gyroscope registers to given target values. Superseded by
+    * CalibrateOffsets(), which keeps the factory trim.
     * @param targetX target value for gyroscope X axis register
     * @param targetY target value for gyroscope Y axis register
     * @param targetZ target value for gyroscope Z axis register
@@ -561,7 +831,7 @@ namespace MPU6050_Driver {
      * application notes are tried, it didnt work as expected. So there is another
      * method implemented to calibrate accelerometer registers automatically. It
      * works with the similar concept of binary search algorithm (setting a range
-     * and narrowing on each step).
+     * and narrowing on each step). Superseded by CalibrateOffsets(), which keeps the factory trim.
      * @param targetX_MG target value for accelerometer X axis register in MG so 1.0f
      * means 1G
      * @param targetY_MG target value for accelerometer Y axis register in MG
@@ -570,6 +840,50 @@ namespace MPU6050_Driver {
      */
     i2c_status_t Calibrate_Accel_Registers(float targetX_MG = 0.0f, float targetY_MG = 0.0f, float targetZ_MG = 1.0f);
 
+    /**
+    * @brief  This method reads all six offset registers.
+    * @param offsets Offsets read
+    * @retval i2c_status_t
+    */
+    i2c_status_t GetOffsets(MPU6050Offsets& offsets);
+
+    /**
+    * @brief  This method writes all six offset registers, through SetAccel_X_Offset() etc.
+    * @param offsets Offsets to write
+    * @retval i2c_status_t
+    */
+    i2c_status_t SetOffsets(const MPU6050Offsets& offsets);
+
+    /**
+     * @brief  This method calibrates the offset registers from the mean of a long FIFO burst, taken at
+     * 1 kHz whatever the sample rate is set to. The bias from the targets is taken off the current
+     * offsets, so the factory trim is only corrected, not thrown away, and each pass measures what the
+     * last one left, until there's nothing left to correct or CALIBRATION_PASSES have run. The rig must
+     * be at rest in the orientation the accelerometer targets describe. If any gyro axis varies by more
+     * than CALIBRATION_MAX_GYRO_SD_DPS it isn't, and the starting offsets are written back. Call after
+     * InitializeSensor() and before SetAcquisitionMode(); the FIFO and sample rate are restored after.
+     * @param offsets Offsets in the sensor afterwards
+     * @param accelCalX Target acceleration in the X axis (units g)
+     * @param accelCalY Target acceleration in the Y axis (units g)
+     * @param accelCalZ Target acceleration in the Z axis (units g)
+     * @param gyroCalX Target angular velocity in the X axis (units deg/s)
+     * @param gyroCalY Target angular velocity in the Y axis (units deg/s)
+     * @param gyroCalZ Target angular velocity in the Z axis (units deg/s)
+     * @param frames Frames averaged in each pass
+     * @retval Calibration_t Outcome of the calibration
+     */
+    Calibration_t CalibrateOffsets(MPU6050Offsets& offsets, float accelCalX = 0, float accelCalY = 0, float accelCalZ = 1,
+				   float gyroCalX = 0, float gyroCalY = 0, float gyroCalZ = 0,
+				   uint16_t frames = CALIBRATION_FRAMES);
+
+    /**
+    * @brief  This method reads the factory self test registers, which differ from chip to chip and can't be
+    * written, so they tell one sensor from another, e.g. to keep a calibration for each.
+    * @param error Result of the operation
+    * @retval uint32_t SELF_TEST_X..SELF_TEST_A, X in the highest byte
+    */
+    uint32_t GetDeviceID(i2c_status_t* error);
+
     /**
     * @brief  This method returns the MG (Gravity) coversion value depending on
     * the accelerometer full scale range. MG value is used to convert raw sensor value to Gravity
@@ -682,6 +996,15 @@ namespace MPU6050_Driver {
     */
     i2c_status_t Reset_Sensor_FIFO(void);
 
+    /**
+    * @brief This function empties the sensor FIFO so it starts again on a frame boundary, e.g. after an
+    *        overflow. FIFO_EN is cleared while the FIFO is reset, so no frame can land part way through,
+    *        then set again.
+    * @param none
+    * @retval i2c_status_t
+    */
+    i2c_status_t Resync_Sensor_FIFO(void);
+
     /**
     * @brief This function gets the sensor interrput status (INT_STATUS) register.
     * @param error Result of the operation
@@ -696,6 +1019,43 @@ namespace MPU6050_Driver {
     */
     uint8_t GetSensor_FIFO_Data(i2c_status_t* error);
 
+    /**
+    * @brief This function reads a block of bytes from the sensor FIFO data register.
+    * @param data Array the FIFO bytes are written to.
+    * @param length Number of bytes to read.
+    * @retval i2c_status_t
+    */
+    i2c_status_t GetSensor_FIFO_Block(uint8_t* data, uint16_t length);
+
+    /**
+    * @brief This function drains every whole frame in the FIFO (up to maxFrames), and converts
+    *        them into samples. The FIFO must be configured as in SetAcquisitionMode(FIFO_BURST).
+    * @param samples Array the samples are written to, oldest first.
+    * @param maxFrames Size of the samples array.
+    * @param error Result of the operation.
+    * @retval uint16_t Number of samples written.
+    */
+    uint16_t ReadFIFOFrames(MPU6050Sample* samples, uint16_t maxFrames, i2c_status_t* error);
+
+    /**
+    * @brief This function drains every whole frame in the FIFO, and converts them all at once into one
+    *        array per axis with ConvertFrames() (see frame_convert.h). The FIFO must be configured as in
+    *        SetAcquisitionMode(FIFO_BURST).
+    * @param batch Batch the frames are converted into, oldest first.
+    * @param error Result of the operation.
+    * @retval uint16_t Number of frames converted.
+    */
+    uint16_t ReadFIFOBatch(MPU6050Batch& batch, i2c_status_t* error);
+
+    /**
+    * @brief This function returns how many times the FIFO overflowed, as seen by the overflow interrupt
+    *        during FIFO_BURST aquisition or by a full FIFO when draining it. Each overflow loses the
+    *        contents of the FIFO.
+    * @param none
+    * @retval uint32_t Number of overflows.
+    */
+    uint32_t GetFIFOOverflowCount(void) { return fifoOverflowCount; }
+
     /**
     * @brief This function returns sensor interrupt pin config register value.
     * @param error Result of the operation.
@@ -726,6 +1086,33 @@ namespace MPU6050_Driver {
 
     /** Data aquisition flag. */
     bool dataAquisitionRunning;
+
+    /** Selected data aquisition mode. */
+    Acquisition_t acquisitionMode = Acquisition_t::DATA_READY;
+
+    /** Time between FIFO drains in FIFO_BURST mode, in nanoseconds. */
+    int64_t batchPeriod_ns = 0;
+
+    /** Time between FIFO frames in FIFO_BURST mode, in nanoseconds. */
+    int64_t samplePeriod_ns = 0;
+
+    /** Latency trace, if one has been set. */
+    Telemetry::LatencyTrace* latencyTrace = nullptr;
+
+    /** Scheduling settings for the data aquisition thread. */
+    RealTime::ThreadConfig threadConfig;
+
+    /** Thread configuration errors, written by the data aquisition thread. */
+    std::atomic<uint8_t> threadConfigErrors{RealTime::NONE};
+
+    /** Number of FIFO overflows seen. */
+    uint32_t fifoOverflowCount = 0;
+
+    /** Raw FIFO bytes drained in one batch. */
+    uint8_t fifoBuffer[FIFO_MAX_FRAMES * FIFO_FRAME_SIZE];
+
+    /** Axes converted from one batch of FIFO frames. */
+    std::unique_ptr<MPU6050Batch> fifoBatch;
     
     /** DPS constant to convert raw register value to the degree per seconds (angular velocity).
     * The index of the values are adjusted to have corresponding values with the gyro_full_scale_range_t
@@ -741,22 +1128,45 @@ namespace MPU6050_Driver {
      * Check sensor datasheet for more info about the offset procedure! */
     const float gyro_offset_1dps = 32.8f;
 
-    /** Keep track of what full scale range we are using for acceleration readings. */
-    Accel_FS_t accelFSRange;
+    /** Accel offset register constant to compensate 1 g offset. The offset registers are in the +-16g range
+     * whatever the full scale range is. */
+    const float accel_offset_1g = 2048.0f;
+
+    /** Keep track of what full scale range we are using for acceleration readings. Starts at the sensor's reset value. */
+    Accel_FS_t accelFSRange = Accel_FS_t::FS_2G;
+
+    /** Keep track of what full scale range we are using for gyro readings. Starts at the sensor's reset value. */
+    Gyro_FS_t gyroFSRange = Gyro_FS_t::FS_250_DPS;
 
-    /** Keep track of what full scale range we are using for gyro readings. */
-    Gyro_FS_t gyroFSRange;
+    /** Scale factors for accelFSRange and gyroFSRange, resolved by ResolveScale(). */
+    MPU6050Scale scale;
+
+    /**
+     * @brief  Read every whole frame in the FIFO, up to maxFrames, into fifoBuffer. If the FIFO has
+     * overflowed, its frames are misaligned, so none are read, the FIFO is resynced and the overflow counted.
+     * @param  maxFrames Most frames to read
+     * @param  error Result of the operation
+     * @retval uint16_t Number of frames read
+     */
+    uint16_t DrainFIFO(uint16_t maxFrames, i2c_status_t* error);
+
+    /**
+     * @brief  Reset the FIFO and sum the words of the next frames written to it, after dropping
+     * CALIBRATION_SETTLE_FRAMES. The FIFO must already be configured to take whole frames.
+     * @param  frames Frames to sum
+     * @param  sampleRate_Hz Sample rate the frames are written at
+     * @param  sums Sum of each word, in frame order
+     * @param  squares Sum of the square of each word, in frame order
+     * @retval i2c_status_t
+     */
+    i2c_status_t SumFIFOFrames(uint16_t frames, float sampleRate_Hz, int64_t sums[7], int64_t squares[7]);
 
-    /** Raw 16 bit accelerometer and gyro values, stored in an array.
-     * Index 0: accel X
-     * Index 1: accel Y
-     * Index 2: accel Z
-     * Index 3: temp
-     * Index 4: gyro X
-     * Index 5: gyro Y
-     * Index 6: gyro Z
+    /**
+     * @brief  Resolve the scale factors from the tracked full scale ranges. Call whenever a range changes.
+     * @param  None
+     * @retval None
      */
-    int16_t rawData[7];
+    void ResolveScale(void);
 
     /**
      * @brief  Data aquisition method that, in a loop, will block until an interrupt is generated by the MPU6050,
@@ -765,6 +1175,15 @@ namespace MPU6050_Driver {
      * @retval None
      */
     void dataAquisition(void);
+
+    /**
+     * @brief  FIFO data aquisition method that, in a loop, will wait one batch period, then drain the FIFO
+     * and send the samples to the registered mpu6050cb callback interface in one batch. If the FIFO overflow
+     * interrupt fires instead, the FIFO is reset, since its contents are no longer aligned to frames.
+     * @param  None
+     * @retval None
+     */
+    void fifoAquisition(void);
   };
 
 } // namespace MPU6050_Driver
@@ -0,0 +1,157 @@
+/**
+ * @file    calibration.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file contains the saving and loading of MPU6050 offset calibrations.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include "calibration.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace Params {
+
+/**
+ * @brief Split a line at the `=`, dropping any comment, and normalise the name before it to single spaces.
+ * @param line Line to split.
+ * @param key Name before the `=`, empty for a blank or comment line.
+ * @param values Text after the `=`.
+ * @retval bool False if there is a name but no `=`.
+ */
+static bool splitLine(std::string line, std::string& key, std::string& values) {
+  std::size_t comment = line.find('#');
+  if (comment != std::string::npos)
+    line.erase(comment);
+
+  std::size_t equals = line.find('=');
+  std::istringstream keyStream(line.substr(0, equals));
+  key.clear();
+  for (std::string word; keyStream >> word;)
+    key += (key.empty() ? "" : " ") + word;
+
+  values = equals == std::string::npos ? "" : line.substr(equals + 1);
+  return key.empty() || equals != std::string::npos;
+}
+
+std::string CalibrationKey(const std::string& i2cFile, uint8_t address, uint32_t deviceID) {
+  char ids[32];
+  std::snprintf(ids, sizeof(ids), " 0x%02x 0x%08x", (unsigned)address, (unsigned)deviceID);
+  return i2cFile + ids;
+}
+
+bool ParseCalibration(std::istream& in, const std::string& key, MPU6050_Driver::MPU6050Offsets& offsets,
+		      std::string& error) {
+  std::string line, lineKey, values;
+  for (int lineNumber = 1; std::getline(in, line); lineNumber++) {
+    if (!splitLine(line, lineKey, values)) {
+      error = "line " + std::to_string(lineNumber) + ": can't parse " + line;
+      return false;
+    }
+    if (lineKey != key)
+      continue; // Blank, comment, or another sensor's line
+
+    long read[6];
+    std::istringstream valueStream(values);
+    bool ok = true;
+    for (long& value : read)
+      ok = ok && (valueStream >> value) && value >= INT16_MIN && value <= INT16_MAX;
+    std::string extra;
+    if (!ok || (valueStream >> extra)) {
+      error = "line " + std::to_string(lineNumber) + ": can't parse " + line;
+      return false;
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+      offsets.accel[axis] = (int16_t)read[axis];
+      offsets.gyro[axis] = (int16_t)read[3 + axis];
+    }
+    return true;
+  }
+
+  return false;
+}
+
+bool LoadCalibration(const std::filesystem::path& path, const std::string& key, MPU6050_Driver::MPU6050Offsets& offsets) {
+  std::ifstream file(path);
+  if (!file.is_open())
+    return false;
+
+  std::string error;
+  if (ParseCalibration(file, key, offsets, error)) {
+    std::cout << "Loaded MPU6050 calibration for " << key << " from " << path << "." << std::endl;
+    return true;
+  }
+
+  if (!error.empty())
+    std::cout << "MPU6050 calibration file " << path << " not loaded, " << error << "." << std::endl;
+  return false;
+}
+
+bool SaveCalibration(const std::filesystem::path& path, const std::string& key,
+		     const MPU6050_Driver::MPU6050Offsets& offsets) {
+  std::vector<std::string> kept;
+  std::ifstream existing(path);
+  std::string line, lineKey, values;
+  if (!existing.is_open())
+    kept.push_back("# MPU6050 offset registers: accel X Y Z, gyro X Y Z. Delete a line to calibrate that sensor again.");
+  while (std::getline(existing, line)) {
+    if (splitLine(line, lineKey, values) && lineKey != key)
+      kept.push_back(line);
+  }
+
+  std::ostringstream entry;
+  entry << key << " =";
+  for (int16_t offset : offsets.accel)
+    entry << ' ' << offset;
+  for (int16_t offset : offsets.gyro)
+    entry << ' ' << offset;
+  kept.push_back(entry.str());
+
+  std::filesystem::path temporary = path;
+  temporary += ".new";
+  {
+    std::ofstream file(temporary, std::ios::trunc);
+    for (const std::string& keptLine : kept)
+      file << keptLine << '\n';
+    if (!file.flush()) {
+      std::cout << "Failed to write MPU6050 calibration file " << temporary << "." << std::endl;
+      return false;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(temporary, path, ec);
+  if (ec) {
+    std::cout << "Failed to replace MPU6050 calibration file " << path << "." << std::endl;
+    return false;
+  }
+
+  std::cout << "Saved MPU6050 calibration for " << key << " to " << path << "." << std::endl;
+  return true;
+}
+
+} // namespace Params
@@ -0,0 +1,85 @@
+/**
+ * @file    calibration.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file contains the saving and loading of MPU6050 offset calibrations.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <string>
+#include "../mpu6050/mpu6050.h"
+
+namespace Params {
+
+/**
+ * @brief Name a sensor's offsets are saved under: its I2C bus, address, and factory ID (see
+ * MPU6050::GetDeviceID()), so a sensor that is swapped out is calibrated afresh.
+ * @param i2cFile I2C device file.
+ * @param address I2C address.
+ * @param deviceID Factory ID of the sensor.
+ * @retval std::string Name, e.g. `/dev/i2c-1 0x68 0x1a0f1b12`.
+ */
+std::string CalibrationKey(const std::string& i2cFile, uint8_t address, uint32_t deviceID);
+
+/**
+ * @brief Find a sensor's offsets in calibration text. Each line is `<name> = <accel X Y Z> <gyro X Y Z>`, with the
+ * offset register values, and `#` starts a comment.
+ * @param in Text to parse.
+ * @param key Name of the sensor.
+ * @param offsets Offsets found, replaced only if the sensor's line parsed.
+ * @param error Set to a description of the problem if the sensor's line couldn't be parsed, otherwise left as it is.
+ * @retval bool False if the sensor isn't there, or its line couldn't be parsed.
+ */
+bool ParseCalibration(std::istream& in, const std::string& key, MPU6050_Driver::MPU6050Offsets& offsets,
+		      std::string& error);
+
+/**
+ * @brief Load a sensor's offsets from a calibration file. A missing file or sensor is a sensor that hasn't been
+ * calibrated yet, so only a line that can't be parsed is reported.
+ * @param path Calibration file.
+ * @param key Name of the sensor.
+ * @param offsets Offsets loaded.
+ * @retval bool False if there is no calibration for the sensor.
+ */
+bool LoadCalibration(const std::filesystem::path& path, const std::string& key, MPU6050_Driver::MPU6050Offsets& offsets);
+
+/**
+ * @brief Save a sensor's offsets to a calibration file, replacing any it had and keeping every other line that can be
+ * parsed. The file is written alongside and renamed over the old one, so it is never left half written.
+ * @param path Calibration file.
+ * @param key Name of the sensor.
+ * @param offsets Offsets to save.
+ * @retval bool False if the file couldn't be written.
+ */
+bool SaveCalibration(const std::filesystem::path& path, const std::string& key,
+		     const MPU6050_Driver::MPU6050Offsets& offsets);
+
+} // namespace Params
+
+#endif
@@ -0,0 +1,352 @@
+/**
+ * @file    config.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the start-up configuration loader.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "config.h"
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace Params {
+
+float Config::MPUSamplePeriod(void) const {
+  // The gyro output rate is 8 kHz with the DLPF off, and 1 kHz with it on.
+  if (mpuDLPF == MPU6050_Driver::DLPF_t::BW_260Hz || mpuDLPF == MPU6050_Driver::DLPF_t::RESERVED)
+    return (1.0 + (float)mpuSampleRateDiv) / 8000.0;
+  else
+    return (1.0 + (float)mpuSampleRateDiv) / 1000.0;
+}
+
+float Config::INASamplePeriod(void) const {
+  switch (inaCurrConvTime) {
+  case INA260_Driver::Conv_Time::TU140:
+    return 140e-6;
+  case INA260_Driver::Conv_Time::TU204:
+    return 204e-6;
+  case INA260_Driver::Conv_Time::TU332:
+    return 332e-6;
+  case INA260_Driver::Conv_Time::TU588:
+    return 588e-6;
+  case INA260_Driver::Conv_Time::TU1100:
+    return 1100e-6;
+  case INA260_Driver::Conv_Time::TU2116:
+    return 2116e-6;
+  case INA260_Driver::Conv_Time::TU4156:
+    return 4156e-6;
+  case INA260_Driver::Conv_Time::TU8224:
+    break;
+  }
+  return 8224e-6;
+}
+
+/**
+ * @brief Name an enumerated setting is given by in a config file.
+ */
+template <typename Enum>
+struct EnumName {
+  const char* name;
+  Enum value;
+};
+
+static const EnumName<Topology> TOPOLOGIES[] = {
+  {"cascade", Topology::CASCADE}, {"single", Topology::SINGLE_LOOP}};
+
+static const EnumName<MPU6050_Driver::Gyro_FS_t> GYRO_SCALES[] = {
+  {"250", MPU6050_Driver::Gyro_FS_t::FS_250_DPS}, {"500", MPU6050_Driver::Gyro_FS_t::FS_500_DPS},
+  {"1000", MPU6050_Driver::Gyro_FS_t::FS_1000_DPS}, {"2000", MPU6050_Driver::Gyro_FS_t::FS_2000_DPS}};
+
+static const EnumName<MPU6050_Driver::Accel_FS_t> ACCEL_SCALES[] = {
+  {"2", MPU6050_Driver::Accel_FS_t::FS_2G}, {"4", MPU6050_Driver::Accel_FS_t::FS_4G},
+  {"8", MPU6050_Driver::Accel_FS_t::FS_8G}, {"16", MPU6050_Driver::Accel_FS_t::FS_16G}};
+
+static const EnumName<MPU6050_Driver::DLPF_t> DLPF_BANDWIDTHS[] = {
+  {"260", MPU6050_Driver::DLPF_t::BW_260Hz}, {"184", MPU6050_Driver::DLPF_t::BW_184Hz},
+  {"94", MPU6050_Driver::DLPF_t::BW_94Hz}, {"44", MPU6050_Driver::DLPF_t::BW_44Hz},
+  {"21", MPU6050_Driver::DLPF_t::BW_21Hz}, {"10", MPU6050_Driver::DLPF_t::BW_10Hz},
+  {"5", MPU6050_Driver::DLPF_t::BW_5Hz}};
+
+static const EnumName<MPU6050_Driver::Acquisition_t> ACQUISITION_MODES[] = {
+  {"data_ready", MPU6050_Driver::Acquisition_t::DATA_READY}, {"fifo_burst", MPU6050_Driver::Acquisition_t::FIFO_BURST}};
+
+static const EnumName<Attitude::Filter_t> FILTERS[] = {
+  {"complementary", Attitude::Filter_t::COMPLEMENTARY}, {"mahony", Attitude::Filter_t::MAHONY},
+  {"kalman", Attitude::Filter_t::KALMAN}};
+
+static const EnumName<INA260_Driver::Conv_Time> CONV_TIMES[] = {
+  {"140", INA260_Driver::Conv_Time::TU140}, {"204", INA260_Driver::Conv_Time::TU204},
+  {"332", INA260_Driver::Conv_Time::TU332}, {"588", INA260_Driver::Conv_Time::TU588},
+  {"1100", INA260_Driver::Conv_Time::TU1100}, {"2116", INA260_Driver::Conv_Time::TU2116},
+  {"4156", INA260_Driver::Conv_Time::TU4156}, {"8224", INA260_Driver::Conv_Time::TU8224}};
+
+static const EnumName<INA260_Driver::Ave_Mode> AVERAGING_MODES[] = {
+  {"1", INA260_Driver::Ave_Mode::AV1}, {"4", INA260_Driver::Ave_Mode::AV4},
+  {"16", INA260_Driver::Ave_Mode::AV16}, {"64", INA260_Driver::Ave_Mode::AV64},
+  {"128", INA260_Driver::Ave_Mode::AV128}, {"256", INA260_Driver::Ave_Mode::AV256},
+  {"512", INA260_Driver::Ave_Mode::AV512}, {"1024", INA260_Driver::Ave_Mode::AV1024}};
+
+/**
+ * @brief Check nothing is left on a line after its values.
+ * @param values Rest of the line.
+ * @retval bool False if there is anything left.
+ */
+static bool atEnd(std::istringstream& values) {
+  std::string extra;
+  return !(values >> extra);
+}
+
+/**
+ * @brief Read a single word, such as a file name.
+ * @param values Rest of the line.
+ * @param out Word read.
+ * @retval bool False if there wasn't exactly one word.
+ */
+static bool readWord(std::istringstream& values, std::string& out) {
+  return (values >> out) && atEnd(values);
+}
+
+/**
+ * @brief Read an integer within a range. A 0x prefix reads it in hex.
+ * @param values Rest of the line.
+ * @param out Integer read.
+ * @param min Smallest value allowed.
+ * @param max Largest value allowed.
+ * @retval bool False if there wasn't exactly one integer, or it was out of range.
+ */
+template <typename T>
+static bool readInteger(std::istringstream& values, T& out, long long min, long long max) {
+  long long value;
+  values.unsetf(std::ios::basefield);
+  if (!(values >> value) || !atEnd(values) || value < min || value > max)
+    return false;
+
+  out = static_cast<T>(value);
+  return true;
+}
+
+/**
+ * @brief Read finite numbers within a range.
+ * @param values Rest of the line.
+ * @param out Array the numbers are written to.
+ * @param count Number of numbers expected.
+ * @param min Smallest value allowed.
+ * @param max Largest value allowed.
+ * @retval bool False if there was the wrong number of numbers, or one was out of range.
+ */
+template <typename T>
+static bool readNumbers(std::istringstream& values, T* out, std::size_t count, double min, double max) {
+  for (std::size_t i = 0; i < count; i++) {
+    double value;
+    if (!(values >> value) || !std::isfinite(value) || value < min || value > max)
+      return false;
+    out[i] = static_cast<T>(value);
+  }
+
+  return atEnd(values);
+}
+
+/**
+ * @brief Read PID gains, as Kp Kd Ki.
+ * @param values Rest of the line.
+ * @param out Gains read.
+ * @retval bool False if there weren't exactly three numbers.
+ */
+static bool readGains(std::istringstream& values, PID_Gains& out) {
+  double gains[3];
+  if (!readNumbers(values, gains, 3, -HUGE_VAL, HUGE_VAL))
+    return false;
+
+  out = {gains[0], gains[1], gains[2]};
+  return true;
+}
+
+/**
+ * @brief Read an enumerated setting by name.
+ * @param values Rest of the line.
+ * @param names Names of each value the setting can take.
+ * @param out Setting read.
+ * @retval bool False if the name isn't one of the names given.
+ */
+template <typename Enum, std::size_t N>
+static bool readEnum(std::istringstream& values, const EnumName<Enum> (&names)[N], Enum& out) {
+  std::string name;
+  if (!readWord(values, name))
+    return false;
+
+  for (const EnumName<Enum>& entry : names) {
+    if (name == entry.name) {
+      out = entry.value;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Read true or false.
+ * @param values Rest of the line.
+ * @param out Flag read.
+ * @retval bool False if it was neither.
+ */
+static bool readBool(std::istringstream& values, bool& out) {
+  std::string word;
+  if (!readWord(values, word) || (word != "true" && word != "false"))
+    return false;
+
+  out = word == "true";
+  return true;
+}
+
+/**
+ * @brief Config file key, and how its value is read into the settings.
+ */
+struct Setting {
+  const char* key;
+  bool (*read)(std::istringstream& values, Config& config);
+};
+
+static const Setting SETTINGS[] = {
+  {"topology", [](std::istringstream& v, Config& c) { return readEnum(v, TOPOLOGIES, c.topology); }},
+  {"gpio_chip", [](std::istringstream& v, Config& c) {
+    std::string chip;
+    if (!readWord(v, chip))
+      return false;
+    c.gpioChip = chip;
+    return true;
+  }},
+  {"mpu_i2c_file", [](std::istringstream& v, Config& c) { return readWord(v, c.mpuI2cFile); }},
+  {"mpu_address", [](std::istringstream& v, Config& c) { return readInteger(v, c.mpuAddress, 0x03, 0x77); }},
+  {"mpu_int_pin", [](std::istringstream& v, Config& c) { return readInteger(v, c.mpuIntPin, 0, 1023); }},
+  {"mpu_gyro_scale", [](std::istringstream& v, Config& c) { return readEnum(v, GYRO_SCALES, c.mpuGyroScale); }},
+  {"mpu_accel_scale", [](std::istringstream& v, Config& c) { return readEnum(v, ACCEL_SCALES, c.mpuAccelScale); }},
+  {"mpu_dlpf", [](std::istringstream& v, Config& c) { return readEnum(v, DLPF_BANDWIDTHS, c.mpuDLPF); }},
+  {"mpu_sample_rate_div", [](std::istringstream& v, Config& c) { return readInteger(v, c.mpuSampleRateDiv, 0, 255); }},
+  {"mpu_acquisition", [](std::istringstream& v, Config& c) { return readEnum(v, ACQUISITION_MODES, c.mpuAcquisition); }},
+  {"mpu_batch_frames", [](std::istringstream& v, Config& c) { return readInteger(v, c.mpuBatchFrames, 1, MPU6050_Driver::FIFO_MAX_FRAMES / 2); }},
+  {"mpu_filter", [](std::istringstream& v, Config& c) { return readEnum(v, FILTERS, c.mpuFilter); }},
+  {"mpu_rest_accel", [](std::istringstream& v, Config& c) { return readNumbers(v, c.mpuRestAccel, 3, -2, 2); }},
+  {"mpu_calibration", [](std::istringstream& v, Config& c) {
+    if (!readWord(v, c.mpuCalibration))
+      return false;
+    if (c.mpuCalibration == "none")
+      c.mpuCalibration.clear();
+    return true;
+  }},
+  {"radius", [](std::istringstream& v, Config& c) { return readNumbers(v, &c.radius, 1, 0.001, 10); }},
+  {"ina_i2c_file", [](std::istringstream& v, Config& c) { return readWord(v, c.inaI2cFile); }},
+  {"ina_address", [](std::istringstream& v, Config& c) { return readInteger(v, c.inaAddress, 0x03, 0x77); }},
+  {"ina_int_pin", [](std::istringstream& v, Config& c) { return readInteger(v, c.inaIntPin, 0, 1023); }},
+  {"ina_volt_conv_time", [](std::istringstream& v, Config& c) { return readEnum(v, CONV_TIMES, c.inaVoltConvTime); }},
+  {"ina_curr_conv_time", [](std::istringstream& v, Config& c) { return readEnum(v, CONV_TIMES, c.inaCurrConvTime); }},
+  {"ina_averaging", [](std::istringstream& v, Config& c) { return readEnum(v, AVERAGING_MODES, c.inaAveraging); }},
+  {"md_dir_pin", [](std::istringstream& v, Config& c) { return readInteger(v, c.mdDirPin, 0, 1023); }},
+  {"md_period", [](std::istringstream& v, Config& c) { return readInteger(v, c.mdPeriod_ns, 1000, 1000000000); }},
+  {"md_direct_registers", [](std::istringstream& v, Config& c) { return readBool(v, c.mdDirectRegisters); }},
+  {"inner", [](std::istringstream& v, Config& c) { return readGains(v, c.inner); }},
+  {"outer", [](std::istringstream& v, Config& c) { return readGains(v, c.outer); }},
+  {"outer_setpoint", [](std::istringstream& v, Config& c) { return readNumbers(v, &c.outerSetpoint, 1, -M_PI, M_PI); }},
+  {"outer_limit", [](std::istringstream& v, Config& c) { return readNumbers(v, &c.outerLimit, 1, 1e-9, HUGE_VAL); }},
+  {"mpu_priority", [](std::istringstream& v, Config& c) { return readInteger(v, c.mpuThread.priority, 0, 99); }},
+  {"mpu_cpu", [](std::istringstream& v, Config& c) { return readInteger(v, c.mpuThread.cpu, -1, 1023); }},
+  {"ina_priority", [](std::istringstream& v, Config& c) { return readInteger(v, c.inaThread.priority, 0, 99); }},
+  {"ina_cpu", [](std::istringstream& v, Config& c) { return readInteger(v, c.inaThread.cpu, -1, 1023); }},
+  {"control_priority", [](std::istringstream& v, Config& c) { return readInteger(v, c.controlThread.priority, 0, 99); }},
+  {"control_cpu", [](std::istringstream& v, Config& c) { return readInteger(v, c.controlThread.cpu, -1, 1023); }},
+  {"lock_memory", [](std::istringstream& v, Config& c) {
+    bool lock;
+    if (!readBool(v, lock))
+      return false;
+    c.mpuThread.lockMemory = c.inaThread.lockMemory = c.controlThread.lockMemory = lock;
+    return true;
+  }},
+  {"telemetry_file", [](std::istringstream& v, Config& c) { return readWord(v, c.telemetryFile); }},
+  {"tuning_file", [](std::istringstream& v, Config& c) { return readWord(v, c.tuningFile); }},
+  {"mpu_trace", [](std::istringstream& v, Config& c) { return readWord(v, c.mpuTrace); }},
+  {"ina_trace", [](std::istringstream& v, Config& c) { return readWord(v, c.inaTrace); }}};
+
+bool ParseConfig(std::istream& in, Config& config, std::string& error) {
+  Config parsed = config;
+
+  std::string line;
+  for (int lineNumber = 1; std::getline(in, line); lineNumber++) {
+    std::size_t comment = line.find('#');
+    if (comment != std::string::npos)
+      line.erase(comment);
+
+    std::size_t equals = line.find('=');
+    std::istringstream keyStream(line.substr(0, equals));
+    std::string key, extraKey;
+    if (!(keyStream >> key))
+      continue; // Blank or comment line
+
+    if (equals == std::string::npos || (keyStream >> extraKey)) {
+      error = "line " + std::to_string(lineNumber) + ": can't parse " + line;
+      return false;
+    }
+
+    const Setting* setting = nullptr;
+    for (const Setting& candidate : SETTINGS) {
+      if (key == candidate.key)
+	setting = &candidate;
+    }
+    if (!setting) {
+      error = "line " + std::to_string(lineNumber) + ": unknown setting " + key;
+      return false;
+    }
+
+    std::istringstream values(line.substr(equals + 1));
+    if (!setting->read(values, parsed)) {
+      error = "line " + std::to_string(lineNumber) + ": bad value for " + key;
+      return false;
+    }
+  }
+
+  config = parsed;
+  return true;
+}
+
+Tuning StartingTuning(const Config& config) {
+  return {config.inner, GainSchedule(0, 0.5, {config.outer, config.outer}, true), config.outerSetpoint};
+}
+
+void LoadConfig(const std::filesystem::path& path, Config& config) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    std::cout << "Failed to open config file " << path << "." << std::endl;
+    throw std::invalid_argument("Failed to open config file.");
+  }
+
+  std::string error;
+  if (!ParseConfig(file, config, error)) {
+    std::cout << "Config file " << path << " not loaded, " << error << "." << std::endl;
+    throw std::invalid_argument("Invalid config file.");
+  }
+
+  std::cout << "Loaded config file " << path << "." << std::endl;
+}
+
+} // namespace Params
@@ -0,0 +1,210 @@
+/**
+ * @file    config.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the start-up configuration of the table and the file it is loaded from.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <limits>
+#include <string>
+#include "../mpu6050/mpu6050.h"
+#include "../ina260/ina260.h"
+#include "../estimator/estimator.h"
+#include "../realtime/realtime.h"
+#include "../pid/pid_controller.h"
+#include "tuning.h"
+
+namespace Params {
+
+/**
+ * @brief Control loops the table is run with.
+ */
+enum class Topology : uint8_t {
+  CASCADE = 0, /**< Outer position loop on the MPU6050, setting the torque of an inner current loop on the INA260. */
+  SINGLE_LOOP = 1 /**< Position loop on the MPU6050 only, driving the motor driver directly. */
+};
+
+/**
+ * @brief Settings the table is started with. The defaults are those of ShakeyTable, so a config file only
+ * needs the settings a rig changes. The MPU6050 interrupt and INA260 alert settings aren't included, since
+ * the data aquisition threads rely on them.
+ */
+struct Config {
+  /** Control loops to run. */
+  Topology topology = Topology::CASCADE;
+
+  /** GPIO chip the interrupt and DIR pins are on. */
+  std::filesystem::path gpioChip = "/dev/gpiochip4";
+
+  /** MPU6050 I2C device file. */
+  std::string mpuI2cFile = "/dev/i2c-1";
+
+  /** MPU6050 I2C address. */
+  uint8_t mpuAddress = MPU6050_ADDRESS;
+
+  /** GPIO pin of the MPU6050 interrupt. */
+  gpiod::line::offset mpuIntPin = 4;
+
+  /** MPU6050 gyro full scale. */
+  MPU6050_Driver::Gyro_FS_t mpuGyroScale = MPU6050_Driver::Gyro_FS_t::FS_250_DPS;
+
+  /** MPU6050 accelerometer full scale. */
+  MPU6050_Driver::Accel_FS_t mpuAccelScale = MPU6050_Driver::Accel_FS_t::FS_2G;
+
+  /** MPU6050 digital low pass filter. Also sets the gyro output rate the sample rate divider divides. */
+  MPU6050_Driver::DLPF_t mpuDLPF = MPU6050_Driver::DLPF_t::BW_94Hz;
+
+  /** MPU6050 sample rate divider. */
+  uint8_t mpuSampleRateDiv = 9;
+
+  /** Acceleration (g) the MPU6050 measures with the table at rest, which its offsets are calibrated to. Given the
+   * MPU's orientation, there should be 1g in the Y axis. */
+  float mpuRestAccel[3] = {0, 1, 0};
+
+  /** File the MPU6050 offsets are saved to for each sensor, so it is only calibrated the first time it is started.
+   * Empty leaves the factory trim. */
+  std::string mpuCalibration = "mpu_calibration.conf";
+
+  /** How the MPU6050 data aquisition thread gets samples: one per DATA_RDY interrupt, or in bursts from the FIFO. */
+  MPU6050_Driver::Acquisition_t mpuAcquisition = MPU6050_Driver::Acquisition_t::DATA_READY;
+
+  /** Number of sample periods between FIFO drains in FIFO burst aquisition, each adding a period of latency. */
+  uint16_t mpuBatchFrames = 8;
+
+  /** Filter fusing the MPU gyro rate with the accelerometer tilt. */
+  Attitude::Filter_t mpuFilter = Attitude::Filter_t::KALMAN;
+
+  /** Radius from the axis of rotation to the MPU chip (m). */
+  float radius = 0.15;
+
+  /** INA260 I2C device file. */
+  std::string inaI2cFile = "/dev/i2c-0";
+
+  /** INA260 I2C address. */
+  uint8_t inaAddress = INA260_ADDRESS;
+
+  /** GPIO pin of the INA260 alert. */
+  gpiod::line::offset inaIntPin = 5;
+
+  /** INA260 voltage conversion time. */
+  INA260_Driver::Conv_Time inaVoltConvTime = INA260_Driver::Conv_Time::TU140;
+
+  /** INA260 current conversion time. Only current is measured, so this sets the sample period. */
+  INA260_Driver::Conv_Time inaCurrConvTime = INA260_Driver::Conv_Time::TU4156;
+
+  /** INA260 averaging mode. */
+  INA260_Driver::Ave_Mode inaAveraging = INA260_Driver::Ave_Mode::AV1;
+
+  /** GPIO pin of the motor driver DIR input. */
+  gpiod::line::offset mdDirPin = 23;
+
+  /** Motor driver PWM period (ns). */
+  uint32_t mdPeriod_ns = 50000;
+
+  /** Drive the motor driver through the RP1's registers rather than sysfs and libgpiod (Pi 5 only, needs root). */
+  bool mdDirectRegisters = false;
+
+  /** Inner (current) loop gains. */
+  PID_Gains inner = {0.01, 0, 0};
+
+  /** Outer (position) loop gains. */
+  PID_Gains outer = {0.01, 0, 0};
+
+  /** Outer loop setpoint, the angle measured when upright (rad). */
+  double outerSetpoint = 0;
+
+  /** Largest outer loop output either way. */
+  double outerLimit = std::numeric_limits<double>::max();
+
+  /** Real-time scheduling of the MPU data aquisition thread. */
+  RealTime::ThreadConfig mpuThread = {80, 1, true, 64 * 1024};
+
+  /** Real-time scheduling of the INA data aquisition thread. The INA samples faster, so it is above the MPU. */
+  RealTime::ThreadConfig inaThread = {81, 2, true, 64 * 1024};
+
+  /** Real-time scheduling of the control executor thread. */
+  RealTime::ThreadConfig controlThread = {82, 3, true, 64 * 1024};
+
+  /** Telemetry file. */
+  std::string telemetryFile = "telemetry_log";
+
+  /** Live tuning file. */
+  std::string tuningFile = "tuning.conf";
+
+  /** File every MPU6050 I2C transaction is recorded to, for replaying offline. Empty records nothing. */
+  std::string mpuTrace;
+
+  /** File every INA260 I2C transaction is recorded to, for replaying offline. Empty records nothing. */
+  std::string inaTrace;
+
+  /**
+   * @brief MPU6050 sample period, from the sample rate divider and the gyro output rate set by the DLPF.
+   * For an explanation, see https://invensense.tdk.com/wp-content/uploads/2015/02/MPU-6000-Register-Map1.pdf, page 12.
+   * @retval float Sample period (s).
+   */
+  float MPUSamplePeriod(void) const;
+
+  /**
+   * @brief INA260 sample period. This assumes only current is being measured, which is all we need.
+   * @retval float Sample period (s).
+   */
+  float INASamplePeriod(void) const;
+};
+
+/**
+ * @brief Parse settings from text, on top of a starting set, so only the settings being changed need to be
+ * given. Each line is `key = value`, and `#` starts a comment. The keys are listed in the README, and
+ * enumerated settings take their value in the sensor's units (e.g. `mpu_dlpf = 94` for 94 Hz).
+ * @param in Text to parse.
+ * @param config Starting settings, replaced by the parsed ones only if everything parsed and is valid.
+ * @param error Set to a description of the first problem, if there was one.
+ * @retval bool False if the text couldn't be parsed, or a setting is out of range.
+ */
+bool ParseConfig(std::istream& in, Config& config, std::string& error);
+
+/**
+ * @brief Tuning the table starts with, before any tuning file is loaded. The outer gains are scheduled on the
+ * tilt either side of upright, from upright out to the tipping limit (approx. 0.5 rad), with the configured
+ * gains at every point until the table has been tuned on the hardware.
+ * @param config Settings the table is started with.
+ * @retval Tuning Starting tuning.
+ */
+Tuning StartingTuning(const Config& config);
+
+/**
+ * @brief Load settings from a config file, on top of a starting set. Meant for start-up, so a file that can't be
+ * read or parsed is reported and thrown rather than ignored.
+ * @param path Config file.
+ * @param config Starting settings, replaced by the loaded ones.
+ */
+void LoadConfig(const std::filesystem::path& path, Config& config);
+
+} // namespace Params
+
+#endif
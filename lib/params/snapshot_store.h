@@ -0,0 +1,141 @@
+/**
+ * @file    snapshot_store.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the lock-free parameter snapshot store.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SNAPSHOT_STORE_H
+#define SNAPSHOT_STORE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace Params {
+
+/**
+ * @brief Store of parameter snapshots, published by a tuning thread and picked up by the control thread.
+ *
+ * Each snapshot is a whole copy of the parameters, so the control thread never sees half of an update.
+ * The reader's snapshot and the writer's snapshot are kept in separate slots, with a third slot holding
+ * the newest published one between them. Publishing and picking up are each a single atomic exchange of
+ * slot indices, so the control thread never waits or takes a lock, and the writer can never overwrite the
+ * snapshot the control thread is using. (With only two slots, a second publish while the control thread was
+ * still reading the first would have to either wait for it or write over it.)
+ *
+ * There must be one reader thread. Any number of threads may publish; they are serialised by a mutex,
+ * which the reader never touches.
+ *
+ * @tparam T Parameter snapshot type. It must be copyable.
+ */
+template <typename T>
+class SnapshotStore {
+public:
+  /**
+   * @brief Constructor.
+   * @param initial Parameters the reader starts with.
+   */
+  explicit SnapshotStore(const T& initial) : slots{{initial, initial, initial}}, latestSnapshot(initial) {}
+
+  /**
+   * @brief Publish a new snapshot. The reader picks it up on its next refresh(). Not for the control thread.
+   * @param snapshot New parameters.
+   */
+  void publish(const T& snapshot) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    slots[back] = snapshot;
+    latestSnapshot = snapshot;
+
+    // Hand the filled slot over as the newest, and take back whichever slot was waiting there.
+    back = middle.exchange(back | NEW, std::memory_order_acq_rel) & INDEX;
+    publishedCount.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Copy of the newest published snapshot, to edit and publish. Not for the control thread.
+   * @retval T Newest parameters.
+   */
+  T latest(void) const {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    return latestSnapshot;
+  }
+
+  /**
+   * @brief Pick up the newest published snapshot, if there is one. Wait-free; for the reader thread only.
+   * @retval bool True if current() has changed.
+   */
+  bool refresh(void) {
+    if (!(middle.load(std::memory_order_relaxed) & NEW))
+      return false;
+
+    front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+    return true;
+  }
+
+  /**
+   * @brief The reader's current snapshot. It stays valid, and unchanged, until the reader's next refresh().
+   * For the reader thread only.
+   * @retval const T& Current parameters.
+   */
+  const T& current(void) const { return slots[front]; }
+
+  /**
+   * @brief Number of snapshots published.
+   * @retval uint64_t Publish count.
+   */
+  uint64_t published(void) const { return publishedCount.load(std::memory_order_relaxed); }
+
+private:
+  /** Flag set in middle when its slot holds a snapshot the reader hasn't picked up. */
+  static constexpr uint8_t NEW = 4;
+
+  /** Mask of the slot index in middle. */
+  static constexpr uint8_t INDEX = 3;
+
+  /** Snapshot slots. */
+  std::array<T, 3> slots;
+
+  /** Slot holding the newest published snapshot, with the NEW flag. */
+  std::atomic<uint8_t> middle{1};
+
+  /** Slot the reader is using. Only used by the reader. */
+  uint8_t front = 0;
+
+  /** Slot the writer fills next. Only used under writerMutex. */
+  uint8_t back = 2;
+
+  /** Serialises publishers. */
+  mutable std::mutex writerMutex;
+
+  /** Copy of the newest published snapshot, for publishers to edit. */
+  T latestSnapshot;
+
+  /** Number of snapshots published. */
+  std::atomic<uint64_t> publishedCount{0};
+};
+
+} // namespace Params
+
+#endif
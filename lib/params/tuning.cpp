@@ -0,0 +1,183 @@
+/**
+ * @file    tuning.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the live tuning file parser and watcher implementation.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "tuning.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace Params {
+
+/**
+ * @brief Read exactly a number of values from the rest of a line.
+ * @param values Rest of the line.
+ * @param out Array the values are written to.
+ * @param count Number of values expected.
+ * @retval bool False if there were too few, too many, or one wasn't a number.
+ */
+static bool readValues(std::istringstream& values, double* out, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) {
+    if (!(values >> out[i]))
+      return false;
+  }
+
+  std::string extra;
+  return !(values >> extra);
+}
+
+bool ParseTuning(std::istream& in, Tuning& tuning, std::string& error) {
+  PID_Gains inner = tuning.inner;
+  double outerSetpoint = tuning.outerSetpoint;
+  double first = tuning.outer.first(), last = tuning.outer.last();
+  bool magnitude = tuning.outer.magnitude();
+  std::vector<PID_Gains> outerPoints;
+
+  std::string line;
+  for (int lineNumber = 1; std::getline(in, line); lineNumber++) {
+    std::size_t comment = line.find('#');
+    if (comment != std::string::npos)
+      line.erase(comment);
+
+    std::size_t equals = line.find('=');
+    std::istringstream keyStream(line.substr(0, equals));
+    std::string key, extraKey;
+    if (!(keyStream >> key))
+      continue; // Blank or comment line
+
+    std::istringstream values(equals == std::string::npos ? "" : line.substr(equals + 1));
+    bool ok = equals != std::string::npos && !(keyStream >> extraKey);
+    if (ok && key == "inner") {
+      double gains[3];
+      ok = readValues(values, gains, 3);
+      inner = {gains[0], gains[1], gains[2]};
+    }
+    else if (ok && key == "outer") {
+      double gains[3];
+      ok = readValues(values, gains, 3);
+      outerPoints.push_back({gains[0], gains[1], gains[2]});
+    }
+    else if (ok && key == "outer_schedule") {
+      std::string flag;
+      ok = static_cast<bool>(values >> first >> last);
+      if (ok && (values >> flag))
+	ok = flag == "magnitude" && !(values >> flag);
+      magnitude = flag == "magnitude";
+    }
+    else if (ok && key == "outer_setpoint")
+      ok = readValues(values, &outerSetpoint, 1);
+    else if (ok) {
+      error = "line " + std::to_string(lineNumber) + ": unknown setting " + key;
+      return false;
+    }
+
+    if (!ok) {
+      error = "line " + std::to_string(lineNumber) + ": can't parse " + line;
+      return false;
+    }
+  }
+
+  if (outerPoints.empty())
+    outerPoints.assign(tuning.outer.points(), tuning.outer.points() + tuning.outer.size());
+
+  try {
+    tuning.outer = GainSchedule(first, last, outerPoints.data(), outerPoints.size(), magnitude);
+  }
+  catch (const std::invalid_argument&) {
+    error = "the outer gain schedule needs 1 to " + std::to_string(GainSchedule::MAX_POINTS)
+      + " points over a non-empty range";
+    return false;
+  }
+  tuning.inner = inner;
+  tuning.outerSetpoint = outerSetpoint;
+  return true;
+}
+
+TuningFile::TuningFile(const std::filesystem::path& _path, SnapshotStore<Tuning>& _store, std::chrono::milliseconds _pollPeriod)
+    : path(_path), store(_store), pollPeriod(_pollPeriod) {}
+
+TuningFile::~TuningFile() { end(); }
+
+void TuningFile::begin(void) {
+  if (watcherRunning.exchange(true))
+    return;
+
+  watcherThread = std::thread(&TuningFile::watch, this);
+}
+
+void TuningFile::end(void) {
+  watcherRunning = false;
+  if (watcherThread.joinable())
+    watcherThread.join();
+}
+
+bool TuningFile::Reload(void) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    std::cout << "Failed to open tuning file " << path << "." << std::endl;
+    errorCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  Tuning tuning = store.latest();
+  std::string error;
+  if (!ParseTuning(file, tuning, error)) {
+    std::cout << "Tuning file " << path << " not loaded, " << error << "." << std::endl;
+    errorCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  store.publish(tuning);
+  reloadCount.fetch_add(1, std::memory_order_relaxed);
+  std::cout << "Loaded tuning file " << path << "." << std::endl;
+  return true;
+}
+
+void TuningFile::watch(void) {
+  std::filesystem::file_time_type lastLoaded;
+  bool loaded = false;
+
+  while (watcherRunning) {
+    std::error_code ec;
+    std::filesystem::file_time_type modified = std::filesystem::last_write_time(path, ec);
+
+    // An editor may save in several steps, so wait for the time to settle before loading.
+    if (!ec && (!loaded || modified != lastLoaded)) {
+      std::this_thread::sleep_for(pollPeriod / 4);
+      if (std::filesystem::last_write_time(path, ec) == modified && !ec) {
+	Reload();
+	lastLoaded = modified;
+	loaded = true;
+      }
+    }
+
+    std::this_thread::sleep_for(pollPeriod);
+  }
+}
+
+} // namespace Params
@@ -0,0 +1,153 @@
+/**
+ * @file    tuning.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the live tuning parameters and the file they are loaded from.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef TUNING_H
+#define TUNING_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <string>
+#include <thread>
+#include "../pid/gain_schedule.h"
+#include "../pid/pid_controller.h"
+#include "snapshot_store.h"
+
+namespace Params {
+
+/**
+ * @brief Parameters that can be retuned while the table is running.
+ */
+struct Tuning {
+  /** Inner (current) loop gains. */
+  PID_Gains inner;
+
+  /** Outer (position) loop gains, scheduled on the angle. */
+  GainSchedule outer;
+
+  /** Outer loop setpoint, to trim the upright angle (rad). */
+  double outerSetpoint;
+};
+
+/**
+ * @brief Parse tuning parameters from text, on top of a starting set, so only the settings being changed need
+ * to be given. Each line is `key = values`, and `#` starts a comment:
+ *   inner = <Kp> <Kd> <Ki>
+ *   outer = <Kp> <Kd> <Ki>            one line per point of the outer gain schedule
+ *   outer_schedule = <first> <last> [magnitude]
+ *   outer_setpoint = <rad>
+ * If any outer lines are given they replace the whole schedule, evenly spaced over outer_schedule (or the
+ * old range, if that isn't given).
+ * @param in Text to parse.
+ * @param tuning Starting parameters, replaced by the parsed ones only if everything parsed.
+ * @param error Set to a description of the first problem, if there was one.
+ * @retval bool False if the text couldn't be parsed.
+ */
+bool ParseTuning(std::istream& in, Tuning& tuning, std::string& error);
+
+/**
+ * @brief Watches a tuning file, and publishes its parameters to a snapshot store each time it is saved.
+ * The file is polled from a background thread, so nothing is done on the control threads.
+ */
+class TuningFile {
+public:
+  /**
+   * @brief Constructor.
+   * @param _path Tuning file. It doesn't have to exist yet.
+   * @param _store Store the parameters are published to. Each file is parsed on top of the newest snapshot in it.
+   * @param _pollPeriod How often the file's modification time is checked.
+   */
+  TuningFile(const std::filesystem::path& _path, SnapshotStore<Tuning>& _store,
+             std::chrono::milliseconds _pollPeriod = std::chrono::milliseconds(200));
+
+  /**
+   * @brief Destructor. Stops the watcher thread.
+   */
+  ~TuningFile();
+
+  /**
+   * @brief Start the watcher thread. The file is loaded straight away if it exists.
+   */
+  void begin(void);
+
+  /**
+   * @brief Stop the watcher thread.
+   */
+  void end(void);
+
+  /**
+   * @brief Parse the file and publish its parameters. A message is printed if it can't be read or parsed,
+   * and nothing is published.
+   * @retval bool False if the file couldn't be read or parsed.
+   */
+  bool Reload(void);
+
+  /**
+   * @brief Number of times the file has been loaded and published.
+   * @retval uint64_t Reload count.
+   */
+  uint64_t GetReloadCount(void) const { return reloadCount.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Number of times the file failed to load.
+   * @retval uint64_t Error count.
+   */
+  uint64_t GetErrorCount(void) const { return errorCount.load(std::memory_order_relaxed); }
+
+private:
+  /**
+   * @brief Watcher thread method. Reloads the file whenever its modification time changes.
+   */
+  void watch(void);
+
+  /** Tuning file. */
+  std::filesystem::path path;
+
+  /** Store the parameters are published to. */
+  SnapshotStore<Tuning>& store;
+
+  /** How often the file is checked. */
+  std::chrono::milliseconds pollPeriod;
+
+  /** Watcher thread. */
+  std::thread watcherThread;
+
+  /** True while the watcher thread should keep running. */
+  std::atomic<bool> watcherRunning{false};
+
+  /** Number of successful loads. */
+  std::atomic<uint64_t> reloadCount{0};
+
+  /** Number of failed loads. */
+  std::atomic<uint64_t> errorCount{0};
+};
+
+} // namespace Params
+
+#endif
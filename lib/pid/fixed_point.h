@@ -0,0 +1,129 @@
+/**
+ * @file    fixed_point.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains a Q16.16 fixed point number type.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _FIXED_POINT_H_
+#define _FIXED_POINT_H_
+
+#include <cstdint>
+
+/**
+ * @brief Signed Q16.16 fixed point number: 16 integer bits and 16 fractional bits, giving a range of
+ * about +/-32768 in steps of 1/65536. Arithmetic saturates at the ends of the range rather than
+ * wrapping, so an overflowing controller pins at its limit instead of flipping sign.
+ * Conversions to and from double are explicit, so mixed expressions don't silently fall back to floating point.
+ */
+class Q16_16
+{
+    public:
+	/** Number of fractional bits */
+	static constexpr int FRACTION_BITS = 16;
+
+	/** Raw value of one */
+	static constexpr int32_t ONE = 1 << FRACTION_BITS;
+
+	/**
+	 * @brief Construct zero.
+	 */
+	constexpr Q16_16() : _raw(0) {}
+
+	/**
+	 * @brief Construct from a double, rounding to the nearest step and saturating out of range values.
+	 * @param value Value to convert
+	 */
+	explicit constexpr Q16_16(double value) : _raw(saturate(value * ONE + (value < 0 ? -0.5 : 0.5))) {}
+
+	/**
+	 * @brief Construct from a raw Q16.16 value.
+	 * @param raw Raw value (the number times 65536)
+	 * @retval Q16_16 Fixed point number
+	 */
+	static constexpr Q16_16 fromRaw(int32_t raw) { Q16_16 number; number._raw = raw; return number; }
+
+	/**
+	 * @brief Get the raw Q16.16 value.
+	 * @retval int32_t Raw value (the number times 65536)
+	 */
+	constexpr int32_t raw() const { return _raw; }
+
+	/**
+	 * @brief Convert to a double.
+	 */
+	explicit constexpr operator double() const { return (double)_raw / ONE; }
+
+	/** Largest representable number */
+	static constexpr Q16_16 max() { return fromRaw(INT32_MAX); }
+
+	/** Most negative representable number */
+	static constexpr Q16_16 lowest() { return fromRaw(INT32_MIN); }
+
+	constexpr Q16_16 operator-() const { return fromRaw(saturate(-(int64_t)_raw)); }
+	constexpr Q16_16 operator+(Q16_16 rhs) const { return fromRaw(saturate((int64_t)_raw + rhs._raw)); }
+	constexpr Q16_16 operator-(Q16_16 rhs) const { return fromRaw(saturate((int64_t)_raw - rhs._raw)); }
+
+	/** Multiply, rounding to the nearest step */
+	constexpr Q16_16 operator*(Q16_16 rhs) const
+	{
+	    return fromRaw(saturate(((int64_t)_raw * rhs._raw + (ONE >> 1)) >> FRACTION_BITS));
+	}
+
+	/** Divide, truncating towards zero. Dividing by zero saturates in the direction of the dividend. */
+	constexpr Q16_16 operator/(Q16_16 rhs) const
+	{
+	    if (rhs._raw == 0)
+		return _raw < 0 ? lowest() : max();
+	    return fromRaw(saturate(((int64_t)_raw * ONE) / rhs._raw));
+	}
+
+	Q16_16& operator+=(Q16_16 rhs) { return *this = *this + rhs; }
+	Q16_16& operator-=(Q16_16 rhs) { return *this = *this - rhs; }
+	Q16_16& operator*=(Q16_16 rhs) { return *this = *this * rhs; }
+
+	constexpr bool operator==(Q16_16 rhs) const { return _raw == rhs._raw; }
+	constexpr bool operator!=(Q16_16 rhs) const { return _raw != rhs._raw; }
+	constexpr bool operator<(Q16_16 rhs) const { return _raw < rhs._raw; }
+	constexpr bool operator>(Q16_16 rhs) const { return _raw > rhs._raw; }
+	constexpr bool operator<=(Q16_16 rhs) const { return _raw <= rhs._raw; }
+	constexpr bool operator>=(Q16_16 rhs) const { return _raw >= rhs._raw; }
+
+    private:
+	/**
+	 * @brief Clamp a wide intermediate result to the 32 bit raw range.
+	 * @param value Wide raw value
+	 * @retval int32_t Saturated raw value
+	 */
+	template <typename Wide>
+	static constexpr int32_t saturate(Wide value)
+	{
+	    return value != value ? 0 // NaN
+		: value >= (Wide)INT32_MAX ? INT32_MAX : value <= (Wide)INT32_MIN ? INT32_MIN : (int32_t)value;
+	}
+
+	/** Raw value (the number times 65536) */
+	int32_t _raw;
+};
+
+#endif
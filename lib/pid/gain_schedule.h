@@ -0,0 +1,209 @@
+/**
+ * @file    gain_schedule.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the PID gain schedule.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _GAIN_SCHEDULE_H_
+#define _GAIN_SCHEDULE_H_
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include "pid_controller.h"
+
+/**
+ * @brief Table of PID gains at evenly spaced values of a scheduling variable, such as the tilt angle,
+ * with the gains in between linearly interpolated. Because the points are evenly spaced, a lookup is
+ * one multiply to find the row, with no search, and the table is a fixed size array, so nothing is
+ * allocated after construction. Interpolating means the gains move smoothly between regions rather
+ * than stepping, and together with the integral being kept in output units by the PID controller,
+ * moving across the table doesn't bump the output.
+ */
+class GainSchedule
+{
+    public:
+	/** Largest number of points in a schedule */
+	static constexpr std::size_t MAX_POINTS = 16;
+
+	/**
+	 * @brief Class constructor. Throws std::invalid_argument if there are no points, too many, or the range is empty.
+	 * @param first Scheduling variable at the first point
+	 * @param last Scheduling variable at the last point
+	 * @param points Gains at each point, evenly spaced from first to last
+	 * @param magnitude Look up the magnitude of the scheduling variable, for a schedule symmetric about zero
+	 * @retval None
+	 */
+	GainSchedule(double first, double last, std::initializer_list<PID_Gains> points, bool magnitude = false) :
+	    GainSchedule(first, last, points.begin(), points.size(), magnitude)
+	{
+	}
+
+	/**
+	 * @brief Class constructor. Throws std::invalid_argument if there are no points, too many, or the range is empty.
+	 * @param first Scheduling variable at the first point
+	 * @param last Scheduling variable at the last point
+	 * @param points Array of the gains at each point, evenly spaced from first to last
+	 * @param count Number of points
+	 * @param magnitude Look up the magnitude of the scheduling variable, for a schedule symmetric about zero
+	 * @retval None
+	 */
+	GainSchedule(double first, double last, const PID_Gains* points, std::size_t count, bool magnitude = false) :
+	    _first(first),
+	    _last(last),
+	    _count(count),
+	    _magnitude(magnitude)
+	{
+	    if (_count == 0 || _count > MAX_POINTS || (_count > 1 && !(last > first))) {
+		throw std::invalid_argument("Gain schedule needs 1 to " + std::to_string(MAX_POINTS) + " points over a non-empty range.");
+	    }
+
+	    for (std::size_t i = 0; i < _count; i++)
+		_points[i] = points[i];
+	    _rowsPerUnit = _count > 1 ? (_count - 1) / (last - first) : 0;
+	}
+
+	/**
+	 * @brief Look up the gains at a value of the scheduling variable. Values outside the table
+	 * get the gains of the nearest end.
+	 * @param x Scheduling variable
+	 * @retval PID_Gains Interpolated gains
+	 */
+	PID_Gains lookup(double x) const
+	{
+	    if (_magnitude && x < 0)
+		x = -x;
+
+	    // Position in the table, in rows
+	    double position = (x - _first) * _rowsPerUnit;
+	    if (!(position > 0))
+		return _points[0];
+	    if (position >= _count - 1)
+		return _points[_count - 1];
+
+	    std::size_t row = (std::size_t)position;
+	    double fraction = position - row;
+	    const PID_Gains& lower = _points[row];
+	    const PID_Gains& upper = _points[row + 1];
+	    return {lower.Kp + (upper.Kp - lower.Kp) * fraction,
+		    lower.Kd + (upper.Kd - lower.Kd) * fraction,
+		    lower.Ki + (upper.Ki - lower.Ki) * fraction};
+	}
+
+	/**
+	 * @brief Look up the gains at a value of the scheduling variable and set them on a PID controller.
+	 * @param controller PID controller to set the gains of
+	 * @param x Scheduling variable, e.g. the process variable, or something external to the loop
+	 * @retval None
+	 */
+	template <typename Controller>
+	void apply(Controller& controller, double x) const { controller.setGains(lookup(x)); }
+
+	/** Scheduling variable at the first point */
+	double first() const { return _first; }
+
+	/** Scheduling variable at the last point */
+	double last() const { return _last; }
+
+	/** True if the magnitude of the scheduling variable is looked up */
+	bool magnitude() const { return _magnitude; }
+
+	/** Gains at each point */
+	const PID_Gains* points() const { return _points.data(); }
+
+	/** Number of points */
+	std::size_t size() const { return _count; }
+
+    private:
+	/** Gains at each point */
+	std::array<PID_Gains, MAX_POINTS> _points{};
+
+	/** Scheduling variable at the first point */
+	double _first;
+
+	/** Scheduling variable at the last point */
+	double _last;
+
+	/** Number of points used */
+	std::size_t _count;
+
+	/** Rows per unit of the scheduling variable */
+	double _rowsPerUnit;
+
+	/** Look up the magnitude of the scheduling variable */
+	bool _magnitude;
+};
+
+/**
+ * @brief Gain schedule with the sample period of one controller folded into every point, for scheduling
+ * the gains on every sample. Each point holds Kp, Kd/dt and Ki*dt, so a lookup interpolates the gains
+ * the controller uses directly and setting them does no division. As folding is a scaling, this gives
+ * the same gains as GainSchedule::apply(), to rounding.
+ */
+class FoldedGainSchedule
+{
+    public:
+	/**
+	 * @brief Class constructor.
+	 * @param schedule Gain schedule to fold
+	 * @param dt Sample period of the controller the gains will be applied to
+	 * @retval None
+	 */
+	FoldedGainSchedule(const GainSchedule& schedule, double dt) : _folded(fold(schedule, dt)) {}
+
+	/**
+	 * @brief Look up the gains at a value of the scheduling variable and set them on a PID controller.
+	 * @param controller PID controller to set the gains of, with the sample period this schedule was folded with
+	 * @param x Scheduling variable
+	 * @retval None
+	 */
+	template <typename Controller>
+	void apply(Controller& controller, double x) const
+	{
+	    PID_Gains folded = _folded.lookup(x);
+	    controller.setFoldedGains(folded.Kp, folded.Kd, folded.Ki);
+	}
+
+    private:
+	/**
+	 * @brief Fold a sample period into every point of a schedule.
+	 * @param schedule Gain schedule to fold
+	 * @param dt Sample period
+	 * @retval GainSchedule Schedule of Kp, Kd/dt and Ki*dt
+	 */
+	static GainSchedule fold(const GainSchedule& schedule, double dt)
+	{
+	    std::array<PID_Gains, GainSchedule::MAX_POINTS> points{};
+	    for (std::size_t i = 0; i < schedule.size(); i++)
+		points[i] = {schedule.points()[i].Kp, schedule.points()[i].Kd / dt, schedule.points()[i].Ki * dt};
+	    return GainSchedule(schedule.first(), schedule.last(), points.data(), schedule.size(), schedule.magnitude());
+	}
+
+	/** Schedule of Kp, Kd/dt and Ki*dt */
+	GainSchedule _folded;
+};
+
+#endif
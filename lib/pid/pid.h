@@ -30,6 +30,8 @@
 #ifndef _PID_H_
 #define _PID_H_
 
+#include "pid_controller.h"
+
 /**
  * @brief PID controller callback interface.
  */
@@ -44,9 +46,10 @@ class PID_Interface
 };
 
 /**
- * @brief PID controller class.
+ * @brief PID controller class. This is the double precision PID controller with every term enabled,
+ * passing its output to a PID_Interface callback, so the callback can be chosen at runtime.
  */
-class PID
+class PID : public PIDController<double, PID_ALL, PID_Interface>
 {
     public:
 	/**
@@ -62,54 +65,8 @@ class PID
 	 * @param Ki Integral gain
 	 * @retval None
 	 */
-        PID(PID_Interface* pidInterface, double setpoint, double dt, double max, double min, double Kp, double Kd, double Ki);
-
-	/**
-	 * @brief This method will take a process variable, do PID stuff using this process variable and the
-	 * object attributes that contain the current setpoint, sample period, PID constants etc., then
-	 * pass the PID output to the registered callback.
-	 * @param pv Process variable (i.e. the feedback value)
-	 * @retval None
-	 */
-        void calculate(double pv);
-	
-	/**
-	 * @brief Setter to set the PID setpoint (desired plant output)
-	 * @param setpoint Setpoint value
-	 * @retval None
-	 */
-	void setSetpoint(double setpoint) { _setpoint = setpoint; }
-
-    private:
-	/** Sample period */
-        double _dt;
-
-	/** Maximum possible PID output value */
-        double _max;
-
-	/** Minimum possible PID output value */
-        double _min;
-
-	/** Proportional gain */
-        double _Kp;
-
-	/** Derivative gain */
-        double _Kd;
-
-	/** Integral gain */
-        double _Ki;
-
-	/** Previous error (acts as memory for derivative calculations) */
-        double _pre_error;
-
-	/** Accumulated integral for calculating integral component of the PID output */
-        double _integral;
-
-	/** Setpoint value */
-	double _setpoint;
-
-	/** Pointer to registered PID interface */
-	PID_Interface* _PIDcb = nullptr;
+        PID(PID_Interface* pidInterface, double setpoint, double dt, double max, double min, double Kp, double Kd, double Ki)
+	    : PIDController(pidInterface, setpoint, dt, max, min, Kp, Kd, Ki) {}
 };
 
 #endif
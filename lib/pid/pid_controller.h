@@ -0,0 +1,377 @@
+/**
+ * @file    pid_controller.h
+ * @author  Bradley J. Snyder
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the header-only PID controller template.
+ *
+ * Copyright 2019 Bradley J. Snyder <snyder.bradleyj@gmail.com>
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _PID_CONTROLLER_H_
+#define _PID_CONTROLLER_H_
+
+#include <cmath>
+#include <cstddef>
+
+/**
+ * @brief Terms a PIDController calculates, combined as bit flags. Terms that are not enabled are
+ * compiled out entirely, so e.g. a PI controller does no derivative work at all.
+ */
+enum PID_Terms : unsigned
+{
+    PID_P = 1,     /**< Proportional term */
+    PID_I = 2,     /**< Integral term */
+    PID_D = 4,     /**< Derivative term */
+    PID_LIMIT = 8, /**< Restrict the output to [min, max] */
+    PID_ALL = PID_P | PID_I | PID_D | PID_LIMIT
+};
+
+/**
+ * @brief How a PIDController stops its integral winding up while the output is limited.
+ */
+enum class PID_AntiWindup
+{
+    NONE,            /**< Always integrate */
+    CONDITIONAL,     /**< Stop integrating while the output is limited and the error would push it further */
+    BACK_CALCULATION /**< Bleed the amount the output is limited by back out of the integral */
+};
+
+/**
+ * @brief Set of PID gains, in the same order as the PIDController constructor takes them.
+ */
+struct PID_Gains
+{
+    double Kp; /**< Proportional gain */
+    double Kd; /**< Derivative gain */
+    double Ki; /**< Integral gain */
+};
+
+/**
+ * @brief PID controller template.
+ *
+ * The sample period is folded into the gains when they are set, so calculate() does no division:
+ * the integral accumulates Ki*dt*error and the derivative is Kd/dt*(error change).
+ * The output is passed to sink->hasOutput(). With a concrete (ideally final) sink class the call is
+ * resolved at compile time and can be inlined; with PID_Interface it is a virtual call.
+ *
+ * @tparam Scalar Number type of the calculation, e.g. double, float or Q16_16.
+ * @tparam Terms PID_Terms flags of the terms to calculate.
+ * @tparam Sink Type with a hasOutput(Scalar) method receiving each output.
+ */
+template <typename Scalar, unsigned Terms, typename Sink>
+class PIDController
+{
+    public:
+	/**
+	 * @brief Class constructor for setting PID attributes such as the PID constants,
+	 * and setting the sink that will be passed each new PID output.
+	 * @param sink Output sink pointer
+	 * @param setpoint Setpoint value
+	 * @param dt Sample period
+	 * @param max Maximum possible PID output value
+	 * @param min Minimum possible PID output value
+	 * @param Kp Proportional gain
+	 * @param Kd Derivative gain
+	 * @param Ki Integral gain
+	 * @retval None
+	 */
+	PIDController(Sink* sink, double setpoint, double dt, double max, double min, double Kp, double Kd, double Ki) :
+	    _max(static_cast<Scalar>(max)),
+	    _min(static_cast<Scalar>(min)),
+	    _Kp(static_cast<Scalar>(Kp)),
+	    _KiDt(static_cast<Scalar>(Ki * dt)),
+	    _KdInvDt(static_cast<Scalar>(Kd / dt)),
+	    _dt(dt),
+	    _state(),
+	    _setpoint(static_cast<Scalar>(setpoint)),
+	    _sink(sink)
+	{
+	}
+
+	/**
+	 * @brief This method will take a process variable, do PID stuff using this process variable and the
+	 * object attributes that contain the current setpoint, PID constants etc., then
+	 * pass the PID output to the sink.
+	 * @param pv Process variable (i.e. the feedback value)
+	 * @retval None
+	 */
+	void calculate(Scalar pv)
+	{
+	    Scalar proportional{};
+	    if constexpr ((Terms & PID_P) != 0)
+		proportional = _Kp * (_setpoint - pv);
+
+	    // Send output to the sink
+	    _sink->hasOutput(advance(pv, _setpoint, proportional, _state));
+	}
+
+	/**
+	 * @brief Run the controller over a batch of process variables, oldest first, e.g. a burst drained
+	 * from a sensor FIFO. Gives the same outputs as calling calculate() for each, but the error and
+	 * proportional terms are worked out for the whole batch in one loop the compiler can vectorise,
+	 * the integral and derivative state is kept in locals rather than reloaded for every sample, and
+	 * the sink is only passed the last output.
+	 * @param pv Array of process variables
+	 * @param out Array the output for each process variable is written to. It must not overlap pv.
+	 * @param count Number of process variables
+	 * @retval None
+	 */
+	void calculateBatch(const Scalar* pv, Scalar* out, std::size_t count)
+	{
+	    if (count == 0)
+		return;
+
+	    // The error and proportional terms have no state, so are worked out for every sample at once.
+	    const Scalar setpoint = _setpoint;
+	    if constexpr ((Terms & PID_P) != 0) {
+		const Scalar Kp = _Kp;
+		for (std::size_t i = 0; i < count; i++)
+		    out[i] = Kp * (setpoint - pv[i]);
+	    }
+	    else {
+		for (std::size_t i = 0; i < count; i++)
+		    out[i] = Scalar{};
+	    }
+
+	    // The integral and derivative terms carry state from one sample to the next. A local copy of it
+	    // can stay in registers, where as far as the compiler knows the members could alias out.
+	    State state = _state;
+	    for (std::size_t i = 0; i < count; i++)
+		out[i] = advance(pv[i], setpoint, out[i], state);
+	    _state = state;
+
+	    // Send the last output to the sink
+	    _sink->hasOutput(out[count - 1]);
+	}
+
+	/**
+	 * @brief Setter to set the PID setpoint (desired plant output)
+	 * @param setpoint Setpoint value
+	 * @retval None
+	 */
+	void setSetpoint(Scalar setpoint) { _setpoint = setpoint; }
+
+	/**
+	 * @brief Setter to change the PID constants while running. The integral is kept as its contribution
+	 * to the output, so changing Ki doesn't bump the output; only the new Ki applies from now on.
+	 * @param Kp Proportional gain
+	 * @param Kd Derivative gain
+	 * @param Ki Integral gain
+	 * @retval None
+	 */
+	void setGains(double Kp, double Kd, double Ki)
+	{
+	    _Kp = static_cast<Scalar>(Kp);
+	    _KiDt = static_cast<Scalar>(Ki * _dt);
+	    _KdInvDt = static_cast<Scalar>(Kd / _dt);
+	}
+
+	/**
+	 * @brief Setter to change the PID constants while running.
+	 * @param gains PID constants
+	 * @retval None
+	 */
+	void setGains(const PID_Gains& gains) { setGains(gains.Kp, gains.Kd, gains.Ki); }
+
+	/**
+	 * @brief Setter to change the PID constants while running, with the sample period already folded in,
+	 * so nothing is divided on the way. Used by FoldedGainSchedule on every sample.
+	 * @param Kp Proportional gain
+	 * @param KdInvDt Derivative gain divided by the sample period
+	 * @param KiDt Integral gain times the sample period
+	 * @retval None
+	 */
+	void setFoldedGains(double Kp, double KdInvDt, double KiDt)
+	{
+	    _Kp = static_cast<Scalar>(Kp);
+	    _KiDt = static_cast<Scalar>(KiDt);
+	    _KdInvDt = static_cast<Scalar>(KdInvDt);
+	}
+
+	/**
+	 * @brief Getter for the sample period.
+	 * @retval double Sample period
+	 */
+	double dt(void) const { return _dt; }
+
+	/**
+	 * @brief Setter to choose how integral windup is prevented while the output is limited.
+	 * Only has an effect when both the integral term and the output limit are enabled.
+	 * @param mode Anti-windup mode
+	 * @param trackingTime Time constant for bleeding the excess out of the integral with back-calculation.
+	 * Shorter unwinds faster; 0 (or anything up to the sample period) removes all of it on the next sample.
+	 * @retval None
+	 */
+	void setAntiWindup(PID_AntiWindup mode, double trackingTime = 0)
+	{
+	    _antiWindup = mode;
+	    _KtDt = static_cast<Scalar>(trackingTime > _dt ? _dt / trackingTime : 1.0);
+	}
+
+	/**
+	 * @brief Setter to take the derivative of the measurement rather than of the error, so setpoint
+	 * changes don't kick the output.
+	 * @param enable True for derivative on measurement, false for derivative on error
+	 * @retval None
+	 */
+	void setDerivativeOnMeasurement(bool enable) { _derivativeOnMeasurement = enable; }
+
+	/**
+	 * @brief Setter to low-pass filter the derivative term with a first order filter, to keep
+	 * sensor noise out of the output.
+	 * @param cutoff Cutoff frequency in Hz, or 0 to not filter
+	 * @retval None
+	 */
+	void setDerivativeFilter(double cutoff)
+	{
+	    _filterDerivative = cutoff > 0;
+	    if (_filterDerivative)
+		_alpha = static_cast<Scalar>(_dt / (_dt + 1 / (2 * M_PI * cutoff)));
+	}
+
+    private:
+	/**
+	 * @brief State carried from one sample to the next.
+	 */
+	struct State
+	{
+	    /** Previous error (acts as memory for derivative calculations) */
+	    Scalar pre_error{};
+
+	    /** Previous process variable (acts as memory for derivative on measurement) */
+	    Scalar pre_pv{};
+
+	    /** Integral component of the PID output, accumulated from Ki*dt*error */
+	    Scalar integral{};
+
+	    /** Filtered derivative component of the PID output */
+	    Scalar derivative{};
+	};
+
+	/**
+	 * @brief Add the integral and derivative terms to the proportional term, limit the output, and
+	 * move the state on to the next sample.
+	 * @param pv Process variable
+	 * @param setpoint Setpoint value
+	 * @param proportional Proportional term for this process variable
+	 * @param state State carried from the previous sample
+	 * @retval Scalar PID output
+	 */
+	Scalar advance(Scalar pv, Scalar setpoint, Scalar proportional, State& state) const
+	{
+	    // Calculate error
+	    Scalar error = setpoint - pv;
+	    Scalar output = proportional;
+
+	    // Derivative term, worked out first so conditional integration can see the whole output
+	    Scalar derivative{};
+	    if constexpr ((Terms & PID_D) != 0) {
+		// The derivative of the measurement ignores setpoint steps, which would otherwise kick the output
+		derivative = _KdInvDt * (_derivativeOnMeasurement ? state.pre_pv - pv : error - state.pre_error);
+		if (_filterDerivative) {
+		    state.derivative += _alpha * (derivative - state.derivative);
+		    derivative = state.derivative;
+		}
+		state.pre_error = error;
+		state.pre_pv = pv;
+	    }
+
+	    // Integral term
+	    if constexpr ((Terms & PID_I) != 0) {
+		Scalar step = _KiDt * error;
+		if constexpr ((Terms & PID_LIMIT) != 0) {
+		    if (_antiWindup == PID_AntiWindup::CONDITIONAL) {
+			Scalar total = output + derivative + state.integral + step;
+			if ((total > _max && step > Scalar{}) || (total < _min && step < Scalar{}))
+			    step = Scalar{};
+		    }
+		}
+		state.integral += step;
+		output += state.integral;
+	    }
+
+	    if constexpr ((Terms & PID_D) != 0)
+		output += derivative;
+
+	    // Restrict to max/min
+	    if constexpr ((Terms & PID_LIMIT) != 0) {
+		Scalar limited = output;
+		if (output > _max)
+		    limited = _max;
+		else if (output < _min)
+		    limited = _min;
+
+		if constexpr ((Terms & PID_I) != 0) {
+		    if (_antiWindup == PID_AntiWindup::BACK_CALCULATION)
+			state.integral += _KtDt * (limited - output);
+		}
+		output = limited;
+	    }
+
+	    return output;
+	}
+
+	/** Maximum possible PID output value */
+	Scalar _max;
+
+	/** Minimum possible PID output value */
+	Scalar _min;
+
+	/** Proportional gain */
+	Scalar _Kp;
+
+	/** Integral gain times the sample period */
+	Scalar _KiDt;
+
+	/** Derivative gain divided by the sample period */
+	Scalar _KdInvDt;
+
+	/** Sample period */
+	double _dt;
+
+	/** State carried from one sample to the next */
+	State _state;
+
+	/** Anti-windup mode */
+	PID_AntiWindup _antiWindup = PID_AntiWindup::NONE;
+
+	/** Sample period divided by the back-calculation tracking time */
+	Scalar _KtDt{};
+
+	/** Take the derivative of the measurement rather than the error */
+	bool _derivativeOnMeasurement = false;
+
+	/** Low-pass filter the derivative */
+	bool _filterDerivative = false;
+
+	/** Derivative filter coefficient, dt / (dt + 1 / (2 pi cutoff)) */
+	Scalar _alpha{};
+
+	/** Setpoint value */
+	Scalar _setpoint;
+
+	/** Pointer to the output sink */
+	Sink* _sink = nullptr;
+};
+
+#endif
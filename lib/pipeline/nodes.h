@@ -0,0 +1,310 @@
+/**
+ * @file    nodes.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the statically wired nodes the control pipelines are built from.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef NODES_H
+#define NODES_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include "../pid/gain_schedule.h"
+#include "../mpu6050/mpu6050.h"
+#include "../mpu6050/frame_convert.h"
+#include "../ina260/ina260.h"
+#include "../telemetry/telemetry.h"
+#include "../telemetry/latency.h"
+#include "../estimator/estimator.h"
+
+/**
+ * @brief Telemetry channels logged by the pipelines. Use telemetry_dump to convert the
+ * telemetry file into text, optionally filtering by channel.
+ */
+enum TelemetryChannel : uint16_t {
+  MPU_ANGLE = 0, /**< Angular position calculated from MPU samples (rad). */
+  OUTER_PID = 1, /**< Outer PID output (torque setpoint, or duty cycle delta in a single loop). */
+  INA_CURRENT = 2, /**< Current measured by the INA (A). */
+  INNER_PID = 3, /**< Inner PID output (duty cycle delta). */
+  MD20_DUTY = 4 /**< Duty cycle written to the PWM (ns). */
+};
+
+/**
+ * @brief Nodes of the control pipelines. Each node is a template on the type of the node it feeds, and calls
+ * it directly, so once a pipeline is put together the compiler can inline along every edge. The only virtual
+ * calls left are where a sensor driver or the control executor hands a sample to the first node.
+ */
+namespace Pipeline {
+
+  /**
+   * @brief Controller output node driving the motor driver. The output is taken as a corrective torque, so
+   * the duty cycle is changed by its negative.
+   * @tparam Actuator Motor driver type, with a setDutyCycleDelta(int) method. With a final class the call is direct.
+   */
+  template <typename Actuator>
+  class DriveMotor final
+  {
+  public:
+    /**
+     * @brief Constructor.
+     * @param _actuator Motor driver (real or simulated).
+     * @param _telemetry Telemetry producer of the thread running the controller.
+     * @param _channel Telemetry channel the controller output is logged to.
+     */
+    DriveMotor(Actuator& _actuator, Telemetry::Producer& _telemetry, uint16_t _channel)
+      : actuator(_actuator), telemetry(_telemetry), channel(_channel) {}
+
+    /**
+     * @brief Pass a controller output to the motor driver.
+     * @param pidOutput Controller output.
+     */
+    void hasOutput(double pidOutput) {
+      Telemetry::LatencyTrace::stamp(Telemetry::LatencyStage::CONTROL);
+      actuator.setDutyCycleDelta(-pidOutput); // If corrective torque is positive, then we need to change duty cycle by a negative amount, and vice versa.
+      telemetry.log(channel, pidOutput);
+    }
+
+  private:
+    /** Motor driver. */
+    Actuator& actuator;
+
+    /** Telemetry producer for logging controller outputs. */
+    Telemetry::Producer& telemetry;
+
+    /** Telemetry channel of the controller outputs. */
+    uint16_t channel;
+  };
+
+  /**
+   * @brief Controller output node setting the setpoint of the next controller down the cascade.
+   * @tparam Controller Controller type, with a setSetpoint(double) method.
+   */
+  template <typename Controller>
+  class DriveSetpoint final
+  {
+  public:
+    /**
+     * @brief Constructor.
+     * @param _controller Controller whose setpoint is driven.
+     * @param _telemetry Telemetry producer of the thread running the outer controller.
+     */
+    DriveSetpoint(Controller& _controller, Telemetry::Producer& _telemetry)
+      : controller(_controller), telemetry(_telemetry) {}
+
+    /**
+     * @brief Pass a controller output on as the setpoint of the next controller.
+     * @param pidOutput Controller output.
+     */
+    void hasOutput(double pidOutput) {
+      Telemetry::LatencyTrace::stamp(Telemetry::LatencyStage::CONTROL);
+      controller.setSetpoint(pidOutput);
+      telemetry.log(OUTER_PID, pidOutput);
+    }
+
+  private:
+    /** Controller whose setpoint is driven. */
+    Controller& controller;
+
+    /** Telemetry producer for logging outer controller outputs. */
+    Telemetry::Producer& telemetry;
+  };
+
+  /**
+   * @brief MPU6050 source node. This is where the magic happens for calculating the cup holder's angular
+   * position based on the IMU measurements, using an attitude estimator. The caclulated angular position is
+   * then sent to the position controller as the process variable.
+   * @tparam Controller Position controller type, a PIDController.
+   */
+  template <typename Controller>
+  class AngleFeedback final : public MPU6050_Driver::MPU6050Interface
+  {
+  public:
+    /**
+     * @brief Constructor.
+     * @param _controller Position controller.
+     * @param _estimator Attitude estimator turning samples into angular position.
+     * @param _telemetry Telemetry producer of the thread running the position loop.
+     */
+    AngleFeedback(Controller& _controller, Attitude::Estimator& _estimator, Telemetry::Producer& _telemetry)
+      : controller(_controller), estimator(_estimator), telemetry(_telemetry) {}
+
+    /**
+     * @brief Takes the sample data and caclulates the angular position of the cup holder, which is then
+     * passed to the position controller as the process variable.
+     * @param sample Measured accel, gyro, and temp data passed to the callback.
+     */
+    virtual void hasSample(MPU6050_Driver::MPU6050Sample& sample) override {
+      /*
+       * The maths here assumes:
+       * 1. The MPU is mounted with the chip, SMD components, axis info etc. visible (towards the back) and the text the right way round. README should have a pic.
+       * 2. Looking from the back of the cup holder, onto the face of the MPU, a positive angular displacement occurs clockwise, and negative anti-clockwise.
+       * 3. Angular displacement is zero when the cup holder is upright.
+       */
+
+      // Fuse the gyro rate with the accelerometer tilt to get the angular displacement in rad from upright.
+      feed(estimator.update(sample), sample.timestamp_ns);
+    }
+
+    /**
+     * @brief As hasSample(), straight from the raw frame, so only the axes the estimator uses are converted.
+     * @param frame Raw accel, gyro, and temp data passed to the callback.
+     */
+    virtual void hasFrame(const MPU6050_Driver::MPU6050Frame& frame) override {
+      feed(estimator.update(frame), frame.timestamp_ns);
+    }
+
+    /**
+     * @brief Calculates the angular position for every sample, then runs the position controller over them all
+     * at once, so only the last output is passed on.
+     * @param samples Array of samples drained from the FIFO, oldest first.
+     * @param count Number of samples in the array.
+     */
+    virtual void hasBatch(MPU6050_Driver::MPU6050Sample* samples, std::size_t count) override {
+      for (std::size_t start = 0; start < count; start += MPU6050_Driver::FIFO_MAX_FRAMES) {
+	std::size_t batchSize = std::min<std::size_t>(count - start, MPU6050_Driver::FIFO_MAX_FRAMES);
+
+	// The estimator has to see every sample in turn, but the controller can take the angles all at once.
+	for (std::size_t i = 0; i < batchSize; i++) {
+	  batchAngles[i] = estimator.update(samples[start + i]);
+	  telemetry.log(MPU_ANGLE, batchAngles[i], samples[start + i].timestamp_ns);
+	}
+	feedBatch(batchSize);
+      }
+
+      Telemetry::LatencyTrace::stamp(Telemetry::LatencyStage::LOGGING);
+    }
+
+    /**
+     * @brief As hasBatch(), straight from the axis arrays of a converted FIFO burst.
+     * @param batch Frames drained from the FIFO, oldest first.
+     */
+    virtual void hasAxes(const MPU6050_Driver::MPU6050Batch& batch) override {
+      for (uint16_t start = 0; start < batch.count; start += MPU6050_Driver::FIFO_MAX_FRAMES) {
+	uint16_t batchSize = std::min<uint16_t>(batch.count - start, MPU6050_Driver::FIFO_MAX_FRAMES);
+	for (uint16_t i = 0; i < batchSize; i++) {
+	  batchAngles[i] = estimator.update(batch, start + i);
+	  telemetry.log(MPU_ANGLE, batchAngles[i], batch.timestamp_ns[start + i]);
+	}
+	feedBatch(batchSize);
+      }
+
+      Telemetry::LatencyTrace::stamp(Telemetry::LatencyStage::LOGGING);
+    }
+
+    /**
+     * @brief Schedule the position controller's gains on the angular position. For a batch, the gains at the
+     * newest angle are used for the whole batch. The schedule is copied with the controller's sample period
+     * folded in, so call this again after changing it.
+     * @param schedule Gain schedule, or nullptr to keep the gains fixed.
+     */
+    void setGainSchedule(const GainSchedule* schedule) {
+      if (schedule)
+	gainSchedule.emplace(*schedule, controller.dt());
+      else
+	gainSchedule.reset();
+    }
+
+  private:
+    /**
+     * @brief Pass the angular positions of a batch to the position controller in one go.
+     * @param batchSize Number of angles in batchAngles.
+     */
+    void feedBatch(std::size_t batchSize) {
+      if (gainSchedule)
+	gainSchedule->apply(controller, batchAngles[batchSize - 1]);
+      controller.calculateBatch(batchAngles, batchOutputs, batchSize);
+    }
+
+    /**
+     * @brief Pass angular position to the position controller as PV.
+     * @param angularPos Angular position in rad.
+     * @param timestamp_ns Timestamp of the sample it was estimated from.
+     */
+    void feed(float angularPos, uint64_t timestamp_ns) {
+      if (gainSchedule)
+	gainSchedule->apply(controller, angularPos);
+      controller.calculate(angularPos);
+      telemetry.log(MPU_ANGLE, angularPos, timestamp_ns);
+      Telemetry::LatencyTrace::stamp(Telemetry::LatencyStage::LOGGING);
+    }
+
+    /** Position controller. */
+    Controller& controller;
+
+    /** Gain schedule for the controller, keyed on angular position. */
+    std::optional<FoldedGainSchedule> gainSchedule;
+
+    /** Angular positions of a batch, passed to the controller. */
+    double batchAngles[MPU6050_Driver::FIFO_MAX_FRAMES];
+
+    /** Controller outputs for a batch. */
+    double batchOutputs[MPU6050_Driver::FIFO_MAX_FRAMES];
+
+    /** Attitude estimator. */
+    Attitude::Estimator& estimator;
+
+    /** Telemetry producer for logging MPU measurements. */
+    Telemetry::Producer& telemetry;
+  };
+
+  /**
+   * @brief INA260 source node, feeding the measured current (torque) to the current controller as the
+   * process variable.
+   * @tparam Controller Current controller type, a PIDController.
+   */
+  template <typename Controller>
+  class CurrentFeedback final : public INA260_Driver::INA260Interface
+  {
+  public:
+    /**
+     * @brief Constructor.
+     * @param _controller Current controller.
+     * @param _telemetry Telemetry producer of the thread running the current loop.
+     */
+    CurrentFeedback(Controller& _controller, Telemetry::Producer& _telemetry)
+      : controller(_controller), telemetry(_telemetry) {}
+
+    /**
+     * @brief Pass the measured current (torque) to the current controller.
+     * @param sample Current measured by the INA260 passed to the callback.
+     */
+    virtual void hasSample(INA260_Driver::INA260Sample& sample) override {
+      controller.calculate(sample.current); // May want a scale factor to convert current -> torque (or just adjust PID constants)
+      telemetry.log(INA_CURRENT, sample.current, sample.timestamp_ns);
+      Telemetry::LatencyTrace::stamp(Telemetry::LatencyStage::LOGGING);
+    }
+
+  private:
+    /** Current controller. */
+    Controller& controller;
+
+    /** Telemetry producer for logging INA measurements. */
+    Telemetry::Producer& telemetry;
+  };
+
+} // namespace Pipeline
+
+#endif
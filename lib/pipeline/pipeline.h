@@ -0,0 +1,222 @@
+/**
+ * @file    pipeline.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the control pipelines the table can be run with, built from the settings.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "../pid/pid_controller.h"
+#include "../params/config.h"
+#include "../params/tuning.h"
+#include "../cascade/executor.h"
+#include "../cascade/tuner.h"
+#include "nodes.h"
+
+namespace Pipeline {
+
+  /**
+   * @brief Single loop: the MPU6050 angle feeds a position controller driving the motor driver directly.
+   * Everything runs on the thread that delivers the MPU samples.
+   * @tparam Actuator Motor driver type.
+   */
+  template <typename Actuator>
+  class SingleLoop
+  {
+  public:
+    /** Controller output node. */
+    using Motor = DriveMotor<Actuator>;
+
+    /** Position controller, calling the motor driver node directly. */
+    using PositionPID = PIDController<double, PID_ALL, Motor>;
+
+    /** MPU6050 source node. */
+    using Feedback = AngleFeedback<PositionPID>;
+
+    /**
+     * @brief Constructor, building the loop from the settings.
+     * @param config Settings the table is started with.
+     * @param actuator Motor driver.
+     * @param telemetry Telemetry producer of the thread delivering the MPU samples.
+     */
+    SingleLoop(const Params::Config& config, Actuator& actuator, Telemetry::Producer& telemetry)
+      : motor(actuator, telemetry, OUTER_PID),
+	positionPID(&motor, config.outerSetpoint, config.MPUSamplePeriod(), config.outerLimit, -config.outerLimit,
+		    config.outer.Kp, config.outer.Kd, config.outer.Ki),
+	estimator(config.mpuFilter, config.MPUSamplePeriod(), config.radius),
+	feedback(positionPID, estimator, telemetry) {}
+
+    /**
+     * @brief Callback to register with the MPU6050 driver.
+     * @retval MPU6050_Driver::MPU6050Interface& Start of the loop.
+     */
+    MPU6050_Driver::MPU6050Interface& mpuInput(void) { return feedback; }
+
+    /**
+     * @brief Position controller, e.g. to set its anti-windup or derivative modes before starting.
+     * @retval PositionPID& Position controller.
+     */
+    PositionPID& outerPID(void) { return positionPID; }
+
+    /**
+     * @brief MPU6050 source node, e.g. to set a gain schedule.
+     * @retval Feedback& Source node.
+     */
+    Feedback& outerFeedback(void) { return feedback; }
+
+  private:
+    /** Motor driver node. */
+    Motor motor;
+
+    /** Position controller. */
+    PositionPID positionPID;
+
+    /** Attitude estimator. */
+    Attitude::Estimator estimator;
+
+    /** MPU6050 source node. */
+    Feedback feedback;
+  };
+
+  /**
+   * @brief Cascade: the MPU6050 angle feeds a position controller setting the torque of an inner current
+   * controller, which the INA260 current feeds and which drives the motor driver. Both loops run on one
+   * control executor thread, so tuning can be applied between passes.
+   * @tparam Actuator Motor driver type.
+   */
+  template <typename Actuator>
+  class Cascade : public CascadeTuner::TargetInterface
+  {
+  public:
+    /** Inner controller output node. */
+    using Motor = DriveMotor<Actuator>;
+
+    /** Current controller, calling the motor driver node directly. */
+    using CurrentPID = PIDController<double, PID_ALL, Motor>;
+
+    /** Outer controller output node. */
+    using Setpoint = DriveSetpoint<CurrentPID>;
+
+    /** Position controller, calling the current controller's setpoint node directly. */
+    using PositionPID = PIDController<double, PID_ALL, Setpoint>;
+
+    /** MPU6050 source node. */
+    using OuterFeedback = AngleFeedback<PositionPID>;
+
+    /** INA260 source node. */
+    using InnerFeedback = CurrentFeedback<CurrentPID>;
+
+    /**
+     * @brief Constructor, building the cascade from the settings.
+     * @param config Settings the table is started with.
+     * @param actuator Motor driver.
+     * @param mpuTelemetry Telemetry producer for the outer loop.
+     * @param inaTelemetry Telemetry producer for the inner loop.
+     */
+    Cascade(const Params::Config& config, Actuator& actuator, Telemetry::Producer& mpuTelemetry, Telemetry::Producer& inaTelemetry)
+      : motor(actuator, inaTelemetry, INNER_PID),
+	currentPID(&motor, 0, config.INASamplePeriod(), std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(),
+		   config.inner.Kp, config.inner.Kd, config.inner.Ki),
+	setpoint(currentPID, mpuTelemetry),
+	positionPID(&setpoint, config.outerSetpoint, config.MPUSamplePeriod(), config.outerLimit, -config.outerLimit,
+		    config.outer.Kp, config.outer.Kd, config.outer.Ki),
+	estimator(config.mpuFilter, config.MPUSamplePeriod(), config.radius),
+	outerFeedback(positionPID, estimator, mpuTelemetry),
+	innerFeedback(currentPID, inaTelemetry),
+	executor(outerFeedback, innerFeedback) {
+      // The outer controller moves the inner setpoint on every MPU sample, so take the inner derivative from the
+      // measured current rather than the error, so each move doesn't kick the motor driver.
+      currentPID.setDerivativeOnMeasurement(true);
+    }
+
+    /**
+     * @brief Callback to register with the MPU6050 driver, posting samples to the control executor.
+     * @retval MPU6050_Driver::MPU6050Interface& Start of the outer loop.
+     */
+    MPU6050_Driver::MPU6050Interface& mpuInput(void) { return executor.mpuInput(); }
+
+    /**
+     * @brief Callback to register with the INA260 driver, posting samples to the control executor.
+     * @retval INA260_Driver::INA260Interface& Start of the inner loop.
+     */
+    INA260_Driver::INA260Interface& inaInput(void) { return executor.inaInput(); }
+
+    /**
+     * @brief Control executor running both loops.
+     * @retval CascadeExecutor& Control executor.
+     */
+    CascadeExecutor& controlExecutor(void) { return executor; }
+
+    /**
+     * @brief Current controller.
+     * @retval CurrentPID& Current controller.
+     */
+    CurrentPID& innerPID(void) { return currentPID; }
+
+    /**
+     * @brief Position controller.
+     * @retval PositionPID& Position controller.
+     */
+    PositionPID& outerPID(void) { return positionPID; }
+
+    /**
+     * @brief Apply tuning parameters. Call on the executor thread, e.g. through a CascadeTuner.
+     * @param tuning Parameters to apply, kept in place until the next call.
+     */
+    virtual void applyTuning(const Params::Tuning& tuning) override {
+      currentPID.setGains(tuning.inner);
+      positionPID.setSetpoint(tuning.outerSetpoint);
+      outerFeedback.setGainSchedule(&tuning.outer);
+    }
+
+  private:
+    /** Motor driver node. */
+    Motor motor;
+
+    /** Current controller. */
+    CurrentPID currentPID;
+
+    /** Node setting the current controller's setpoint. */
+    Setpoint setpoint;
+
+    /** Position controller. */
+    PositionPID positionPID;
+
+    /** Attitude estimator. */
+    Attitude::Estimator estimator;
+
+    /** MPU6050 source node. */
+    OuterFeedback outerFeedback;
+
+    /** INA260 source node. */
+    InnerFeedback innerFeedback;
+
+    /** Control executor running both loops. */
+    CascadeExecutor executor;
+  };
+
+} // namespace Pipeline
+
+#endif
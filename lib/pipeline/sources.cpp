@@ -0,0 +1,99 @@
+/**
+ * @file    sources.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the sensors that feed the control pipelines.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "sources.h"
+#include "../params/calibration.h"
+#include <iostream>
+
+namespace Pipeline {
+
+  MPU6050_Source::MPU6050_Source(const Params::Config& config, MPU6050_Driver::MPU6050Interface& callback)
+    : trace(config.mpuTrace.empty() ? nullptr : new TRACE_I2C_IF(&i2c, config.mpuTrace)),
+      cache(trace ? static_cast<I2C_Interface*>(trace.get()) : &i2c), mpu(&cache, &callback, config.mpuIntPin) {
+    i2c.Init_I2C(config.mpuAddress, config.mpuI2cFile);
+    cache.SetVolatileRegisters(config.mpuAddress, MPU6050_Driver::VOLATILE_REGS, sizeof(MPU6050_Driver::VOLATILE_REGS));
+
+    if (mpu.InitializeSensor(config.mpuGyroScale, config.mpuAccelScale, config.mpuDLPF, config.mpuSampleRateDiv,
+			     MPU6050_Driver::Regbits_INT_PIN_CFG::BIT_INT_RD_CLEAR,
+			     MPU6050_Driver::Regbits_INT_ENABLE::BIT_DATA_RDY_EN) != I2C_STATUS_SUCCESS)
+      std::cout << "Failed to write the settings to the MPU6050." << std::endl;
+    else if (!config.mpuCalibration.empty())
+      calibrate(config);
+
+    // Calibrating uses the FIFO, so the aquisition mode is set after it.
+    if (mpu.SetAcquisitionMode(config.mpuAcquisition, config.mpuBatchFrames) != I2C_STATUS_SUCCESS)
+      std::cout << "Failed to set the MPU6050 aquisition mode." << std::endl;
+    mpu.SetThreadConfig(config.mpuThread);
+  }
+
+  void MPU6050_Source::calibrate(const Params::Config& config) {
+    i2c_status_t result;
+    const uint32_t deviceID = mpu.GetDeviceID(&result);
+    if (result != I2C_STATUS_SUCCESS) {
+      std::cout << "Failed to read the MPU6050's ID, so it is left at its factory trim." << std::endl;
+      return;
+    }
+
+    // A saved calibration takes a few register writes, rather than seconds of sampling.
+    const std::string key = Params::CalibrationKey(config.mpuI2cFile, config.mpuAddress, deviceID);
+    MPU6050_Driver::MPU6050Offsets offsets;
+    if (Params::LoadCalibration(config.mpuCalibration, key, offsets)) {
+      if (mpu.SetOffsets(offsets) != I2C_STATUS_SUCCESS)
+	std::cout << "Failed to write the saved offsets to the MPU6050." << std::endl;
+      return;
+    }
+
+    std::cout << "Calibrating the MPU6050 " << key << ", keep the table still." << std::endl;
+    using MPU6050_Driver::Calibration_t;
+    const Calibration_t outcome = mpu.CalibrateOffsets(offsets, config.mpuRestAccel[0], config.mpuRestAccel[1],
+							config.mpuRestAccel[2]);
+    if (outcome == Calibration_t::UNSETTLED)
+      std::cout << "The MPU6050 offsets were still settling after the last pass." << std::endl;
+
+    // Offsets that are still settling are better than the factory trim, so they're saved too.
+    if (outcome == Calibration_t::DONE || outcome == Calibration_t::UNSETTLED)
+      Params::SaveCalibration(config.mpuCalibration, key, offsets);
+    else if (outcome == Calibration_t::MOVING)
+      std::cout << "The table moved while the MPU6050 was calibrating, so it is left at its factory trim." << std::endl;
+    else
+      std::cout << "Failed to calibrate the MPU6050." << std::endl;
+  }
+
+  INA260_Source::INA260_Source(const Params::Config& config, INA260_Driver::INA260Interface& callback)
+    : trace(config.inaTrace.empty() ? nullptr : new TRACE_I2C_IF(&i2c, config.inaTrace)),
+      cache(trace ? static_cast<I2C_Interface*>(trace.get()) : &i2c), ina(&cache, &callback, config.inaIntPin) {
+    i2c.Init_I2C(config.inaAddress, config.inaI2cFile);
+    cache.SetVolatileRegisters(config.inaAddress, INA260_Driver::VOLATILE_REGS, sizeof(INA260_Driver::VOLATILE_REGS));
+
+    // Only current is measured, which is all we need, so the current conversion time sets the sample period.
+    if (ina.InitializeSensor(INA260_Driver::Alert_Conf::CNVR, config.inaVoltConvTime, config.inaCurrConvTime,
+			     config.inaAveraging, INA260_Driver::Op_Mode::CURCONT) != I2C_STATUS_SUCCESS)
+      std::cout << "Failed to write the settings to the INA260." << std::endl;
+    ina.SetThreadConfig(config.inaThread);
+  }
+
+} // namespace Pipeline
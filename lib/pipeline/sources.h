@@ -0,0 +1,122 @@
+/**
+ * @file    sources.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the sensors that feed the control pipelines, set up from the settings.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SOURCES_H
+#define SOURCES_H
+
+#include "../i2c_interface/smbus_i2c_if.h"
+#include "../i2c_interface/cached_i2c_if.h"
+#include "../i2c_interface/trace_i2c_if.h"
+#include "../mpu6050/mpu6050.h"
+#include "../ina260/ina260.h"
+#include "../params/config.h"
+#include <memory>
+
+namespace Pipeline {
+
+  /**
+   * @brief MPU6050 on its I2C bus, with the configuration registers cached, set up from the settings and
+   * posting its samples to the start of a pipeline. The interrupt fires once per sample, which the data
+   * aquisition thread relies on, so that setting isn't configurable.
+   */
+  class MPU6050_Source
+  {
+  public:
+    /**
+     * @brief Constructor. Opens the I2C bus, starts recording it if a trace file is set, writes the settings
+     * to the sensor, and loads its offsets from the calibration file, calibrating it first if it isn't there.
+     * @param config Settings the table is started with.
+     * @param callback Start of the pipeline.
+     */
+    MPU6050_Source(const Params::Config& config, MPU6050_Driver::MPU6050Interface& callback);
+
+    /**
+     * @brief Sensor driver, e.g. to set a latency trace or start it.
+     * @retval MPU6050_Driver::MPU6050& Sensor driver.
+     */
+    MPU6050_Driver::MPU6050& driver(void) { return mpu; }
+
+  private:
+    /** I2C bus. */
+    SMBUS_I2C_IF i2c;
+
+    /** Recorder of every transaction on the bus, if a trace file is set. */
+    std::unique_ptr<TRACE_I2C_IF> trace;
+
+    /** Configuration register cache in front of the bus (and recorder). */
+    CACHED_I2C_IF cache;
+
+    /** Sensor driver. */
+    MPU6050_Driver::MPU6050 mpu;
+
+    /**
+     * @brief Write the sensor's saved offsets, or if it has none, calibrate it at rest and save them. A sensor
+     * that can't be calibrated is left at its factory trim, and tried again next time.
+     * @param config Settings the table is started with.
+     */
+    void calibrate(const Params::Config& config);
+  };
+
+  /**
+   * @brief INA260 on its I2C bus, with the configuration registers cached, set up from the settings and
+   * posting its samples to the start of a pipeline. The alert fires once per current conversion, which the
+   * data aquisition thread relies on, so that setting isn't configurable.
+   */
+  class INA260_Source
+  {
+  public:
+    /**
+     * @brief Constructor. Opens the I2C bus, starts recording it if a trace file is set, and writes the
+     * settings to the sensor.
+     * @param config Settings the table is started with.
+     * @param callback Start of the pipeline.
+     */
+    INA260_Source(const Params::Config& config, INA260_Driver::INA260Interface& callback);
+
+    /**
+     * @brief Sensor driver, e.g. to set a latency trace or start it.
+     * @retval INA260_Driver::INA260& Sensor driver.
+     */
+    INA260_Driver::INA260& driver(void) { return ina; }
+
+  private:
+    /** I2C bus. */
+    SMBUS_I2C_IF i2c;
+
+    /** Recorder of every transaction on the bus, if a trace file is set. */
+    std::unique_ptr<TRACE_I2C_IF> trace;
+
+    /** Configuration register cache in front of the bus (and recorder). */
+    CACHED_I2C_IF cache;
+
+    /** Sensor driver. */
+    INA260_Driver::INA260 ina;
+  };
+
+} // namespace Pipeline
+
+#endif
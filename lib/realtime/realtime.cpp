@@ -0,0 +1,93 @@
+/**
+ * @file    realtime.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the real-time thread configuration implementation.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "realtime.h"
+#include <alloca.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+namespace RealTime {
+
+/** Page size assumed when prefaulting the stack. Touching more often than needed is harmless. */
+static constexpr std::size_t PAGE_SIZE = 4096;
+
+/**
+ * @brief Touch the given number of bytes below the current stack frame. Kept out of line so the
+ * allocation is released as soon as it returns.
+ * @param size Number of bytes to touch.
+ */
+__attribute__((noinline)) static void prefaultStack(std::size_t size) {
+  volatile unsigned char* stack = static_cast<volatile unsigned char*>(alloca(size));
+  for (std::size_t i = 0; i < size; i += PAGE_SIZE)
+    stack[i] = 0;
+}
+
+uint8_t ApplyThreadConfig(const ThreadConfig& config, const std::string& name) {
+  uint8_t errors = NONE;
+
+  if (config.cpu >= 0) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(config.cpu, &cpus);
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (err != 0) {
+      std::cout << "Failed to pin " << name << " thread to CPU " << config.cpu << ": " << std::strerror(err) << "." << std::endl;
+      errors |= AFFINITY;
+    }
+  }
+
+  if (config.priority > 0) {
+    sched_param param = {};
+    param.sched_priority = config.priority;
+    int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (err != 0) {
+      std::cout << "Failed to set SCHED_FIFO priority " << config.priority << " for " << name << " thread: " << std::strerror(err)
+		<< (err == EPERM ? " (needs root, CAP_SYS_NICE or an rtprio limit)." : ".") << std::endl;
+      errors |= PRIORITY;
+    }
+  }
+
+  if (config.lockMemory) {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+      int err = errno;
+      std::cout << "Failed to lock memory for " << name << " thread: " << std::strerror(err)
+		<< (err == EPERM || err == ENOMEM ? " (needs root, CAP_IPC_LOCK or a memlock limit)." : ".") << std::endl;
+      errors |= MEMLOCK;
+    }
+  }
+
+  if (config.stackPrefault > 0)
+    prefaultStack(config.stackPrefault);
+
+  return errors;
+}
+
+} // namespace RealTime
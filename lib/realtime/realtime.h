@@ -0,0 +1,86 @@
+/**
+ * @file    realtime.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the real-time thread configuration declarations.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef REALTIME_H
+#define REALTIME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace RealTime {
+
+  /**
+   * @brief Errors from applying a thread configuration, as bit flags.
+   */
+  enum ThreadConfigError : uint8_t {
+    NONE = 0x00,     /**< Everything requested was applied. */
+    PRIORITY = 0x01, /**< SCHED_FIFO could not be set (needs CAP_SYS_NICE or an rtprio limit). */
+    AFFINITY = 0x02, /**< The thread could not be pinned to the requested CPU. */
+    MEMLOCK = 0x04   /**< Memory could not be locked (needs CAP_IPC_LOCK or a memlock limit). */
+  };
+
+  /**
+   * @brief Scheduling settings for a data aquisition thread. The defaults leave the thread
+   * exactly as std::thread creates it.
+   */
+  struct ThreadConfig {
+    /**
+     * @brief SCHED_FIFO priority, from 1 to 99. Zero leaves the thread on the default scheduler.
+     */
+    int priority = 0;
+
+    /**
+     * @brief CPU to pin the thread to, or -1 to let it run on any CPU.
+     */
+    int cpu = -1;
+
+    /**
+     * @brief Lock all current and future pages of the process into memory, so the loop never
+     * waits on a page fault. This applies to the whole process, not just the thread.
+     */
+    bool lockMemory = false;
+
+    /**
+     * @brief Number of bytes of stack to touch before the loop starts, so the pages are already
+     * mapped when it first needs them. Only useful with lockMemory.
+     */
+    std::size_t stackPrefault = 0;
+  };
+
+  /**
+   * @brief Apply a thread configuration to the calling thread. Anything that fails is reported on
+   * std::cout, and the rest is still applied, so the thread runs either way.
+   * @param config Settings to apply.
+   * @param name Name of the thread, used in messages.
+   * @retval uint8_t ThreadConfigError flags for everything that could not be applied.
+   */
+  uint8_t ApplyThreadConfig(const ThreadConfig& config, const std::string& name);
+
+} // namespace RealTime
+
+#endif
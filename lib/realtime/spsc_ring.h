@@ -0,0 +1,166 @@
+/**
+ * @file    spsc_ring.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the lock-free single producer, single consumer ring buffer.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace RealTime {
+
+  /**
+   * @brief Single producer, single consumer ring buffer. Pushing and popping are a couple of
+   * atomic operations and never block or make a system call, so a real-time thread can hand
+   * items to another thread without waiting for it. If the ring is full the item is dropped
+   * and counted rather than waiting for the consumer.
+   */
+  template <typename T>
+  class SPSCRing {
+  public:
+    /**
+     * @brief Constructor.
+     * @param capacity Number of items the ring can hold, rounded up to a power of two.
+     */
+    SPSCRing(std::size_t capacity) {
+      // Round capacity up to a power of two so ring indices can be wrapped with a mask.
+      std::size_t size = 2;
+      while (size < capacity)
+        size <<= 1;
+
+      mask = size - 1;
+      ring.reset(new T[size]);
+    }
+
+    /**
+     * @brief Claim the slot at the back of the ring, to be filled in place and then published
+     * with publish(). Only called by the producer thread.
+     * @retval T* Free slot, or nullptr if the ring is full and the item was dropped.
+     */
+    T* claim(void) {
+      const std::size_t currentHead = head.load(std::memory_order_relaxed);
+      if (currentHead - tail.load(std::memory_order_acquire) > mask) {
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+      }
+
+      return &ring[currentHead & mask];
+    }
+
+    /**
+     * @brief Publish the slot returned by claim() to the consumer thread. Only called by the
+     * producer thread, after claim() has returned a slot.
+     */
+    void publish(void) { head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    /**
+     * @brief Add an item to the back of the ring. Only called by the producer thread.
+     * @param item Item to copy into the ring.
+     * @retval bool False if the item was dropped because the ring was full.
+     */
+    bool push(const T& item) {
+      T* slot = claim();
+      if (slot == nullptr)
+        return false;
+
+      *slot = item;
+      publish();
+      return true;
+    }
+
+    /**
+     * @brief Item at the front of the ring. Only called by the consumer thread.
+     * @retval T* Oldest item, or nullptr if the ring is empty.
+     */
+    T* front(void) {
+      const std::size_t currentTail = tail.load(std::memory_order_relaxed);
+      if (currentTail == head.load(std::memory_order_acquire))
+        return nullptr;
+
+      return &ring[currentTail & mask];
+    }
+
+    /**
+     * @brief Remove the item at the front of the ring. Only called by the consumer thread,
+     * after front() has returned an item.
+     */
+    void pop(void) { tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    /**
+     * @brief Move up to maxItems items out of the ring. Only called by the consumer thread.
+     * @param out Array to copy the items into.
+     * @param maxItems Size of the out array.
+     * @retval std::size_t Number of items copied.
+     */
+    std::size_t drain(T* out, std::size_t maxItems) {
+      const std::size_t currentTail = tail.load(std::memory_order_relaxed);
+      std::size_t available = head.load(std::memory_order_acquire) - currentTail;
+      if (available > maxItems)
+        available = maxItems;
+
+      for (std::size_t i = 0; i < available; i++)
+        out[i] = ring[(currentTail + i) & mask];
+
+      // Hand the slots back to the producer.
+      tail.store(currentTail + available, std::memory_order_release);
+      return available;
+    }
+
+    /**
+     * @brief Number of items dropped because the ring was full.
+     * @retval uint64_t Dropped item count.
+     */
+    uint64_t dropped(void) const { return droppedCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Number of slots in the ring.
+     * @retval std::size_t Ring capacity.
+     */
+    std::size_t capacity(void) const { return mask + 1; }
+
+  private:
+    /** Capacity minus one, used to wrap ring indices. */
+    std::size_t mask;
+
+    /** Item storage. */
+    std::unique_ptr<T[]> ring;
+
+    /** Write index, only modified by the producer thread. */
+    alignas(64) std::atomic<std::size_t> head{0};
+
+    /** Read index, only modified by the consumer thread. */
+    alignas(64) std::atomic<std::size_t> tail{0};
+
+    /** Number of items dropped on overflow. */
+    alignas(64) std::atomic<uint64_t> droppedCount{0};
+  };
+
+} // namespace RealTime
+
+#endif
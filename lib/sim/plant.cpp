@@ -0,0 +1,103 @@
+/**
+ * @file    plant.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the physics model of the cup holder used by the offline simulator.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "plant.h"
+#include <cmath>
+
+namespace Sim {
+
+Plant::Plant(const PlantParams& _params, double initialAngle)
+    : params(_params), generator(_params.seed), normal(0.0, 1.0) {
+  state.angle = initialAngle;
+}
+
+void Plant::setDutyCycle(double dutyCycle) {
+  if (dutyCycle > 1)
+    dutyCycle = 1;
+  else if (dutyCycle < -1)
+    dutyCycle = -1;
+
+  state.dutyCycle = dutyCycle;
+}
+
+void Plant::step(double dt) {
+  const double Kt = params.torqueConstant;
+
+  // No inductance, so the current is set by the applied voltage less the back EMF.
+  state.motorCurrent = (params.supplyVoltage * state.dutyCycle - Kt * state.wheelVelocity) / params.resistance;
+
+  // The motor torque spins the wheel one way and the cup holder the other.
+  const double wheelAcceleration = (Kt * state.motorCurrent - params.wheelDamping * state.wheelVelocity) / params.wheelInertia;
+  state.angularAcceleration = (params.gravityTorque * std::sin(state.angle)
+			       - params.bodyDamping * state.angularVelocity
+			       - Kt * state.motorCurrent) / params.bodyInertia;
+
+  // Semi-implicit Euler: update the velocities first, then the positions with the new velocities.
+  state.wheelVelocity += wheelAcceleration * dt;
+  state.angularVelocity += state.angularAcceleration * dt;
+  state.angle += state.angularVelocity * dt;
+
+  // End stops. Inelastic, so the cup holder just stops.
+  if (state.angle > params.angleLimit || state.angle < -params.angleLimit) {
+    state.angle = std::copysign(params.angleLimit, state.angle);
+    state.angularVelocity = 0;
+    state.angularAcceleration = 0;
+  }
+
+  time += dt;
+}
+
+void Plant::readAccel(double& ax, double& ay, double& az) {
+  const double r = params.mpuRadius;
+  const double w = state.angularVelocity;
+
+  // Specific force in the MPU frame: y points away from the pivot, x is tangential. A positive (clockwise)
+  // angle is a negative rotation about the MPU's Z axis, so gravity tips into -x and the tangential
+  // acceleration into +x.
+  ax = (-GRAVITY * std::sin(state.angle) + state.angularAcceleration * r) / GRAVITY + noise(params.accelNoise);
+  ay = (GRAVITY * std::cos(state.angle) - w * w * r) / GRAVITY + noise(params.accelNoise);
+  az = noise(params.accelNoise);
+}
+
+double Plant::readGyroZ(void) {
+  // Z points out of the face of the MPU, so a clockwise rotation reads negative.
+  return -state.angularVelocity * 180.0 / M_PI + noise(params.gyroNoise);
+}
+
+double Plant::readCurrent(void) {
+  return -state.motorCurrent + noise(params.currentNoise);
+}
+
+double Plant::noise(double stddev) {
+  // Don't draw from the generator when noise is off, so turning one source on doesn't change the others.
+  if (stddev == 0)
+    return 0;
+
+  return stddev * normal(generator);
+}
+
+} // namespace Sim
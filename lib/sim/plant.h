@@ -0,0 +1,215 @@
+/**
+ * @file    plant.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the physics model of the cup holder used by the offline simulator.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SIM_PLANT_H
+#define SIM_PLANT_H
+
+#include <cstdint>
+#include <random>
+
+namespace Sim {
+
+  /** Standard gravity in m/s^2, the same value the MPU callback uses. */
+  static constexpr double GRAVITY = 9.80665;
+
+  /**
+   * @brief Physical constants of the cup holder, motor and sensors. The defaults are rough
+   * estimates of the real hardware, good enough to exercise the control loops.
+   */
+  struct PlantParams {
+    /** Gravity torque at 90 degrees from upright, m*g*l, in N*m. */
+    double gravityTorque = 0.49;
+
+    /** Moment of inertia of the cup holder (without the wheel) about the pivot, in kg*m^2. */
+    double bodyInertia = 0.1;
+
+    /** Viscous friction at the pivot, in N*m*s/rad. */
+    double bodyDamping = 0.002;
+
+    /** Moment of inertia of the reaction wheel, in kg*m^2. */
+    double wheelInertia = 5e-4;
+
+    /** Viscous friction of the wheel bearing and motor, in N*m*s/rad. */
+    double wheelDamping = 1e-5;
+
+    /** Motor torque constant (and back EMF constant), in N*m/A. */
+    double torqueConstant = 0.05;
+
+    /** Motor winding resistance, in ohms. */
+    double resistance = 2.0;
+
+    /** Motor driver supply voltage, in volts. */
+    double supplyVoltage = 12.0;
+
+    /** Distance from the pivot to the MPU, in meters. */
+    double mpuRadius = 0.15;
+
+    /** Angle of the end stops either side of upright, in rad. The cup holder stops dead when it hits one. */
+    double angleLimit = 0.6;
+
+    /** Standard deviation of the accelerometer noise, in g. */
+    double accelNoise = 0;
+
+    /** Standard deviation of the gyroscope noise, in deg/s. */
+    double gyroNoise = 0;
+
+    /** Standard deviation of the current measurement noise, in A. */
+    double currentNoise = 0;
+
+    /** Seed of the noise generator. The same seed always gives the same noise. */
+    uint32_t seed = 1;
+  };
+
+  /**
+   * @brief Plant state. Angles follow the convention in MPU6050_Feedback: zero is upright,
+   * and positive is clockwise looking onto the face of the MPU.
+   */
+  struct PlantState {
+    /** Angular position of the cup holder, in rad. */
+    double angle = 0;
+
+    /** Angular velocity of the cup holder, in rad/s. */
+    double angularVelocity = 0;
+
+    /** Angular acceleration of the cup holder during the last step, in rad/s^2. */
+    double angularAcceleration = 0;
+
+    /** Angular velocity of the reaction wheel relative to the cup holder, in rad/s. */
+    double wheelVelocity = 0;
+
+    /** Motor current, in A. Positive current accelerates the wheel clockwise. */
+    double motorCurrent = 0;
+
+    /** Duty cycle applied to the motor, between -1 and 1. */
+    double dutyCycle = 0;
+  };
+
+  /**
+   * @brief Inverted pendulum with a reaction wheel, driven by a DC motor. The motor
+   * inductance is neglected, so the motor current follows the duty cycle instantly:
+   *   i = (Vs * d - Kt * w_wheel) / R
+   *   J * a = m*g*l * sin(angle) - b * w - Kt * i
+   *   Jw * a_wheel = Kt * i - bw * w_wheel
+   * The state is advanced with semi-implicit Euler steps, so a run only depends on the
+   * step size, the inputs and the noise seed, and is exactly repeatable.
+   */
+  class Plant {
+  public:
+    /**
+     * @brief Class constructor.
+     * @param _params Physical constants.
+     * @param initialAngle Starting angular position, in rad.
+     */
+    Plant(const PlantParams& _params = PlantParams(), double initialAngle = 0);
+
+    /**
+     * @brief Set the duty cycle applied to the motor.
+     * @param dutyCycle Duty cycle between -1 and 1. Out of range values are clamped.
+     */
+    void setDutyCycle(double dutyCycle);
+
+    /**
+     * @brief Advance the model.
+     * @param dt Time step in seconds.
+     */
+    void step(double dt);
+
+    /**
+     * @brief Current state of the model.
+     * @retval const PlantState& State.
+     */
+    const PlantState& getState(void) const { return state; }
+
+    /**
+     * @brief Physical constants of the model.
+     * @retval const PlantParams& Parameters.
+     */
+    const PlantParams& getParams(void) const { return params; }
+
+    /**
+     * @brief Time simulated so far, in seconds.
+     * @retval double Virtual time.
+     */
+    double getTime(void) const { return time; }
+
+    /**
+     * @brief Accelerometer reading at the MPU, including gravity and the centripetal and
+     * tangential accelerations of the rotating cup holder (the centripetal part is
+     * what the attitude estimator corrects for).
+     * @param ax X axis (tangential) acceleration in g.
+     * @param ay Y axis (radial) acceleration in g.
+     * @param az Z axis acceleration in g.
+     */
+    void readAccel(double& ax, double& ay, double& az);
+
+    /**
+     * @brief Gyroscope reading about the axis of rotation. The Z axis points out of the face of the
+     * MPU, so this is minus the angular velocity of the cup holder.
+     * @retval double Z axis angular velocity in deg/s.
+     */
+    double readGyroZ(void);
+
+    /**
+     * @brief Current reading of the INA260, which sits in the motor supply the opposite
+     * way round to positive motor current.
+     * @retval double Measured current in A.
+     */
+    double readCurrent(void);
+
+    /**
+     * @brief Bus voltage reading of the INA260.
+     * @retval double Measured voltage in V.
+     */
+    double readVoltage(void) const { return params.supplyVoltage; }
+
+  private:
+    /**
+     * @brief Draw a noise sample.
+     * @param stddev Standard deviation, or zero for no noise.
+     * @retval double Noise sample.
+     */
+    double noise(double stddev);
+
+    /** Physical constants. */
+    PlantParams params;
+
+    /** Model state. */
+    PlantState state;
+
+    /** Virtual time in seconds. */
+    double time = 0;
+
+    /** Noise generator. */
+    std::mt19937 generator;
+
+    /** Unit normal distribution, scaled by the noise standard deviations. */
+    std::normal_distribution<double> normal;
+  };
+
+} // namespace Sim
+
+#endif
@@ -0,0 +1,347 @@
+/**
+  ******************************************************************************
+  * @file    sim_i2c_if.cpp
+  * @author  Adam Englebright
+  * @date    16.10.2026
+  * @brief   This file constains the implementation of a simulated I2C bus, with an MPU6050
+  * and an INA260 whose measurements come from the plant model.
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Adam Englebright
+  * 
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  * 
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  */
+
+#include "sim_i2c_if.h"
+#include "../mpu6050/mpu6050.h"
+#include "../ina260/ina260.h"
+#include <cmath>
+#include <cstring>
+
+namespace MPU = MPU6050_Driver;
+namespace INA = INA260_Driver;
+
+/** MPU6050 WHO_AM_I register, and the value it holds */
+#define SIM_MPU6050_WHO_AM_I 0x75
+/** INT_STATUS bits */
+#define SIM_MPU6050_DATA_RDY_INT BIT_0
+#define SIM_MPU6050_FIFO_OFLOW_INT BIT_4
+
+/** INA260 power on register values, from the datasheet */
+#define SIM_INA260_CONF_DEFAULT 0x6127
+#define SIM_INA260_MAN_ID 0x5449
+#define SIM_INA260_DIE_ID 0x2270
+/** INA260 CONF reset bit, and MASKEN flag bits */
+#define SIM_INA260_RST (1 << 15)
+#define SIM_INA260_AFF (1 << 4)
+#define SIM_INA260_CVRF (1 << 3)
+#define SIM_INA260_MASKEN_FLAGS 0x03FE
+
+/** Temperature reported by the simulated MPU6050, in degrees C */
+#define SIM_MPU6050_TEMPERATURE 25.0
+
+/**
+  * @brief  Convert a measurement into a saturated 16 bit register value.
+  * @param  value Measurement
+  * @param  lsb Value of one least significant bit
+  * @retval int16_t Register value
+  */
+static int16_t ToRaw(double value, double lsb)
+{
+	double raw = std::round(value / lsb);
+	if (raw > 32767)
+		raw = 32767;
+	else if (raw < -32768)
+		raw = -32768;
+
+	return (int16_t)raw;
+}
+
+SIM_I2C_IF::SIM_I2C_IF(Sim::Plant &_plant, i2c_clockspeed_t _clock) : plant(_plant), clock((uint32_t)_clock)
+{
+	ResetMPU6050();
+	ResetINA260();
+}
+
+void SIM_I2C_IF::ResetMPU6050(void)
+{
+	std::memset(mpuRegs, 0, sizeof(mpuRegs));
+	mpuRegs[MPU::Sensor_Regs::PWR_MGMT_1] = MPU::Regbits_PWR_MGMT_1::BIT_SLEEP;
+	mpuRegs[SIM_MPU6050_WHO_AM_I] = MPU6050_ADDRESS_AD0;
+	mpuFIFO.clear();
+}
+
+void SIM_I2C_IF::ResetINA260(void)
+{
+	std::memset(inaRegs, 0, sizeof(inaRegs));
+	inaRegs[INA::Sensor_Regs::CONF_REG] = SIM_INA260_CONF_DEFAULT;
+	inaRegs[INA::Sensor_Regs::MAN_ID] = SIM_INA260_MAN_ID;
+	inaRegs[INA::Sensor_Regs::DIE_ID] = SIM_INA260_DIE_ID;
+}
+
+void SIM_I2C_IF::SetMPU6050Word(uint8_t regAddress, int16_t value)
+{
+	mpuRegs[regAddress] = (uint16_t)value >> 8;
+	mpuRegs[regAddress + 1] = (uint16_t)value & 0xFF;
+}
+
+void SIM_I2C_IF::LatchMPU6050(void)
+{
+	std::lock_guard<std::mutex> lock(busMutex);
+	if (mpuRegs[MPU::Sensor_Regs::PWR_MGMT_1] & MPU::Regbits_PWR_MGMT_1::BIT_SLEEP)
+		return;
+
+	// Full scale ranges are in bits 3 and 4 of the config registers, in the same order as Accel_FS_t and Gyro_FS_t.
+	const double accelLSB = (2 << ((mpuRegs[MPU::Sensor_Regs::ACCEL_CONFIG] >> 3) & 0x03)) / 32767.0;
+	const double gyroLSB = (250 << ((mpuRegs[MPU::Sensor_Regs::GYRO_CONFIG] >> 3) & 0x03)) / 32767.0;
+
+	double ax, ay, az;
+	plant.readAccel(ax, ay, az);
+	SetMPU6050Word(MPU::Sensor_Regs::ACCEL_X_OUT_H, ToRaw(ax, accelLSB));
+	SetMPU6050Word(MPU::Sensor_Regs::ACCEL_Y_OUT_H, ToRaw(ay, accelLSB));
+	SetMPU6050Word(MPU::Sensor_Regs::ACCEL_Z_OUT_H, ToRaw(az, accelLSB));
+	SetMPU6050Word(MPU::Sensor_Regs::TEMP_OUT_H, ToRaw((SIM_MPU6050_TEMPERATURE - 36.53) * 340.0, 1.0));
+	SetMPU6050Word(MPU::Sensor_Regs::GYRO_X_OUT_H, 0);
+	SetMPU6050Word(MPU::Sensor_Regs::GYRO_Y_OUT_H, 0);
+	SetMPU6050Word(MPU::Sensor_Regs::GYRO_Z_OUT_H, ToRaw(plant.readGyroZ(), gyroLSB));
+	mpuRegs[MPU::Sensor_Regs::INT_STATUS] |= SIM_MPU6050_DATA_RDY_INT;
+
+	if (!(mpuRegs[MPU::Sensor_Regs::USER_CTRL] & MPU::Regbits_USER_CTRL::BIT_FIFO_EN))
+		return;
+
+	// Frames are written in register order, skipping anything not enabled in FIFO_EN.
+	const uint8_t fifoEnable = mpuRegs[MPU::Sensor_Regs::FIFO_EN];
+	const struct { uint8_t bit; uint8_t reg; uint8_t length; } sources[] = {
+		{MPU::Regbits_FIFO_EN::BIT_ACCEL_FIFO_EN, MPU::Sensor_Regs::ACCEL_X_OUT_H, 6},
+		{MPU::Regbits_FIFO_EN::BIT_TEMP_FIFO_EN, MPU::Sensor_Regs::TEMP_OUT_H, 2},
+		{MPU::Regbits_FIFO_EN::BIT_XG_FIFO_EN, MPU::Sensor_Regs::GYRO_X_OUT_H, 2},
+		{MPU::Regbits_FIFO_EN::BIT_YG_FIFO_EN, MPU::Sensor_Regs::GYRO_Y_OUT_H, 2},
+		{MPU::Regbits_FIFO_EN::BIT_ZG_FIFO_EN, MPU::Sensor_Regs::GYRO_Z_OUT_H, 2}};
+
+	for (const auto &source : sources) {
+		if (!(fifoEnable & source.bit))
+			continue;
+		for (uint8_t i = 0; i < source.length; i++)
+			mpuFIFO.push_back(mpuRegs[source.reg + i]);
+	}
+
+	// A full FIFO overwrites its oldest data.
+	if (mpuFIFO.size() > MPU::FIFO_SIZE) {
+		mpuFIFO.erase(mpuFIFO.begin(), mpuFIFO.begin() + (mpuFIFO.size() - MPU::FIFO_SIZE));
+		mpuRegs[MPU::Sensor_Regs::INT_STATUS] |= SIM_MPU6050_FIFO_OFLOW_INT;
+	}
+}
+
+void SIM_I2C_IF::LatchINA260(void)
+{
+	std::lock_guard<std::mutex> lock(busMutex);
+	const double current = plant.readCurrent();
+	const double voltage = plant.readVoltage();
+
+	inaRegs[INA::Sensor_Regs::CURRENT_REG] = (uint16_t)ToRaw(current, INA::ReadingBases::CURRENT);
+	inaRegs[INA::Sensor_Regs::VOLTAGE_REG] = (uint16_t)ToRaw(voltage, INA::ReadingBases::VOLTAGE);
+	inaRegs[INA::Sensor_Regs::POWER_REG] = (uint16_t)ToRaw(std::fabs(current * voltage), INA::ReadingBases::POWER);
+	inaRegs[INA::Sensor_Regs::MASKEN_REG] |= SIM_INA260_CVRF;
+}
+
+i2c_status_t SIM_I2C_IF::ReadBytes(uint8_t slaveAddress, uint8_t regAddress, uint16_t length, uint8_t *data)
+{
+	CountTransfer(length);
+
+	if (slaveAddress == MPU6050_ADDRESS) {
+		for (uint16_t i = 0; i < length; i++) {
+			// FIFO reads stay on FIFO_R_W, everything else auto-increments.
+			uint8_t reg = (regAddress == MPU::Sensor_Regs::FIFO_R_W) ? regAddress : regAddress + i;
+
+			if (reg == MPU::Sensor_Regs::FIFO_R_W) {
+				if (mpuFIFO.empty()) {
+					data[i] = 0xFF;
+				} else {
+					data[i] = mpuFIFO.front();
+					mpuFIFO.pop_front();
+				}
+			} else if (reg == MPU::Sensor_Regs::FIFO_COUNT_H) {
+				data[i] = mpuFIFO.size() >> 8;
+			} else if (reg == MPU::Sensor_Regs::FIFO_COUNT_L) {
+				data[i] = mpuFIFO.size() & 0xFF;
+			} else {
+				data[i] = mpuRegs[reg];
+				if (reg == MPU::Sensor_Regs::INT_STATUS)
+					mpuRegs[reg] = 0; // Cleared by reading
+			}
+		}
+		return I2C_STATUS_SUCCESS;
+	}
+
+	if (slaveAddress == INA260_ADDRESS) {
+		// INA260 registers are 16 bits, MSB first, and reads keep returning the same register.
+		const uint16_t value = inaRegs[regAddress];
+		for (uint16_t i = 0; i < length; i++)
+			data[i] = (i % 2 == 0) ? (value >> 8) : (value & 0xFF);
+
+		// Reading MASKEN clears the flags and releases the alert pin.
+		if (regAddress == INA::Sensor_Regs::MASKEN_REG && length > 0)
+			inaRegs[regAddress] &= ~(SIM_INA260_CVRF | SIM_INA260_AFF);
+		return I2C_STATUS_SUCCESS;
+	}
+
+	return I2C_STATUS_ERROR;
+}
+
+i2c_status_t SIM_I2C_IF::WriteBytes(uint8_t slaveAddress, uint8_t regAddress, uint16_t length, const uint8_t *data)
+{
+	CountTransfer(length + 1); // Register address byte too
+
+	if (slaveAddress == MPU6050_ADDRESS) {
+		for (uint16_t i = 0; i < length; i++) {
+			uint8_t reg = regAddress + i;
+
+			if (reg == MPU::Sensor_Regs::PWR_MGMT_1 && (data[i] & MPU::Regbits_PWR_MGMT_1::BIT_DEVICE_RESET)) {
+				ResetMPU6050();
+			} else if (reg == MPU::Sensor_Regs::USER_CTRL) {
+				if (data[i] & MPU::Regbits_USER_CTRL::BIT_FIFO_RESET)
+					mpuFIFO.clear();
+				mpuRegs[reg] = data[i] & ~MPU::Regbits_USER_CTRL::BIT_FIFO_RESET; // Self clearing
+			} else if (reg == MPU::Sensor_Regs::FIFO_R_W) {
+				mpuFIFO.push_back(data[i]);
+			} else if (reg != MPU::Sensor_Regs::INT_STATUS && reg != SIM_MPU6050_WHO_AM_I) {
+				mpuRegs[reg] = data[i];
+			}
+		}
+		return I2C_STATUS_SUCCESS;
+	}
+
+	if (slaveAddress == INA260_ADDRESS) {
+		// A bare register address just moves the pointer. Otherwise the INA260 ignores anything
+		// but whole 16 bit writes.
+		if (length == 0)
+			return I2C_STATUS_SUCCESS;
+		if (length != 2)
+			return I2C_STATUS_ERROR;
+
+		const uint16_t value = ((uint16_t)data[0] << 8) | data[1];
+		if (regAddress == INA::Sensor_Regs::CONF_REG && (value & SIM_INA260_RST)) {
+			ResetINA260();
+		} else if (regAddress == INA::Sensor_Regs::CONF_REG || regAddress == INA::Sensor_Regs::ALERT_LIM) {
+			inaRegs[regAddress] = value;
+		} else if (regAddress == INA::Sensor_Regs::MASKEN_REG) {
+			// Flag bits are read only.
+			inaRegs[regAddress] = (value & ~SIM_INA260_MASKEN_FLAGS) | (inaRegs[regAddress] & SIM_INA260_MASKEN_FLAGS);
+		}
+		return I2C_STATUS_SUCCESS;
+	}
+
+	return I2C_STATUS_ERROR;
+}
+
+uint8_t SIM_I2C_IF::ReadRegister(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status)
+{
+	std::lock_guard<std::mutex> lock(busMutex);
+	uint8_t data = 0;
+	i2c_status_t result = ReadBytes(slaveAddress, regAddress, 1, &data);
+	status && (*status = result);
+	return data;
+}
+
+uint16_t SIM_I2C_IF::ReadRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status)
+{
+	std::lock_guard<std::mutex> lock(busMutex);
+	uint8_t data[2] = {0, 0};
+	i2c_status_t result = ReadBytes(slaveAddress, regAddress, 2, data);
+	status && (*status = result);
+	return ((uint16_t)data[1] << 8) | data[0];
+}
+
+uint16_t SIM_I2C_IF::ReadRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status)
+{
+	std::lock_guard<std::mutex> lock(busMutex);
+	uint8_t data[2] = {0, 0};
+	i2c_status_t result = ReadBytes(slaveAddress, regAddress, 2, data);
+	status && (*status = result);
+	return ((uint16_t)data[0] << 8) | data[1];
+}
+
+i2c_status_t SIM_I2C_IF::WriteRegister(uint8_t slaveAddress, uint8_t regAddress, uint8_t data)
+{
+	std::lock_guard<std::mutex> lock(busMutex);
+	return WriteBytes(slaveAddress, regAddress, 1, &data);
+}
+
+i2c_status_t SIM_I2C_IF::WriteRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data)
+{
+	std::lock_guard<std::mutex> lock(busMutex);
+	const uint8_t bytes[2] = {(uint8_t)(data & 0xFF), (uint8_t)(data >> 8)};
+	return WriteBytes(slaveAddress, regAddress, 2, bytes);
+}
+
+i2c_status_t SIM_I2C_IF::WriteRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data)
+{
+	std::lock_guard<std::mutex> lock(busMutex);
+	const uint8_t bytes[2] = {(uint8_t)(data >> 8), (uint8_t)(data & 0xFF)};
+	return WriteBytes(slaveAddress, regAddress, 2, bytes);
+}
+
+i2c_status_t SIM_I2C_IF::ReadRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data)
+{
+	std::lock_guard<std::mutex> lock(busMutex);
+	return ReadBytes(slaveAddress, regAddress, length, data);
+}
+
+i2c_status_t SIM_I2C_IF::WriteRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data)
+{
+	std::lock_guard<std::mutex> lock(busMutex);
+	return WriteBytes(slaveAddress, regAddress, length, data);
+}
+
+/**
+  * @brief  Combined transfer. A write segment sets the device's register pointer from its first
+  * byte and writes any further bytes, and a read segment reads from the last pointer set.
+  * @param  segments Transfer segments, in bus order
+  * @param  count Number of segments
+  * @retval i2c_status_t
+  */
+i2c_status_t SIM_I2C_IF::TransferSegments(i2c_segment_t *segments, uint8_t count)
+{
+	if (count == 0 || count > I2C_MAX_SEGMENTS)
+		return I2C_STATUS_ERROR;
+
+	std::lock_guard<std::mutex> lock(busMutex);
+	uint8_t pointers[256] = {0};
+
+	for (uint8_t i = 0; i < count; i++) {
+		i2c_segment_t &segment = segments[i];
+		i2c_status_t status;
+
+		if (segment.read) {
+			status = ReadBytes(segment.slaveAddress, pointers[segment.slaveAddress], segment.length, segment.data);
+		} else if (segment.length == 0) {
+			status = I2C_STATUS_ERROR;
+		} else {
+			pointers[segment.slaveAddress] = segment.data[0];
+			status = WriteBytes(segment.slaveAddress, segment.data[0], segment.length - 1, segment.data + 1);
+		}
+
+		// A NACK ends the whole transfer.
+		if (status != I2C_STATUS_SUCCESS)
+			return status;
+	}
+
+	return I2C_STATUS_SUCCESS;
+}
@@ -0,0 +1,187 @@
+/**
+  ******************************************************************************
+  * @file    sim_i2c_if.h
+  * @author  Adam Englebright
+  * @date    16.10.2026
+  * @brief   This file constains the definition of a simulated I2C bus, with an MPU6050
+  * and an INA260 whose measurements come from the plant model.
+  *
+  * MIT License
+  *
+  * Copyright (c) 2026 Adam Englebright
+  * 
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  * 
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  * 
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  */
+
+#include "../i2c_interface/i2c_interface.h"
+#include "plant.h"
+#include <deque>
+#include <mutex>
+
+#ifndef SIM_I2C_IF_H
+#define SIM_I2C_IF_H
+
+/** Simulated I2C bus for running the drivers offline. It emulates the register maps of an MPU6050
+ * and an INA260 closely enough for the drivers: register auto-increment, the MPU FIFO, clear on read
+ * status registers, and the reset bits. New measurements only appear when LatchMPU6050() or
+ * LatchINA260() is called, which the simulator does at the sample rate, in place of the conversion
+ * complete interrupts. Every transfer is counted, along with the time it would take on a real bus. */
+class SIM_I2C_IF : public I2C_Interface
+{
+public:
+/**
+  * @brief  Class constructor. Both devices start in their power on state.
+  * @param  _plant Plant model the measurements are taken from.
+  * @param  _clock Bus clock used to work out transfer times.
+  * @retval none
+  */
+  SIM_I2C_IF(Sim::Plant &_plant, i2c_clockspeed_t _clock = i2c_clockspeed_t::CLK_400KHz);
+
+/**
+  * @brief  I2C peripheral initialization method. There is nothing to open, so this always succeeds.
+  * @param  slaveAddress Address of the device that will be communicated
+  * @param  i2cFile Device file of I2C controller (ignored).
+  * @retval i2c_status_t
+  */
+  virtual i2c_status_t Init_I2C(uint8_t slaveAddress, std::string i2cFile) override { return I2C_STATUS_SUCCESS; };
+
+/**
+  * @brief  Take a new MPU6050 sample from the plant. Updates the data registers, pushes a frame
+  * into the FIFO if it is enabled, and sets the data ready (and FIFO overflow) interrupt status.
+  * Does nothing while the sensor is asleep.
+  * @param  none
+  * @retval none
+  */
+  void LatchMPU6050(void);
+
+/**
+  * @brief  Take a new INA260 conversion from the plant. Updates the measurement registers and
+  * sets the conversion ready flag.
+  * @param  none
+  * @retval none
+  */
+  void LatchINA260(void);
+
+/**
+  * @brief  Number of bus transactions (segments) so far.
+  * @param  none
+  * @retval uint32_t Transactions
+  */
+  uint32_t GetTransactionCount(void) { return transactions; }
+
+/**
+  * @brief  Time the transfers so far would have kept the bus busy, at the configured clock.
+  * @param  none
+  * @retval double Bus time in seconds
+  */
+  double GetBusTime(void) { return busBits / (double)clock; }
+
+  virtual uint8_t ReadRegister(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status = nullptr) override;
+  virtual uint16_t ReadRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status = nullptr) override;
+  virtual uint16_t ReadRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status = nullptr) override;
+  virtual i2c_status_t WriteRegister(uint8_t slaveAddress, uint8_t regAddress, uint8_t data) override;
+  virtual i2c_status_t WriteRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data) override;
+  virtual i2c_status_t WriteRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data) override;
+  virtual i2c_status_t ReadRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data) override;
+  virtual i2c_status_t WriteRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data) override;
+  virtual i2c_status_t TransferSegments(i2c_segment_t *segments, uint8_t count) override;
+
+private:
+/**
+  * @brief  Read bytes from a device, starting at a register, like the data phase of a register read.
+  * @param  slaveAddress Slave chip I2C bus address
+  * @param  regAddress First register
+  * @param  length Number of bytes
+  * @param  data Buffer to read into
+  * @retval i2c_status_t I2C_STATUS_ERROR if no device answers at the address
+  */
+  i2c_status_t ReadBytes(uint8_t slaveAddress, uint8_t regAddress, uint16_t length, uint8_t *data);
+
+/**
+  * @brief  Write bytes to a device, starting at a register, like the data phase of a register write.
+  * @param  slaveAddress Slave chip I2C bus address
+  * @param  regAddress First register
+  * @param  length Number of bytes
+  * @param  data Buffer to write from
+  * @retval i2c_status_t I2C_STATUS_ERROR if no device answers, or the write is malformed
+  */
+  i2c_status_t WriteBytes(uint8_t slaveAddress, uint8_t regAddress, uint16_t length, const uint8_t *data);
+
+/**
+  * @brief  Count a transaction and its bytes (plus the address byte) towards the bus time.
+  */
+  void CountTransfer(uint16_t length) { transactions++; busBits += 9 * (1 + (uint32_t)length); }
+
+/**
+  * @brief  Put the MPU6050 registers and FIFO in their power on state.
+  */
+  void ResetMPU6050(void);
+
+/**
+  * @brief  Put the INA260 registers in their power on state.
+  */
+  void ResetINA260(void);
+
+/**
+  * @brief  Store a big endian 16 bit value in two MPU6050 registers.
+  */
+  void SetMPU6050Word(uint8_t regAddress, int16_t value);
+
+/**
+  * @brief  Plant model the measurements are taken from.
+  */
+  Sim::Plant &plant;
+
+/**
+  * @brief  Bus clock in Hz.
+  */
+  uint32_t clock;
+
+/**
+  * @brief  MPU6050 register map.
+  */
+  uint8_t mpuRegs[256];
+
+/**
+  * @brief  MPU6050 FIFO contents, oldest byte first.
+  */
+  std::deque<uint8_t> mpuFIFO;
+
+/**
+  * @brief  INA260 register map.
+  */
+  uint16_t inaRegs[256];
+
+/**
+  * @brief  Serialises access to the devices, as a real bus would.
+  */
+  std::mutex busMutex;
+
+/**
+  * @brief  Bus transactions so far.
+  */
+  uint32_t transactions = 0;
+
+/**
+  * @brief  Bits clocked on the bus so far.
+  */
+  uint64_t busBits = 0;
+};
+
+#endif
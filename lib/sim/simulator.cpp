@@ -0,0 +1,108 @@
+/**
+ * @file    simulator.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the virtual time simulator and the simulated motor driver.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "simulator.h"
+#include "../telemetry/latency.h"
+#include <cmath>
+
+namespace Sim {
+
+/** Convert seconds into whole nanoseconds. */
+static uint64_t toNanoseconds(double seconds) {
+  return (uint64_t)std::llround(seconds * 1e9);
+}
+
+void SimMotorDriver::setDutyCycle(double DutyCycle) {
+  // Make sure the DutyCycle is within the limit.
+  if (DutyCycle > 1)
+    DutyCycle = 1;
+  else if (DutyCycle < -1)
+    DutyCycle = -1;
+
+  currDC = DutyCycle;
+  plant.setDutyCycle(DutyCycle);
+  Telemetry::LatencyTrace::stamp(Telemetry::LatencyStage::PWM_WRITE);
+
+  if (telemetry)
+    telemetry->log(telemetryChannel, (uint32_t)(std::abs(DutyCycle) * period_PWM));
+}
+
+Simulator::Simulator(Plant& _plant, double physicsStep) : plant(_plant), step_ns(toNanoseconds(physicsStep)) {
+  if (step_ns == 0)
+    step_ns = 1;
+}
+
+void Simulator::addPeriodicTask(double period, std::function<void(void)> task, double phase) {
+  uint64_t period_ns = toNanoseconds(period);
+  if (period_ns == 0)
+    period_ns = step_ns;
+
+  tasks.push_back({period_ns, now_ns + toNanoseconds(phase), task});
+}
+
+void Simulator::run(double duration) {
+  const uint64_t end_ns = now_ns + toNanoseconds(duration);
+
+  while (now_ns < end_ns) {
+    // Run everything that fell due during the last step, as if its interrupt had just fired.
+    for (Task& task : tasks) {
+      while (task.next_ns <= now_ns) {
+	task.function();
+	task.next_ns += task.period_ns;
+      }
+    }
+
+    plant.step(step_ns * 1e-9);
+    now_ns += step_ns;
+
+    for (std::function<void(void)>& observer : observers)
+      observer();
+  }
+}
+
+void AddMPU6050Aquisition(Simulator& simulator, SIM_I2C_IF& bus, MPU6050_Driver::MPU6050& mpu,
+			  MPU6050_Driver::Acquisition_t mode, uint16_t framesPerBatch, double samplePeriod,
+			  std::function<void(void)> after) {
+  if (mode != MPU6050_Driver::Acquisition_t::FIFO_BURST) {
+    simulator.addPeriodicTask(samplePeriod, [&bus, &mpu, after]() { bus.LatchMPU6050(); mpu.ProcessSample(); after(); });
+    return;
+  }
+
+  // Each latch pushes a frame into the FIFO, which is drained after the last frame of each batch.
+  uint16_t latched = 0;
+  simulator.addPeriodicTask(samplePeriod, [&bus, &mpu, after, framesPerBatch, latched]() mutable {
+    bus.LatchMPU6050();
+    if (++latched < framesPerBatch)
+      return;
+
+    latched = 0;
+    mpu.ProcessBatch();
+    after();
+  });
+}
+
+} // namespace Sim
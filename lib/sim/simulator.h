@@ -0,0 +1,188 @@
+/**
+ * @file    simulator.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the virtual time simulator and the simulated motor driver.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SIM_SIMULATOR_H
+#define SIM_SIMULATOR_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "plant.h"
+#include "sim_i2c_if.h"
+#include "../MotorDriver/dutycycle_interface.h"
+#include "../mpu6050/mpu6050.h"
+#include "../telemetry/telemetry.h"
+
+namespace Sim {
+
+  /**
+   * @brief Stand-in for MotorDriver that applies the duty cycle to the plant model
+   * instead of the PWM and DIR pins.
+   */
+  class SimMotorDriver final : public DutyCycle_Interface {
+  public:
+    /**
+     * @brief Class constructor.
+     * @param _plant Plant model driven by the motor.
+     * @param period_ns PWM period in nanoseconds, only used for the logged duty cycle.
+     */
+    SimMotorDriver(Plant& _plant, uint32_t period_ns = 50000) : plant(_plant), period_PWM(period_ns) {}
+
+    /**
+     * @brief Function to set the duty cycle and direction of the motor
+     * @param DutyCycle index value between -1 and 1. Out of range values are clamped.
+     */
+    virtual void setDutyCycle(double DutyCycle) override;
+
+    /**
+     * @brief Function to change duty cycle by a delta.
+     * @param DCdelta amount to change the duty cycle by
+     */
+    virtual void setDutyCycleDelta(double DCdelta) override { setDutyCycle(currDC + DCdelta); }
+
+    /**
+     * @brief Function to log every duty cycle applied, in the same form as MotorDriver.
+     * @param producer Telemetry producer, or nullptr to stop logging
+     * @param channel Telemetry channel the duty cycle (in nanoseconds) is logged under
+     */
+    void setTelemetry(Telemetry::Producer* producer, uint16_t channel) { telemetry = producer; telemetryChannel = channel; }
+
+    /**
+     * @brief Current duty cycle.
+     * @retval double Duty cycle between -1 and 1.
+     */
+    double getDutyCycle(void) const { return currDC; }
+
+  private:
+    /** Plant model driven by the motor. */
+    Plant& plant;
+
+    /** Period of PWM in nanoseconds. */
+    uint32_t period_PWM;
+
+    /** Current duty cycle. */
+    double currDC = 0;
+
+    /** Telemetry producer for logging motor driver control. */
+    Telemetry::Producer* telemetry = nullptr;
+
+    /** Telemetry channel for logging motor driver control. */
+    uint16_t telemetryChannel = 0;
+  };
+
+  /**
+   * @brief Runs the plant model and the control loop in virtual time. The plant is advanced in
+   * fixed physics steps, and periodic tasks (e.g. latching a sensor sample and processing it) are
+   * run between steps when they fall due. Nothing waits on a real clock, so a run is as fast as
+   * the code under test allows, and always gives the same result.
+   */
+  class Simulator {
+  public:
+    /**
+     * @brief Class constructor.
+     * @param _plant Plant model to advance.
+     * @param physicsStep Plant time step in seconds.
+     */
+    Simulator(Plant& _plant, double physicsStep = 1e-4);
+
+    /**
+     * @brief Add a task that runs periodically in virtual time. Tasks that fall due at the same
+     * time run in the order they were added.
+     * @param period Time between runs in seconds.
+     * @param task Function to run.
+     * @param phase Virtual time of the first run in seconds, relative to now.
+     */
+    void addPeriodicTask(double period, std::function<void(void)> task, double phase = 0);
+
+    /**
+     * @brief Advance virtual time, running tasks as they fall due.
+     * @param duration Time to simulate in seconds.
+     */
+    void run(double duration);
+
+    /**
+     * @brief Add a function that is called after every physics step, e.g. to record the plant state.
+     * @param observer Function to call.
+     */
+    void addObserver(std::function<void(void)> observer) { observers.push_back(observer); }
+
+    /**
+     * @brief Virtual time so far.
+     * @retval double Time in seconds.
+     */
+    double now(void) const { return now_ns * 1e-9; }
+
+  private:
+    /**
+     * @brief A periodic task.
+     */
+    struct Task {
+      /** Time between runs in nanoseconds. */
+      uint64_t period_ns;
+
+      /** Virtual time of the next run in nanoseconds. */
+      uint64_t next_ns;
+
+      /** Function to run. */
+      std::function<void(void)> function;
+    };
+
+    /** Plant model to advance. */
+    Plant& plant;
+
+    /** Plant time step in nanoseconds. Integer time keeps task scheduling exact over long runs. */
+    uint64_t step_ns;
+
+    /** Virtual time in nanoseconds. */
+    uint64_t now_ns = 0;
+
+    /** Periodic tasks. */
+    std::vector<Task> tasks;
+
+    /** Functions called after every physics step. */
+    std::vector<std::function<void(void)>> observers;
+  };
+
+  /**
+   * @brief Drive an MPU6050's data aquisition from the simulator, as its interrupt would on the rig. A sample
+   * is latched every sample period. In DATA_READY mode each sample is read straight away, and in FIFO_BURST
+   * mode the FIFO is drained once every framesPerBatch samples.
+   * @param simulator Simulator to add the task to.
+   * @param bus Simulated bus the MPU6050 is on.
+   * @param mpu MPU6050 driver, already set to the aquisition mode.
+   * @param mode Aquisition mode the driver is set to.
+   * @param framesPerBatch Number of sample periods between FIFO drains (FIFO_BURST only).
+   * @param samplePeriod Time between samples in seconds.
+   * @param after Function to run after each read or drain, e.g. one pass of the control executor.
+   */
+  void AddMPU6050Aquisition(Simulator& simulator, SIM_I2C_IF& bus, MPU6050_Driver::MPU6050& mpu,
+			    MPU6050_Driver::Acquisition_t mode, uint16_t framesPerBatch, double samplePeriod,
+			    std::function<void(void)> after);
+
+} // namespace Sim
+
+#endif
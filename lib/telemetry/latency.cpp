@@ -0,0 +1,178 @@
+/**
+ * @file    latency.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the lock-free latency histograms used to instrument the control loop.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "latency.h"
+#include "telemetry.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace Telemetry {
+
+/** Trace of the sample being processed by this thread, if any. */
+static thread_local LatencyTrace* activeTrace = nullptr;
+
+/** Stage names, in LatencyStage order. */
+static const char* const STAGE_NAMES[] = {"wakeup", "i2c_read", "queue", "control", "pwm_write", "logging"};
+
+std::size_t LatencyHistogram::bucketIndex(uint64_t value_ns) {
+  // Values below 2^(SUB_BUCKET_BITS + 1) are counted exactly. Above that, keep the top
+  // SUB_BUCKET_BITS + 1 bits, and use how far they were shifted down to pick the power of two.
+  unsigned magnitude = 63 - __builtin_clzll(value_ns | 1);
+  if (magnitude <= SUB_BUCKET_BITS)
+    return value_ns;
+  if (magnitude >= MAX_MAGNITUDE)
+    return BUCKET_COUNT - 1;
+
+  unsigned shift = magnitude - SUB_BUCKET_BITS;
+  return ((std::size_t)shift << SUB_BUCKET_BITS) + (value_ns >> shift);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(std::size_t index) {
+  if (index < (2u << SUB_BUCKET_BITS))
+    return index;
+
+  unsigned shift = (index >> SUB_BUCKET_BITS) - 1;
+  uint64_t mantissa = index - ((std::size_t)shift << SUB_BUCKET_BITS);
+  return ((mantissa + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value_ns) {
+  buckets[bucketIndex(value_ns)].fetch_add(1, std::memory_order_relaxed);
+  sum.fetch_add(value_ns, std::memory_order_relaxed);
+
+  // Only the recording thread writes these, so a plain compare is enough.
+  if (value_ns < minValue.load(std::memory_order_relaxed))
+    minValue.store(value_ns, std::memory_order_relaxed);
+  if (value_ns > maxValue.load(std::memory_order_relaxed))
+    maxValue.store(value_ns, std::memory_order_relaxed);
+
+  totalCount.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t LatencyHistogram::min(void) const {
+  return count() ? minValue.load(std::memory_order_relaxed) : 0;
+}
+
+double LatencyHistogram::mean(void) const {
+  uint64_t n = count();
+  return n ? (double)sum.load(std::memory_order_relaxed) / n : 0;
+}
+
+uint64_t LatencyHistogram::percentile(double percent) const {
+  uint64_t n = totalCount.load(std::memory_order_acquire);
+  if (n == 0)
+    return 0;
+
+  // Rank of the percentile, counting from one.
+  uint64_t rank = (uint64_t)(percent / 100.0 * n + 0.5);
+  if (rank < 1)
+    rank = 1;
+
+  uint64_t seen = 0;
+  for (std::size_t i = 0; i < BUCKET_COUNT; i++) {
+    seen += buckets[i].load(std::memory_order_relaxed);
+    if (seen >= rank)
+      return std::min(bucketUpperBound(i), max());
+  }
+
+  return max();
+}
+
+void LatencyHistogram::reset(void) {
+  for (std::atomic<uint64_t>& bucket : buckets)
+    bucket.store(0, std::memory_order_relaxed);
+  sum.store(0, std::memory_order_relaxed);
+  minValue.store(UINT64_MAX, std::memory_order_relaxed);
+  maxValue.store(0, std::memory_order_relaxed);
+  totalCount.store(0, std::memory_order_release);
+}
+
+void LatencyTrace::begin(uint64_t _origin_ns) {
+  origin_ns = _origin_ns;
+  last_ns = _origin_ns;
+  activeTrace = this;
+}
+
+void LatencyTrace::end(void) {
+  activeTrace = nullptr;
+}
+
+void LatencyTrace::stamp(LatencyStage stage) {
+  if (activeTrace)
+    stamp(stage, Producer::now_ns());
+}
+
+void LatencyTrace::stamp(LatencyStage stage, uint64_t now_ns) {
+  LatencyTrace* trace = activeTrace;
+  if (!trace)
+    return;
+
+  // Clamp, in case an edge timestamp was taken on a different clock or slightly in the future.
+  trace->stageHistograms[(std::size_t)stage].record(now_ns > trace->last_ns ? now_ns - trace->last_ns : 0);
+  trace->edgeHistograms[(std::size_t)stage].record(now_ns > trace->origin_ns ? now_ns - trace->origin_ns : 0);
+  trace->last_ns = now_ns;
+}
+
+void LatencyTrace::print(std::ostream& out) const {
+  const double us = 1e-3;
+  const std::streamsize precision = out.precision();
+  out << name << " latency (us)\n";
+  out << std::left << std::setw(22) << "stage" << std::right << std::setw(10) << "count" << std::setw(10) << "min"
+      << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99"
+      << std::setw(10) << "p99.9" << std::setw(10) << "max" << "\n";
+  out << std::fixed << std::setprecision(1);
+
+  auto row = [&](const std::string& label, const LatencyHistogram& histogram) {
+    out << std::left << std::setw(22) << label << std::right << std::setw(10) << histogram.count()
+	<< std::setw(10) << histogram.min() * us << std::setw(10) << histogram.mean() * us
+	<< std::setw(10) << histogram.percentile(50) * us << std::setw(10) << histogram.percentile(90) * us
+	<< std::setw(10) << histogram.percentile(99) * us << std::setw(10) << histogram.percentile(99.9) * us
+	<< std::setw(10) << histogram.max() * us << "\n";
+  };
+
+  for (std::size_t i = 0; i < (std::size_t)LatencyStage::STAGE_COUNT; i++) {
+    if (stageHistograms[i].count() == 0)
+      continue;
+    row(STAGE_NAMES[i], stageHistograms[i]);
+  }
+  for (std::size_t i = 0; i < (std::size_t)LatencyStage::STAGE_COUNT; i++) {
+    if (edgeHistograms[i].count() == 0)
+      continue;
+    row(std::string("edge->") + STAGE_NAMES[i], edgeHistograms[i]);
+  }
+
+  out << std::defaultfloat << std::setprecision(precision) << std::flush;
+}
+
+void LatencyTrace::reset(void) {
+  for (std::size_t i = 0; i < (std::size_t)LatencyStage::STAGE_COUNT; i++) {
+    stageHistograms[i].reset();
+    edgeHistograms[i].reset();
+  }
+}
+
+} // namespace Telemetry
@@ -0,0 +1,229 @@
+/**
+ * @file    latency.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the lock-free latency histograms used to instrument the control loop.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace Telemetry {
+
+  /**
+   * @brief Histogram of latencies in nanoseconds, with HDR-style log-linear buckets: values are
+   * counted exactly up to 64 ns, and above that each power of two is split into 32 buckets, so
+   * every bucket is within about 3% of the values in it. Recording is a handful of relaxed atomic
+   * operations, so it is safe to call from a real-time thread while another thread reads it.
+   */
+  class LatencyHistogram {
+  public:
+    /** Number of bits of each value kept when bucketing (the sub-bucket resolution). */
+    static constexpr unsigned SUB_BUCKET_BITS = 5;
+
+    /** Largest power of two tracked. Longer latencies (over a minute) go in the last bucket. */
+    static constexpr unsigned MAX_MAGNITUDE = 36;
+
+    /** Number of buckets, the last of which counts everything over 2^MAX_MAGNITUDE ns. */
+    static constexpr std::size_t BUCKET_COUNT = ((MAX_MAGNITUDE - SUB_BUCKET_BITS) << SUB_BUCKET_BITS) + (1u << SUB_BUCKET_BITS) + 1;
+
+    /**
+     * @brief Count a latency.
+     * @param value_ns Latency in nanoseconds.
+     */
+    void record(uint64_t value_ns);
+
+    /**
+     * @brief Number of latencies recorded.
+     * @retval uint64_t Count.
+     */
+    uint64_t count(void) const { return totalCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Smallest latency recorded, or zero if none have been.
+     * @retval uint64_t Latency in nanoseconds.
+     */
+    uint64_t min(void) const;
+
+    /**
+     * @brief Largest latency recorded.
+     * @retval uint64_t Latency in nanoseconds.
+     */
+    uint64_t max(void) const { return maxValue.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Mean of the latencies recorded.
+     * @retval double Latency in nanoseconds.
+     */
+    double mean(void) const;
+
+    /**
+     * @brief Latency that the given percentage of recorded latencies are at or below, to the
+     * resolution of the buckets.
+     * @param percent Percentile, between 0 and 100.
+     * @retval uint64_t Upper bound of the bucket holding the percentile, in nanoseconds.
+     */
+    uint64_t percentile(double percent) const;
+
+    /**
+     * @brief Clear the histogram. Latencies recorded at the same time may be lost.
+     */
+    void reset(void);
+
+    /**
+     * @brief Bucket a latency is counted in.
+     * @param value_ns Latency in nanoseconds.
+     * @retval std::size_t Bucket index.
+     */
+    static std::size_t bucketIndex(uint64_t value_ns);
+
+    /**
+     * @brief Largest latency counted in a bucket.
+     * @param index Bucket index.
+     * @retval uint64_t Latency in nanoseconds.
+     */
+    static uint64_t bucketUpperBound(std::size_t index);
+
+  private:
+    /** Bucket counts. */
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+
+    /** Number of latencies recorded. */
+    std::atomic<uint64_t> totalCount{0};
+
+    /** Sum of the latencies recorded, for the mean. */
+    std::atomic<uint64_t> sum{0};
+
+    /** Smallest latency recorded. */
+    std::atomic<uint64_t> minValue{UINT64_MAX};
+
+    /** Largest latency recorded. */
+    std::atomic<uint64_t> maxValue{0};
+  };
+
+  /**
+   * @brief Stages of the control loop, in the order a sample passes through them.
+   */
+  enum class LatencyStage : uint8_t {
+    WAKEUP = 0, /**< Interrupt edge until the aquisition thread is running again. */
+    I2C_READ = 1, /**< Reading the sample from the sensor. */
+    QUEUE = 2, /**< Waiting for the control executor, when the loops run on their own thread. */
+    CONTROL = 3, /**< Feedback callback and PID calculation, up to the PID output. */
+    PWM_WRITE = 4, /**< Writing the new duty cycle to the PWM. */
+    LOGGING = 5, /**< Telemetry logging at the end of the feedback callback. */
+    STAGE_COUNT = 6
+  };
+
+  /**
+   * @brief Per-stage latency histograms of one control path (i.e. one aquisition thread).
+   * The driver starts a trace for each sample with the kernel timestamp of the interrupt edge
+   * that announced it, and each stage the sample passes through is then stamped from wherever
+   * it happens to be (driver, PID callback or motor driver), with no need to pass the trace
+   * along. Each stamp records the time since the previous stamp in that stage's histogram, and
+   * the time since the edge in that stage's cumulative histogram.
+   */
+  class LatencyTrace {
+  public:
+    /**
+     * @brief Class constructor.
+     * @param _name Name of the control path, used when printing.
+     */
+    LatencyTrace(const std::string& _name) : name(_name) {}
+
+    /**
+     * @brief Start tracing a sample, and make this the calling thread's active trace.
+     * @param origin_ns Monotonic timestamp of the interrupt edge, in nanoseconds.
+     */
+    void begin(uint64_t origin_ns);
+
+    /**
+     * @brief Stop tracing on the calling thread.
+     */
+    static void end(void);
+
+    /**
+     * @brief Stamp a stage of the calling thread's active trace, if there is one.
+     * @param stage Stage that has just finished.
+     */
+    static void stamp(LatencyStage stage);
+
+    /**
+     * @brief Stamp a stage of the calling thread's active trace at a given time.
+     * @param stage Stage that has just finished.
+     * @param now_ns Monotonic timestamp in nanoseconds.
+     */
+    static void stamp(LatencyStage stage, uint64_t now_ns);
+
+    /**
+     * @brief Histogram of time spent in a stage.
+     * @param stage Stage.
+     * @retval const LatencyHistogram& Histogram.
+     */
+    const LatencyHistogram& stageLatency(LatencyStage stage) const { return stageHistograms[(std::size_t)stage]; }
+
+    /**
+     * @brief Histogram of time from the interrupt edge to the end of a stage.
+     * @param stage Stage.
+     * @retval const LatencyHistogram& Histogram.
+     */
+    const LatencyHistogram& edgeLatency(LatencyStage stage) const { return edgeHistograms[(std::size_t)stage]; }
+
+    /**
+     * @brief Print a table of count, min, mean, percentiles and max for every stage that has
+     * been stamped. Safe to call while the control loop is running.
+     * @param out Stream to print to.
+     */
+    void print(std::ostream& out) const;
+
+    /**
+     * @brief Clear every histogram.
+     */
+    void reset(void);
+
+  private:
+    /** Name of the control path. */
+    std::string name;
+
+    /** Timestamp of the edge that started the current sample. */
+    uint64_t origin_ns = 0;
+
+    /** Timestamp of the previous stamp. */
+    uint64_t last_ns = 0;
+
+    /** Time spent in each stage. */
+    std::array<LatencyHistogram, (std::size_t)LatencyStage::STAGE_COUNT> stageHistograms;
+
+    /** Time from the edge to the end of each stage. */
+    std::array<LatencyHistogram, (std::size_t)LatencyStage::STAGE_COUNT> edgeHistograms;
+  };
+
+} // namespace Telemetry
+
+#endif
@@ -0,0 +1,151 @@
+/**
+ * @file    telemetry.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the asynchronous binary telemetry logger implementation.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "telemetry.h"
+#include <iostream>
+#include <stdexcept>
+
+namespace Telemetry {
+
+/** Number of records the writer thread moves out of a producer in one go. */
+static constexpr std::size_t BATCH_RECORDS = 1024;
+
+Producer::Producer(uint16_t _index, std::size_t _capacity) : index(_index), ring(_capacity) {
+}
+
+bool Producer::log(uint16_t channel, double value) {
+  return log(channel, value, now_ns());
+}
+
+bool Producer::log(uint16_t channel, double value, uint64_t timestamp_ns) {
+  Record* slot = ring.claim();
+
+  // Ring full. Drop the record rather than block the real-time thread.
+  if (slot == nullptr) {
+    nextSequence++; // Keep the gap visible in the sequence numbers.
+    return false;
+  }
+
+  Record& record = *slot;
+  record.timestamp_ns = timestamp_ns;
+  record.sequence = nextSequence++;
+  record.channel = channel;
+  record.producer = index;
+  record.value = value;
+
+  // Publish the record to the writer thread.
+  ring.publish();
+  return true;
+}
+
+std::size_t Producer::drain(Record* out, std::size_t maxRecords) {
+  return ring.drain(out, maxRecords);
+}
+
+Logger::Logger(const std::string& path, std::chrono::milliseconds _flushPeriod)
+    : file(path, std::ios::binary | std::ios::trunc), flushPeriod(_flushPeriod),
+      batch(new Record[BATCH_RECORDS]) {
+  if (!file.is_open()) {
+    std::cout << "Failed to open telemetry file " << path << "." << std::endl;
+    throw std::invalid_argument("Failed to open telemetry file.");
+  }
+
+  FileHeader header;
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.flush();
+}
+
+Producer& Logger::createProducer(std::size_t capacity) {
+  std::lock_guard<std::mutex> lock(producerMutex);
+
+  const std::size_t count = producerCount.load(std::memory_order_relaxed);
+  if (count >= MAX_PRODUCERS)
+    throw std::length_error("Too many telemetry producers.");
+
+  producers[count].reset(new Producer(count, capacity));
+
+  // Publish the new producer to the writer thread.
+  producerCount.store(count + 1, std::memory_order_release);
+  return *producers[count];
+}
+
+void Logger::begin(void) {
+  if (writerRunning.exchange(true))
+    return;
+
+  writerThread = std::thread(&Logger::writer, this);
+}
+
+void Logger::end(void) {
+  writerRunning = false;
+  if (writerThread.joinable())
+    writerThread.join();
+
+  // Write out anything logged since the last pass.
+  while (writeBatch() > 0)
+    ;
+}
+
+uint64_t Logger::droppedRecords(void) const {
+  uint64_t total = 0;
+  const std::size_t count = producerCount.load(std::memory_order_acquire);
+  for (std::size_t i = 0; i < count; i++)
+    total += producers[i]->dropped();
+
+  return total;
+}
+
+std::size_t Logger::writeBatch(void) {
+  std::size_t total = 0;
+  const std::size_t count = producerCount.load(std::memory_order_acquire);
+
+  for (std::size_t i = 0; i < count; i++) {
+    std::size_t n = producers[i]->drain(batch.get(), BATCH_RECORDS);
+    if (n == 0)
+      continue;
+
+    file.write(reinterpret_cast<const char*>(batch.get()), n * sizeof(Record));
+    total += n;
+  }
+
+  if (total > 0) {
+    file.flush();
+    writtenCount.fetch_add(total, std::memory_order_relaxed);
+  }
+
+  return total;
+}
+
+void Logger::writer(void) {
+  while (writerRunning) {
+    // Keep draining while the producers are ahead of us, otherwise sleep until the next pass.
+    if (writeBatch() < BATCH_RECORDS)
+      std::this_thread::sleep_for(flushPeriod);
+  }
+}
+
+} // namespace Telemetry
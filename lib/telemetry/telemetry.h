@@ -0,0 +1,275 @@
+/**
+ * @file    telemetry.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the asynchronous binary telemetry logger declarations.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "../realtime/spsc_ring.h"
+
+namespace Telemetry {
+
+  /** Magic bytes at the start of every telemetry file ("STTL"). */
+  static constexpr uint32_t FILE_MAGIC = 0x4C545453;
+
+  /** Version of the telemetry file format. */
+  static constexpr uint16_t FILE_VERSION = 1;
+
+  /** Maximum number of producers that can be registered with one logger. */
+  static constexpr std::size_t MAX_PRODUCERS = 8;
+
+  /**
+   * @brief Fixed-size binary record written to the telemetry file.
+   */
+  struct Record {
+    /**
+     * @brief Time the value was logged, from the monotonic clock in nanoseconds.
+     */
+    uint64_t timestamp_ns = 0;
+
+    /**
+     * @brief Per-producer sequence number, used to spot dropped records offline.
+     */
+    uint32_t sequence = 0;
+
+    /**
+     * @brief Channel the value belongs to. Channel numbers are chosen by the application.
+     */
+    uint16_t channel = 0;
+
+    /**
+     * @brief Index of the producer that logged the record.
+     */
+    uint16_t producer = 0;
+
+    /**
+     * @brief Logged value.
+     */
+    double value = 0;
+  };
+
+  /**
+   * @brief Header at the start of every telemetry file.
+   */
+  struct FileHeader {
+    /** Always FILE_MAGIC. */
+    uint32_t magic = FILE_MAGIC;
+
+    /** File format version. */
+    uint16_t version = FILE_VERSION;
+
+    /** Size of each record in bytes, so readers can check the layout matches. */
+    uint16_t recordSize = sizeof(Record);
+  };
+
+  class Logger;
+
+  /**
+   * @brief Ring buffer of telemetry records for one real-time thread.
+   * Each real-time thread gets its own producer, so logging a record never blocks or
+   * contends with the other threads. If the ring is full the record is dropped and
+   * counted rather than waiting for the writer thread.
+   */
+  class Producer {
+  public:
+    /**
+     * @brief Log a value, timestamped with the current monotonic time.
+     * Must only be called from the thread that owns this producer.
+     * @param channel Channel the value belongs to.
+     * @param value Value to log.
+     * @retval bool False if the record was dropped because the ring was full.
+     */
+    bool log(uint16_t channel, double value);
+
+    /**
+     * @brief Log a value with a timestamp supplied by the caller.
+     * Must only be called from the thread that owns this producer.
+     * @param channel Channel the value belongs to.
+     * @param value Value to log.
+     * @param timestamp_ns Monotonic timestamp of the value in nanoseconds.
+     * @retval bool False if the record was dropped because the ring was full.
+     */
+    bool log(uint16_t channel, double value, uint64_t timestamp_ns);
+
+    /**
+     * @brief Number of records dropped because the ring was full.
+     * @retval uint64_t Dropped record count.
+     */
+    uint64_t dropped(void) const { return ring.dropped(); }
+
+    /**
+     * @brief Number of record slots in the ring.
+     * @retval std::size_t Ring capacity.
+     */
+    std::size_t capacity(void) const { return ring.capacity(); }
+
+    /**
+     * @brief Current monotonic time in nanoseconds, on the same clock used for record timestamps.
+     * @retval uint64_t Monotonic time.
+     */
+    static uint64_t now_ns(void) {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+  private:
+    friend class Logger;
+
+    /**
+     * @brief Constructor, only called by Logger::createProducer().
+     * @param _index Index of this producer in its logger.
+     * @param _capacity Requested capacity, rounded up to a power of two.
+     */
+    Producer(uint16_t _index, std::size_t _capacity);
+
+    /**
+     * @brief Move up to maxRecords records out of the ring. Only called by the writer thread.
+     * @param out Array to copy the records into.
+     * @param maxRecords Size of the out array.
+     * @retval std::size_t Number of records copied.
+     */
+    std::size_t drain(Record* out, std::size_t maxRecords);
+
+    /** Index of this producer in its logger. */
+    uint16_t index;
+
+    /** Sequence number of the next record pushed. */
+    uint32_t nextSequence = 0;
+
+    /** Record storage, filled by the producer thread and drained by the writer thread. */
+    RealTime::SPSCRing<Record> ring;
+  };
+
+  /**
+   * @brief Telemetry logger. Owns the producers and a background thread that
+   * drains them in batches and writes the records to a binary file, taking the
+   * formatting and flushing off the control threads.
+   */
+  class Logger {
+  public:
+    /**
+     * @brief Class constructor. Opens the output file and writes the file header.
+     * @param path Path of the binary telemetry file to create.
+     * @param _flushPeriod How often the writer thread drains the producers and flushes the file.
+     */
+    Logger(const std::string& path, std::chrono::milliseconds _flushPeriod = std::chrono::milliseconds(50));
+
+    /**
+     * @brief Class destructor. Simply calls end() to flush any remaining records.
+     */
+    ~Logger() { end(); }
+
+    /**
+     * @brief Create a new producer. Each thread that logs should use its own producer.
+     * Producers live as long as the logger.
+     * @param capacity Number of records the producer can buffer, rounded up to a power of two.
+     * @retval Producer& The new producer.
+     */
+    Producer& createProducer(std::size_t capacity = 4096);
+
+    /**
+     * @brief  This function will begin writing telemetry in a separate thread.
+     * @param  None
+     * @retval None
+     */
+    void begin(void);
+
+    /**
+     * @brief  This method stops the writer thread, after writing out everything still buffered.
+     * @param  None
+     * @retval None
+     */
+    void end(void);
+
+    /**
+     * @brief Total number of records dropped by all producers.
+     * @retval uint64_t Dropped record count.
+     */
+    uint64_t droppedRecords(void) const;
+
+    /**
+     * @brief Total number of records written to the file so far.
+     * @retval uint64_t Written record count.
+     */
+    uint64_t writtenRecords(void) const { return writtenCount.load(std::memory_order_relaxed); }
+
+  private:
+    /**
+     * @brief Drain every producer once and write what was collected to the file.
+     * @param None
+     * @retval std::size_t Number of records written.
+     */
+    std::size_t writeBatch(void);
+
+    /**
+     * @brief Writer thread method. Periodically drains the producers until end() is called.
+     * @param None
+     * @retval None
+     */
+    void writer(void);
+
+    /** Output file stream for the binary telemetry. */
+    std::ofstream file;
+
+    /** Time between writer passes. */
+    std::chrono::milliseconds flushPeriod;
+
+    /** Registered producers. */
+    std::array<std::unique_ptr<Producer>, MAX_PRODUCERS> producers;
+
+    /** Number of registered producers, published to the writer thread. */
+    std::atomic<std::size_t> producerCount{0};
+
+    /** Serialises createProducer() calls. */
+    std::mutex producerMutex;
+
+    /** Number of records written to the file. */
+    std::atomic<uint64_t> writtenCount{0};
+
+    /** Staging buffer the writer drains producers into. */
+    std::unique_ptr<Record[]> batch;
+
+    /** Writer thread. */
+    std::thread writerThread;
+
+    /** Writer running flag. */
+    std::atomic<bool> writerRunning{false};
+  };
+
+} // namespace Telemetry
+
+#endif
@@ -0,0 +1,98 @@
+/**
+ * @file    i2c_trace_dump.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains a program for converting binary I2C trace files into text.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Usage: i2c_trace_dump <trace file>
+ * Every recorded transaction is printed as CSV (timestamp_ns,duration_ns,op,status,slave,register,data),
+ * with the timestamp counted from the start of the first transaction, and the data in hex. The data of
+ * a transfer is each segment in turn, as R or W, the slave address, and the bytes in brackets.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include "../lib/i2c_interface/i2c_trace.h"
+
+/** Names of the transaction kinds, by i2c_trace_op_t. */
+static const char* OP_NAMES[] = {"read_byte", "read_word", "write_byte", "write_word", "read_block", "write_block", "transfer"};
+
+/**
+ * @brief Print bytes in hex.
+ * @param data Bytes to print
+ * @param length Number of bytes
+ */
+void printHex(const uint8_t* data, std::size_t length) {
+  char hex[3];
+  for (std::size_t i = 0; i < length; i++) {
+    std::snprintf(hex, sizeof(hex), "%02x", data[i]);
+    std::cout << hex;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: " << argv[0] << " <trace file>" << std::endl;
+    return 1;
+  }
+
+  std::ifstream file(argv[1], std::ios::binary);
+  if (!file.is_open()) {
+    std::cout << "Failed to open " << argv[1] << "." << std::endl;
+    return 1;
+  }
+
+  // Check the file was written with the same record layout as this program uses.
+  i2c_trace_header_t header;
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!file || header.magic != I2C_TRACE_MAGIC || header.version != I2C_TRACE_VERSION
+      || header.recordSize != sizeof(i2c_trace_record_t)) {
+    std::cout << argv[1] << " is not an I2C trace, or was written by an incompatible version." << std::endl;
+    return 1;
+  }
+
+  std::cout << "timestamp_ns,duration_ns,op,status,slave,register,data\n";
+
+  uint64_t timestamp = 0;
+  i2c_trace_record_t record;
+  std::vector<uint8_t> payload;
+  while (file.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+    payload.resize(record.length);
+    if (!file.read(reinterpret_cast<char*>(payload.data()), record.length)) {
+      std::cout << "Trace is cut short." << std::endl;
+      return 1;
+    }
+
+    timestamp += record.gap_ns;
+    std::cout << timestamp << ',' << record.duration_ns << ','
+	      << (record.op <= I2C_TRACE_TRANSFER ? OP_NAMES[record.op] : "unknown") << ','
+	      << (int)record.status << ',';
+    timestamp += record.duration_ns;
+
+    if (record.op != I2C_TRACE_TRANSFER) {
+      std::cout << (int)record.slaveAddress << ',' << (int)record.regAddress << ',';
+      printHex(payload.data(), payload.size());
+    } else {
+      std::cout << ",,";
+      std::size_t offset = 0;
+      for (uint16_t i = 0; i < record.segments && offset + sizeof(i2c_trace_segment_t) <= payload.size(); i++) {
+	i2c_trace_segment_t segment;
+	std::memcpy(&segment, &payload[offset], sizeof(segment));
+	offset += sizeof(segment);
+	std::cout << (i ? " " : "") << (segment.read ? 'R' : 'W') << (int)segment.slaveAddress << '[';
+	printHex(&payload[offset], std::min<std::size_t>(segment.length, payload.size() - offset));
+	std::cout << ']';
+	offset += segment.length;
+      }
+    }
+    std::cout << '\n';
+  }
+
+  return 0;
+}
@@ -14,6 +14,7 @@
 #include <iostream>
 #include "../lib/mpu6050/mpu6050.h"
 #include "../lib/i2c_interface/smbus_i2c_if.h"
+#include "../lib/estimator/estimator.h"
 
 
 /**
@@ -25,11 +26,10 @@ class MPU6050_Feedback : public MPU6050_Driver::MPU6050Interface
 public:
   /**
    * @brief Constructor assigning values.
-   * @param _radius Distance between MPU and axis of rotation.
-   * @param _samplePeriod Time between samples.
+   * @param _estimator Attitude estimator turning samples into angular position.
    */
-  MPU6050_Feedback(float _radius, float _samplePeriod)
-    : radius(_radius), samplePeriod(_samplePeriod) {}
+  MPU6050_Feedback(Attitude::Estimator& _estimator)
+    : estimator(_estimator) {}
 
   /**
    * @brief MPU6050 callback implementation. Takes the sample data and calculates the angular position of the cup holder,
@@ -44,29 +44,8 @@ public:
      * 3. Angular displacement is zero when the cup holder is upright.
      */
 
-    // Adjust y accel component for centripetal acceleration caused by angular velocity around axis of rotation
-    // Watch units. Sample linear acceleration is in g. Convert to m/s^2.
-    // Watch units. Sample angular velocity is in deg/s. Convert to rad/s.
-    float ayUnitsCorrected = sample.ay * 9.80665;
-    float gzUnitsCorrected = sample.gz * 3.14159265358979323846 / 180.0;
-    float ayGrav = ayUnitsCorrected + gzUnitsCorrected * gzUnitsCorrected * radius;
-
-    // Adjust x accel component for tangential acceleration caused by angular acceleration around axis of rotation
-    // Watch units. Sample linear acceleration is in g. Convert to m/s^2.
-    // Watch units. Sample angular velocity is in deg/s. Convert to rad/s.
-    float axUnitsCorrected = sample.ax * 9.80665;
-    float axGrav = axUnitsCorrected + ((gzUnitsCorrected - gzPrev) / samplePeriod) * radius;
-    gzPrev = gzUnitsCorrected;
-
-    // Caculate magnitude of gravity in xy plane.
-    float gravMag = std::sqrt(axGrav * axGrav + ayGrav * ayGrav);
-
-    // Calculate angular displacement in rad from upright.
-    float angularPos = std::acos(ayGrav / gravMag);
-
-    // Ensure sign of angular position is correct.
-    if (axGrav > 0)
-      angularPos = -angularPos;
+    // Fuse the gyro rate with the accelerometer tilt to get the angular displacement in rad from upright.
+    float angularPos = estimator.update(sample);
 
     float angularPosDeg = angularPos * 180.0 / 3.14159265358979323846;
 
@@ -80,19 +59,9 @@ public:
 
 private:
   /**
-   * @brief Radius from axis of rotation to MPU in meters.
-   */
-  float radius;
-
-  /**
-   * @brief Sample period for tangential acceleration calculation in seconds.
-   */
-  float samplePeriod;
-
-  /**
-   * @brief Previous angular velocity around z axis for tangential acceleration calculation (stored in rad/s).
+   * @brief Attitude estimator reference attribute.
    */
-  float gzPrev = 0;
+  Attitude::Estimator& estimator;
 };
 
 
@@ -124,13 +93,14 @@ int main() {
   gpiod::line::offset MPU_IntPin = 4;
 
   // Initialise MPU6050 object with callback for printing data, and I2C callback for communication.
-  MPU6050_Feedback MPU6050Callback(radius, MPU_SamplePeriod);
+  Attitude::Estimator MPU_Estimator(Attitude::Filter_t::KALMAN, MPU_SamplePeriod, radius);
+  MPU6050_Feedback MPU6050Callback(MPU_Estimator);
   SMBUS_I2C_IF MPU6050_I2C_Callback;
   MPU6050_I2C_Callback.Init_I2C(MPU_Address, MPU_i2cFile);
   MPU6050_Driver::MPU6050 MPU6050(&MPU6050_I2C_Callback, &MPU6050Callback, MPU_IntPin);
 
   // Setup settings on MPU over i2c.
-  MPU6050.InitializeSensor(MPU_GyroScale, MPU_AccelScale, MPU_DLPFconf, MPU_SRdiv, MPU_INTconf, MPU_INTenable, 0, 1); // Given the MPU's orientation, there should be 1g in the Y axis at initalisaton
+  MPU6050.InitializeSensor(MPU_GyroScale, MPU_AccelScale, MPU_DLPFconf, MPU_SRdiv, MPU_INTconf, MPU_INTenable);
 
   // Start data aquisition and processing from the MPU.
   MPU6050.begin();
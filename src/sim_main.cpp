@@ -0,0 +1,114 @@
+/**
+ * @file    sim_main.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains a program that runs the full control cascade against the offline plant simulator.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Usage: ShakeyTable_sim [duration (s)] [initial angle (rad)] [outer Kp] [outer Kd] [inner Kp]
+ * The same drivers, callbacks and PID controllers as the main program are run in virtual time,
+ * with the sensors and motor driver replaced by the simulator. Telemetry is written to
+ * sim_telemetry_log, and can be read with telemetry_dump.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include "../lib/mpu6050/mpu6050.h"
+#include "../lib/ina260/ina260.h"
+#include "../lib/telemetry/telemetry.h"
+#include "../lib/params/config.h"
+#include "../lib/pipeline/pipeline.h"
+#include "../lib/sim/plant.h"
+#include "../lib/sim/sim_i2c_if.h"
+#include "../lib/sim/simulator.h"
+
+
+int main(int argc, char* argv[]) {
+  double duration = (argc > 1) ? std::atof(argv[1]) : 5.0;
+  double initialAngle = (argc > 2) ? std::atof(argv[2]) : 0.05;
+
+  // Settings, the same as the main program apart from the PID constants, which are tuned against the default
+  // plant model. The derivative term works on the angle calculated from the accelerometer, which picks up the
+  // tangential acceleration, so high Kd amplifies that error.
+  Params::Config config;
+  config.inner = {(argc > 5) ? std::atof(argv[5]) : 0.02, 0, 0};
+  config.outer = {(argc > 3) ? std::atof(argv[3]) : 30, (argc > 4) ? std::atof(argv[4]) : 2, 0};
+  config.outerLimit = 6;
+  float MPU_SamplePeriod = config.MPUSamplePeriod();
+  float INA_SamplePeriod = config.INASamplePeriod();
+
+  // Band the angle must stay inside to count as settled, in rad.
+  double settledBand = 0.02;
+
+  // Plant model, with a little sensor noise so the controllers see something like the real thing.
+  Sim::PlantParams params;
+  params.accelNoise = 0.004;
+  params.gyroNoise = 0.05;
+  params.currentNoise = 0.005;
+  config.radius = params.mpuRadius;
+  Sim::Plant plant(params, initialAngle);
+  SIM_I2C_IF bus(plant);
+  Sim::SimMotorDriver motorDriver(plant);
+  Sim::Simulator simulator(plant);
+
+  Telemetry::Logger telemetry("sim_telemetry_log");
+  Telemetry::Producer& MPU_Telemetry = telemetry.createProducer();
+  Telemetry::Producer& INA_Telemetry = telemetry.createProducer();
+  motorDriver.setTelemetry(&INA_Telemetry, MD20_DUTY);
+
+  // Build the cascade exactly as the main program does.
+  Pipeline::Cascade<Sim::SimMotorDriver> cascade(config, motorDriver, MPU_Telemetry, INA_Telemetry);
+  CascadeExecutor& controlExecutor = cascade.controlExecutor();
+
+  MPU6050_Driver::MPU6050 MPU6050(&bus, &cascade.mpuInput(), 0);
+  INA260_Driver::INA260 INA260(&bus, &cascade.inaInput(), 0);
+
+  if (MPU6050.InitializeSensor(config.mpuGyroScale, config.mpuAccelScale, config.mpuDLPF, config.mpuSampleRateDiv) != I2C_STATUS_SUCCESS ||
+      INA260.InitializeSensor(INA260_Driver::Alert_Conf::CNVR, config.inaVoltConvTime, config.inaCurrConvTime,
+			      config.inaAveraging, INA260_Driver::Op_Mode::CURCONT) != I2C_STATUS_SUCCESS) {
+    std::cout << "Failed to initialise the simulated sensors." << std::endl;
+    return 1;
+  }
+  if (MPU6050.SetAcquisitionMode(config.mpuAcquisition, config.mpuBatchFrames) != I2C_STATUS_SUCCESS) {
+    std::cout << "Failed to set the simulated MPU6050 aquisition mode." << std::endl;
+    return 1;
+  }
+
+  // Each sensor's interrupt becomes a periodic task that latches a sample and runs one pass of its aquisition loop,
+  // followed by one pass of the control executor.
+  Sim::AddMPU6050Aquisition(simulator, bus, MPU6050, config.mpuAcquisition, config.mpuBatchFrames, MPU_SamplePeriod,
+			    [&]() { controlExecutor.ProcessPending(); });
+  simulator.addPeriodicTask(INA_SamplePeriod, [&]() { bus.LatchINA260(); INA260.ProcessSample(); controlExecutor.ProcessPending(); });
+
+  // Track the last time the angle was outside the settled band.
+  double lastUnsettled = 0;
+  double peakAngle = 0;
+  simulator.addObserver([&]() {
+    double angle = std::fabs(plant.getState().angle);
+    if (angle > settledBand)
+      lastUnsettled = simulator.now();
+    if (angle > peakAngle)
+      peakAngle = angle;
+  });
+
+  telemetry.begin();
+  auto start = std::chrono::steady_clock::now();
+  simulator.run(duration);
+  double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  telemetry.end();
+
+  std::cout << std::dec << "Simulated " << simulator.now() << " s in " << wallTime << " s of wall time ("
+	    << simulator.now() / wallTime << "x real time)." << std::endl;
+  std::cout << "Peak angle: " << peakAngle << " rad. Final angle: " << plant.getState().angle << " rad." << std::endl;
+  if (lastUnsettled < simulator.now())
+    std::cout << "Settled within " << settledBand << " rad after " << lastUnsettled << " s." << std::endl;
+  else
+    std::cout << "Did not settle within " << settledBand << " rad." << std::endl;
+  std::cout << "I2C transactions: " << bus.GetTransactionCount() << ", bus busy for "
+	    << 100.0 * bus.GetBusTime() / simulator.now() << "% of the time." << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file    telemetry_dump.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains a program for converting binary telemetry files into text.
+ *
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ * Usage: telemetry_dump <telemetry file> [channel]
+ * With no channel, every record is printed as CSV (timestamp_ns,producer,sequence,channel,value).
+ * With a channel, only the values of that channel are printed, one per line, the same as the
+ * old per-channel log files.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "../lib/telemetry/telemetry.h"
+
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cout << "Usage: " << argv[0] << " <telemetry file> [channel]" << std::endl;
+    return 1;
+  }
+
+  std::ifstream file(argv[1], std::ios::binary);
+  if (!file.is_open()) {
+    std::cout << "Failed to open " << argv[1] << "." << std::endl;
+    return 1;
+  }
+
+  // Check the file was written with the same record layout as this program uses.
+  Telemetry::FileHeader header;
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!file || header.magic != Telemetry::FILE_MAGIC || header.recordSize != sizeof(Telemetry::Record)) {
+    std::cout << argv[1] << " is not a telemetry file, or was written by an incompatible version." << std::endl;
+    return 1;
+  }
+
+  bool filter = argc > 2;
+  uint16_t channel = filter ? std::atoi(argv[2]) : 0;
+
+  if (!filter)
+    std::cout << "timestamp_ns,producer,sequence,channel,value\n";
+
+  Telemetry::Record record;
+  while (file.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+    if (!filter)
+      std::cout << record.timestamp_ns << ',' << record.producer << ',' << record.sequence << ','
+		<< record.channel << ',' << record.value << '\n';
+    else if (record.channel == channel)
+      std::cout << record.value << '\n';
+  }
+
+  return 0;
+}
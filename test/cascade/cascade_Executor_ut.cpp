@@ -0,0 +1,212 @@
+/**
+ * @file    cascade_Executor_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the control executor
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../../lib/cascade/executor.h"
+
+/**
+ * @brief Records which loop ran for each sample, and the thread it ran on.
+ */
+struct LoopLog {
+    /** Timestamps of the samples run, negative for the outer loop. */
+    std::vector<int64_t> order;
+
+    /** Threads the loops were run from. */
+    std::vector<std::thread::id> threads;
+};
+
+/**
+ * @brief Outer loop stand-in, logging each MPU sample it is given.
+ */
+class OuterLoop : public MPU6050_Driver::MPU6050Interface {
+public:
+    OuterLoop(LoopLog& _log) : log(_log) {}
+    virtual void hasSample(MPU6050_Driver::MPU6050Sample& sample) override {
+        log.order.push_back(-(int64_t)sample.timestamp_ns);
+        log.threads.push_back(std::this_thread::get_id());
+    }
+    virtual void hasBatch(MPU6050_Driver::MPU6050Sample* samples, std::size_t count) override {
+        batchSizes.push_back(count);
+        MPU6050Interface::hasBatch(samples, count);
+    }
+
+    /** Size of each batch passed to hasBatch(). */
+    std::vector<std::size_t> batchSizes;
+
+private:
+    LoopLog& log;
+};
+
+/**
+ * @brief Inner loop stand-in, logging each INA sample it is given.
+ */
+class InnerLoop : public INA260_Driver::INA260Interface {
+public:
+    InnerLoop(LoopLog& _log) : log(_log) {}
+    virtual void hasSample(INA260_Driver::INA260Sample& sample) override {
+        log.order.push_back((int64_t)sample.timestamp_ns);
+        log.threads.push_back(std::this_thread::get_id());
+    }
+
+private:
+    LoopLog& log;
+};
+
+// Test case for the order samples are run in
+/**
+ * @brief Posts interleaved MPU and INA samples and checks they are run oldest first, with the
+ * outer loop first on a tie, and that a full queue drops samples rather than blocking.
+ * @return None
+ */
+void testOrder() {
+    std::cout << "Test function for control executor ordering is getting executed" << std::endl;
+    LoopLog log;
+    OuterLoop outer(log);
+    InnerLoop inner(log);
+    CascadeExecutor executor(outer, inner, 4);
+
+    MPU6050_Driver::MPU6050Sample mpuSample;
+    INA260_Driver::INA260Sample inaSample;
+    for (uint64_t t : {10, 30}) {
+        mpuSample.timestamp_ns = t;
+        executor.mpuInput().hasSample(mpuSample);
+    }
+    for (uint64_t t : {5, 10, 20, 40}) {
+        inaSample.timestamp_ns = t;
+        executor.inaInput().hasSample(inaSample);
+    }
+
+    // The INA queue is full, so this one is dropped.
+    inaSample.timestamp_ns = 50;
+    executor.inaInput().hasSample(inaSample);
+
+    if (executor.ProcessPending() != 6) {
+        throw std::runtime_error("Wrong number of samples run!");
+    }
+
+    const std::vector<int64_t> expected = {5, -10, 10, 20, -30, 40};
+    if (log.order != expected) {
+        throw std::runtime_error("Samples were run in the wrong order!");
+    }
+    if (executor.GetOuterCount() != 2 || executor.GetInnerCount() != 4 || executor.GetDroppedCount() != 1) {
+        throw std::runtime_error("Control executor counts are wrong!");
+    }
+    if (executor.ProcessPending() != 0) {
+        throw std::runtime_error("Samples were run twice!");
+    }
+}
+
+// Test case for batching runs of MPU samples
+/**
+ * @brief Posts a FIFO burst of MPU samples with INA samples part way through, and checks each run of
+ * MPU samples between INA samples is passed to the outer loop as one batch.
+ * @return None
+ */
+void testBatching() {
+    std::cout << "Test function for control executor batching is getting executed" << std::endl;
+    LoopLog log;
+    OuterLoop outer(log);
+    InnerLoop inner(log);
+    CascadeExecutor executor(outer, inner, 16);
+
+    MPU6050_Driver::MPU6050Sample burst[8];
+    for (uint64_t i = 0; i < 8; i++)
+        burst[i].timestamp_ns = 10 * (i + 1);
+    executor.mpuInput().hasBatch(burst, 8);
+
+    INA260_Driver::INA260Sample inaSample;
+    for (uint64_t t : {35, 55}) {
+        inaSample.timestamp_ns = t;
+        executor.inaInput().hasSample(inaSample);
+    }
+
+    if (executor.ProcessPending() != 10) {
+        throw std::runtime_error("Wrong number of samples run!");
+    }
+
+    const std::vector<int64_t> expected = {-10, -20, -30, 35, -40, -50, 55, -60, -70, -80};
+    const std::vector<std::size_t> expectedBatches = {3, 2, 3};
+    if (log.order != expected || outer.batchSizes != expectedBatches) {
+        throw std::runtime_error("MPU samples were not batched between INA samples!");
+    }
+    if (executor.GetOuterCount() != 8 || executor.GetInnerCount() != 2) {
+        throw std::runtime_error("Control executor counts are wrong!");
+    }
+}
+
+// Test case for running the loops on the executor thread
+/**
+ * @brief Posts samples from two threads while the executor thread is running, and checks every
+ * sample is run, in order for each loop, and only on the executor thread.
+ * @return None
+ */
+void testThread() {
+    std::cout << "Test function for control executor thread is getting executed" << std::endl;
+    const uint64_t samplesPerLoop = 20000;
+    LoopLog log;
+    OuterLoop outer(log);
+    InnerLoop inner(log);
+    CascadeExecutor executor(outer, inner, 1024);
+    executor.begin();
+
+    std::thread mpuThread([&]() {
+        MPU6050_Driver::MPU6050Sample sample;
+        for (uint64_t i = 1; i <= samplesPerLoop; i++) {
+            sample.timestamp_ns = i;
+            executor.mpuInput().hasSample(sample);
+            if (i % 256 == 0)
+                std::this_thread::yield();
+        }
+    });
+    std::thread inaThread([&]() {
+        INA260_Driver::INA260Sample sample;
+        for (uint64_t i = 1; i <= samplesPerLoop; i++) {
+            sample.timestamp_ns = i;
+            executor.inaInput().hasSample(sample);
+            if (i % 256 == 0)
+                std::this_thread::yield();
+        }
+    });
+    mpuThread.join();
+    inaThread.join();
+
+    // Wait for the executor to catch up, then stop it.
+    while (executor.GetOuterCount() + executor.GetInnerCount() + executor.GetDroppedCount() < 2 * samplesPerLoop)
+        std::this_thread::yield();
+    executor.end();
+
+    int64_t lastOuter = 0;
+    int64_t lastInner = 0;
+    for (std::size_t i = 0; i < log.order.size(); i++) {
+        if (log.threads[i] != log.threads[0] || log.threads[i] == std::this_thread::get_id()) {
+            throw std::runtime_error("Loops were run from more than one thread!");
+        }
+        int64_t& last = log.order[i] < 0 ? lastOuter : lastInner;
+        int64_t timestamp = log.order[i] < 0 ? -log.order[i] : log.order[i];
+        if (timestamp <= last) {
+            throw std::runtime_error("Samples of a loop were run out of order!");
+        }
+        last = timestamp;
+    }
+    std::cout << "Samples dropped while the executor was behind: " << executor.GetDroppedCount() << std::endl;
+}
+
+int main() {
+    //Execute test case
+    testOrder();
+    testBatching();
+    testThread();
+
+    std::cout << "All control executor tests passed!" << std::endl;
+    return 0;
+}
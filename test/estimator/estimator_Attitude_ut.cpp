@@ -0,0 +1,240 @@
+/**
+ * @file    estimator_Attitude_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the attitude estimators
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "../../lib/estimator/estimator.h"
+
+/** Time between samples in seconds. */
+static const float SAMPLE_PERIOD = 0.002f;
+
+/** Radius from axis of rotation to MPU in meters. */
+static const float RADIUS = 0.15f;
+
+/** Gyro bias added to every sample, in deg/s. */
+static const float GYRO_BIAS = 2.0f;
+
+/**
+ * @brief True angle and MPU samples of the cup holder swinging back and forth.
+ */
+struct Swing {
+    std::vector<float> angle;
+    std::vector<MPU6050_Driver::MPU6050Sample> samples;
+};
+
+/**
+ * @brief Generates noisy MPU samples of a sinusoidal swing, including the centripetal and
+ * tangential acceleration of the MPU, and a constant gyro bias. The MPU's axes are right handed with
+ * Z out of its face, so the clockwise angle theta is a rotation of -theta about Z: gravity tips into
+ * -X, the tangential acceleration appears in +X, and the gyro reads minus the angular velocity.
+ * @param duration Length of the swing in seconds.
+ * @return Swing True angles and samples.
+ */
+Swing makeSwing(float duration) {
+    const double g = 9.80665;
+    const double amplitude = 0.3;
+    const double w = 2 * M_PI * 0.2;
+    std::mt19937 rng(1);
+    std::normal_distribution<float> accelNoise(0, 0.05f);
+    std::normal_distribution<float> gyroNoise(0, 0.5f);
+
+    Swing swing;
+    for (double t = 0; t < duration; t += SAMPLE_PERIOD) {
+        double theta = amplitude * std::sin(w * t);
+        double omega = amplitude * w * std::cos(w * t);
+        double alpha = -amplitude * w * w * std::sin(w * t);
+
+        MPU6050_Driver::MPU6050Sample sample;
+        sample.ax = (-g * std::sin(theta) + alpha * RADIUS) / g + accelNoise(rng);
+        sample.ay = (g * std::cos(theta) - omega * omega * RADIUS) / g + accelNoise(rng);
+        sample.gz = -omega * 180 / M_PI + GYRO_BIAS + gyroNoise(rng);
+        swing.angle.push_back(theta);
+        swing.samples.push_back(sample);
+    }
+    return swing;
+}
+
+// Test case for the fast arctangent
+/**
+ * @brief Compares FastAtan2 with std::atan2 all the way round the circle.
+ * @return None
+ */
+void testFastAtan2() {
+    std::cout << "Test function for the fast arctangent is getting executed" << std::endl;
+    float maxError = 0;
+    for (int i = 0; i < 3600; i++) {
+        float a = (i - 1800) * M_PI / 1800;
+        for (float r : {1e-3f, 1.0f, 50.0f}) {
+            float error = std::fabs(Attitude::FastAtan2(r * std::sin(a), r * std::cos(a)) - std::atan2(r * std::sin(a), r * std::cos(a)));
+            if (error > M_PI)
+                error = 2 * M_PI - error; // +pi and -pi are the same angle
+            maxError = std::fmax(maxError, error);
+        }
+    }
+    if (maxError > 1e-4f || Attitude::FastAtan2(0, 0) != 0) {
+        throw std::runtime_error("Fast arctangent is inaccurate!");
+    }
+}
+
+// Test case for the sign of the gyro rate against the accelerometer tilt
+/**
+ * @brief Turns the MPU steadily about its Z axis, as a right handed sensor reads it, and checks the
+ * accelerometer tilt and the integrated gyro rate agree on the angle, and that the bias tracking filters
+ * don't take the rate for bias.
+ * @return None
+ */
+void testSignConvention() {
+    std::cout << "Test function for the gyro and accelerometer sign convention is getting executed" << std::endl;
+    const double rate = 0.3; // rad/s about +Z
+    const std::size_t count = 1 / SAMPLE_PERIOD;
+
+    for (Attitude::Filter_t filter : {Attitude::Filter_t::COMPLEMENTARY, Attitude::Filter_t::MAHONY, Attitude::Filter_t::KALMAN}) {
+        Attitude::Estimator estimator(filter, SAMPLE_PERIOD, 0);
+        // Long enough that the complementary filter is all gyro over the turn.
+        estimator.setComplementaryTimeConstant(1e6f);
+        double z = 0;
+        for (std::size_t i = 0; i <= count; i++, z += rate * SAMPLE_PERIOD) {
+            MPU6050_Driver::MPU6050Sample sample;
+            sample.ax = std::sin(z);
+            sample.ay = std::cos(z);
+            sample.gz = rate * 180 / M_PI;
+
+            // A positive Z rotation is anticlockwise, so a negative angle.
+            if (std::fabs(estimator.accelTilt(sample) + z) > 1e-4) {
+                throw std::runtime_error("Accelerometer tilt has the wrong sign!");
+            }
+            estimator.update(sample);
+        }
+        if (std::fabs(estimator.getAngle() + z - rate * SAMPLE_PERIOD) > 1e-3 || std::fabs(estimator.getRate() + rate) > 1e-3
+                || std::fabs(estimator.getGyroBias()) > 1e-3) {
+            throw std::runtime_error("Gyro rate and accelerometer tilt disagree!");
+        }
+    }
+}
+
+// Test case for tracking a swing with each filter
+/**
+ * @brief Runs each filter over the same noisy swing, and checks it tracks the true angle more
+ * closely than the accelerometer tilt alone, and that the bias tracking filters find the gyro bias.
+ * @return None
+ */
+void testFilters() {
+    std::cout << "Test function for the attitude filters is getting executed" << std::endl;
+    const Swing swing = makeSwing(30);
+    const std::size_t settle = swing.samples.size() / 4;
+    const char* names[] = {"complementary", "Mahony", "Kalman"};
+
+    for (Attitude::Filter_t filter : {Attitude::Filter_t::COMPLEMENTARY, Attitude::Filter_t::MAHONY, Attitude::Filter_t::KALMAN}) {
+        Attitude::Estimator estimator(filter, SAMPLE_PERIOD, RADIUS);
+        double filterError = 0;
+        double tiltError = 0;
+        for (std::size_t i = 0; i < swing.samples.size(); i++) {
+            float tilt = estimator.accelTilt(swing.samples[i]);
+            float angle = estimator.update(swing.samples[i]);
+            if (i < settle)
+                continue;
+            filterError += std::pow(angle - swing.angle[i], 2);
+            tiltError += std::pow(tilt - swing.angle[i], 2);
+        }
+        filterError = std::sqrt(filterError / (swing.samples.size() - settle));
+        tiltError = std::sqrt(tiltError / (swing.samples.size() - settle));
+        std::cout << names[(int)filter] << ": RMS error " << filterError << " rad (accelerometer tilt " << tiltError
+                  << " rad), gyro bias " << estimator.getGyroBias() * 180 / M_PI << " deg/s" << std::endl;
+
+        // Without a bias estimate, the complementary filter is offset by the gyro bias times its time constant.
+        double limit = filter == Attitude::Filter_t::COMPLEMENTARY ? 0.025 : 0.01;
+        if (filterError > limit || filterError > tiltError / 2) {
+            throw std::runtime_error("Attitude filter does not track the swing!");
+        }
+        if (filter != Attitude::Filter_t::COMPLEMENTARY && std::fabs(estimator.getGyroBias() * 180 / M_PI - GYRO_BIAS) > 1) {
+            throw std::runtime_error("Attitude filter did not find the gyro bias!");
+        }
+    }
+}
+
+// Test case for the batch API and reset
+/**
+ * @brief Checks updating with a batch gives the same angle as updating one sample at a time, and
+ * that reset starts again from the accelerometer tilt.
+ * @return None
+ */
+void testBatch() {
+    std::cout << "Test function for batch updates is getting executed" << std::endl;
+    const Swing swing = makeSwing(1);
+    Attitude::Estimator single(Attitude::Filter_t::KALMAN, SAMPLE_PERIOD, RADIUS);
+    Attitude::Estimator batch(Attitude::Filter_t::KALMAN, SAMPLE_PERIOD, RADIUS);
+
+    for (const MPU6050_Driver::MPU6050Sample& sample : swing.samples)
+        single.update(sample);
+    for (std::size_t i = 0; i < swing.samples.size(); i += 40)
+        batch.updateBatch(&swing.samples[i], std::min<std::size_t>(40, swing.samples.size() - i));
+
+    if (single.getAngle() != batch.getAngle() || single.getGyroBias() != batch.getGyroBias()) {
+        throw std::runtime_error("Batch update differs from single updates!");
+    }
+
+    batch.reset();
+    if (batch.update(swing.samples[10]) != batch.accelTilt(swing.samples[10]) || batch.getGyroBias() != 0) {
+        throw std::runtime_error("Estimator did not reset!");
+    }
+}
+
+// Test case for updating straight from raw frames
+/**
+ * @brief Encodes the swing into raw frames, and checks every filter gives exactly the same angles fed the
+ * frames as fed the same frames converted into samples.
+ * @return None
+ */
+void testFrames() {
+    std::cout << "Test function for raw frame updates is getting executed" << std::endl;
+    const Swing swing = makeSwing(1);
+    MPU6050_Driver::MPU6050Scale scale;
+    const float perLsb[8] = {4.0f / 32767, 4.0f / 32767, 4.0f / 32767, 0, 500.0f / 32767, 500.0f / 32767, 500.0f / 32767, 0};
+    std::copy(perLsb, perLsb + 8, scale.perLsb);
+
+    std::vector<MPU6050_Driver::MPU6050Frame> frames(swing.samples.size());
+    for (std::size_t i = 0; i < frames.size(); i++) {
+        const float values[7] = {swing.samples[i].ax, swing.samples[i].ay, 0, 0, 0, 0, swing.samples[i].gz};
+        for (int j = 0; j < 7; j++) {
+            int16_t raw = perLsb[j] ? (int16_t)std::lround(values[j] / perLsb[j]) : 0;
+            frames[i].bytes[2 * j] = (uint16_t)raw >> 8;
+            frames[i].bytes[2 * j + 1] = raw & 0xFF;
+        }
+        frames[i].scale = &scale;
+    }
+
+    const Attitude::Filter_t filters[] = {Attitude::Filter_t::COMPLEMENTARY, Attitude::Filter_t::MAHONY, Attitude::Filter_t::KALMAN};
+    for (Attitude::Filter_t filter : filters) {
+        Attitude::Estimator fromFrames(filter, SAMPLE_PERIOD, RADIUS);
+        Attitude::Estimator fromSamples(filter, SAMPLE_PERIOD, RADIUS);
+        for (const MPU6050_Driver::MPU6050Frame& frame : frames) {
+            MPU6050_Driver::MPU6050Sample sample;
+            frame.toSample(sample);
+            if (fromFrames.update(frame) != fromSamples.update(sample) || fromFrames.accelTilt(frame) != fromSamples.accelTilt(sample)) {
+                throw std::runtime_error("Frame update differs from sample update!");
+            }
+        }
+    }
+}
+
+int main() {
+    //Execute test case
+    testFastAtan2();
+    testSignConvention();
+    testFilters();
+    testBatch();
+    testFrames();
+
+    std::cout << "All attitude estimator tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,214 @@
+/**
+ * @file    fake_i2c_if.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the register map fake of the I2C interface shared by the offline tests and benchmarks
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#ifndef FAKE_I2C_IF_H
+#define FAKE_I2C_IF_H
+
+#include <cstdint>
+#include <vector>
+#include "../lib/i2c_interface/i2c_interface.h"
+
+/**
+ * @brief I2C interface backed by a register file, standing in for a device offline. Registers are either 8 bit,
+ * with words in consecutive registers as on the MPU6050, or 16 bit as on the INA260. Block reads, block writes and
+ * combined transactions move on to the next register after each one. Every bus call is counted, and every register
+ * read is recorded in order. A fake device overrides readRegister(), writeRegister() and nextRegister() for the
+ * registers that do more than hold a value.
+ */
+class FakeRegisterMap : public I2C_Interface
+{
+public:
+  /**
+   * @brief Constructor.
+   * @param _wordRegisters True for 16 bit registers, false for 8 bit.
+   * @param _combined True if TransferSegments() is supported.
+   */
+  FakeRegisterMap(bool _wordRegisters = false, bool _combined = true) : wordRegisters(_wordRegisters), combined(_combined) {}
+
+  virtual uint8_t ReadRegister(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status = nullptr) override {
+    countRead();
+    status && (*status = I2C_STATUS_SUCCESS);
+    return readRegister(regAddress) & 0xFF;
+  }
+
+  virtual uint16_t ReadRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status = nullptr) override {
+    uint16_t data = ReadRegisterWordBigEndian(slaveAddress, regAddress, status);
+    return (data >> 8) | (data << 8);
+  }
+
+  virtual uint16_t ReadRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, i2c_status_t *status = nullptr) override {
+    countRead();
+    status && (*status = I2C_STATUS_SUCCESS);
+    if (wordRegisters)
+      return readRegister(regAddress);
+
+    uint8_t msb = readRegister(regAddress);
+    return ((uint16_t)msb << 8) | readRegister(nextRegister(regAddress));
+  }
+
+  virtual i2c_status_t WriteRegister(uint8_t slaveAddress, uint8_t regAddress, uint8_t data) override {
+    countWrite();
+    if (failWrites)
+      return I2C_STATUS_ERROR;
+
+    writeRegister(regAddress, data);
+    return I2C_STATUS_SUCCESS;
+  }
+
+  virtual i2c_status_t WriteRegisterWordLittleEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data) override {
+    return WriteRegisterWordBigEndian(slaveAddress, regAddress, (data >> 8) | (data << 8));
+  }
+
+  virtual i2c_status_t WriteRegisterWordBigEndian(uint8_t slaveAddress, uint8_t regAddress, uint16_t data) override {
+    countWrite();
+    if (failWrites)
+      return I2C_STATUS_ERROR;
+
+    uint8_t bytes[2] = {(uint8_t)(data >> 8), (uint8_t)(data & 0xFF)};
+    writeBytes(regAddress, 2, bytes);
+    return I2C_STATUS_SUCCESS;
+  }
+
+  virtual i2c_status_t ReadRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data) override {
+    countRead();
+    if (length > 32)
+      return I2C_STATUS_ERROR; // SMBus block limit
+
+    readBytes(regAddress, length, data);
+    return I2C_STATUS_SUCCESS;
+  }
+
+  virtual i2c_status_t WriteRegisterBlock(uint8_t slaveAddress, uint8_t regAddress, uint8_t length, uint8_t *data) override {
+    countWrite();
+    if (failWrites)
+      return I2C_STATUS_ERROR;
+
+    writeBytes(regAddress, length, data);
+    return I2C_STATUS_SUCCESS;
+  }
+
+  virtual i2c_status_t TransferSegments(i2c_segment_t *segments, uint8_t count) override {
+    if (!combined)
+      return I2C_STATUS_NONE;
+
+    // A write segment sets the register pointer, and writes any bytes after it from there.
+    countRead();
+    uint8_t pointer = 0;
+    for (uint8_t i = 0; i < count; i++) {
+      if (segments[i].read) {
+        pointer = readBytes(pointer, segments[i].length, segments[i].data);
+      } else if (segments[i].length > 0) {
+        pointer = segments[i].data[0];
+        if (segments[i].length > 1 && failWrites)
+          return I2C_STATUS_ERROR;
+        pointer = writeBytes(pointer, segments[i].length - 1, segments[i].data + 1);
+      }
+    }
+    return I2C_STATUS_SUCCESS;
+  }
+
+  /**
+   * @brief Register values. Only the low byte is used with 8 bit registers.
+   */
+  uint16_t regs[256] = {};
+
+  /**
+   * @brief Number of bus transactions made.
+   */
+  int transactions = 0;
+
+  /**
+   * @brief Number of bus reads, counting a combined transaction as one.
+   */
+  int reads = 0;
+
+  /**
+   * @brief Number of bus writes.
+   */
+  int writes = 0;
+
+  /**
+   * @brief Registers read, in order.
+   */
+  std::vector<uint8_t> readOrder;
+
+  /**
+   * @brief Fail every write, like a device that has dropped off the bus.
+   */
+  bool failWrites = false;
+
+protected:
+  /**
+   * @brief Read one register.
+   * @param regAddress Register
+   * @return uint16_t Register value
+   */
+  virtual uint16_t readRegister(uint8_t regAddress) {
+    readOrder.push_back(regAddress);
+    return regs[regAddress];
+  }
+
+  /**
+   * @brief Write one register.
+   * @param regAddress Register
+   * @param data Register value
+   */
+  virtual void writeRegister(uint8_t regAddress, uint16_t data) { regs[regAddress] = data; }
+
+  /**
+   * @brief Register a block transfer moves on to after a register.
+   * @param regAddress Register
+   * @return uint8_t Next register
+   */
+  virtual uint8_t nextRegister(uint8_t regAddress) { return regAddress + 1; }
+
+private:
+  void countRead(void) { transactions++; reads++; }
+
+  void countWrite(void) { transactions++; writes++; }
+
+  /**
+   * @brief Read bytes from consecutive registers, 16 bit registers most significant byte first.
+   * @return uint8_t Register after the last one read
+   */
+  uint8_t readBytes(uint8_t regAddress, uint16_t length, uint8_t *data) {
+    for (uint16_t i = 0; i < length; regAddress = nextRegister(regAddress)) {
+      uint16_t value = readRegister(regAddress);
+      if (wordRegisters)
+        data[i++] = value >> 8;
+      if (i < length)
+        data[i++] = value & 0xFF;
+    }
+    return regAddress;
+  }
+
+  /**
+   * @brief Write bytes to consecutive registers, 16 bit registers most significant byte first.
+   * @return uint8_t Register after the last one written
+   */
+  uint8_t writeBytes(uint8_t regAddress, uint16_t length, const uint8_t *data) {
+    for (uint16_t i = 0; i < length; regAddress = nextRegister(regAddress)) {
+      if (wordRegisters && i + 1 < length) {
+        writeRegister(regAddress, (uint16_t)(data[i] << 8) | data[i + 1]);
+        i += 2;
+      } else {
+        writeRegister(regAddress, data[i++]);
+      }
+    }
+    return regAddress;
+  }
+
+  /** True for 16 bit registers. */
+  bool wordRegisters;
+
+  /** True if TransferSegments() is supported. */
+  bool combined;
+};
+
+#endif
@@ -0,0 +1,131 @@
+/**
+ * @file    fake_mpu6050.h
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the MPU6050 fake shared by the offline tests and benchmarks
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#ifndef FAKE_MPU6050_H
+#define FAKE_MPU6050_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "fake_i2c_if.h"
+#include "../lib/mpu6050/mpu6050.h"
+
+/**
+ * @brief Register map standing in for an MPU6050. Reads of the data registers step through a set of frames,
+ * moving on to the next frame after GYRO_Z_OUT_L, and FIFO reads stream round and round the same frames. The
+ * FIFO count reads back fifoBytes, and writes to USER_CTRL are recorded, with FIFO_RESET clearing itself.
+ * A device with a live FIFO overrides countFIFO(), readFIFO() and resetFIFO().
+ */
+class FakeMPU6050 : public FakeRegisterMap
+{
+public:
+  /**
+   * @brief Constructor.
+   * @param _combined True if TransferSegments() is supported.
+   */
+  FakeMPU6050(bool _combined = true) : FakeRegisterMap(false, _combined) {}
+
+  /**
+   * @brief Bytes of one frame.
+   */
+  const uint8_t* frame(std::size_t index) const { return &frames[index * MPU6050_Driver::FIFO_FRAME_SIZE]; }
+
+  /**
+   * @brief Big endian frames, in ACCEL_X_OUT_H..GYRO_Z_OUT_L layout. With none, the data registers read as set.
+   */
+  std::vector<uint8_t> frames;
+
+  /**
+   * @brief FIFO count in bytes.
+   */
+  uint16_t fifoBytes = 0;
+
+  /**
+   * @brief Frame returned by the next data register read.
+   */
+  std::size_t nextFrame = 0;
+
+  /**
+   * @brief Values written to USER_CTRL, oldest first.
+   */
+  std::vector<uint8_t> userCtrlWrites;
+
+protected:
+  /**
+   * @brief FIFO count, read when FIFO_COUNT_H is.
+   * @return uint16_t Bytes in the FIFO
+   */
+  virtual uint16_t countFIFO(void) { return fifoBytes; }
+
+  /**
+   * @brief Next byte out of the FIFO.
+   * @return uint8_t FIFO byte
+   */
+  virtual uint8_t readFIFO(void) {
+    if (frames.empty())
+      return 0;
+
+    uint8_t data = frames[fifoOffset];
+    fifoOffset = (fifoOffset + 1) % frames.size();
+    return data;
+  }
+
+  /**
+   * @brief Empty the FIFO, as a write of FIFO_RESET does.
+   */
+  virtual void resetFIFO(void) {}
+
+  virtual uint16_t readRegister(uint8_t regAddress) override {
+    using namespace MPU6050_Driver::Sensor_Regs;
+    if (regAddress == FIFO_COUNT_H)
+      latchedCount = countFIFO();
+
+    FakeRegisterMap::readRegister(regAddress);
+    if (regAddress == FIFO_COUNT_H)
+      return latchedCount >> 8;
+    if (regAddress == FIFO_COUNT_L)
+      return latchedCount & 0xFF;
+    if (regAddress == FIFO_R_W)
+      return readFIFO();
+    if (regAddress < ACCEL_X_OUT_H || regAddress > GYRO_Z_OUT_L || frames.empty())
+      return regs[regAddress];
+
+    const std::size_t frameCount = frames.size() / MPU6050_Driver::FIFO_FRAME_SIZE;
+    uint8_t data = frame(nextFrame % frameCount)[regAddress - ACCEL_X_OUT_H];
+    if (regAddress == GYRO_Z_OUT_L)
+      nextFrame = (nextFrame + 1) % frameCount;
+    return data;
+  }
+
+  virtual void writeRegister(uint8_t regAddress, uint16_t data) override {
+    if (regAddress == MPU6050_Driver::Sensor_Regs::USER_CTRL) {
+      userCtrlWrites.push_back(data);
+      // FIFO_RESET clears itself once the FIFO is empty.
+      if (data & MPU6050_Driver::Regbits_USER_CTRL::BIT_FIFO_RESET) {
+        resetFIFO();
+        data &= ~MPU6050_Driver::Regbits_USER_CTRL::BIT_FIFO_RESET;
+      }
+    }
+    FakeRegisterMap::writeRegister(regAddress, data);
+  }
+
+  virtual uint8_t nextRegister(uint8_t regAddress) override {
+    // FIFO_R_W does not move on, so a block read drains the FIFO.
+    return regAddress == MPU6050_Driver::Sensor_Regs::FIFO_R_W ? regAddress : regAddress + 1;
+  }
+
+private:
+  /** FIFO count as of the last read of FIFO_COUNT_H. */
+  uint16_t latchedCount = 0;
+
+  /** Byte of the frames returned by the next FIFO read. */
+  std::size_t fifoOffset = 0;
+};
+
+#endif
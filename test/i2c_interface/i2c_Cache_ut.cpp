@@ -0,0 +1,108 @@
+/**
+ * @file    i2c_Cache_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the register shadow cache
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <iostream>
+#include <stdexcept>
+#include "../../lib/i2c_interface/cached_i2c_if.h"
+#include "../fake_i2c_if.h"
+
+// Test case for read-modify-write through the cache
+/**
+ * @brief Sets bits of a cached register, and checks only the first read and changed writes reach the bus.
+ * @return None
+ */
+void testReadModifyWrite() {
+    std::cout << "Test function for cached read-modify-write is getting executed" << std::endl;
+    FakeRegisterMap bus(true);
+    CACHED_I2C_IF cache(&bus);
+
+    cache.WriteRegisterBit(0x68, 0x1B, 0x08, true);
+    cache.WriteRegisterBit(0x68, 0x1B, 0x10, true);
+    cache.WriteRegisterBit(0x68, 0x1B, 0x10, true); // No change
+
+    // Verify the result
+    if (bus.regs[0x1B] != 0x18 || bus.reads != 1 || bus.writes != 2 || cache.GetWritesSkipped() != 1) {
+        throw std::runtime_error("Cached read-modify-write used the bus more than needed!");
+    }
+}
+
+// Test case for volatile registers
+/**
+ * @brief Reads a volatile register twice, and checks both reads reach the bus and see the latest value.
+ * @return None
+ */
+void testVolatile() {
+    std::cout << "Test function for volatile registers is getting executed" << std::endl;
+    FakeRegisterMap bus(true);
+    CACHED_I2C_IF cache(&bus);
+    const uint8_t volatileRegs[] = {0x3A};
+    cache.SetVolatileRegisters(0x68, volatileRegs, sizeof(volatileRegs));
+
+    cache.ReadRegister(0x68, 0x3A);
+    bus.regs[0x3A] = 0x01;
+    uint8_t status = cache.ReadRegister(0x68, 0x3A);
+
+    // Verify the result
+    if (status != 0x01 || bus.reads != 2) {
+        throw std::runtime_error("Volatile register was cached!");
+    }
+}
+
+// Test case for BeginUpdate/CommitUpdate
+/**
+ * @brief Updates three fields of one word register in an update, and checks they are committed as one write.
+ * Then checks Invalidate() forces the next read to the bus, and drops a staged write.
+ * @return None
+ */
+void testUpdate() {
+    std::cout << "Test function for staged updates is getting executed" << std::endl;
+    FakeRegisterMap bus(true);
+    CACHED_I2C_IF cache(&bus);
+    bus.regs[0x00] = 0x6127;
+
+    cache.BeginUpdate();
+    for (int field = 0; field < 3; field++) {
+        uint16_t conf = cache.ReadRegisterWordBigEndian(0x40, 0x00);
+        cache.WriteRegisterWordBigEndian(0x40, 0x00, conf & ~(0x7 << (3 * field)));
+    }
+    if (bus.writes != 0) {
+        throw std::runtime_error("Staged write reached the bus before CommitUpdate!");
+    }
+    i2c_status_t result = cache.CommitUpdate();
+
+    // Verify the result
+    if (result != I2C_STATUS_SUCCESS || bus.regs[0x00] != 0x6000 || bus.reads != 1 || bus.writes != 1) {
+        throw std::runtime_error("Staged update was not committed as one write!");
+    }
+
+    cache.Invalidate(0x40);
+    cache.ReadRegisterWordBigEndian(0x40, 0x00);
+    if (bus.reads != 2) {
+        throw std::runtime_error("Invalidate did not drop the shadow copy!");
+    }
+
+    // A write staged before Invalidate() must be dropped, not committed.
+    cache.BeginUpdate();
+    cache.WriteRegisterWordBigEndian(0x40, 0x00, 0x1234);
+    cache.Invalidate(0x40);
+    result = cache.CommitUpdate();
+    if (result != I2C_STATUS_SUCCESS || bus.writes != 1 || bus.regs[0x00] != 0x6000) {
+        throw std::runtime_error("Invalidate did not drop the staged write!");
+    }
+}
+
+int main() {
+
+    //Execute test case
+    testReadModifyWrite();
+    testVolatile();
+    testUpdate();
+    std::cout << "All I2C cache tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,284 @@
+/**
+ * @file    i2c_Trace_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of I2C trace recording and replay
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include "../../lib/i2c_interface/replay_i2c_if.h"
+#include "../../lib/i2c_interface/trace_i2c_if.h"
+#include "../../lib/mpu6050/mpu6050.h"
+#include "../fake_i2c_if.h"
+
+/**
+ * @brief Register map whose registers change after every read like a sensor's would, so the next read is different.
+ */
+class SensorBus : public FakeRegisterMap
+{
+protected:
+  virtual uint16_t readRegister(uint8_t regAddress) override {
+    uint16_t data = FakeRegisterMap::readRegister(regAddress);
+    regs[regAddress] = (data + 1) & 0xFF;
+    return data;
+  }
+};
+
+/**
+ * @brief Everything read by runTransactions().
+ */
+struct Readings {
+  uint8_t id = 0;
+  uint16_t word = 0;
+  uint8_t blocks[5][14] = {};
+  uint8_t longBlocks[5][100] = {};
+
+  bool operator==(const Readings& other) const {
+    return id == other.id && word == other.word && std::memcmp(blocks, other.blocks, sizeof(blocks)) == 0
+      && std::memcmp(longBlocks, other.longBlocks, sizeof(longBlocks)) == 0;
+  }
+};
+
+/**
+ * @brief Runs a fixed mix of every kind of transaction, like a driver setting up then sampling a sensor.
+ * @param bus Interface to run them on
+ * @return Readings Everything read
+ */
+Readings runTransactions(I2C_Interface& bus) {
+    Readings readings;
+    bus.WriteRegister(0x68, 0x6B, 0x00);
+    readings.id = bus.ReadRegister(0x68, 0x75);
+    bus.WriteRegisterWordBigEndian(0x40, 0x00, 0x1234);
+    readings.word = bus.ReadRegisterWordLittleEndian(0x40, 0x00);
+    uint8_t config[3] = {1, 2, 3};
+    bus.WriteRegisterBlock(0x68, 0x19, sizeof(config), config);
+
+    for (int i = 0; i < 5; i++) {
+        bus.ReadRegisterBlock(0x68, 0x3B, 14, readings.blocks[i]);
+        bus.ReadRegisterBlockLong(0x68, 0x74, 100, readings.longBlocks[i]);
+    }
+    return readings;
+}
+
+// Test case for recording and replaying every kind of transaction
+/**
+ * @brief Records a mix of transactions, replays them in the same order, and checks every read gives the
+ * same data, every write matches, and the timestamps go up.
+ * @return None
+ */
+void testRoundTrip(const std::string& path) {
+    std::cout << "Test function for I2C trace round trip is getting executed" << std::endl;
+    SensorBus bus;
+    for (int i = 0; i < 256; i++)
+        bus.regs[i] = i * 7;
+    bus.regs[0x75] = 0x68;
+
+    Readings recorded;
+    {
+        TRACE_I2C_IF trace(&bus, path);
+        recorded = runTransactions(trace);
+        if (trace.GetRecordCount() != 15 || trace.GetDroppedCount() != 0) {
+            throw std::runtime_error("Wrong number of transactions recorded!");
+        }
+    }
+
+    REPLAY_I2C_IF replay(path);
+    if (replay.GetRecordCount() != 15) {
+        throw std::runtime_error("Wrong number of transactions loaded!");
+    }
+
+    Readings replayed = runTransactions(replay);
+    if (!(replayed == recorded) || replayed.id != 0x68 || replayed.word != 0x3412) {
+        throw std::runtime_error("Replayed reads don't match the recording!");
+    }
+    if (replay.GetServedCount() != 15 || replay.GetMismatchCount() != 0 || replay.GetSkippedCount() != 0 || !replay.AtEnd()) {
+        throw std::runtime_error("Replay didn't follow the recording exactly!");
+    }
+    if (replay.GetTimestamp() == 0) {
+        throw std::runtime_error("Replay timestamps didn't move on!");
+    }
+}
+
+// Test case for replaying only part of a recording
+/**
+ * @brief Replays only the sample reads of a recording, then checks mismatched writes, missing reads, the end
+ * of the trace and looping.
+ * @return None
+ */
+void testPartialReplay(const std::string& path) {
+    std::cout << "Test function for partial I2C trace replay is getting executed" << std::endl;
+    SensorBus bus;
+    Readings recorded;
+    {
+        TRACE_I2C_IF trace(&bus, path);
+        recorded = runTransactions(trace);
+    }
+
+    // Only the block reads, skipping the set up.
+    REPLAY_I2C_IF replay(path);
+    uint8_t block[14];
+    uint64_t lastTimestamp = 0;
+    for (int i = 0; i < 5; i++) {
+        if (replay.ReadRegisterBlock(0x68, 0x3B, 14, block) != I2C_STATUS_SUCCESS
+            || std::memcmp(block, recorded.blocks[i], 14) != 0) {
+            throw std::runtime_error("Partial replay served the wrong block!");
+        }
+        if (replay.GetTimestamp() <= lastTimestamp) {
+            throw std::runtime_error("Replay timestamps went backwards!");
+        }
+        lastTimestamp = replay.GetTimestamp();
+    }
+    if (replay.GetSkippedCount() != 9 || replay.GetMismatchCount() != 0) {
+        throw std::runtime_error("Set up and long reads were not passed over!");
+    }
+
+    // The last long read is next, so a write is out of step, and a read never recorded isn't there.
+    if (replay.WriteRegister(0x68, 0x6B, 0x40) != I2C_STATUS_SUCCESS || replay.GetMismatchCount() != 1) {
+        throw std::runtime_error("Unrecorded write was not counted!");
+    }
+    i2c_status_t status;
+    replay.ReadRegister(0x68, 0x00, &status);
+    if (status != I2C_STATUS_ERROR || replay.GetMismatchCount() != 2 || replay.AtEnd()) {
+        throw std::runtime_error("Unrecorded read was served!");
+    }
+
+    // Past the end, reads fail until looping starts again from the first.
+    if (replay.ReadRegisterBlock(0x68, 0x3B, 14, block) != I2C_STATUS_ERROR) {
+        throw std::runtime_error("Read past the end of the trace was served!");
+    }
+    replay.SetLoop(true);
+    if (replay.ReadRegisterBlock(0x68, 0x3B, 14, block) != I2C_STATUS_SUCCESS
+        || std::memcmp(block, recorded.blocks[0], 14) != 0 || replay.GetTimestamp() <= lastTimestamp) {
+        throw std::runtime_error("Looping replay didn't start again from the first read!");
+    }
+
+    replay.Rewind();
+    if (replay.GetTimestamp() != 0 || replay.ReadRegister(0x68, 0x75) != recorded.id) {
+        throw std::runtime_error("Rewound replay didn't start again!");
+    }
+}
+
+/**
+ * @brief MPU6050 callback that keeps every sample.
+ */
+class KeepSamples : public MPU6050_Driver::MPU6050Interface {
+public:
+    virtual void hasSample(MPU6050_Driver::MPU6050Sample& sample) override { samples.push_back(sample); }
+
+    /** Samples, in order. */
+    std::vector<MPU6050_Driver::MPU6050Sample> samples;
+};
+
+/**
+ * @brief Sets up an MPU6050 driver on a bus and takes samples.
+ * @param bus Interface the driver talks through
+ * @return std::vector<MPU6050_Driver::MPU6050Sample> Samples, in order
+ */
+std::vector<MPU6050_Driver::MPU6050Sample> sampleMPU6050(I2C_Interface& bus) {
+    KeepSamples sink;
+    MPU6050_Driver::MPU6050 mpu(&bus, &sink, 0);
+    mpu.SetGyroFullScale(MPU6050_Driver::Gyro_FS_t::FS_500_DPS);
+    mpu.SetAccelFullScale(MPU6050_Driver::Accel_FS_t::FS_4G);
+    for (int i = 0; i < 20; i++)
+        mpu.ProcessSample(i + 1);
+    return sink.samples;
+}
+
+// Test case for replaying a driver
+/**
+ * @brief Records an MPU6050 driver setting up and sampling, replays it through a new driver, and checks the
+ * samples are identical.
+ * @return None
+ */
+void testDriverReplay(const std::string& path) {
+    std::cout << "Test function for I2C trace replay through the MPU6050 driver is getting executed" << std::endl;
+    SensorBus bus;
+    std::vector<MPU6050_Driver::MPU6050Sample> recorded;
+    {
+        TRACE_I2C_IF trace(&bus, path);
+        recorded = sampleMPU6050(trace);
+    }
+
+    REPLAY_I2C_IF replay(path);
+    std::vector<MPU6050_Driver::MPU6050Sample> replayed = sampleMPU6050(replay);
+    if (recorded.size() != 20 || replayed.size() != recorded.size()) {
+        throw std::runtime_error("Wrong number of replayed samples!");
+    }
+    for (std::size_t i = 0; i < recorded.size(); i++) {
+        const MPU6050_Driver::MPU6050Sample& a = recorded[i];
+        const MPU6050_Driver::MPU6050Sample& b = replayed[i];
+        if (a.ax != b.ax || a.ay != b.ay || a.az != b.az || a.temp != b.temp || a.gx != b.gx || a.gy != b.gy
+            || a.gz != b.gz || a.timestamp_ns != b.timestamp_ns || (i > 0 && a.ax == recorded[i - 1].ax)) {
+            throw std::runtime_error("Replayed sample doesn't match the recording!");
+        }
+    }
+    if (replay.GetMismatchCount() != 0 || !replay.AtEnd()) {
+        throw std::runtime_error("Driver replay didn't follow the recording exactly!");
+    }
+}
+
+/**
+ * @brief Checks loading a trace throws std::invalid_argument.
+ * @param path Trace file
+ * @param message Error message if it loads
+ */
+void expectRejected(const std::string& path, const char* message) {
+    try {
+        REPLAY_I2C_IF replay(path);
+    } catch (const std::invalid_argument&) {
+        return;
+    }
+    throw std::runtime_error(message);
+}
+
+// Test case for bad trace files
+/**
+ * @brief Checks missing files, files that aren't traces, and traces cut short are rejected.
+ * @return None
+ */
+void testBadFiles(const std::string& path) {
+    std::cout << "Test function for bad I2C trace files is getting executed" << std::endl;
+    std::remove(path.c_str());
+    expectRejected(path, "Missing trace file was loaded!");
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "not a trace at all";
+    }
+    expectRejected(path, "File that isn't a trace was loaded!");
+
+    SensorBus bus;
+    {
+        TRACE_I2C_IF trace(&bus, path);
+        runTransactions(trace);
+    }
+    std::ifstream in(path, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), bytes.size() - 5);
+    }
+    expectRejected(path, "Trace cut short was loaded!");
+}
+
+int main() {
+    std::string path = "i2c_Trace_ut.bin";
+
+    //Execute test case
+    testRoundTrip(path);
+    testPartialReplay(path);
+    testDriverReplay(path);
+    testBadFiles(path);
+    std::remove(path.c_str());
+
+    std::cout << "All I2C trace tests passed!" << std::endl;
+    return 0;
+}
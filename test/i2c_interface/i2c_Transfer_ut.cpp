@@ -0,0 +1,95 @@
+/**
+ * @file    i2c_Transfer_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the combined I2C transaction helpers
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "../../lib/i2c_interface/i2c_interface.h"
+#include "../fake_i2c_if.h"
+
+/**
+ * @brief Register map whose registers each hold their own address.
+ * @param map Register map
+ */
+void fillAddresses(FakeRegisterMap& map) {
+    for (int i = 0; i < 256; i++)
+        map.regs[i] = i;
+}
+
+// Test case for ReadRegisterWordsBigEndian method
+/**
+ * @brief Reads two word registers, with and without combined transaction support.
+ * Throws runtime error if the values, the number of transactions or the order of the reads is wrong.
+ * @param combined True if the interface supports TransferSegments().
+ * @return None
+ */
+void testReadRegisterWordsBigEndian(bool combined) {
+
+    std::cout << "Test function for ReadRegisterWordsBigEndian (combined " << combined << ") is getting executed" << std::endl;
+    FakeRegisterMap i2c(false, combined);
+    fillAddresses(i2c);
+    const uint8_t regs[2] = {0x02, 0x10};
+    uint16_t data[2] = {0, 0};
+
+    // Call the method
+    i2c_status_t result = i2c.ReadRegisterWordsBigEndian(0x40, regs, 2, data);
+
+    // Verify the result
+    if (result != I2C_STATUS_SUCCESS || data[0] != 0x0203 || data[1] != 0x1011) {
+        throw std::runtime_error("ReadRegisterWordsBigEndian returned the wrong data!");
+    }
+    if (i2c.transactions != (combined ? 1 : 2)) {
+        throw std::runtime_error("ReadRegisterWordsBigEndian used the wrong number of transactions!");
+    }
+    if (i2c.readOrder != std::vector<uint8_t>({0x02, 0x03, 0x10, 0x11})) {
+        throw std::runtime_error("ReadRegisterWordsBigEndian read the registers in the wrong order!");
+    }
+}
+
+// Test case for ReadRegisterBlockLong method
+/**
+ * @brief Reads blocks shorter and longer than the SMBus limit, with and without combined transaction support.
+ * Throws runtime error if a supported read fails or returns the wrong data, or an unsupported one doesn't return I2C_STATUS_NONE.
+ * @param combined True if the interface supports TransferSegments().
+ * @return None
+ */
+void testReadRegisterBlockLong(bool combined) {
+
+    std::cout << "Test function for ReadRegisterBlockLong (combined " << combined << ") is getting executed" << std::endl;
+    FakeRegisterMap i2c(false, combined);
+    fillAddresses(i2c);
+    uint8_t data[100];
+
+    // Call the method
+    i2c_status_t result = i2c.ReadRegisterBlockLong(0x68, 0x20, 14, data);
+
+    // Verify the result
+    if (result != I2C_STATUS_SUCCESS || data[0] != 0x20 || data[13] != 0x2D || i2c.transactions != 1) {
+        throw std::runtime_error("ReadRegisterBlockLong short read failed!");
+    }
+
+    result = i2c.ReadRegisterBlockLong(0x68, 0x20, sizeof(data), data);
+    if (combined && (result != I2C_STATUS_SUCCESS || data[99] != 0x83 || i2c.transactions != 2)) {
+        throw std::runtime_error("ReadRegisterBlockLong long read failed!");
+    }
+    if (!combined && result != I2C_STATUS_NONE) {
+        throw std::runtime_error("ReadRegisterBlockLong long read without TransferSegments should not be supported!");
+    }
+}
+
+int main() {
+
+    //Execute test case
+    testReadRegisterWordsBigEndian(true);
+    testReadRegisterWordsBigEndian(false);
+    testReadRegisterBlockLong(true);
+    testReadRegisterBlockLong(false);
+    std::cout << "All I2C transfer tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file    ina260_ReadSample_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the INA260 sample read against a fake register map
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "../../lib/i2c_interface/i2c_interface.h"
+#include "../../lib/ina260/ina260.h"
+#include "../fake_i2c_if.h"
+
+/**
+ * @brief Register map of the INA260's 16 bit big endian registers, as they read at 12 V and 1 A.
+ */
+class FakeINA260 : public FakeRegisterMap
+{
+public:
+  FakeINA260() : FakeRegisterMap(true) {
+    regs[INA260_Driver::Sensor_Regs::CONF_REG] = 0x6127;
+    regs[INA260_Driver::Sensor_Regs::CURRENT_REG] = 800;  // 1 A
+    regs[INA260_Driver::Sensor_Regs::VOLTAGE_REG] = 9600; // 12 V
+    regs[INA260_Driver::Sensor_Regs::MASKEN_REG] = 0x0408;
+  }
+};
+
+/**
+ * @brief FakeINA260 on an interface that stages configuration writes, where the staged writes never reach the sensor.
+ */
+class FailedCommitINA260 : public FakeINA260
+{
+public:
+  virtual i2c_status_t CommitUpdate(void) override { return I2C_STATUS_ERROR; }
+};
+
+/**
+ * @brief INA260 callback that does nothing, since data aquisition is not started.
+ */
+class NullCallback : public INA260_Driver::INA260Interface
+{
+public:
+  virtual void hasSample(INA260_Driver::INA260Sample &sample) override {}
+};
+
+// Test case for ReadSample method
+/**
+ * @brief Sets an operating mode, then reads a sample.
+ * Throws runtime error if the wrong registers are read, more than one transaction is used, or the values are wrong.
+ * @param mode Operating mode to test.
+ * @param expectedRegs Registers expected to be read, in order.
+ * @param expectCurrent True if the current should be read.
+ * @param expectVoltage True if the voltage should be read.
+ * @return None
+ */
+void testReadSample(INA260_Driver::Op_Mode mode, std::vector<uint8_t> expectedRegs, bool expectCurrent, bool expectVoltage) {
+    std::cout << "Test function for ReadSample (mode " << (int)mode << ") is getting executed" << std::endl;
+    FakeINA260 i2c;
+    NullCallback callback;
+    INA260_Driver::INA260 ina(&i2c, &callback, 27);
+    if (ina.OperatingMode(mode) != I2C_STATUS_SUCCESS) {
+        throw std::runtime_error("OperatingMode failed!");
+    }
+    i2c.transactions = 0;
+    i2c.readOrder.clear();
+
+    // Call the method
+    INA260_Driver::INA260Sample sample;
+    i2c_status_t result = ina.ReadSample(sample);
+
+    // Verify the result
+    if (result != I2C_STATUS_SUCCESS || i2c.transactions != 1 || i2c.readOrder != expectedRegs) {
+        throw std::runtime_error("ReadSample read the wrong registers!");
+    }
+    bool current = std::fabs(sample.current - 1.0) < 1e-6;
+    bool voltage = std::fabs(sample.voltage - 12.0) < 1e-6;
+    if (current != expectCurrent || voltage != expectVoltage || sample.maskEnable != 0x0408) {
+        throw std::runtime_error("ReadSample returned the wrong values!");
+    }
+}
+
+// Test case for a configuration that was never committed
+/**
+ * @brief Initialises the sensor in one mode, then fails to commit a change to another, and checks ReadSample()
+ * still reads the registers of the mode the sensor is really in.
+ * @return None
+ */
+void testFailedCommit() {
+    std::cout << "Test function for ReadSample after a failed commit is getting executed" << std::endl;
+    using namespace INA260_Driver;
+    FailedCommitINA260 i2c;
+    NullCallback callback;
+    INA260 ina(&i2c, &callback, 27);
+    if (ina.OperatingMode(Op_Mode::CURCONT) != I2C_STATUS_SUCCESS) {
+        throw std::runtime_error("OperatingMode failed!");
+    }
+    if (ina.InitializeSensor(Alert_Conf::CNVR, Conv_Time::TU1100, Conv_Time::TU1100, Ave_Mode::AV1, Op_Mode::VOLCONT) == I2C_STATUS_SUCCESS) {
+        throw std::runtime_error("Failed commit was reported as a success!");
+    }
+    i2c.readOrder.clear();
+
+    INA260Sample sample;
+    if (ina.ReadSample(sample) != I2C_STATUS_SUCCESS
+            || i2c.readOrder != std::vector<uint8_t>{Sensor_Regs::CURRENT_REG, Sensor_Regs::MASKEN_REG}) {
+        throw std::runtime_error("ReadSample followed a mode that was never committed!");
+    }
+}
+
+int main() {
+    using namespace INA260_Driver;
+
+    //Execute test case
+    testReadSample(Op_Mode::CURCONT, {Sensor_Regs::CURRENT_REG, Sensor_Regs::MASKEN_REG}, true, false);
+    testReadSample(Op_Mode::VOLCONT, {Sensor_Regs::VOLTAGE_REG, Sensor_Regs::MASKEN_REG}, false, true);
+    testReadSample(Op_Mode::CURVOLCONT, {Sensor_Regs::CURRENT_REG, Sensor_Regs::VOLTAGE_REG, Sensor_Regs::MASKEN_REG}, true, true);
+    testFailedCommit();
+    std::cout << "All ReadSample tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file    motordriver_RP1_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the RP1 register backends
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include "../../lib/MotorDriver/MotorDriver.h"
+#include "../../lib/MotorDriver/rp1.h"
+
+// Test case for the PWM registers
+/**
+ * @brief Runs the PWM backend against stand-in registers, and checks the period and duty cycle are
+ * converted to clock ticks and latched, and that other channels are left alone.
+ * @return None
+ */
+void testPWM() {
+    std::cout << "Test function for RP1 PWM registers is getting executed" << std::endl;
+    auto registers = std::make_shared<RegisterFile>(RP1::WINDOW_SIZE);
+    const std::size_t pwm = RP1::PWM0;
+
+    // Channel 0 is already in use by someone else.
+    registers->write(pwm + RP1::PWM_GLOBAL_CTRL, 1);
+    {
+        RP1PWM backend(registers, 2, 50000000);
+        backend.writePeriod(50000);
+        backend.writeEnable(true);
+        backend.writeDuty(12345);
+
+        if (registers->read(pwm + RP1::PWM_CHAN_RANGE(2)) != 2500 || registers->read(pwm + RP1::PWM_CHAN_DUTY(2)) != 617) {
+            throw std::runtime_error("Period or duty cycle was not converted to clock ticks!");
+        }
+        if (registers->read(pwm + RP1::PWM_CHAN_CTRL(2)) != RP1::PWM_CHAN_DEFAULT
+            || registers->read(pwm + RP1::PWM_GLOBAL_CTRL) != (RP1::PWM_SET_UPDATE | 0x5)) {
+            throw std::runtime_error("Channel was not enabled and latched!");
+        }
+
+        backend.writeDuty(50000);
+        if (registers->read(pwm + RP1::PWM_CHAN_DUTY(2)) != 2500) {
+            throw std::runtime_error("Full duty cycle lost a tick!");
+        }
+    }
+
+    if ((registers->read(pwm + RP1::PWM_GLOBAL_CTRL) & ~RP1::PWM_SET_UPDATE) != 1) {
+        throw std::runtime_error("Output was not disabled on exit!");
+    }
+}
+
+// Test case for the GPIO registers
+/**
+ * @brief Runs the direction backend against stand-in registers, and checks the pin is set up as a
+ * registered I/O output and driven through the set and clear aliases.
+ * @return None
+ */
+void testDIR() {
+    std::cout << "Test function for RP1 GPIO registers is getting executed" << std::endl;
+    auto registers = std::make_shared<RegisterFile>(RP1::WINDOW_SIZE);
+    const uint32_t mask = 1u << 23;
+    const std::size_t out = RP1::SYS_RIO0 + RP1::RIO_OUT;
+
+    // Pin defaults from the datasheet: function NULL (31), output disabled.
+    registers->write(RP1::IO_BANK0 + RP1::IO_GPIO_CTRL(23), 0x1f);
+    registers->write(RP1::PADS_BANK0 + RP1::PADS_GPIO(23), 0x96);
+
+    RP1DIR dir(registers, 23);
+    if ((registers->read(RP1::IO_BANK0 + RP1::IO_GPIO_CTRL(23)) & RP1::IO_FUNCSEL_MASK) != RP1::IO_FUNCSEL_SYS_RIO
+        || registers->read(RP1::PADS_BANK0 + RP1::PADS_GPIO(23)) != 0x16
+        || registers->read(RP1::SYS_RIO0 + RP1::ALIAS_SET + RP1::RIO_OE) != mask
+        || registers->read(out + RP1::ALIAS_CLR) != mask) {
+        throw std::runtime_error("Pin was not set up as a low output!");
+    }
+
+    registers->write(out + RP1::ALIAS_CLR, 0);
+    dir.writeDirection(true);
+    if (registers->read(out + RP1::ALIAS_SET) != mask || registers->read(out + RP1::ALIAS_CLR) != 0) {
+        throw std::runtime_error("Pin was not set high!");
+    }
+    dir.writeDirection(false);
+    if (registers->read(out + RP1::ALIAS_CLR) != mask) {
+        throw std::runtime_error("Pin was not set low!");
+    }
+
+    try {
+        RP1DIR outOfBank(registers, 28);
+    }
+    catch (const std::invalid_argument&) {
+        return;
+    }
+    throw std::runtime_error("Pin outside bank 0 was not reported!");
+}
+
+// Test case for the motor driver on the RP1 backends
+/**
+ * @brief Drives the motor driver through both backends on stand-in registers, checks a reversal
+ * lands in the registers, and times the update for information.
+ * @return None
+ */
+void testMotorDriver() {
+    std::cout << "Test function for the motor driver on RP1 registers is getting executed" << std::endl;
+    auto registers = std::make_shared<RegisterFile>(RP1::WINDOW_SIZE);
+    MotorDriver driver(std::unique_ptr<DIR_Backend>(new RP1DIR(registers, 23)),
+                       std::unique_ptr<PWM_Backend>(new RP1PWM(registers, 2)), 50000);
+
+    driver.setDutyCycle(-0.5);
+    if (registers->read(RP1::PWM0 + RP1::PWM_CHAN_DUTY(2)) != 1250
+        || registers->read(RP1::SYS_RIO0 + RP1::ALIAS_CLR + RP1::RIO_OUT) != (1u << 23)) {
+        throw std::runtime_error("Motor driver did not write the registers!");
+    }
+
+    // Time the hot path, for information. Alternate direction so every call writes.
+    const int writes = 100000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < writes; i++)
+        driver.setDutyCycle((i & 1) ? 0.5 : -0.25);
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << "Average reversing duty cycle update: " << elapsed.count() / writes << " ns" << std::endl;
+}
+
+// Test case for a missing register device
+/**
+ * @brief Checks mapping a device that doesn't exist is reported rather than carrying on.
+ * @return None
+ */
+void testMissingDevice() {
+    std::cout << "Test function for a missing register device is getting executed" << std::endl;
+    try {
+        RP1::MapPeripherals("/dev/missing_rp1_registers");
+    }
+    catch (const std::invalid_argument&) {
+        return;
+    }
+    throw std::runtime_error("Missing register device was not reported!");
+}
+
+int main() {
+    //Execute test case
+    testPWM();
+    testDIR();
+    testMotorDriver();
+    testMissingDevice();
+
+    std::cout << "All RP1 register tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file    motordriver_SysfsPWM_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the sysfs PWM backend
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "../../lib/MotorDriver/sysfs_pwm.h"
+
+/**
+ * @brief Reads the value last written to a stand-in attribute file.
+ * @param path Attribute file.
+ * @return std::string First line of the file.
+ */
+std::string readAttribute(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+// Test case for writing through the backend
+/**
+ * @brief Runs the backend against a stand-in sysfs directory, and checks every value written can
+ * be read back, including shorter values over longer ones, and that the output is disabled on exit.
+ * @return None
+ */
+void testWrites(const std::filesystem::path& chipDir) {
+    std::cout << "Test function for sysfs PWM writes is getting executed" << std::endl;
+    if (!SysfsPWM::CreateStandIn(chipDir, 2)) {
+        throw std::runtime_error("Failed to create the stand-in sysfs directory!");
+    }
+
+    const std::filesystem::path channelDir = chipDir / "pwm2";
+    {
+        SysfsPWM pwm(chipDir, 2);
+        if (!pwm.writePeriod(50000) || !pwm.writeEnable(true)) {
+            throw std::runtime_error("Failed to write the period or enable!");
+        }
+        if (readAttribute(channelDir / "period") != "50000" || readAttribute(channelDir / "enable") != "1") {
+            throw std::runtime_error("Period or enable was not written!");
+        }
+
+        for (uint32_t duty : {4294967295u, 49999u, 123u, 0u, 50000u}) {
+            if (!pwm.writeDuty(duty) || readAttribute(channelDir / "duty_cycle") != std::to_string(duty)) {
+                throw std::runtime_error("Duty cycle was not written!");
+            }
+        }
+
+        // Time the hot path, for information.
+        const int writes = 100000;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < writes; i++)
+            pwm.writeDuty(i % 50000);
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << "Average duty cycle write: " << elapsed.count() / writes << " ns" << std::endl;
+    }
+
+    if (readAttribute(channelDir / "enable") != "0") {
+        throw std::runtime_error("Output was not disabled on exit!");
+    }
+    if (readAttribute(chipDir / "unexport") != "0") {
+        throw std::runtime_error("Channel exported by someone else was unexported!");
+    }
+}
+
+// Test case for a missing PWM chip
+/**
+ * @brief Checks the backend reports a PWM chip that doesn't exist rather than carrying on.
+ * @return None
+ */
+void testMissingChip(const std::filesystem::path& chipDir) {
+    std::cout << "Test function for a missing PWM chip is getting executed" << std::endl;
+    try {
+        SysfsPWM pwm(chipDir / "missing", 2);
+    }
+    catch (const std::invalid_argument&) {
+        return;
+    }
+    throw std::runtime_error("Missing PWM chip was not reported!");
+}
+
+int main() {
+    char dirTemplate[] = "/tmp/sysfs_pwm_ut.XXXXXX";
+    if (!mkdtemp(dirTemplate)) {
+        throw std::runtime_error("Failed to create a temp directory!");
+    }
+    const std::filesystem::path chipDir = std::filesystem::path(dirTemplate) / "pwmchip2";
+
+    //Execute test case
+    testWrites(chipDir);
+    testMissingChip(chipDir);
+    std::filesystem::remove_all(dirTemplate);
+
+    std::cout << "All sysfs PWM tests passed!" << std::endl;
+    return 0;
+}
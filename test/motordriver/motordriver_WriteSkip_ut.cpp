@@ -0,0 +1,137 @@
+/**
+ * @file    motordriver_WriteSkip_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the motor driver's skipped writes
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../../lib/MotorDriver/MotorDriver.h"
+
+/** Every write made to the fake backends, in order, e.g. "duty 100" or "dir 1". */
+std::vector<std::string> writes;
+
+/**
+ * @brief Direction output that records its writes.
+ */
+class FakeDIR : public DIR_Backend {
+public:
+    virtual void writeDirection(bool forward) override { writes.push_back("dir " + std::to_string(forward)); }
+};
+
+/**
+ * @brief PWM backend that records its duty cycle writes.
+ */
+class FakePWM : public PWM_Backend {
+public:
+    virtual bool writePeriod(uint32_t) override { return true; }
+    virtual bool writeDuty(uint32_t duty_ns) override { writes.push_back("duty " + std::to_string(duty_ns)); return true; }
+    virtual bool writeEnable(bool) override { return true; }
+};
+
+/**
+ * @brief Checks the writes recorded since the last check, then clears them.
+ * @param expected Writes expected, in order
+ * @param message Error message if they don't match
+ */
+void expectWrites(const std::vector<std::string>& expected, const char* message) {
+    if (writes != expected) {
+        for (const std::string& write : writes)
+            std::cout << "  " << write << std::endl;
+        throw std::runtime_error(message);
+    }
+    writes.clear();
+}
+
+// Test case for change detection
+/**
+ * @brief Checks repeated duty cycles and directions are written once, and counted as skipped after.
+ * @return None
+ */
+void testChangeDetection() {
+    std::cout << "Test function for motor driver change detection is getting executed" << std::endl;
+    MotorDriver driver(std::unique_ptr<DIR_Backend>(new FakeDIR), std::unique_ptr<PWM_Backend>(new FakePWM), 1000);
+    expectWrites({"dir 0", "duty 0"}, "Constructor writes are wrong!");
+
+    driver.setDutyCycle(0.5);
+    driver.setDutyCycle(0.5);
+    driver.setDutyCycleDelta(0.0001);
+    expectWrites({"dir 1", "duty 500"}, "Unchanged duty cycle was rewritten!");
+
+    driver.setDutyCycle(0.25);
+    expectWrites({"duty 250"}, "Changed duty cycle was not written!");
+
+    // Stopping keeps the direction, so there's nothing to undo when starting again.
+    driver.setDutyCycle(0);
+    driver.setDutyCycle(0.1);
+    expectWrites({"duty 0", "duty 100"}, "Stopping changed the direction!");
+
+    if (driver.getDutyWriteCount() != 4 || driver.getDutySkipCount() != 2
+        || driver.getDirWriteCount() != 1 || driver.getDirSkipCount() != 5) {
+        throw std::runtime_error("Write counters are wrong!");
+    }
+}
+
+// Test case for direction reversal
+/**
+ * @brief Checks a reversal stops the output before changing direction, then writes the new duty cycle.
+ * @return None
+ */
+void testReversal() {
+    std::cout << "Test function for motor driver reversal is getting executed" << std::endl;
+    MotorDriver driver(std::unique_ptr<DIR_Backend>(new FakeDIR), std::unique_ptr<PWM_Backend>(new FakePWM), 1000);
+    driver.setDutyCycle(0.8);
+    writes.clear();
+
+    driver.setDutyCycle(-0.3);
+    expectWrites({"duty 0", "dir 0", "duty 300"}, "Reversal was not glitch free!");
+
+    // Already stopped, so no extra zero is needed.
+    driver.setDutyCycle(0);
+    driver.setDutyCycle(0.3);
+    expectWrites({"duty 0", "dir 1", "duty 300"}, "Reversal from stopped is wrong!");
+}
+
+// Test case for deadband and hysteresis
+/**
+ * @brief Checks small duty cycles are written as zero, small changes are skipped, and that stopping
+ * and starting are always written.
+ * @return None
+ */
+void testDeadbandHysteresis() {
+    std::cout << "Test function for motor driver deadband and hysteresis is getting executed" << std::endl;
+    MotorDriver driver(std::unique_ptr<DIR_Backend>(new FakeDIR), std::unique_ptr<PWM_Backend>(new FakePWM), 1000);
+    driver.setDeadband(50);
+    driver.setHysteresis(10);
+    writes.clear();
+
+    // Inside the deadband, even the wrong way, nothing changes.
+    driver.setDutyCycle(-0.04);
+    driver.setDutyCycle(0.049);
+    expectWrites({}, "Duty cycle in the deadband was written!");
+
+    driver.setDutyCycle(0.06);
+    driver.setDutyCycle(0.07);
+    driver.setDutyCycle(0.071);
+    expectWrites({"dir 1", "duty 60", "duty 71"}, "Hysteresis is wrong!");
+
+    driver.setDutyCycle(0.065);
+    driver.setDutyCycle(0.03);
+    expectWrites({"duty 0"}, "Stopping in the deadband was not written!");
+}
+
+int main() {
+    //Execute test case
+    testChangeDetection();
+    testReversal();
+    testDeadbandHysteresis();
+
+    std::cout << "All motor driver write tests passed!" << std::endl;
+    return 0;
+}
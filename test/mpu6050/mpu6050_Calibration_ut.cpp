@@ -0,0 +1,258 @@
+/**
+ * @file    mpu6050_Calibration_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the MPU6050 offset calibration
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include "../../lib/mpu6050/mpu6050.h"
+#include "../fake_mpu6050.h"
+
+using MPU6050_Driver::Sensor_Regs::XA_OFFS_USR_H;
+using MPU6050_Driver::Sensor_Regs::XG_OFFS_USR_H;
+
+/** Raw accelerometer LSBs per g, at the +-2g range the tests use. */
+static const float ACCEL_LSB_PER_G = 16384.0f;
+
+/** Raw gyro LSBs per deg/s, at the +-250 deg/s range the tests use. */
+static const float GYRO_LSB_PER_DPS = 131.0f;
+
+/** Accelerometer offsets the sensor is trimmed to at the factory. X is odd, to check bit 0 is kept. */
+static const int16_t FACTORY_ACCEL[3] = {-2001, 1500, 900};
+
+/** Gyro offsets the sensor is trimmed to at the factory. */
+static const int16_t FACTORY_GYRO[3] = {20, -5, 40};
+
+/**
+ * @brief I2C interface standing in for an MPU6050 at rest, with 1g in the Y axis, whose factory trim leaves
+ * some bias in every axis. Registers read back what was written, and the FIFO fills with frames worked out
+ * from the offset registers written, by a few frames each time its count is read.
+ */
+class RestBus : public FakeMPU6050
+{
+public:
+  RestBus() : FakeMPU6050(false) {
+    for (int axis = 0; axis < 3; axis++) {
+      setWord(XA_OFFS_USR_H + 2 * axis, FACTORY_ACCEL[axis]);
+      setWord(XG_OFFS_USR_H + 2 * axis, FACTORY_GYRO[axis]);
+    }
+    regs[MPU6050_Driver::Sensor_Regs::SELF_TEST_X] = 0x1a;
+    regs[MPU6050_Driver::Sensor_Regs::SELF_TEST_Y] = 0x0f;
+    regs[MPU6050_Driver::Sensor_Regs::SELF_TEST_Z] = 0x1b;
+    regs[MPU6050_Driver::Sensor_Regs::SELF_TEST_A] = 0x12;
+  }
+
+  /**
+   * @brief Offset register, as the sensor holds it.
+   */
+  int16_t word(uint8_t regAddress) const { return (int16_t)(regs[regAddress] << 8 | regs[regAddress + 1]); }
+
+  /**
+   * @brief Mean acceleration of an axis the sensor outputs, with its current offsets (g).
+   */
+  float accel(int axis) const {
+    return ((axis == 1 ? 1.0f : 0.0f) + ACCEL_BIAS[axis]) + (word(XA_OFFS_USR_H + 2 * axis) - FACTORY_ACCEL[axis]) / 2048.0f;
+  }
+
+  /**
+   * @brief Mean angular velocity of an axis the sensor outputs, with its current offsets (deg/s).
+   */
+  float gyro(int axis) const {
+    return GYRO_BIAS[axis] + (word(XG_OFFS_USR_H + 2 * axis) - FACTORY_GYRO[axis]) / 32.8f;
+  }
+
+  /**
+   * @brief Peak gyro noise (raw LSBs), alternating about the mean. Large enough and the rig seems to be moving.
+   */
+  int gyroNoise = 20;
+
+protected:
+  virtual uint16_t countFIFO(void) override {
+    if (regs[MPU6050_Driver::Sensor_Regs::USER_CTRL] & MPU6050_Driver::Regbits_USER_CTRL::BIT_FIFO_EN)
+      queued = std::min<uint32_t>(queued + 18 * MPU6050_Driver::FIFO_FRAME_SIZE, MPU6050_Driver::FIFO_SIZE - 2);
+    return queued;
+  }
+
+  virtual uint8_t readFIFO(void) override {
+    if (fifoByte == 0)
+      workOutFrame();
+    uint8_t data = fifoFrame[fifoByte];
+    fifoByte = (fifoByte + 1) % MPU6050_Driver::FIFO_FRAME_SIZE;
+    queued--;
+    return data;
+  }
+
+  virtual void resetFIFO(void) override { queued = 0; }
+
+private:
+  /** Bias the factory trim leaves in each accelerometer axis (g). */
+  const float ACCEL_BIAS[3] = {0.05f, -0.03f, 0.02f};
+
+  /** Bias the factory trim leaves in each gyro axis (deg/s). */
+  const float GYRO_BIAS[3] = {1.5f, -2.0f, 0.7f};
+
+  /** Bytes in the FIFO. */
+  uint32_t queued = 0;
+
+  /** Frame being read out of the FIFO. */
+  uint8_t fifoFrame[MPU6050_Driver::FIFO_FRAME_SIZE] = {};
+
+  /** Byte of the frame read next. */
+  uint8_t fifoByte = 0;
+
+  /** Frames read out of the FIFO. */
+  uint32_t framesRead = 0;
+
+  /** Write a big endian register pair. */
+  void setWord(uint8_t regAddress, int16_t value) {
+    regs[regAddress] = (uint16_t)value >> 8;
+    regs[regAddress + 1] = value & 0xFF;
+  }
+
+  /** Work out the next frame from the offsets, with noise that averages out. */
+  void workOutFrame(void) {
+    const int sign = (framesRead++ % 2) ? 1 : -1;
+    for (int axis = 0; axis < 3; axis++) {
+      const int16_t accelRaw = (int16_t)std::lround(accel(axis) * ACCEL_LSB_PER_G) + sign * 30;
+      const int16_t gyroRaw = (int16_t)std::lround(gyro(axis) * GYRO_LSB_PER_DPS) + sign * gyroNoise;
+      fifoFrame[2 * axis] = (uint16_t)accelRaw >> 8;
+      fifoFrame[2 * axis + 1] = accelRaw & 0xFF;
+      fifoFrame[8 + 2 * axis] = (uint16_t)gyroRaw >> 8;
+      fifoFrame[9 + 2 * axis] = gyroRaw & 0xFF;
+    }
+  }
+};
+
+/**
+ * @brief Implementation of the MPU6050Interface that drops every sample, since calibration never sends any.
+ */
+class DropSamples : public MPU6050_Driver::MPU6050Interface
+{
+public:
+  virtual void hasSample(MPU6050_Driver::MPU6050Sample& sample) override {}
+};
+
+/**
+ * @brief Set up a sensor as the table does, at 100 Hz with the DLPF on and the FIFO off.
+ */
+void initialize(MPU6050_Driver::MPU6050& mpu) {
+    if (mpu.InitializeSensor(MPU6050_Driver::Gyro_FS_t::FS_250_DPS, MPU6050_Driver::Accel_FS_t::FS_2G,
+                             MPU6050_Driver::DLPF_t::BW_94Hz, 9) != I2C_STATUS_SUCCESS) {
+        throw std::runtime_error("InitializeSensor failed!");
+    }
+}
+
+// Test case for calibrating a sensor at rest
+/**
+ * @brief Calibrates a sensor at rest, and checks every axis is left within three quarters of an offset step of
+ * its target, that the accelerometer offsets keep bit 0, that the offsets returned are those in the sensor,
+ * and that the FIFO and sample rate are put back.
+ * @return None
+ */
+void testCalibrate() {
+    std::cout << "Test function for offset calibration is getting executed" << std::endl;
+    using namespace MPU6050_Driver;
+    RestBus bus;
+    DropSamples sink;
+    MPU6050 mpu(&bus, &sink, 0);
+    initialize(mpu);
+
+    MPU6050Offsets offsets;
+    if (mpu.CalibrateOffsets(offsets, 0, 1, 0, 0, 0, 0, 256) != Calibration_t::DONE) {
+        throw std::runtime_error("Calibration didn't settle!");
+    }
+    for (int axis = 0; axis < 3; axis++) {
+        const float target = axis == 1 ? 1.0f : 0.0f;
+        if (std::fabs(bus.accel(axis) - target) > 1.5f / 2048.0f || std::fabs(bus.gyro(axis)) > 0.75f / 32.8f) {
+            throw std::runtime_error("Calibration left a bias!");
+        }
+        if (offsets.accel[axis] != bus.word(Sensor_Regs::XA_OFFS_USR_H + 2 * axis)
+                || offsets.gyro[axis] != bus.word(Sensor_Regs::XG_OFFS_USR_H + 2 * axis)) {
+            throw std::runtime_error("Calibration returned offsets that aren't in the sensor!");
+        }
+        if ((offsets.accel[axis] & 1) != (FACTORY_ACCEL[axis] & 1)) {
+            throw std::runtime_error("Calibration changed bit 0 of an accelerometer offset!");
+        }
+    }
+
+    i2c_status_t error;
+    if (mpu.GetGyro_SampleRateDivider(&error) != 9 || mpu.GetSensor_FIFO_Config(&error) != 0 || mpu.GetSensor_FIFO_Enable(&error)) {
+        throw std::runtime_error("Calibration didn't put the FIFO and sample rate back!");
+    }
+
+    // Offsets written back are read back the same.
+    MPU6050Offsets readBack;
+    if (mpu.SetOffsets(offsets) != I2C_STATUS_SUCCESS || mpu.GetOffsets(readBack) != I2C_STATUS_SUCCESS) {
+        throw std::runtime_error("Offsets couldn't be written or read!");
+    }
+    for (int axis = 0; axis < 3; axis++) {
+        if (readBack.accel[axis] != offsets.accel[axis] || readBack.gyro[axis] != offsets.gyro[axis]) {
+            throw std::runtime_error("Offsets read back differ!");
+        }
+    }
+}
+
+// Test case for calibrating a sensor that isn't at rest
+/**
+ * @brief Calibrates a sensor that is moving and one that has dropped off the bus, and checks neither is
+ * calibrated, and the moving one is left at its factory trim.
+ * @return None
+ */
+void testRejected() {
+    std::cout << "Test function for rejected offset calibration is getting executed" << std::endl;
+    using namespace MPU6050_Driver;
+    RestBus bus;
+    DropSamples sink;
+    MPU6050 mpu(&bus, &sink, 0);
+    initialize(mpu);
+
+    bus.gyroNoise = 300;
+    MPU6050Offsets offsets;
+    if (mpu.CalibrateOffsets(offsets, 0, 1, 0, 0, 0, 0, 256) != Calibration_t::MOVING) {
+        throw std::runtime_error("Calibration didn't see the rig moving!");
+    }
+    for (int axis = 0; axis < 3; axis++) {
+        if (bus.word(Sensor_Regs::XA_OFFS_USR_H + 2 * axis) != FACTORY_ACCEL[axis] || offsets.accel[axis] != FACTORY_ACCEL[axis]
+                || bus.word(Sensor_Regs::XG_OFFS_USR_H + 2 * axis) != FACTORY_GYRO[axis] || offsets.gyro[axis] != FACTORY_GYRO[axis]) {
+            throw std::runtime_error("A moving rig wasn't left at its factory trim!");
+        }
+    }
+
+    bus.failWrites = true;
+    if (mpu.CalibrateOffsets(offsets) != Calibration_t::BUS_ERROR) {
+        throw std::runtime_error("Calibration didn't report the bus failing!");
+    }
+}
+
+// Test case for the device ID
+/**
+ * @brief Checks the device ID is the self test registers, X first.
+ * @return None
+ */
+void testDeviceID() {
+    std::cout << "Test function for the device ID is getting executed" << std::endl;
+    RestBus bus;
+    DropSamples sink;
+    MPU6050_Driver::MPU6050 mpu(&bus, &sink, 0);
+
+    i2c_status_t error;
+    if (mpu.GetDeviceID(&error) != 0x1a0f1b12 || error != I2C_STATUS_SUCCESS) {
+        throw std::runtime_error("Device ID is wrong!");
+    }
+}
+
+int main() {
+    //Execute test case
+    testCalibrate();
+    testRejected();
+    testDeviceID();
+
+    std::cout << "All offset calibration tests passed!" << std::endl;
+    return 0;
+}
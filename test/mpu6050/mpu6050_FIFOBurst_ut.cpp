@@ -0,0 +1,131 @@
+/**
+ * @file    mpu6050_FIFOBurst_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does online testing of FIFO burst data aquisition between Pi and the MPU sensor
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <iostream>
+#include <cmath>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+#include "../../lib/mpu6050/mpu6050.h"
+#include "../../lib/i2c_interface/smbus_i2c_if.h"
+
+/**
+ * @brief Implementation of the MPU6050Interface that counts the samples and batches it receives.
+ */
+class MPU6050_BatchCounter : public MPU6050_Driver::MPU6050Interface
+{
+public:
+  virtual void hasSample(MPU6050_Driver::MPU6050Sample& sample) override {
+    samples++;
+  }
+
+  virtual void hasBatch(MPU6050_Driver::MPU6050Sample* batch, std::size_t count) override {
+    batches++;
+    samples += count;
+  }
+
+  /**
+   * @brief Number of samples received.
+   */
+  std::size_t samples = 0;
+
+  /**
+   * @brief Number of batches received.
+   */
+  std::size_t batches = 0;
+};
+
+// Test case for ReadFIFOFrames method
+/**
+ * @brief Lets the FIFO fill for a while, then drains it with ReadFIFOFrames.
+ * Throws runtime error if no frames are read, or if the sensor at rest doesn't measure about 1 g.
+ * @return None
+ */
+void testReadFIFOFrames(MPU6050_Driver::MPU6050* mpu) {
+
+    std::cout << "Test function for ReadFIFOFrames is getting executed" << std::endl;
+    if (mpu->SetAcquisitionMode(MPU6050_Driver::Acquisition_t::FIFO_BURST, 8) != I2C_STATUS_SUCCESS) {
+        throw std::runtime_error("SetAcquisitionMode test failed!");
+    }
+
+    // Wait for the FIFO to fill about halfway, well short of overflowing.
+    i2c_status_t error;
+    const float sampleRate_Hz = mpu->GetSensor_CurrentSampleRate_Hz(&error);
+    if (error != I2C_STATUS_SUCCESS) {
+        throw std::runtime_error("GetSensor_CurrentSampleRate_Hz test failed!");
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds((int64_t)(MPU6050_Driver::FIFO_MAX_FRAMES / 2 * 1e6 / sampleRate_Hz)));
+
+    // Call the method
+    MPU6050_Driver::MPU6050Sample samples[MPU6050_Driver::FIFO_MAX_FRAMES];
+    uint16_t frames = mpu->ReadFIFOFrames(samples, MPU6050_Driver::FIFO_MAX_FRAMES, &error);
+
+    // Verify the result
+    if (error != I2C_STATUS_SUCCESS || frames == 0) {
+        throw std::runtime_error("ReadFIFOFrames test failed!");
+    }
+    for (uint16_t i = 0; i < frames; i++) {
+        float g = std::sqrt(samples[i].ax * samples[i].ax + samples[i].ay * samples[i].ay + samples[i].az * samples[i].az);
+        if (g < 0.8 || g > 1.2) {
+            throw std::runtime_error("ReadFIFOFrames returned a misaligned frame!");
+        }
+    }
+}
+
+// Test case for FIFO burst data aquisition
+/**
+ * @brief Runs FIFO burst data aquisition for a second and checks the samples arrive in batches without overflowing.
+ * @return None
+ */
+void testFIFOBurstAquisition(MPU6050_Driver::MPU6050* mpu, MPU6050_BatchCounter* counter) {
+
+    std::cout << "Test function for FIFO burst aquisition is getting executed" << std::endl;
+    mpu->SetAcquisitionMode(MPU6050_Driver::Acquisition_t::FIFO_BURST, 8);
+    mpu->begin();
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    mpu->end();
+
+    // Verify the result
+    if (counter->batches == 0 || counter->samples < counter->batches) {
+        throw std::runtime_error("FIFO burst aquisition test failed!");
+    }
+    if (mpu->GetFIFOOverflowCount() != 0) {
+        throw std::runtime_error("FIFO overflowed during burst aquisition!");
+    }
+    std::cout << counter->samples << " samples in " << counter->batches << " batches" << std::endl;
+
+    // Put the sensor back into the default mode.
+    mpu->SetAcquisitionMode(MPU6050_Driver::Acquisition_t::DATA_READY);
+}
+
+int main() {
+
+    // I2C device file and address for the MPU:
+    std::string MPU_i2cFile = "/dev/i2c-1";
+    uint8_t MPU_Address = MPU6050_ADDRESS;
+
+    // Initialise MPU6050 object with a counting callback, and I2C callback for communication.
+    std::cout << "MPU6050 instance creation" << std::endl;
+    MPU6050_BatchCounter MPU6050Callback;
+    SMBUS_I2C_IF MPU6050_I2C_Callback;
+    MPU6050_I2C_Callback.Init_I2C(MPU_Address, MPU_i2cFile);
+    MPU6050_Driver::MPU6050 MPU6050(&MPU6050_I2C_Callback, &MPU6050Callback, 4);
+
+    // Run the sensor at 1 kHz, so the FIFO fills quickly.
+    if (MPU6050.InitializeSensor(MPU6050_Driver::Gyro_FS_t::FS_250_DPS, MPU6050_Driver::Accel_FS_t::FS_2G,
+                                 MPU6050_Driver::DLPF_t::BW_184Hz, 0) != I2C_STATUS_SUCCESS) {
+        throw std::runtime_error("InitializeSensor failed!");
+    }
+
+    //Execute test case
+    testReadFIFOFrames(&MPU6050);
+    testFIFOBurstAquisition(&MPU6050, &MPU6050Callback);
+    std::cout << "All FIFO burst tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file    mpu6050_FrameConvert_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the batch frame conversion
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "../../lib/mpu6050/frame_convert.h"
+
+/**
+ * @brief Scale factors of a pair of full scale ranges, as the driver resolves them.
+ * @return MPU6050Scale Scale factors.
+ */
+MPU6050_Driver::MPU6050Scale makeScale(float accelConst, float gyroConst) {
+    MPU6050_Driver::MPU6050Scale scale;
+    const float perLsb[8] = {accelConst, accelConst, accelConst, 0, gyroConst, gyroConst, gyroConst, 0};
+    std::memcpy(scale.perLsb, perLsb, sizeof(perLsb));
+    return scale;
+}
+
+/**
+ * @brief Checks a batch holds exactly, bit for bit, what MPU6050Frame::convert() gives for each frame.
+ * @return bool True if every value matches.
+ */
+bool matchesFrames(const uint8_t* frames, uint16_t count, const MPU6050_Driver::MPU6050Scale& scale,
+                   const MPU6050_Driver::MPU6050Batch& batch) {
+    if (batch.count != count)
+        return false;
+
+    for (uint16_t i = 0; i < count; i++) {
+        MPU6050_Driver::MPU6050Sample sample;
+        MPU6050_Driver::MPU6050Frame::convert(frames + i * MPU6050_Driver::FIFO_FRAME_SIZE, scale, sample);
+        const float expected[7] = {sample.ax, sample.ay, sample.az, sample.temp, sample.gx, sample.gy, sample.gz};
+        for (int word = 0; word < 7; word++) {
+            if (std::memcmp(&batch.words[word][i], &expected[word], sizeof(float)) != 0)
+                return false;
+        }
+    }
+    return true;
+}
+
+// Test case for matching the single frame conversion
+/**
+ * @brief Converts random frames, including every extreme raw value, at every full scale range and every
+ * batch size, from an unaligned array sized exactly to the frames, and checks the vector and scalar kernels
+ * both match MPU6050Frame::convert() bit for bit.
+ * @return None
+ */
+void testConvertFrames() {
+    std::cout << "Test function for ConvertFrames (" << MPU6050_Driver::ConvertFramesISA() << ") is getting executed" << std::endl;
+    using namespace MPU6050_Driver;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> byte(0, 255);
+    const float accelConsts[4] = {2.0f / 32767.0f, 4.0f / 32767.0f, 8.0f / 32767.0f, 16.0f / 32767.0f};
+    const float gyroConsts[4] = {250.0f / 32767.0f, 500.0f / 32767.0f, 1000.0f / 32767.0f, 2000.0f / 32767.0f};
+    MPU6050Batch batch, scalarBatch;
+
+    for (uint16_t count = 0; count <= BATCH_CAPACITY; count++) {
+        // One byte of padding in front, so the frames are not aligned.
+        std::vector<uint8_t> buffer(1 + count * FIFO_FRAME_SIZE);
+        for (uint8_t& value : buffer)
+            value = byte(rng);
+        const uint8_t extremes[4][2] = {{0x80, 0x00}, {0x7F, 0xFF}, {0xFF, 0xFF}, {0x00, 0x00}};
+        for (uint16_t i = 0; i < count && i < 4; i++)
+            for (int word = 0; word < 7; word++)
+                std::memcpy(&buffer[1 + i * FIFO_FRAME_SIZE + 2 * word], extremes[(i + word) % 4], 2);
+        const uint8_t* frames = buffer.data() + 1;
+
+        const MPU6050Scale scale = makeScale(accelConsts[count % 4], gyroConsts[(count / 4) % 4]);
+        ConvertFrames(frames, count, scale, batch);
+        ConvertFramesScalar(frames, count, scale, scalarBatch);
+        if (!matchesFrames(frames, count, scale, batch)) {
+            throw std::runtime_error("ConvertFrames differs from MPU6050Frame::convert!");
+        }
+        if (!matchesFrames(frames, count, scale, scalarBatch)) {
+            throw std::runtime_error("ConvertFramesScalar differs from MPU6050Frame::convert!");
+        }
+    }
+
+    // Frames beyond the capacity of a batch are left out.
+    std::vector<uint8_t> frames((BATCH_CAPACITY + 5) * FIFO_FRAME_SIZE, 0x12);
+    ConvertFrames(frames.data(), BATCH_CAPACITY + 5, makeScale(accelConsts[0], gyroConsts[0]), batch);
+    if (batch.count != BATCH_CAPACITY) {
+        throw std::runtime_error("ConvertFrames overran the batch!");
+    }
+}
+
+int main() {
+    //Execute test case
+    testConvertFrames();
+
+    std::cout << "All frame conversion tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,262 @@
+/**
+ * @file    mpu6050_Frame_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the raw MPU6050 frames
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "../../lib/mpu6050/frame_convert.h"
+#include "../../lib/mpu6050/mpu6050.h"
+#include "../fake_mpu6050.h"
+
+/** Number of frames the bus steps through. */
+static const std::size_t FRAME_COUNT = 16;
+
+/**
+ * @brief MPU6050 stand-in stepping through a fixed set of frames, covering the whole range of every word.
+ * The FIFO count reads back all of them.
+ */
+class FrameBus : public FakeMPU6050
+{
+public:
+  FrameBus() : FakeMPU6050(false) {
+    frames.resize(FRAME_COUNT * MPU6050_Driver::FIFO_FRAME_SIZE);
+    for (std::size_t i = 0; i < frames.size(); i++)
+      frames[i] = (uint8_t)(i * 37 + 11);
+    fifoBytes = frames.size();
+  }
+};
+
+/**
+ * @brief Implementation of the MPU6050Interface that keeps what it was sent. The frame callback can be
+ * left to the default, which converts the frame and passes it on as a sample.
+ */
+class KeepFrames : public MPU6050_Driver::MPU6050Interface
+{
+public:
+  KeepFrames(bool _takeFrames) : takeFrames(_takeFrames) {}
+
+  virtual void hasSample(MPU6050_Driver::MPU6050Sample& sample) override {
+    samples.push_back(sample);
+  }
+
+  virtual void hasFrame(const MPU6050_Driver::MPU6050Frame& frame) override {
+    if (!takeFrames)
+      return MPU6050Interface::hasFrame(frame);
+
+    frames.push_back(frame);
+  }
+
+  /** Samples received. */
+  std::vector<MPU6050_Driver::MPU6050Sample> samples;
+
+  /** Frames received. */
+  std::vector<MPU6050_Driver::MPU6050Frame> frames;
+
+private:
+  /** Whether to take frames rather than samples. */
+  bool takeFrames;
+};
+
+/**
+ * @brief Checks a sample is exactly the frame's axes.
+ * @return bool True if every axis matches.
+ */
+bool sameAxes(const MPU6050_Driver::MPU6050Frame& frame, const MPU6050_Driver::MPU6050Sample& sample) {
+    return frame.ax() == sample.ax && frame.ay() == sample.ay && frame.az() == sample.az && frame.temp() == sample.temp
+        && frame.gx() == sample.gx && frame.gy() == sample.gy && frame.gz() == sample.gz;
+}
+
+// Test case for the axes of a frame
+/**
+ * @brief Reads frames at every full scale range, and checks each axis is the raw word scaled by the range's
+ * constant, that converting the whole frame gives the same values, and that a failed range change keeps
+ * the old scale.
+ * @return None
+ */
+void testFrameAxes() {
+    std::cout << "Test function for raw frame axes is getting executed" << std::endl;
+    using namespace MPU6050_Driver;
+    FrameBus bus;
+    KeepFrames sink(true);
+    MPU6050 mpu(&bus, &sink, 0);
+
+    for (uint8_t range = 0; range < 4; range++) {
+        if (mpu.SetAccelFullScale((Accel_FS_t)range) != I2C_STATUS_SUCCESS || mpu.SetGyroFullScale((Gyro_FS_t)(3 - range)) != I2C_STATUS_SUCCESS) {
+            throw std::runtime_error("Setting the full scale failed!");
+        }
+        const float accelConst = mpu.GetAccel_MG_Constant((Accel_FS_t)range);
+        const float gyroConst = mpu.GetGyro_DPS_Constant((Gyro_FS_t)(3 - range));
+
+        for (std::size_t i = 0; i < FRAME_COUNT; i++) {
+            MPU6050Frame frame;
+            if (mpu.ReadAllRawData(frame) != I2C_STATUS_SUCCESS || frame.scale != &mpu.GetScale()) {
+                throw std::runtime_error("ReadAllRawData failed!");
+            }
+            const uint8_t* bytes = bus.frame(i);
+            const int16_t raw[7] = {(int16_t)(bytes[0] << 8 | bytes[1]), (int16_t)(bytes[2] << 8 | bytes[3]), (int16_t)(bytes[4] << 8 | bytes[5]),
+                                    (int16_t)(bytes[6] << 8 | bytes[7]), (int16_t)(bytes[8] << 8 | bytes[9]), (int16_t)(bytes[10] << 8 | bytes[11]),
+                                    (int16_t)(bytes[12] << 8 | bytes[13])};
+            if (frame.ax() != raw[0] * accelConst || frame.ay() != raw[1] * accelConst || frame.az() != raw[2] * accelConst
+                || frame.temp() != raw[3] / 340.0f + 36.53f
+                || frame.gx() != raw[4] * gyroConst || frame.gy() != raw[5] * gyroConst || frame.gz() != raw[6] * gyroConst) {
+                throw std::runtime_error("Frame axes are scaled wrongly!");
+            }
+
+            MPU6050Sample sample;
+            frame.toSample(sample);
+            if (!sameAxes(frame, sample)) {
+                throw std::runtime_error("Converted frame differs from its axes!");
+            }
+        }
+    }
+
+    // The write fails, so the sensor is still at the old range and so must the scale be.
+    const float accelScale = mpu.GetScale().perLsb[MPU6050Frame::ACCEL_X];
+    bus.failWrites = true;
+    mpu.SetAccelFullScale(Accel_FS_t::FS_2G);
+    if (mpu.GetScale().perLsb[MPU6050Frame::ACCEL_X] != accelScale) {
+        throw std::runtime_error("Scale changed on a failed write!");
+    }
+}
+
+// Test case for passing frames to the callback
+/**
+ * @brief Processes samples with a callback taking frames and one taking samples, and checks both see the
+ * same values and timestamps, and that FIFO frames, one at a time or as a batch, are converted the same way.
+ * @return None
+ */
+void testCallbacks() {
+    std::cout << "Test function for raw frame callbacks is getting executed" << std::endl;
+    using namespace MPU6050_Driver;
+    FrameBus frameBus, sampleBus;
+    KeepFrames frameSink(true), sampleSink(false);
+    MPU6050 frameMPU(&frameBus, &frameSink, 0), sampleMPU(&sampleBus, &sampleSink, 0);
+    for (MPU6050* mpu : {&frameMPU, &sampleMPU}) {
+        mpu->SetAccelFullScale(Accel_FS_t::FS_4G);
+        mpu->SetGyroFullScale(Gyro_FS_t::FS_1000_DPS);
+        for (std::size_t i = 0; i < FRAME_COUNT; i++)
+            mpu->ProcessSample(1000 * (i + 1));
+    }
+
+    if (frameSink.frames.size() != FRAME_COUNT || !frameSink.samples.empty() || sampleSink.samples.size() != FRAME_COUNT) {
+        throw std::runtime_error("Samples were sent to the wrong callback!");
+    }
+    for (std::size_t i = 0; i < FRAME_COUNT; i++) {
+        if (!sameAxes(frameSink.frames[i], sampleSink.samples[i]) || frameSink.frames[i].timestamp_ns != 1000 * (i + 1)
+                || sampleSink.samples[i].timestamp_ns != 1000 * (i + 1)) {
+            throw std::runtime_error("Frame callback and sample callback differ!");
+        }
+    }
+
+    // The FIFO streams the same frames from the start.
+    i2c_status_t error;
+    MPU6050Sample samples[FRAME_COUNT];
+    if (sampleMPU.ReadFIFOFrames(samples, FRAME_COUNT, &error) != FRAME_COUNT || error != I2C_STATUS_SUCCESS) {
+        throw std::runtime_error("ReadFIFOFrames failed!");
+    }
+    for (std::size_t i = 0; i < FRAME_COUNT; i++) {
+        if (!sameAxes(frameSink.frames[i], samples[i])) {
+            throw std::runtime_error("FIFO frame is converted differently!");
+        }
+    }
+
+    // The same again, converted all at once into one array per axis.
+    MPU6050Batch batch;
+    if (frameMPU.ReadFIFOBatch(batch, &error) != FRAME_COUNT || error != I2C_STATUS_SUCCESS || batch.count != FRAME_COUNT) {
+        throw std::runtime_error("ReadFIFOBatch failed!");
+    }
+    for (std::size_t i = 0; i < FRAME_COUNT; i++) {
+        MPU6050Sample sample;
+        sample.ax = batch.ax()[i];
+        sample.ay = batch.ay()[i];
+        sample.az = batch.az()[i];
+        sample.temp = batch.temp()[i];
+        sample.gx = batch.gx()[i];
+        sample.gy = batch.gy()[i];
+        sample.gz = batch.gz()[i];
+        if (!sameAxes(frameSink.frames[i], sample)) {
+            throw std::runtime_error("FIFO batch is converted differently!");
+        }
+    }
+}
+
+// Test case for the FIFO burst callback
+/**
+ * @brief Drains the FIFO with ProcessBatch(), which passes the converted batch to hasAxes(), and checks the
+ * default hasAxes() hands the frames on as samples, oldest first, the newest at the DATA_RDY edge given and the
+ * rest back-dated one sample period apart.
+ * @return None
+ */
+void testProcessBatch() {
+    std::cout << "Test function for FIFO burst callbacks is getting executed" << std::endl;
+    using namespace MPU6050_Driver;
+    FrameBus bus;
+    KeepFrames frameSink(true), sampleSink(false);
+    MPU6050 frameMPU(&bus, &frameSink, 0), sampleMPU(&bus, &sampleSink, 0);
+    for (std::size_t i = 0; i < FRAME_COUNT; i++)
+        frameMPU.ProcessSample(1000 * (i + 1));
+
+    const uint64_t origin_ns = 1000000000;
+    if (sampleMPU.SetAcquisitionMode(Acquisition_t::FIFO_BURST) != I2C_STATUS_SUCCESS || sampleMPU.ProcessBatch(origin_ns) != I2C_STATUS_SUCCESS) {
+        throw std::runtime_error("ProcessBatch failed!");
+    }
+    if (bus.regs[Sensor_Regs::INT_ENABLE] != Regbits_INT_ENABLE::BIT_DATA_RDY_EN) {
+        throw std::runtime_error("DATA_RDY isn't left on to time the frames!");
+    }
+    if (sampleSink.samples.size() != FRAME_COUNT || sampleSink.samples.back().timestamp_ns != origin_ns) {
+        throw std::runtime_error("FIFO burst wasn't passed on!");
+    }
+
+    const uint64_t period_ns = origin_ns - sampleSink.samples[FRAME_COUNT - 2].timestamp_ns;
+    for (std::size_t i = 0; i < FRAME_COUNT; i++) {
+        if (!sameAxes(frameSink.frames[i], sampleSink.samples[i])
+                || sampleSink.samples[i].timestamp_ns != origin_ns - (FRAME_COUNT - 1 - i) * period_ns) {
+            throw std::runtime_error("FIFO burst samples differ from the frames!");
+        }
+    }
+    if (period_ns == 0) {
+        throw std::runtime_error("FIFO burst samples weren't back-dated!");
+    }
+}
+
+// Test case for draining an overflowed FIFO
+/**
+ * @brief Drains a FIFO that has overflowed, and checks no frames are returned, the overflow is counted, and
+ * the FIFO is disabled while it is reset, then enabled again.
+ * @return None
+ */
+void testOverflow() {
+    std::cout << "Test function for draining an overflowed FIFO is getting executed" << std::endl;
+    using namespace MPU6050_Driver;
+    FrameBus bus;
+    KeepFrames sink(false);
+    MPU6050 mpu(&bus, &sink, 0);
+    bus.fifoBytes = MPU6050_Driver::FIFO_SIZE;
+
+    i2c_status_t error;
+    MPU6050Sample samples[FRAME_COUNT];
+    if (mpu.ReadFIFOFrames(samples, FRAME_COUNT, &error) != 0 || error != I2C_STATUS_SUCCESS || mpu.GetFIFOOverflowCount() != 1) {
+        throw std::runtime_error("Overflowed FIFO was drained!");
+    }
+    const std::vector<uint8_t> resync = {0, Regbits_USER_CTRL::BIT_FIFO_RESET, Regbits_USER_CTRL::BIT_FIFO_EN};
+    if (bus.userCtrlWrites != resync) {
+        throw std::runtime_error("Overflowed FIFO wasn't reset with FIFO_EN clear!");
+    }
+}
+
+int main() {
+    //Execute test case
+    testFrameAxes();
+    testCallbacks();
+    testProcessBatch();
+    testOverflow();
+
+    std::cout << "All raw frame tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file    params_Calibration_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the MPU6050 calibration file
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "../../lib/params/calibration.h"
+
+/**
+ * @brief Checks two sets of offsets are the same.
+ * @return bool True if every offset matches.
+ */
+bool sameOffsets(const MPU6050_Driver::MPU6050Offsets& a, const MPU6050_Driver::MPU6050Offsets& b) {
+    for (int axis = 0; axis < 3; axis++) {
+        if (a.accel[axis] != b.accel[axis] || a.gyro[axis] != b.gyro[axis])
+            return false;
+    }
+    return true;
+}
+
+// Test case for parsing calibration text
+/**
+ * @brief Parses calibration text holding several sensors, and checks only the named one is read, that a
+ * missing sensor isn't an error, and that a bad line for the sensor is.
+ * @return None
+ */
+void testParse() {
+    std::cout << "Test function for parsing calibrations is getting executed" << std::endl;
+    const std::string key = Params::CalibrationKey("/dev/i2c-1", 0x68, 0x1a0f1b12);
+    if (key != "/dev/i2c-1 0x68 0x1a0f1b12") {
+        throw std::runtime_error("Calibration key is wrong: " + key);
+    }
+
+    std::istringstream text("# Two rigs\n"
+                            "/dev/i2c-1 0x69 0x1a0f1b12 = 1 2 3 4 5 6\n"
+                            "\n"
+                            "/dev/i2c-1   0x68 0x1a0f1b12 = -2001 1500 900 20 -5 40  # bench rig\n");
+    MPU6050_Driver::MPU6050Offsets offsets;
+    std::string error;
+    if (!Params::ParseCalibration(text, key, offsets, error) || offsets.accel[0] != -2001 || offsets.gyro[2] != 40) {
+        throw std::runtime_error("Calibration was parsed wrongly: " + error);
+    }
+
+    std::istringstream other("/dev/i2c-1 0x69 0x1a0f1b12 = 1 2 3 4 5 6\n");
+    if (Params::ParseCalibration(other, key, offsets, error) || !error.empty() || offsets.accel[0] != -2001) {
+        throw std::runtime_error("Another sensor's calibration was used!");
+    }
+
+    const char* bad[] = {"/dev/i2c-1 0x68 0x1a0f1b12 = 1 2 3 4 5\n", "/dev/i2c-1 0x68 0x1a0f1b12 = 1 2 3 4 5 40000\n",
+                         "/dev/i2c-1 0x68 0x1a0f1b12 = 1 2 3 4 5 6 7\n", "/dev/i2c-1 0x68 0x1a0f1b12 1 2 3 4 5 6\n"};
+    for (const char* line : bad) {
+        std::istringstream in(line);
+        error.clear();
+        if (Params::ParseCalibration(in, key, offsets, error) || error.empty() || offsets.accel[0] != -2001) {
+            throw std::runtime_error(std::string("Bad calibration was accepted: ") + line);
+        }
+    }
+}
+
+// Test case for saving and loading a calibration file
+/**
+ * @brief Saves two sensors to a calibration file, then saves one again, and checks each loads its own
+ * offsets, the other sensor and the comments are kept, and a missing file loads nothing.
+ * @return None
+ */
+void testSaveLoad(const std::string& path) {
+    std::cout << "Test function for saving and loading calibrations is getting executed" << std::endl;
+    std::remove(path.c_str());
+    const std::string first = Params::CalibrationKey("/dev/i2c-1", 0x68, 1), second = Params::CalibrationKey("/dev/i2c-1", 0x69, 2);
+    MPU6050_Driver::MPU6050Offsets offsets, loaded;
+    if (Params::LoadCalibration(path, first, loaded)) {
+        throw std::runtime_error("Calibration was loaded from a missing file!");
+    }
+
+    offsets.accel[0] = -2001;
+    offsets.gyro[1] = 7;
+    MPU6050_Driver::MPU6050Offsets otherOffsets;
+    otherOffsets.accel[2] = 300;
+    if (!Params::SaveCalibration(path, first, offsets) || !Params::SaveCalibration(path, second, otherOffsets)) {
+        throw std::runtime_error("Calibration wasn't saved!");
+    }
+
+    offsets.gyro[1] = -8;
+    if (!Params::SaveCalibration(path, first, offsets)) {
+        throw std::runtime_error("Calibration wasn't saved again!");
+    }
+    if (!Params::LoadCalibration(path, first, loaded) || !sameOffsets(loaded, offsets)
+            || !Params::LoadCalibration(path, second, loaded) || !sameOffsets(loaded, otherOffsets)) {
+        throw std::runtime_error("Calibration loaded differs from that saved!");
+    }
+
+    int lines = 0, comments = 0;
+    std::ifstream file(path);
+    for (std::string line; std::getline(file, line); lines++)
+        comments += line.rfind("#", 0) == 0;
+    std::remove(path.c_str());
+    if (lines != 3 || comments != 1) {
+        throw std::runtime_error("Calibration file has " + std::to_string(lines) + " lines!");
+    }
+}
+
+int main() {
+    //Execute test case
+    testParse();
+    testSaveLoad("params_Calibration_ut.conf");
+
+    std::cout << "All calibration file tests passed!" << std::endl;
+    return 0;
+}
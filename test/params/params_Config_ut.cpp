@@ -0,0 +1,152 @@
+/**
+ * @file    params_Config_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the config loader
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "../../lib/params/config.h"
+
+// Test case for the derived sample periods
+/**
+ * @brief Checks the sample periods worked out from the defaults match those ShakeyTable used, and that the
+ * MPU period follows the gyro output rate the DLPF sets.
+ * @return None
+ */
+void testSamplePeriods() {
+    std::cout << "Test function for derived sample periods is getting executed" << std::endl;
+    Params::Config config;
+
+    if (std::fabs(config.MPUSamplePeriod() - 0.01f) > 1e-9 || std::fabs(config.INASamplePeriod() - 4156e-6f) > 1e-9) {
+        throw std::runtime_error("Default sample periods are wrong!");
+    }
+
+    config.mpuDLPF = MPU6050_Driver::DLPF_t::BW_260Hz;
+    config.mpuSampleRateDiv = 7;
+    config.inaCurrConvTime = INA260_Driver::Conv_Time::TU8224;
+    if (std::fabs(config.MPUSamplePeriod() - 0.001f) > 1e-9 || std::fabs(config.INASamplePeriod() - 8224e-6f) > 1e-9) {
+        throw std::runtime_error("Sample periods don't follow the settings!");
+    }
+}
+
+// Test case for parsing config text
+/**
+ * @brief Parses a config for a different rig, and checks the settings given are changed, the rest are kept,
+ * and that bad text is reported without changing anything.
+ * @return None
+ */
+void testParse() {
+    std::cout << "Test function for parsing config is getting executed" << std::endl;
+    Params::Config config;
+    std::string error;
+
+    std::istringstream rig("# Second rig\n"
+                           "mpu_i2c_file = /dev/i2c-3\n"
+                           "mpu_address = 0x69   # AD0 high\n"
+                           "mpu_dlpf = 44\n"
+                           "mpu_sample_rate_div = 4\n"
+                           "mpu_acquisition = fifo_burst\n"
+                           "mpu_batch_frames = 16\n"
+                           "mpu_filter = mahony\n"
+                           "mpu_rest_accel = 0 0 -1\n"
+                           "mpu_calibration = none\n"
+                           "ina_curr_conv_time = 1100\n"
+                           "md_period = 40000\n"
+                           "md_direct_registers = true\n"
+                           "outer = 0.3 0.01 0.002\n"
+                           "outer_setpoint = -0.05\n"
+                           "control_cpu = -1\n"
+                           "lock_memory = false\n");
+    if (!Params::ParseConfig(rig, config, error)) {
+        throw std::runtime_error("Config was not parsed: " + error);
+    }
+    if (config.mpuI2cFile != "/dev/i2c-3" || config.mpuAddress != 0x69 || config.mpuDLPF != MPU6050_Driver::DLPF_t::BW_44Hz
+        || config.mpuAcquisition != MPU6050_Driver::Acquisition_t::FIFO_BURST || config.mpuBatchFrames != 16
+        || config.mpuFilter != Attitude::Filter_t::MAHONY || config.mpuRestAccel[2] != -1 || !config.mpuCalibration.empty()
+        || config.mdPeriod_ns != 40000 || !config.mdDirectRegisters
+        || config.outer.Ki != 0.002 || config.outerSetpoint != -0.05 || config.controlThread.cpu != -1
+        || config.mpuThread.lockMemory || config.inaThread.lockMemory) {
+        throw std::runtime_error("Config settings were parsed wrongly!");
+    }
+    if (config.inaI2cFile != "/dev/i2c-0" || config.mdDirPin != 23 || config.inner.Kp != 0.01 || config.mpuThread.priority != 80) {
+        throw std::runtime_error("Config settings not given were changed!");
+    }
+    if (std::fabs(config.MPUSamplePeriod() - 0.005f) > 1e-9 || std::fabs(config.INASamplePeriod() - 1100e-6f) > 1e-9) {
+        throw std::runtime_error("Parsed sample periods are wrong!");
+    }
+
+    const char* bad[] = {"mpu_dlpf = 100\n", "mpu_sample_rate_div = 256\n", "mpu_address = 0x80\n", "md_period = 0\n",
+                         "inner = 1 2\n", "mpu_filter = kalman please\n", "md_direct_registers = yes\n",
+                         "mpu_cpu = -2\n", "mpu_rest_accel = 0 1\n", "radius = nan\n", "mpu_i2c_file =\n", "gyro_scale = 250\n", "mpu_dlpf 94\n",
+                         "mpu_dlpf = 94\nmpu_priority = 100\n", "mpu_acquisition = dma\n", "mpu_batch_frames = 0\n",
+                         "mpu_batch_frames = 100\n"};
+    for (const char* text : bad) {
+        Params::Config before = config;
+        std::istringstream in(text);
+        error.clear();
+        if (Params::ParseConfig(in, config, error) || error.empty()) {
+            throw std::runtime_error(std::string("Bad config was accepted: ") + text);
+        }
+        if (config.mpuDLPF != before.mpuDLPF || config.mpuThread.priority != before.mpuThread.priority) {
+            throw std::runtime_error("Bad config changed the settings!");
+        }
+    }
+}
+
+// Test case for loading a config file
+/**
+ * @brief Loads a config file, and checks a missing or bad file is thrown.
+ * @return None
+ */
+void testLoad(const std::string& path) {
+    std::cout << "Test function for loading a config file is getting executed" << std::endl;
+    Params::Config config;
+
+    std::ofstream(path) << "radius = 0.2\n";
+    Params::LoadConfig(path, config);
+    if (config.radius != 0.2f) {
+        throw std::runtime_error("Config file was not loaded!");
+    }
+
+    bool thrown = false;
+    std::ofstream(path) << "radius = far\n";
+    try {
+        Params::LoadConfig(path, config);
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    std::remove(path.c_str());
+    if (!thrown || config.radius != 0.2f) {
+        throw std::runtime_error("Bad config file was not thrown!");
+    }
+
+    thrown = false;
+    try {
+        Params::LoadConfig(path, config);
+    }
+    catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    if (!thrown) {
+        throw std::runtime_error("Missing config file was not thrown!");
+    }
+}
+
+int main() {
+    //Execute test case
+    testSamplePeriods();
+    testParse();
+    testLoad("params_Config_ut.conf");
+
+    std::cout << "All config tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file    params_Tuning_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of live tuning
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include "../../lib/params/snapshot_store.h"
+#include "../../lib/params/tuning.h"
+
+/**
+ * @brief Snapshot whose fields must always agree, so a torn read can be spotted.
+ */
+struct Snapshot {
+    uint64_t version;
+    double values[15];
+};
+
+// Test case for the snapshot store
+/**
+ * @brief Publishes snapshots from one thread while another refreshes as fast as it can, and checks the
+ * reader only ever sees whole snapshots, in order, and ends on the last one.
+ * @return None
+ */
+void testSnapshotStore() {
+    std::cout << "Test function for the snapshot store is getting executed" << std::endl;
+    Snapshot initial = {0, {}};
+    Params::SnapshotStore<Snapshot> store(initial);
+    const uint64_t snapshots = 200000;
+    std::atomic<bool> done{false};
+
+    std::thread writer([&]() {
+        for (uint64_t version = 1; version <= snapshots; version++) {
+            Snapshot snapshot;
+            snapshot.version = version;
+            for (double& value : snapshot.values)
+                value = (double)version;
+            store.publish(snapshot);
+        }
+        done = true;
+    });
+
+    uint64_t lastVersion = 0, refreshes = 0;
+    while (true) {
+        bool finished = done;
+        if (store.refresh()) {
+            const Snapshot& snapshot = store.current();
+            for (double value : snapshot.values) {
+                if (value != (double)snapshot.version) {
+                    throw std::runtime_error("Reader saw a torn snapshot!");
+                }
+            }
+            if (snapshot.version <= lastVersion) {
+                throw std::runtime_error("Reader went back to an older snapshot!");
+            }
+            lastVersion = snapshot.version;
+            refreshes++;
+        }
+        else if (finished)
+            break;
+    }
+    writer.join();
+
+    if (lastVersion != snapshots || store.published() != snapshots || store.latest().version != snapshots) {
+        throw std::runtime_error("Reader didn't end on the last snapshot!");
+    }
+    std::cout << "Reader picked up " << refreshes << " of " << snapshots << " snapshots." << std::endl;
+}
+
+/**
+ * @brief Tuning to start each parse from.
+ * @return Params::Tuning Starting tuning
+ */
+Params::Tuning startingTuning() {
+    return {{1, 2, 3}, GainSchedule(0, 0.5, {{4, 5, 6}}, true), 0};
+}
+
+// Test case for parsing tuning text
+/**
+ * @brief Parses partial and complete tuning text, and checks settings not given are kept, and that bad
+ * text is reported without changing anything.
+ * @return None
+ */
+void testParse() {
+    std::cout << "Test function for parsing tuning is getting executed" << std::endl;
+    Params::Tuning tuning = startingTuning();
+    std::string error;
+
+    std::istringstream partial("# Just trim the angle\n  outer_setpoint = -0.07  # rad\n\n");
+    if (!Params::ParseTuning(partial, tuning, error) || tuning.outerSetpoint != -0.07 || tuning.inner.Kp != 1
+        || tuning.outer.size() != 1 || tuning.outer.points()[0].Ki != 6 || !tuning.outer.magnitude()) {
+        throw std::runtime_error("Partial tuning didn't keep the other settings!");
+    }
+
+    std::istringstream full("inner = 0.1 0 0.01\nouter_schedule = -1 1\nouter = 10 1 0\nouter = 20 2 0\nouter = 30 3 0\n");
+    if (!Params::ParseTuning(full, tuning, error) || tuning.inner.Ki != 0.01 || tuning.outer.size() != 3
+        || tuning.outer.magnitude() || tuning.outer.lookup(0).Kp != 20 || tuning.outer.lookup(0.5).Kd != 2.5) {
+        throw std::runtime_error("Full tuning was parsed wrongly!");
+    }
+
+    const char* bad[] = {"inner = 1 2\n", "inner = 1 2 3 4\n", "outer_setpoint = up\n", "kp = 1\n",
+                         "outer_schedule = 1 0\n", "inner 1 2 3\n", "outer_schedule = 0 1 both\n"};
+    for (const char* text : bad) {
+        Params::Tuning before = tuning;
+        std::istringstream in(text);
+        error.clear();
+        if (Params::ParseTuning(in, tuning, error) || error.empty()) {
+            throw std::runtime_error(std::string("Bad tuning was accepted: ") + text);
+        }
+        if (tuning.inner.Kp != before.inner.Kp || tuning.outer.size() != before.outer.size()) {
+            throw std::runtime_error("Bad tuning changed the settings!");
+        }
+    }
+}
+
+// Test case for the tuning file
+/**
+ * @brief Writes a tuning file, and checks the watcher publishes it, then publishes it again when it changes,
+ * and that a bad file is counted and not published.
+ * @return None
+ */
+void testTuningFile(const std::string& path) {
+    std::cout << "Test function for the tuning file is getting executed" << std::endl;
+    Params::SnapshotStore<Params::Tuning> store(startingTuning());
+    Params::TuningFile watcher(path, store, std::chrono::milliseconds(10));
+
+    auto waitFor = [](auto condition) {
+        for (int i = 0; i < 500; i++) {
+            if (condition())
+                return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    };
+
+    std::ofstream(path) << "inner = 7 0 0\n";
+    watcher.begin();
+    if (!waitFor([&]() { return store.refresh() && store.current().inner.Kp == 7; })) {
+        throw std::runtime_error("Tuning file was not published!");
+    }
+
+    // Make sure the new file gets a different modification time.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::ofstream(path) << "inner = oops\n";
+    if (!waitFor([&]() { return watcher.GetErrorCount() == 1; }) || store.refresh()) {
+        throw std::runtime_error("Bad tuning file was not reported!");
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::ofstream(path) << "outer_setpoint = 0.1\n";
+    if (!waitFor([&]() { return store.refresh() && store.current().outerSetpoint == 0.1; })) {
+        throw std::runtime_error("Changed tuning file was not published!");
+    }
+    watcher.end();
+
+    if (store.current().inner.Kp != 7 || watcher.GetReloadCount() != 2) {
+        throw std::runtime_error("Tuning file reloads are wrong!");
+    }
+}
+
+int main() {
+    std::string path = "params_Tuning_ut.conf";
+
+    //Execute test case
+    testSnapshotStore();
+    testParse();
+    testTuningFile(path);
+    std::remove(path.c_str());
+
+    std::cout << "All tuning tests passed!" << std::endl;
+    return 0;
+}
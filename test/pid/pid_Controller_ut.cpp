@@ -0,0 +1,429 @@
+/**
+ * @file    pid_Controller_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the PID controller template
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include "fixed_point.h"
+#include "gain_schedule.h"
+#include "pid.h"
+
+/**
+ * @brief Sink recording the last output, called without a virtual call.
+ */
+template <typename Scalar>
+class LastOutput final
+{
+    public:
+    void hasOutput(Scalar pidOutput) { output = pidOutput; count++; }
+
+    Scalar output{};
+    int count = 0;
+};
+
+/**
+ * @brief Reference PID callback recording the last output, through the virtual interface.
+ */
+class LastOutputInterface : public PID_Interface
+{
+    public:
+    virtual void hasOutput(double pidOutput) override { output = pidOutput; }
+
+    double output = 0;
+};
+
+/**
+ * @brief Copy of the original PID::calculate algorithm, before the controller became a template, with
+ * the gains folded with the sample period on every call. Used as the reference the template is checked against.
+ */
+class BaselinePID
+{
+    public:
+    BaselinePID(double setpoint, double dt, double max, double min, double Kp, double Kd, double Ki)
+        : _setpoint(setpoint), _dt(dt), _max(max), _min(min), _Kp(Kp), _Kd(Kd), _Ki(Ki) {}
+
+    double calculate(double pv) {
+        // Calculate error
+        double error = _setpoint - pv;
+
+        // Proportional term
+        double Pout = _Kp * error;
+
+        // Integral term
+        _integral += (_Ki * _dt) * error;
+        double Iout = _integral;
+
+        // Derivative term
+        double Dout = (_Kd / _dt) * (error - _pre_error);
+
+        // Calculate total output
+        double output = Pout + Iout + Dout;
+
+        // Restrict to max/min
+        if( output > _max )
+            output = _max;
+        else if( output < _min )
+            output = _min;
+
+        // Save error to previous error
+        _pre_error = error;
+        return output;
+    }
+
+    private:
+    double _setpoint, _dt, _max, _min, _Kp, _Kd, _Ki;
+    double _pre_error = 0;
+    double _integral = 0;
+};
+
+/**
+ * @brief Process variable of the test sequence at a given step: a decaying oscillation about the setpoint.
+ * @param step Sample number
+ * @return double Process variable
+ */
+double processVariable(int step) {
+    return 1.0 - std::exp(-0.01 * step) * std::cos(0.1 * step);
+}
+
+// Test case for the scalar types
+/**
+ * @brief Runs the same controller as double, float and Q16.16 over the test sequence, and checks
+ * they follow the original double precision algorithm, to within the precision of the type. The PID
+ * class must match it exactly.
+ * @return None
+ */
+void testScalarTypes() {
+    std::cout << "Test function for PID scalar types is getting executed" << std::endl;
+    const double setpoint = 1, dt = 0.01, max = 10, min = -10, Kp = 2, Kd = 0.05, Ki = 0.5;
+
+    BaselinePID baseline(setpoint, dt, max, min, Kp, Kd, Ki);
+    LastOutputInterface classSink;
+    PID classPID(&classSink, setpoint, dt, max, min, Kp, Kd, Ki);
+    LastOutput<double> doubleSink;
+    PIDController<double, PID_ALL, LastOutput<double>> doublePID(&doubleSink, setpoint, dt, max, min, Kp, Kd, Ki);
+    LastOutput<float> floatSink;
+    PIDController<float, PID_ALL, LastOutput<float>> floatPID(&floatSink, setpoint, dt, max, min, Kp, Kd, Ki);
+    LastOutput<Q16_16> fixedSink;
+    PIDController<Q16_16, PID_ALL, LastOutput<Q16_16>> fixedPID(&fixedSink, setpoint, dt, max, min, Kp, Kd, Ki);
+
+    double floatError = 0, fixedError = 0;
+    for (int step = 0; step < 1000; step++) {
+        double pv = processVariable(step);
+        double reference = baseline.calculate(pv);
+        classPID.calculate(pv);
+        doublePID.calculate(pv);
+        floatPID.calculate((float)pv);
+        fixedPID.calculate(Q16_16(pv));
+
+        if (classSink.output != reference || doubleSink.output != reference) {
+            throw std::runtime_error("Double PID doesn't match the original PID algorithm!");
+        }
+        floatError = std::max(floatError, std::abs(floatSink.output - reference));
+        fixedError = std::max(fixedError, std::abs((double)fixedSink.output - reference));
+    }
+
+    std::cout << "Largest float error: " << floatError << ", largest Q16.16 error: " << fixedError << std::endl;
+    if (floatError > 1e-4 || fixedError > 5e-3) {
+        throw std::runtime_error("Reduced precision PID drifted from double precision!");
+    }
+}
+
+// Test case for compiling out terms
+/**
+ * @brief Checks a PI controller without a limit gives the same outputs as a full controller with no
+ * derivative gain and a limit that is never reached.
+ * @return None
+ */
+void testTerms() {
+    std::cout << "Test function for PID terms is getting executed" << std::endl;
+    LastOutput<double> fullSink, piSink;
+    PIDController<double, PID_ALL, LastOutput<double>> fullPID(&fullSink, 1, 0.01, 1e9, -1e9, 2, 0, 0.5);
+    PIDController<double, PID_P | PID_I, LastOutput<double>> piPID(&piSink, 1, 0.01, 0, 0, 2, 123, 0.5);
+
+    for (int step = 0; step < 100; step++) {
+        fullPID.calculate(processVariable(step));
+        piPID.calculate(processVariable(step));
+        if (fullSink.output != piSink.output) {
+            throw std::runtime_error("PI controller doesn't match PID controller with no derivative!");
+        }
+    }
+
+    // Limit is applied only when enabled.
+    LastOutput<double> limitSink;
+    PIDController<double, PID_P | PID_LIMIT, LastOutput<double>> limitPID(&limitSink, 0, 0.01, 1, -1, 10, 0, 0);
+    limitPID.calculate(-5);
+    piPID.setSetpoint(1000);
+    piPID.calculate(0);
+    if (limitSink.output != 1 || piSink.output < 1000) {
+        throw std::runtime_error("Output limit is wrong!");
+    }
+}
+
+// Test case for anti-windup
+/**
+ * @brief Holds a PI controller saturated, then steps the process variable past the setpoint, and checks
+ * the output comes straight off the limit with either anti-windup mode but stays there without.
+ * @return None
+ */
+void testAntiWindup() {
+    std::cout << "Test function for PID anti-windup is getting executed" << std::endl;
+    const PID_AntiWindup modes[] = {PID_AntiWindup::NONE, PID_AntiWindup::CONDITIONAL, PID_AntiWindup::BACK_CALCULATION};
+    for (PID_AntiWindup mode : modes) {
+        LastOutput<double> sink;
+        PIDController<double, PID_ALL, LastOutput<double>> pid(&sink, 1, 0.01, 1, -1, 1, 0, 10);
+        pid.setAntiWindup(mode);
+
+        for (int step = 0; step < 200; step++)
+            pid.calculate(0);
+        pid.calculate(2);
+
+        bool wound = sink.output == 1;
+        if (wound != (mode == PID_AntiWindup::NONE)) {
+            throw std::runtime_error("Anti-windup mode didn't stop the integral winding up!");
+        }
+    }
+
+    // Back-calculation with a long tracking time unwinds gradually.
+    LastOutput<double> sink;
+    PIDController<double, PID_ALL, LastOutput<double>> pid(&sink, 1, 0.01, 1, -1, 1, 0, 10);
+    pid.setAntiWindup(PID_AntiWindup::BACK_CALCULATION, 0.1);
+    for (int step = 0; step < 200; step++)
+        pid.calculate(0);
+    pid.calculate(1);
+    if (sink.output <= 0.5 || sink.output >= 1) {
+        throw std::runtime_error("Back-calculation tracking time is wrong!");
+    }
+}
+
+// Test case for the derivative modes
+/**
+ * @brief Checks derivative on measurement doesn't kick on a setpoint step, and that the derivative
+ * filter attenuates noise at the sample rate.
+ * @return None
+ */
+void testDerivativeModes() {
+    std::cout << "Test function for PID derivative modes is getting executed" << std::endl;
+    LastOutput<double> errorSink, measurementSink;
+    PIDController<double, PID_D, LastOutput<double>> errorPID(&errorSink, 0, 0.01, 0, 0, 0, 1, 0);
+    PIDController<double, PID_D, LastOutput<double>> measurementPID(&measurementSink, 0, 0.01, 0, 0, 0, 1, 0);
+    measurementPID.setDerivativeOnMeasurement(true);
+
+    errorPID.calculate(0.5);
+    measurementPID.calculate(0.5);
+    errorPID.setSetpoint(1);
+    measurementPID.setSetpoint(1);
+    errorPID.calculate(0.5);
+    measurementPID.calculate(0.5);
+    if (errorSink.output != 100 || measurementSink.output != 0) {
+        throw std::runtime_error("Derivative on measurement kicked on a setpoint step!");
+    }
+
+    LastOutput<double> rawSink, filteredSink;
+    PIDController<double, PID_D, LastOutput<double>> rawPID(&rawSink, 0, 0.01, 0, 0, 0, 1, 0);
+    PIDController<double, PID_D, LastOutput<double>> filteredPID(&filteredSink, 0, 0.01, 0, 0, 0, 1, 0);
+    filteredPID.setDerivativeFilter(1);
+    double rawPeak = 0, filteredPeak = 0;
+    for (int step = 0; step < 500; step++) {
+        double noise = (step & 1) ? 0.01 : -0.01;
+        rawPID.calculate(noise);
+        filteredPID.calculate(noise);
+        if (step > 400) {
+            rawPeak = std::max(rawPeak, std::abs(rawSink.output));
+            filteredPeak = std::max(filteredPeak, std::abs(filteredSink.output));
+        }
+    }
+    if (filteredPeak > rawPeak / 10) {
+        throw std::runtime_error("Derivative filter didn't attenuate noise!");
+    }
+}
+
+// Test case for batch evaluation
+/**
+ * @brief Runs a batch through calculateBatch() and the same samples one at a time through calculate(),
+ * with every mode enabled, and checks the outputs and state match and that the sink is called once.
+ * @return None
+ */
+void testBatch() {
+    std::cout << "Test function for PID batch evaluation is getting executed" << std::endl;
+    LastOutput<double> singleSink, batchSink;
+    PIDController<double, PID_ALL, LastOutput<double>> singlePID(&singleSink, 1, 0.01, 0.8, -0.8, 2, 0.05, 5);
+    PIDController<double, PID_ALL, LastOutput<double>> batchPID(&batchSink, 1, 0.01, 0.8, -0.8, 2, 0.05, 5);
+    for (auto* pid : {&singlePID, &batchPID}) {
+        pid->setAntiWindup(PID_AntiWindup::BACK_CALCULATION, 0.05);
+        pid->setDerivativeOnMeasurement(true);
+        pid->setDerivativeFilter(20);
+    }
+
+    double pv[37], out[37];
+    for (int batch = 0; batch < 20; batch++) {
+        for (int i = 0; i < 37; i++)
+            pv[i] = processVariable(batch * 37 + i);
+
+        batchPID.calculateBatch(pv, out, 37);
+        for (int i = 0; i < 37; i++) {
+            singlePID.calculate(pv[i]);
+            if (singleSink.output != out[i]) {
+                throw std::runtime_error("Batch output doesn't match single sample output!");
+            }
+        }
+    }
+
+    if (batchSink.count != 20 || batchSink.output != singleSink.output) {
+        throw std::runtime_error("Batch sink wasn't passed the last output once per batch!");
+    }
+
+    batchPID.calculateBatch(pv, out, 0);
+    if (batchSink.count != 20) {
+        throw std::runtime_error("Empty batch called the sink!");
+    }
+}
+
+// Test case for gain scheduling
+/**
+ * @brief Checks the schedule interpolates between points, holds the end gains outside the table, looks up
+ * the magnitude when asked, that changing gains while running doesn't bump the integral, and that a folded
+ * schedule sets the same gains.
+ * @return None
+ */
+void testGainSchedule() {
+    std::cout << "Test function for PID gain scheduling is getting executed" << std::endl;
+    GainSchedule schedule(0, 0.5, {{1, 0.1, 0}, {2, 0.1, 1}, {4, 0.3, 1}}, true);
+
+    PID_Gains gains = schedule.lookup(-0.125);
+    if (std::abs(gains.Kp - 1.5) > 1e-12 || std::abs(gains.Kd - 0.1) > 1e-12 || std::abs(gains.Ki - 0.5) > 1e-12) {
+        throw std::runtime_error("Gain schedule didn't interpolate!");
+    }
+    gains = schedule.lookup(0.4);
+    if (std::abs(gains.Kp - 3.2) > 1e-12 || std::abs(gains.Kd - 0.22) > 1e-12) {
+        throw std::runtime_error("Gain schedule didn't interpolate in the second region!");
+    }
+    if (schedule.lookup(9).Kp != 4 || schedule.lookup(0).Kp != 1) {
+        throw std::runtime_error("Gain schedule ends are wrong!");
+    }
+
+    GainSchedule oneSided(-1, 1, {{0, 0, 0}, {2, 0, 0}});
+    if (oneSided.lookup(-5).Kp != 0 || oneSided.lookup(0).Kp != 1) {
+        throw std::runtime_error("Gain schedule without magnitude is wrong!");
+    }
+
+    try {
+        GainSchedule empty(0, 1, {});
+        throw std::runtime_error("Empty gain schedule was not reported!");
+    }
+    catch (const std::invalid_argument&) {
+    }
+
+    // The integral built up before a change of Ki stays, and only the new Ki applies after.
+    LastOutput<double> sink;
+    PIDController<double, PID_ALL, LastOutput<double>> pid(&sink, 1, 0.1, 100, -100, 0, 0, 1);
+    for (int step = 0; step < 10; step++)
+        pid.calculate(0);
+    pid.setGains({0, 0, 5});
+    pid.calculate(1);
+    if (std::abs(sink.output - 1) > 1e-12) {
+        throw std::runtime_error("Changing Ki bumped the output!");
+    }
+    schedule.apply(pid, 0.5);
+    pid.calculate(0);
+    if (std::abs(sink.output - (4 + 1 + 0.1 + 3)) > 1e-12) {
+        throw std::runtime_error("Scheduled gains were not applied!");
+    }
+
+    // Folding the sample period into the schedule gives the same outputs as setting the gains on every sample.
+    FoldedGainSchedule folded(schedule, 0.01);
+    LastOutput<double> setSink, foldedSink;
+    PIDController<double, PID_ALL, LastOutput<double>> setPID(&setSink, 1, 0.01, 100, -100, 0, 0, 0);
+    PIDController<double, PID_ALL, LastOutput<double>> foldedPID(&foldedSink, 1, 0.01, 100, -100, 0, 0, 0);
+    for (int step = 0; step < 500; step++) {
+        double pv = processVariable(step);
+        schedule.apply(setPID, pv - 1);
+        folded.apply(foldedPID, pv - 1);
+        setPID.calculate(pv);
+        foldedPID.calculate(pv);
+        if (std::abs(setSink.output - foldedSink.output) > 1e-9) {
+            throw std::runtime_error("Folded gain schedule doesn't match the gain schedule!");
+        }
+    }
+}
+
+// Test case for the fixed point type
+/**
+ * @brief Checks Q16.16 conversion rounding and that arithmetic saturates instead of wrapping.
+ * @return None
+ */
+void testFixedPoint() {
+    std::cout << "Test function for Q16.16 fixed point is getting executed" << std::endl;
+    if (Q16_16(1.5).raw() != 0x18000 || Q16_16(-0.25).raw() != -0x4000 || (double)Q16_16(3.0) * 2 != 6.0) {
+        throw std::runtime_error("Q16.16 conversion is wrong!");
+    }
+    if (Q16_16(1e9) != Q16_16::max() || Q16_16(-1e9) != Q16_16::lowest()) {
+        throw std::runtime_error("Q16.16 conversion doesn't saturate!");
+    }
+    if (Q16_16(30000.0) + Q16_16(30000.0) != Q16_16::max() || Q16_16(-300.0) * Q16_16(300.0) != Q16_16::lowest()) {
+        throw std::runtime_error("Q16.16 arithmetic doesn't saturate!");
+    }
+    if ((double)(Q16_16(1.5) * Q16_16(-2.25)) != -3.375 || (double)(Q16_16(1.0) / Q16_16(4.0)) != 0.25) {
+        throw std::runtime_error("Q16.16 arithmetic is wrong!");
+    }
+}
+
+// Benchmark of the controller types
+/**
+ * @brief Times the PID class against a static sink template for information.
+ * @return None
+ */
+void benchmark() {
+    const int samples = 1000000;
+    static double signal[1024];
+    static float floatSignal[1024];
+    for (int i = 0; i < 1024; i++) {
+        signal[i] = processVariable(i);
+        floatSignal[i] = (float)signal[i];
+    }
+
+    LastOutputInterface reference;
+    PID referencePID(&reference, 1, 0.01, 10, -10, 2, 0.05, 0.5);
+    LastOutput<float> floatSink;
+    PIDController<float, PID_ALL, LastOutput<float>> floatPID(&floatSink, 1, 0.01, 10, -10, 2, 0.05, 0.5);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < samples; i++)
+        referencePID.calculate(signal[i & 1023]);
+    auto middle = std::chrono::steady_clock::now();
+    for (int i = 0; i < samples; i++)
+        floatPID.calculate(floatSignal[i & 1023]);
+    auto end = std::chrono::steady_clock::now();
+    static double out[1024];
+    for (int i = 0; i < samples; i += 1024)
+        referencePID.calculateBatch(signal, out, 1024);
+    auto batchEnd = std::chrono::steady_clock::now();
+
+    std::cout << "PID class: " << std::chrono::duration_cast<std::chrono::nanoseconds>(middle - start).count() / samples
+              << " ns per sample, float template: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(end - middle).count() / samples
+              << " ns per sample, PID class batches: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(batchEnd - end).count() / samples
+              << " ns per sample" << std::endl;
+}
+
+int main() {
+    //Execute test case
+    testScalarTypes();
+    testTerms();
+    testAntiWindup();
+    testDerivativeModes();
+    testBatch();
+    testGainSchedule();
+    testFixedPoint();
+    benchmark();
+
+    std::cout << "All PID controller tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,280 @@
+/**
+ * @file    pipeline_Topology_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the control pipelines
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "../../lib/cascade/cascade.h"
+#include "../../lib/cascade/executor.h"
+#include "../../lib/cascade/tuner.h"
+#include "../../lib/mpu6050/frame_convert.h"
+#include "../../lib/pipeline/pipeline.h"
+
+/**
+ * @brief Motor driver stand-in, recording each duty cycle change.
+ */
+class FakeMotor final : public DutyCycle_Interface {
+public:
+    virtual void setDutyCycle(double DutyCycle) override {}
+    virtual void setDutyCycleDelta(double DCdelta) override { deltas.push_back(DCdelta); }
+
+    /** Duty cycle changes, in order. */
+    std::vector<double> deltas;
+};
+
+// Every edge of a pipeline must be a direct call.
+static_assert(std::is_final<Pipeline::Cascade<FakeMotor>::Motor>::value, "Motor node must be final");
+static_assert(std::is_final<Pipeline::Cascade<FakeMotor>::Setpoint>::value, "Setpoint node must be final");
+static_assert(std::is_same<Pipeline::Cascade<FakeMotor>::PositionPID,
+              PIDController<double, PID_ALL, Pipeline::DriveSetpoint<Pipeline::Cascade<FakeMotor>::CurrentPID>>>::value,
+              "Position controller must call the setpoint node directly");
+
+/**
+ * @brief Settings for the tests, with gains that make every term do something.
+ * @return Params::Config Settings
+ */
+Params::Config testConfig() {
+    Params::Config config;
+    config.inner = {0.5, 0.01, 0.2};
+    config.outer = {3, 0.1, 0.5};
+    config.outerSetpoint = 0.02;
+    config.outerLimit = 4;
+    return config;
+}
+
+/**
+ * @brief Pitching MPU sample, as if the table swings slowly either side of upright.
+ * @param i Sample number
+ * @param period Sample period (s)
+ * @return MPU6050_Driver::MPU6050Sample Sample
+ */
+MPU6050_Driver::MPU6050Sample mpuSample(int i, float period) {
+    MPU6050_Driver::MPU6050Sample sample;
+    double angle = 0.1 * std::sin(i * period * 3);
+    sample.ax = std::sin(angle);
+    sample.ay = std::cos(angle);
+    sample.gz = 0.3 * 180 / M_PI * std::cos(i * period * 3);
+    sample.timestamp_ns = (uint64_t)(i * period * 1e9);
+    return sample;
+}
+
+/**
+ * @brief Copies samples into a batch, as ConvertFrames() would leave a FIFO burst.
+ * @param samples Samples, oldest first
+ * @param count Number of samples
+ * @param batch Batch to write to
+ * @return None
+ */
+void toBatch(const MPU6050_Driver::MPU6050Sample* samples, std::size_t count, MPU6050_Driver::MPU6050Batch& batch) {
+    using MPU6050_Driver::MPU6050Frame;
+    for (std::size_t i = 0; i < count; i++) {
+        batch.words[MPU6050Frame::ACCEL_X][i] = samples[i].ax;
+        batch.words[MPU6050Frame::ACCEL_Y][i] = samples[i].ay;
+        batch.words[MPU6050Frame::ACCEL_Z][i] = samples[i].az;
+        batch.words[MPU6050Frame::TEMP][i] = samples[i].temp;
+        batch.words[MPU6050Frame::GYRO_X][i] = samples[i].gx;
+        batch.words[MPU6050Frame::GYRO_Y][i] = samples[i].gy;
+        batch.words[MPU6050Frame::GYRO_Z][i] = samples[i].gz;
+        batch.timestamp_ns[i] = samples[i].timestamp_ns;
+    }
+    batch.count = count;
+}
+
+/**
+ * @brief Checks two runs drove the motor identically.
+ * @param expected Deltas of the reference run
+ * @param actual Deltas of the run under test
+ * @param what Description for the error
+ * @return None
+ */
+void expectSame(const std::vector<double>& expected, const std::vector<double>& actual, const char* what) {
+    if (expected.empty() || expected.size() != actual.size()) {
+        throw std::runtime_error(std::string(what) + ": wrong number of motor driver writes!");
+    }
+    for (std::size_t i = 0; i < expected.size(); i++) {
+        if (expected[i] != actual[i]) {
+            throw std::runtime_error(std::string(what) + ": motor driver writes differ!");
+        }
+    }
+}
+
+/**
+ * @brief Feeds the same samples through a cascade and posts them through its executor.
+ * @param mpu Outer loop input
+ * @param ina Inner loop input
+ * @param executor Executor running the loops
+ * @param config Settings the loops were built from
+ * @param asAxes Post the MPU bursts as converted batches through hasAxes() rather than hasBatch()
+ * @return None
+ */
+void feedCascade(MPU6050_Driver::MPU6050Interface& mpu, INA260_Driver::INA260Interface& ina, CascadeExecutor& executor,
+                 const Params::Config& config, bool asAxes = false) {
+    MPU6050_Driver::MPU6050Batch batch;
+    const float mpuPeriod = config.MPUSamplePeriod(), inaPeriod = config.INASamplePeriod();
+    int nextMPU = 0;
+    for (int i = 0; i < 500; i++) {
+        // Post the MPU samples due before this INA sample, in bursts of up to three like a FIFO read.
+        MPU6050_Driver::MPU6050Sample burst[3];
+        std::size_t count = 0;
+        while (nextMPU * mpuPeriod <= i * inaPeriod && count < 3)
+            burst[count++] = mpuSample(nextMPU++, mpuPeriod);
+        if (count > 0 && asAxes) {
+            toBatch(burst, count, batch);
+            mpu.hasAxes(batch);
+        }
+        else if (count > 0)
+            mpu.hasBatch(burst, count);
+
+        INA260_Driver::INA260Sample sample;
+        sample.current = 0.2 * std::sin(i * 0.05);
+        sample.timestamp_ns = (uint64_t)(i * inaPeriod * 1e9);
+        ina.hasSample(sample);
+        executor.ProcessPending();
+    }
+}
+
+// Test case for the statically wired cascade
+/**
+ * @brief Runs the same samples through the runtime wired cascade and the statically wired one, and checks
+ * they drive the motor identically, whether the MPU bursts are posted as samples or as converted batches.
+ * @return None
+ */
+void testCascade() {
+    std::cout << "Test function for the cascade pipeline is getting executed" << std::endl;
+    Params::Config config = testConfig();
+    Telemetry::Logger telemetry("pipeline_Topology_ut.bin");
+    Telemetry::Producer& MPU_Telemetry = telemetry.createProducer(1 << 16);
+    Telemetry::Producer& INA_Telemetry = telemetry.createProducer(1 << 16);
+
+    FakeMotor runtimeMotor;
+    PID_MotorDriver innerPIDCallback(runtimeMotor, INA_Telemetry);
+    PID innerPID(&innerPIDCallback, 0, config.INASamplePeriod(), std::numeric_limits<double>::max(),
+                 std::numeric_limits<double>::lowest(), config.inner.Kp, config.inner.Kd, config.inner.Ki);
+    innerPID.setDerivativeOnMeasurement(true);
+    PID_Position outerPIDCallback(innerPID, MPU_Telemetry);
+    PID outerPID(&outerPIDCallback, config.outerSetpoint, config.MPUSamplePeriod(), config.outerLimit, -config.outerLimit,
+                 config.outer.Kp, config.outer.Kd, config.outer.Ki);
+    Attitude::Estimator estimator(config.mpuFilter, config.MPUSamplePeriod(), config.radius);
+    MPU6050_Feedback mpuCallback(outerPID, estimator, MPU_Telemetry);
+    INA260_Feedback inaCallback(innerPID, INA_Telemetry);
+    CascadeExecutor executor(mpuCallback, inaCallback);
+    feedCascade(executor.mpuInput(), executor.inaInput(), executor, config);
+
+    FakeMotor pipelineMotor;
+    Pipeline::Cascade<FakeMotor> cascade(config, pipelineMotor, MPU_Telemetry, INA_Telemetry);
+    feedCascade(cascade.mpuInput(), cascade.inaInput(), cascade.controlExecutor(), config);
+
+    expectSame(runtimeMotor.deltas, pipelineMotor.deltas, "Cascade");
+
+    FakeMotor axesMotor;
+    Pipeline::Cascade<FakeMotor> axesCascade(config, axesMotor, MPU_Telemetry, INA_Telemetry);
+    feedCascade(axesCascade.mpuInput(), axesCascade.inaInput(), axesCascade.controlExecutor(), config, true);
+
+    expectSame(runtimeMotor.deltas, axesMotor.deltas, "Cascade fed batches");
+}
+
+// Test case for the single loop
+/**
+ * @brief Runs the same samples through a runtime wired position loop and the single loop pipeline, and checks
+ * they drive the motor identically, straight from the MPU samples. Then checks bursts passed to the single loop
+ * as converted batches drive it the same as bursts of samples.
+ * @return None
+ */
+void testSingleLoop() {
+    std::cout << "Test function for the single loop pipeline is getting executed" << std::endl;
+    Params::Config config = testConfig();
+    config.topology = Params::Topology::SINGLE_LOOP;
+    Telemetry::Logger telemetry("pipeline_Topology_ut.bin");
+    Telemetry::Producer& MPU_Telemetry = telemetry.createProducer(1 << 16);
+
+    FakeMotor runtimeMotor;
+    PID_MotorDriver outerPIDCallback(runtimeMotor, MPU_Telemetry);
+    PID outerPID(&outerPIDCallback, config.outerSetpoint, config.MPUSamplePeriod(), config.outerLimit, -config.outerLimit,
+                 config.outer.Kp, config.outer.Kd, config.outer.Ki);
+    Attitude::Estimator estimator(config.mpuFilter, config.MPUSamplePeriod(), config.radius);
+    MPU6050_Feedback mpuCallback(outerPID, estimator, MPU_Telemetry);
+
+    FakeMotor pipelineMotor;
+    Pipeline::SingleLoop<FakeMotor> loop(config, pipelineMotor, MPU_Telemetry);
+
+    for (int i = 0; i < 300; i++) {
+        MPU6050_Driver::MPU6050Sample sample = mpuSample(i, config.MPUSamplePeriod());
+        MPU6050_Driver::MPU6050Sample copy = sample;
+        mpuCallback.hasSample(sample);
+        loop.mpuInput().hasSample(copy);
+    }
+
+    expectSame(runtimeMotor.deltas, pipelineMotor.deltas, "Single loop");
+
+    FakeMotor samplesMotor, axesMotor;
+    Pipeline::SingleLoop<FakeMotor> samplesLoop(config, samplesMotor, MPU_Telemetry), axesLoop(config, axesMotor, MPU_Telemetry);
+    MPU6050_Driver::MPU6050Batch batch;
+    for (int i = 0; i < 300; i += 5) {
+        MPU6050_Driver::MPU6050Sample burst[5];
+        for (int j = 0; j < 5; j++)
+            burst[j] = mpuSample(i + j, config.MPUSamplePeriod());
+        toBatch(burst, 5, batch);
+        axesLoop.mpuInput().hasAxes(batch);
+        samplesLoop.mpuInput().hasBatch(burst, 5);
+    }
+
+    expectSame(samplesMotor.deltas, axesMotor.deltas, "Single loop fed batches");
+}
+
+// Test case for tuning a pipeline
+/**
+ * @brief Starts a cascade with one set of gains and tunes it to another through the executor's pass hook,
+ * and checks it then drives the motor the same as a cascade started with the new gains.
+ * @return None
+ */
+void testTuning() {
+    std::cout << "Test function for tuning a pipeline is getting executed" << std::endl;
+    Params::Config tuned = testConfig();
+    Params::Config config = tuned;
+    config.inner = {0.1, 0, 0};
+    config.outerSetpoint = -0.05;
+    Telemetry::Logger telemetry("pipeline_Topology_ut.bin");
+    Telemetry::Producer& MPU_Telemetry = telemetry.createProducer(1 << 16);
+    Telemetry::Producer& INA_Telemetry = telemetry.createProducer(1 << 16);
+
+    FakeMotor expectedMotor;
+    Pipeline::Cascade<FakeMotor> expected(tuned, expectedMotor, MPU_Telemetry, INA_Telemetry);
+    Params::SnapshotStore<Params::Tuning> expectedStore(Params::StartingTuning(tuned));
+    CascadeTuner expectedTuner(expectedStore, expected);
+    expected.controlExecutor().SetPassHook(&expectedTuner);
+    feedCascade(expected.mpuInput(), expected.inaInput(), expected.controlExecutor(), tuned);
+
+    FakeMotor tunedMotor;
+    Pipeline::Cascade<FakeMotor> cascade(config, tunedMotor, MPU_Telemetry, INA_Telemetry);
+    Params::SnapshotStore<Params::Tuning> store(Params::StartingTuning(config));
+    CascadeTuner tuner(store, cascade);
+    cascade.controlExecutor().SetPassHook(&tuner);
+    store.publish(Params::StartingTuning(tuned));
+    feedCascade(cascade.mpuInput(), cascade.inaInput(), cascade.controlExecutor(), config);
+
+    if (tuner.GetAppliedCount() != 1) {
+        throw std::runtime_error("Tuning was not applied once!");
+    }
+    expectSame(expectedMotor.deltas, tunedMotor.deltas, "Tuned cascade");
+}
+
+int main() {
+    //Execute test case
+    testCascade();
+    testSingleLoop();
+    testTuning();
+    std::remove("pipeline_Topology_ut.bin");
+
+    std::cout << "All pipeline tests passed!" << std::endl;
+    return 0;
+}
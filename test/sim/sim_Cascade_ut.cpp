@@ -0,0 +1,377 @@
+/**
+ * @file    sim_Cascade_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the plant simulator and the full control cascade running against it
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include "../../lib/pid/pid.h"
+#include "../../lib/mpu6050/mpu6050.h"
+#include "../../lib/ina260/ina260.h"
+#include "../../lib/cascade/cascade.h"
+#include "../../lib/params/config.h"
+#include "../../lib/pipeline/pipeline.h"
+#include "../../lib/sim/plant.h"
+#include "../../lib/sim/sim_i2c_if.h"
+#include "../../lib/sim/simulator.h"
+
+/**
+ * @brief MPU6050 callback that keeps the last sample, and the size of the last batch.
+ */
+class LastMPU6050Sample : public MPU6050_Driver::MPU6050Interface
+{
+public:
+  virtual void hasSample(MPU6050_Driver::MPU6050Sample& _sample) override { sample = _sample; samples++; }
+  virtual void hasBatch(MPU6050_Driver::MPU6050Sample* batch, std::size_t count) override { sample = batch[count - 1]; batchSize = count; }
+  MPU6050_Driver::MPU6050Sample sample;
+  int samples = 0;
+  std::size_t batchSize = 0;
+};
+
+/**
+ * @brief MPU6050 callback that counts the samples and batches passing through it on their way to another callback.
+ */
+class CountingMPU6050Input : public MPU6050_Driver::MPU6050Interface
+{
+public:
+  CountingMPU6050Input(MPU6050_Driver::MPU6050Interface& _target) : target(_target) {}
+  virtual void hasSample(MPU6050_Driver::MPU6050Sample& sample) override { samples++; target.hasSample(sample); }
+  virtual void hasBatch(MPU6050_Driver::MPU6050Sample* batch, std::size_t count) override { batches++; target.hasBatch(batch, count); }
+  virtual void hasFrame(const MPU6050_Driver::MPU6050Frame& frame) override { samples++; target.hasFrame(frame); }
+  virtual void hasAxes(const MPU6050_Driver::MPU6050Batch& batch) override { batches++; frames += batch.count; target.hasAxes(batch); }
+  MPU6050_Driver::MPU6050Interface& target;
+  int samples = 0;
+  int batches = 0;
+  std::size_t frames = 0;
+};
+
+/**
+ * @brief INA260 callback that keeps the last sample.
+ */
+class LastINA260Sample : public INA260_Driver::INA260Interface
+{
+public:
+  virtual void hasSample(INA260_Driver::INA260Sample& _sample) override { sample = _sample; samples++; }
+  INA260_Driver::INA260Sample sample;
+  int samples = 0;
+};
+
+/**
+ * @brief Checks a measurement is within a tolerance of the expected value.
+ */
+void expectNear(double value, double expected, double tolerance, const char* what) {
+  if (std::fabs(value - expected) > tolerance) {
+    std::cout << what << ": " << value << ", expected " << expected << std::endl;
+    throw std::runtime_error("Simulated measurement is wrong!");
+  }
+}
+
+// Test case for the simulated register maps
+/**
+ * @brief Runs the real drivers against the simulated bus with the plant held still, and checks the
+ * samples they read match the plant, in both MPU aquisition modes.
+ * @return None
+ */
+void testSensorRegisters() {
+  std::cout << "Test function for the simulated register maps is getting executed" << std::endl;
+  Sim::Plant plant(Sim::PlantParams(), 0.1);
+  SIM_I2C_IF bus(plant);
+  plant.setDutyCycle(0.5);
+  plant.step(1e-6); // Update the motor current, without moving anything noticeably
+
+  LastMPU6050Sample mpuSamples;
+  MPU6050_Driver::MPU6050 mpu(&bus, &mpuSamples, 0);
+  if (mpu.InitializeSensor(MPU6050_Driver::Gyro_FS_t::FS_250_DPS, MPU6050_Driver::Accel_FS_t::FS_4G) != I2C_STATUS_SUCCESS) {
+    throw std::runtime_error("MPU6050 initialisation failed!");
+  }
+
+  // Nothing to read until the first sample is latched.
+  bus.LatchMPU6050();
+  if (mpu.ProcessSample() != I2C_STATUS_SUCCESS || mpuSamples.samples != 1) {
+    throw std::runtime_error("MPU6050 sample not read!");
+  }
+
+  const Sim::PlantState& state = plant.getState();
+  const double r = plant.getParams().mpuRadius;
+  expectNear(mpuSamples.sample.ax, (-Sim::GRAVITY * std::sin(0.1) + state.angularAcceleration * r) / Sim::GRAVITY, 0.001, "ax");
+  expectNear(mpuSamples.sample.ay, std::cos(0.1), 0.001, "ay");
+  expectNear(mpuSamples.sample.az, 0, 0.001, "az");
+  expectNear(mpuSamples.sample.gz, -state.angularVelocity * 180 / M_PI, 0.01, "gz");
+  expectNear(mpuSamples.sample.temp, 25, 0.01, "temp");
+
+  // FIFO burst mode: every latch pushes one frame, and a batch drains them all.
+  if (mpu.SetAcquisitionMode(MPU6050_Driver::Acquisition_t::FIFO_BURST, 8) != I2C_STATUS_SUCCESS) {
+    throw std::runtime_error("FIFO burst mode not set!");
+  }
+  for (int i = 0; i < 10; i++)
+    bus.LatchMPU6050();
+  if (mpu.ProcessBatch() != I2C_STATUS_SUCCESS || mpuSamples.batchSize != 10) {
+    throw std::runtime_error("FIFO batch has the wrong number of frames!");
+  }
+  expectNear(mpuSamples.sample.ay, std::cos(0.1), 0.001, "FIFO ay");
+
+  LastINA260Sample inaSamples;
+  INA260_Driver::INA260 ina(&bus, &inaSamples, 0);
+  if (ina.InitializeSensor(INA260_Driver::Alert_Conf::CNVR, INA260_Driver::Conv_Time::TU140, INA260_Driver::Conv_Time::TU4156,
+			   INA260_Driver::Ave_Mode::AV1, INA260_Driver::Op_Mode::CURVOLCONT) != I2C_STATUS_SUCCESS) {
+    throw std::runtime_error("INA260 initialisation failed!");
+  }
+
+  bus.LatchINA260();
+  if (ina.ProcessSample() != I2C_STATUS_SUCCESS || inaSamples.samples != 1) {
+    throw std::runtime_error("INA260 sample not read!");
+  }
+  expectNear(inaSamples.sample.current, -state.motorCurrent, 0.00125, "current");
+  expectNear(inaSamples.sample.voltage, plant.getParams().supplyVoltage, 0.00125, "voltage");
+
+  // Reading the sample clears the conversion ready flag.
+  i2c_status_t status;
+  if (bus.ReadRegisterWordBigEndian(INA260_ADDRESS, INA260_Driver::Sensor_Regs::MASKEN_REG, &status) & (1 << 3)) {
+    throw std::runtime_error("Conversion ready flag not cleared!");
+  }
+
+  // Nothing answers at other addresses.
+  bus.ReadRegister(0x50, 0x00, &status);
+  if (status != I2C_STATUS_ERROR) {
+    throw std::runtime_error("Unknown device answered!");
+  }
+}
+
+/**
+ * @brief Result of one closed loop run.
+ */
+struct CascadeResult {
+  double finalAngle;
+  double peakAngle;
+  double settlingTime;
+  int mpuSamples;
+  int mpuBatches;
+  std::size_t mpuFrames;
+};
+
+/**
+ * @brief Builds the cascade from the main program against the simulator, and runs it in virtual time.
+ * @param initialAngle Starting angle of the cup holder in rad
+ * @param duration Time to simulate in seconds
+ * @return CascadeResult Final and peak angles, and the last time the angle was outside 0.02 rad
+ */
+CascadeResult runCascade(double initialAngle, double duration) {
+  const float MPU_SamplePeriod = 0.01;
+  const float INA_SamplePeriod = 4156e-6;
+
+  Sim::PlantParams params;
+  params.accelNoise = 0.004;
+  params.gyroNoise = 0.05;
+  params.currentNoise = 0.005;
+  Sim::Plant plant(params, initialAngle);
+  SIM_I2C_IF bus(plant);
+  Sim::SimMotorDriver motorDriver(plant);
+  Sim::Simulator simulator(plant);
+
+  // Producers are never drained, so once full they just count drops.
+  Telemetry::Logger telemetry("sim_Cascade_ut.bin");
+  Telemetry::Producer& MPU_Telemetry = telemetry.createProducer(16);
+  Telemetry::Producer& INA_Telemetry = telemetry.createProducer(16);
+
+  PID_MotorDriver innerPIDCallback(motorDriver, INA_Telemetry);
+  PID innerPID(&innerPIDCallback, 0, INA_SamplePeriod, std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(), 0.02, 0, 0);
+  PID_Position outerPIDCallback(innerPID, MPU_Telemetry);
+  PID outerPID(&outerPIDCallback, 0, MPU_SamplePeriod, 6, -6, 30, 2, 0);
+
+  Attitude::Estimator estimator(Attitude::Filter_t::KALMAN, MPU_SamplePeriod, params.mpuRadius);
+  MPU6050_Feedback mpuCallback(outerPID, estimator, MPU_Telemetry);
+  MPU6050_Driver::MPU6050 mpu(&bus, &mpuCallback, 0);
+  INA260_Feedback inaCallback(innerPID, INA_Telemetry);
+  INA260_Driver::INA260 ina(&bus, &inaCallback, 0);
+
+  if (mpu.InitializeSensor(MPU6050_Driver::Gyro_FS_t::FS_250_DPS, MPU6050_Driver::Accel_FS_t::FS_2G, MPU6050_Driver::DLPF_t::BW_94Hz, 9) != I2C_STATUS_SUCCESS ||
+      ina.InitializeSensor(INA260_Driver::Alert_Conf::CNVR, INA260_Driver::Conv_Time::TU140, INA260_Driver::Conv_Time::TU4156,
+			   INA260_Driver::Ave_Mode::AV1, INA260_Driver::Op_Mode::CURCONT) != I2C_STATUS_SUCCESS) {
+    throw std::runtime_error("Simulated sensor initialisation failed!");
+  }
+
+  simulator.addPeriodicTask(MPU_SamplePeriod, [&]() { bus.LatchMPU6050(); mpu.ProcessSample(); });
+  simulator.addPeriodicTask(INA_SamplePeriod, [&]() { bus.LatchINA260(); ina.ProcessSample(); });
+
+  CascadeResult result = {0, 0, 0};
+  simulator.addObserver([&]() {
+    double angle = std::fabs(plant.getState().angle);
+    if (angle > 0.02)
+      result.settlingTime = simulator.now();
+    if (angle > result.peakAngle)
+      result.peakAngle = angle;
+  });
+
+  simulator.run(duration);
+  result.finalAngle = plant.getState().angle;
+  return result;
+}
+
+// Test case for the closed loop
+/**
+ * @brief Runs the full cascade from a tilted start, and checks the cup holder is brought back
+ * upright without hitting an end stop, and that repeating the run gives exactly the same result.
+ * @return None
+ */
+void testClosedLoop() {
+  std::cout << "Test function for the closed loop cascade is getting executed" << std::endl;
+  CascadeResult first = runCascade(0.05, 10);
+  std::cout << "Settled after " << first.settlingTime << " s, peak " << first.peakAngle << " rad, final " << first.finalAngle << " rad" << std::endl;
+
+  if (first.peakAngle > 0.1) {
+    throw std::runtime_error("Cup holder fell further over!");
+  }
+  if (first.settlingTime > 8 || std::fabs(first.finalAngle) > 0.02) {
+    throw std::runtime_error("Cup holder did not settle upright!");
+  }
+
+  CascadeResult second = runCascade(0.05, 10);
+  if (second.finalAngle != first.finalAngle || second.settlingTime != first.settlingTime) {
+    throw std::runtime_error("Simulation is not deterministic!");
+  }
+}
+
+/**
+ * @brief Builds the cascade from settings parsed out of a config file, as the main program does, and runs it
+ * in virtual time with the MPU6050 in the aquisition mode the settings ask for.
+ * @param configText Contents of the config file
+ * @return CascadeResult Final and peak angles, the last time the angle was outside 0.02 rad, and the MPU samples,
+ * batches and batched frames passed to the cascade
+ */
+CascadeResult runConfiguredCascade(const std::string& configText) {
+  Params::Config config;
+  std::istringstream in(configText);
+  std::string error;
+  if (!Params::ParseConfig(in, config, error)) {
+    std::cout << error << std::endl;
+    throw std::runtime_error("Config file did not parse!");
+  }
+
+  Sim::PlantParams params;
+  params.accelNoise = 0.004;
+  params.gyroNoise = 0.05;
+  params.currentNoise = 0.005;
+  config.radius = params.mpuRadius;
+  Sim::Plant plant(params, 0.05);
+  SIM_I2C_IF bus(plant);
+  Sim::SimMotorDriver motorDriver(plant);
+  Sim::Simulator simulator(plant);
+
+  // Producers are never drained, so once full they just count drops.
+  Telemetry::Logger telemetry("sim_Cascade_ut.bin");
+  Telemetry::Producer& MPU_Telemetry = telemetry.createProducer(16);
+  Telemetry::Producer& INA_Telemetry = telemetry.createProducer(16);
+
+  Pipeline::Cascade<Sim::SimMotorDriver> cascade(config, motorDriver, MPU_Telemetry, INA_Telemetry);
+  CascadeExecutor& controlExecutor = cascade.controlExecutor();
+  CountingMPU6050Input counter(cascade.mpuInput());
+  MPU6050_Driver::MPU6050 mpu(&bus, &counter, 0);
+  INA260_Driver::INA260 ina(&bus, &cascade.inaInput(), 0);
+
+  if (mpu.InitializeSensor(config.mpuGyroScale, config.mpuAccelScale, config.mpuDLPF, config.mpuSampleRateDiv) != I2C_STATUS_SUCCESS ||
+      ina.InitializeSensor(INA260_Driver::Alert_Conf::CNVR, config.inaVoltConvTime, config.inaCurrConvTime,
+			   config.inaAveraging, INA260_Driver::Op_Mode::CURCONT) != I2C_STATUS_SUCCESS ||
+      mpu.SetAcquisitionMode(config.mpuAcquisition, config.mpuBatchFrames) != I2C_STATUS_SUCCESS) {
+    throw std::runtime_error("Simulated sensor initialisation failed!");
+  }
+
+  Sim::AddMPU6050Aquisition(simulator, bus, mpu, config.mpuAcquisition, config.mpuBatchFrames, config.MPUSamplePeriod(),
+			    [&]() { controlExecutor.ProcessPending(); });
+  simulator.addPeriodicTask(config.INASamplePeriod(), [&]() { bus.LatchINA260(); ina.ProcessSample(); controlExecutor.ProcessPending(); });
+
+  CascadeResult result = {};
+  simulator.addObserver([&]() {
+    double angle = std::fabs(plant.getState().angle);
+    if (angle > 0.02)
+      result.settlingTime = simulator.now();
+    if (angle > result.peakAngle)
+      result.peakAngle = angle;
+  });
+
+  simulator.run(10);
+  result.finalAngle = plant.getState().angle;
+  result.mpuSamples = counter.samples;
+  result.mpuBatches = counter.batches;
+  result.mpuFrames = counter.frames;
+  return result;
+}
+
+// Test case for the configured aquisition modes
+/**
+ * @brief Runs the pipeline cascade from a config file in both MPU aquisition modes, and checks it settles
+ * either way, and that each mode reaches the cascade through its own callbacks. Each batch delays the newest sample
+ * by up to the batch length, so the batches are kept short enough for the simulator's gains.
+ * @return None
+ */
+void testConfiguredAquisition() {
+  std::cout << "Test function for the configured aquisition modes is getting executed" << std::endl;
+  const char* gains =
+    "inner = 0.02 0 0\n"
+    "outer = 30 2 0\n"
+    "outer_limit = 6\n";
+  std::string dataReady = std::string(gains) + "mpu_acquisition = data_ready\n";
+  std::string fifoBurst = std::string(gains) + "mpu_acquisition = fifo_burst\nmpu_batch_frames = 2\n";
+
+  CascadeResult sampled = runConfiguredCascade(dataReady);
+  CascadeResult batched = runConfiguredCascade(fifoBurst);
+  std::cout << "DATA_READY settled after " << sampled.settlingTime << " s, FIFO_BURST after " << batched.settlingTime << " s" << std::endl;
+
+  if (sampled.mpuSamples < 990 || sampled.mpuBatches != 0) {
+    throw std::runtime_error("DATA_READY aquisition did not pass single samples!");
+  }
+  if (batched.mpuSamples != 0 || batched.mpuBatches < 495 || batched.mpuFrames != 2 * (std::size_t)batched.mpuBatches) {
+    throw std::runtime_error("FIFO_BURST aquisition did not pass batches!");
+  }
+
+  if (sampled.peakAngle > 0.1 || batched.peakAngle > 0.1) {
+    throw std::runtime_error("Cup holder fell further over!");
+  }
+  if (sampled.settlingTime > 8 || std::fabs(sampled.finalAngle) > 0.02 ||
+      batched.settlingTime > 8 || std::fabs(batched.finalAngle) > 0.02) {
+    throw std::runtime_error("Cup holder did not settle upright!");
+  }
+}
+
+// Test case for the open loop plant
+/**
+ * @brief Checks the plant falls over with no control, and that positive motor current pushes it anticlockwise.
+ * @return None
+ */
+void testOpenLoop() {
+  std::cout << "Test function for the open loop plant is getting executed" << std::endl;
+  Sim::Plant falling(Sim::PlantParams(), 0.01);
+  Sim::Simulator fallingSim(falling);
+  fallingSim.run(5);
+  if (falling.getState().angle != falling.getParams().angleLimit) {
+    throw std::runtime_error("Uncontrolled plant didn't fall onto the end stop!");
+  }
+
+  Sim::Plant driven(Sim::PlantParams(), 0);
+  Sim::SimMotorDriver motorDriver(driven);
+  motorDriver.setDutyCycleDelta(0.3);
+  motorDriver.setDutyCycleDelta(0.3);
+  Sim::Simulator drivenSim(driven);
+  drivenSim.run(0.01);
+  if (motorDriver.getDutyCycle() != 0.6 || driven.getState().motorCurrent <= 0 || driven.getState().angle >= 0) {
+    throw std::runtime_error("Motor torque acts the wrong way!");
+  }
+}
+
+int main() {
+  //Execute test case
+  testSensorRegisters();
+  testOpenLoop();
+  testClosedLoop();
+  testConfiguredAquisition();
+  std::remove("sim_Cascade_ut.bin");
+
+  std::cout << "All simulator tests passed!" << std::endl;
+  return 0;
+}
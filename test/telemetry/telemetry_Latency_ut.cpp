@@ -0,0 +1,151 @@
+/**
+ * @file    telemetry_Latency_ut.cpp
+ * @author  Adam J. Englebright
+ * @date    16.10.2026
+ * @brief   This file constains the unit testing program that does offline validation of the latency histograms
+ * Copyright 2026 Adam J. Englebright <adamenglebright@rocketmail.com>
+ *
+ */
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "../../lib/telemetry/latency.h"
+
+// Test case for the histogram buckets
+/**
+ * @brief Checks every value lands in a bucket whose upper bound is at or above it and within the
+ * promised relative error, and that buckets are ordered.
+ * @return None
+ */
+void testBuckets() {
+    std::cout << "Test function for latency histogram buckets is getting executed" << std::endl;
+    using Telemetry::LatencyHistogram;
+
+    for (uint64_t value = 0; value < 64; value++) {
+        if (LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(value)) != value) {
+            throw std::runtime_error("Small latencies are not counted exactly!");
+        }
+    }
+
+    std::size_t lastIndex = 0;
+    for (uint64_t value = 64; value < (1ull << 35); value += value / 7 + 1) {
+        std::size_t index = LatencyHistogram::bucketIndex(value);
+        uint64_t upper = LatencyHistogram::bucketUpperBound(index);
+        if (index < lastIndex || index >= LatencyHistogram::BUCKET_COUNT - 1) {
+            throw std::runtime_error("Latency buckets are out of order!");
+        }
+        if (upper < value || (upper - value) > value / 32) {
+            throw std::runtime_error("Latency bucket is too coarse!");
+        }
+        lastIndex = index;
+    }
+
+    if (LatencyHistogram::bucketIndex(UINT64_MAX) != LatencyHistogram::BUCKET_COUNT - 1) {
+        throw std::runtime_error("Huge latencies are not counted in the overflow bucket!");
+    }
+}
+
+// Test case for the histogram statistics
+/**
+ * @brief Records 1 us to 1000 us in 1 us steps and checks the count, min, max, mean and percentiles.
+ * @return None
+ */
+void testStatistics() {
+    std::cout << "Test function for latency histogram statistics is getting executed" << std::endl;
+    Telemetry::LatencyHistogram histogram;
+
+    if (histogram.count() != 0 || histogram.min() != 0 || histogram.percentile(50) != 0) {
+        throw std::runtime_error("Empty histogram is not empty!");
+    }
+
+    for (uint64_t value = 1000; value <= 1000000; value += 1000)
+        histogram.record(value);
+
+    if (histogram.count() != 1000 || histogram.min() != 1000 || histogram.max() != 1000000) {
+        throw std::runtime_error("Histogram count, min or max is wrong!");
+    }
+    if (histogram.mean() != 500500) {
+        throw std::runtime_error("Histogram mean is wrong!");
+    }
+
+    // Percentiles are rounded up to the bucket bound, so allow for the bucket resolution.
+    const double percents[] = {50, 90, 99, 99.9};
+    for (double percent : percents) {
+        uint64_t expected = (uint64_t)(percent * 10) * 1000;
+        uint64_t actual = histogram.percentile(percent);
+        if (actual < expected || actual > expected + expected / 32) {
+            throw std::runtime_error("Histogram percentile is wrong!");
+        }
+    }
+    if (histogram.percentile(100) != 1000000) {
+        throw std::runtime_error("Histogram 100th percentile is not the max!");
+    }
+
+    histogram.reset();
+    if (histogram.count() != 0 || histogram.max() != 0) {
+        throw std::runtime_error("Histogram did not reset!");
+    }
+}
+
+// Test case for stamping stages of a trace
+/**
+ * @brief Stamps a sample through each stage with explicit times, and checks the stage and
+ * edge latencies, and that stamping without an active trace does nothing.
+ * @return None
+ */
+void testTrace() {
+    std::cout << "Test function for latency trace stamping is getting executed" << std::endl;
+    using Telemetry::LatencyStage;
+    using Telemetry::LatencyTrace;
+    LatencyTrace trace("test");
+
+    // Nothing is recorded before a trace is begun on this thread.
+    LatencyTrace::stamp(LatencyStage::WAKEUP, 100);
+    if (trace.stageLatency(LatencyStage::WAKEUP).count() != 0) {
+        throw std::runtime_error("Stamp recorded without an active trace!");
+    }
+
+    trace.begin(1000);
+    LatencyTrace::stamp(LatencyStage::WAKEUP, 1040);
+    LatencyTrace::stamp(LatencyStage::I2C_READ, 1050);
+    LatencyTrace::stamp(LatencyStage::CONTROL, 1055);
+    LatencyTrace::stamp(LatencyStage::PWM_WRITE, 1060);
+    LatencyTrace::end();
+    LatencyTrace::stamp(LatencyStage::LOGGING, 2000);
+
+    if (trace.stageLatency(LatencyStage::WAKEUP).max() != 40 || trace.stageLatency(LatencyStage::I2C_READ).max() != 10
+        || trace.stageLatency(LatencyStage::CONTROL).max() != 5 || trace.stageLatency(LatencyStage::PWM_WRITE).max() != 5) {
+        throw std::runtime_error("Stage latencies are wrong!");
+    }
+    if (trace.edgeLatency(LatencyStage::PWM_WRITE).max() != 60) {
+        throw std::runtime_error("Edge to PWM write latency is wrong!");
+    }
+    if (trace.stageLatency(LatencyStage::LOGGING).count() != 0) {
+        throw std::runtime_error("Stamp recorded after the trace ended!");
+    }
+
+    // An edge timestamp after the stamp is clamped rather than wrapping round.
+    trace.begin(5000);
+    LatencyTrace::stamp(LatencyStage::WAKEUP, 4000);
+    LatencyTrace::end();
+    if (trace.stageLatency(LatencyStage::WAKEUP).min() != 0) {
+        throw std::runtime_error("Negative latency was not clamped!");
+    }
+
+    std::ostringstream out;
+    trace.print(out);
+    if (out.str().find("edge->pwm_write") == std::string::npos || out.str().find("logging") != std::string::npos) {
+        throw std::runtime_error("Printed latency table is wrong!");
+    }
+}
+
+int main() {
+    //Execute test case
+    testBuckets();
+    testStatistics();
+    testTrace();
+
+    std::cout << "All latency tests passed!" << std::endl;
+    return 0;
+}